@@ -45,6 +45,7 @@
 #include "viennacl/linalg/bicgstab.hpp"
 #include "viennacl/linalg/gmres.hpp"
 #include "viennacl/linalg/mixed_precision_cg.hpp"
+#include "viennacl/linalg/iterative_refinement.hpp"
 
 #include "viennacl/linalg/ilu.hpp"
 #include "viennacl/linalg/ichol.hpp"
@@ -425,6 +426,11 @@ int run_benchmark(viennacl::context ctx)
     viennacl::linalg::mixed_precision_cg_tag mixed_precision_cg_solver(solver_tolerance, solver_iters);
 
     run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, mixed_precision_cg_solver, viennacl::linalg::no_precond(), cg_ops);
+
+    std::cout << "------- CG solver, mixed precision iterative refinement (no preconditioner) via ViennaCL, compressed_matrix ----------" << std::endl;
+    viennacl::linalg::iterative_refinement_tag<viennacl::linalg::cg_tag> refinement_cg_solver(viennacl::linalg::cg_tag(1e-2, solver_iters), solver_tolerance);
+
+    run_solver(vcl_compressed_matrix, vcl_vec2, vcl_result, refinement_cg_solver, viennacl::linalg::no_precond(), cg_ops);
   }
 
   std::cout << "------- CG solver (no preconditioner) via ViennaCL, coordinate_matrix ----------" << std::endl;
@@ -0,0 +1,198 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/*
+*
+*   Benchmark:  Setup time of the host-based SPAI and FSPAI preconditioners for increasing numbers of OpenMP threads
+*
+*   Usage: spai-bench-cpu [grid_size]
+*
+*/
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/host_spai.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/tools/timer.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <vector>
+#include <map>
+
+
+#define BENCHMARK_RUNS          3
+
+
+/** Finite difference discretization of -Laplace(u) + c * du/dx on a grid_size x grid_size grid. Symmetric for c = 0. */
+template<typename ScalarType>
+void fill_convection_diffusion(std::vector< std::map<unsigned int, ScalarType> > & A, unsigned int grid_size, ScalarType convection)
+{
+  A.resize(grid_size * grid_size);
+  for (unsigned int i=0; i<grid_size; ++i)
+    for (unsigned int j=0; j<grid_size; ++j)
+    {
+      unsigned int row = i * grid_size + j;
+      A[row][row] = 4;
+      if (i > 0)           A[row][row - grid_size] = -1;
+      if (i < grid_size-1) A[row][row + grid_size] = -1;
+      if (j > 0)           A[row][row - 1] = -1 - convection;
+      if (j < grid_size-1) A[row][row + 1] = -1 + convection;
+    }
+}
+
+
+template<typename PrecondT, typename MatrixT, typename TagT>
+double setup_time(MatrixT const & A, TagT const & tag)
+{
+  viennacl::tools::timer timer;
+  double best_time = 0;
+  for (int runs=0; runs<BENCHMARK_RUNS; ++runs)
+  {
+    timer.start();
+    PrecondT precond(A, tag);
+    double exec_time = timer.get();
+    if (runs == 0 || exec_time < best_time)
+      best_time = exec_time;
+  }
+  return best_time;
+}
+
+
+template<typename ScalarType>
+int run_benchmark(unsigned int grid_size)
+{
+  typedef viennacl::compressed_matrix<ScalarType>                          MatrixType;
+  typedef viennacl::linalg::host_spai_precond<MatrixType>                  SPAIType;
+  typedef viennacl::linalg::host_fspai_precond<MatrixType>                 FSPAIType;
+
+  std::vector< std::map<unsigned int, ScalarType> > std_A_sym, std_A_nonsym;
+  fill_convection_diffusion(std_A_sym,    grid_size, ScalarType(0));
+  fill_convection_diffusion(std_A_nonsym, grid_size, ScalarType(0.5));
+
+  MatrixType A_sym, A_nonsym;
+  viennacl::copy(std_A_sym, A_sym);
+  viennacl::copy(std_A_nonsym, A_nonsym);
+
+  std::cout << "Unknowns: " << A_sym.size1() << ", nonzeros: " << A_sym.nnz() << std::endl;
+
+  viennacl::linalg::spai_tag  static_tag(1e-3, 3, 5e-2, true);
+  viennacl::linalg::spai_tag  dynamic_tag(1e-3, 3, 5e-2, false);
+  viennacl::linalg::fspai_tag fspai_tag;
+
+  //
+  // Convergence with the preconditioners (independent of the number of threads):
+  //
+  viennacl::vector<ScalarType> rhs = viennacl::scalar_vector<ScalarType>(A_sym.size1(), ScalarType(1));
+
+  viennacl::linalg::bicgstab_tag bicgstab_none(1e-8, 1000);
+  viennacl::linalg::solve(A_nonsym, rhs, bicgstab_none);
+  viennacl::linalg::bicgstab_tag bicgstab_static(1e-8, 1000);
+  viennacl::linalg::solve(A_nonsym, rhs, bicgstab_static, SPAIType(A_nonsym, static_tag));
+  viennacl::linalg::bicgstab_tag bicgstab_dynamic(1e-8, 1000);
+  viennacl::linalg::solve(A_nonsym, rhs, bicgstab_dynamic, SPAIType(A_nonsym, dynamic_tag));
+  viennacl::linalg::cg_tag cg_none(1e-8, 1000);
+  viennacl::linalg::solve(A_sym, rhs, cg_none);
+  viennacl::linalg::cg_tag cg_fspai(1e-8, 1000);
+  viennacl::linalg::solve(A_sym, rhs, cg_fspai, FSPAIType(A_sym, fspai_tag));
+
+  std::cout << "BiCGStab iterations (none / static SPAI / dynamic SPAI): "
+            << bicgstab_none.iters() << " / " << bicgstab_static.iters() << " / " << bicgstab_dynamic.iters() << std::endl;
+  std::cout << "CG iterations (none / FSPAI): " << cg_none.iters() << " / " << cg_fspai.iters() << std::endl;
+
+  //
+  // Setup time scaling:
+  //
+  std::vector<int> thread_counts(1, 1);
+#ifdef VIENNACL_WITH_OPENMP
+  int max_threads = omp_get_max_threads();
+  for (int threads = 2; threads < max_threads; threads *= 2)
+    thread_counts.push_back(threads);
+  if (max_threads > 1)
+    thread_counts.push_back(max_threads);
+#endif
+
+  std::cout << std::endl;
+  std::cout << std::setw(8) << "Threads"
+            << std::setw(16) << "SPAI (static)" << std::setw(10) << "Speedup"
+            << std::setw(16) << "SPAI (dynamic)" << std::setw(10) << "Speedup"
+            << std::setw(16) << "FSPAI" << std::setw(10) << "Speedup" << std::endl;
+
+  double base_static = 0, base_dynamic = 0, base_fspai = 0;
+  for (std::size_t i=0; i<thread_counts.size(); ++i)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    omp_set_num_threads(thread_counts[i]);
+#endif
+    double time_static  = setup_time<SPAIType>(A_nonsym, static_tag);
+    double time_dynamic = setup_time<SPAIType>(A_nonsym, dynamic_tag);
+    double time_fspai   = setup_time<FSPAIType>(A_sym, fspai_tag);
+    if (i == 0)
+    {
+      base_static  = time_static;
+      base_dynamic = time_dynamic;
+      base_fspai   = time_fspai;
+    }
+
+    std::cout << std::setw(8) << thread_counts[i]
+              << std::setw(16) << time_static  << std::setw(10) << base_static  / time_static
+              << std::setw(16) << time_dynamic << std::setw(10) << base_dynamic / time_dynamic
+              << std::setw(16) << time_fspai   << std::setw(10) << base_fspai   / time_fspai << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char * argv[])
+{
+  unsigned int grid_size = (argc > 1) ? static_cast<unsigned int>(std::atoi(argv[1])) : 300;
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "               Device Info" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+#ifdef VIENNACL_WITH_OPENMP
+  std::cout << "Host with up to " << omp_get_max_threads() << " OpenMP threads" << std::endl;
+#else
+  std::cout << "Host without OpenMP, single thread only" << std::endl;
+#endif
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Benchmark :: SPAI/FSPAI Setup" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  std::cout << "   # benchmarking double-precision" << std::endl;
+  std::cout << "   -------------------------------" << std::endl;
+  run_benchmark<double>(grid_size);
+
+  std::cout << std::endl;
+  std::cout << "!!!! BENCHMARK COMPLETED SUCCESSFULLY !!!!" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
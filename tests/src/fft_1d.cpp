@@ -24,6 +24,7 @@
 #include <cmath>
 #include <complex>
 #include <algorithm>
+#include <cstdlib>
 
 //#define VIENNACL_BUILD_INFO
 #include "viennacl/linalg/host_based/fft_operations.hpp"
@@ -1015,6 +1016,354 @@ int testcorrectnes_multiply(const std::string& log_tag)
   return EXIT_SUCCESS;
 }
 
+void fill_random(std::vector<ScalarType>& data);
+
+void fill_random(std::vector<ScalarType>& data)
+{
+  for (std::size_t i = 0; i < data.size(); i++)
+    data[i] = ScalarType(std::rand()) / ScalarType(RAND_MAX) - ScalarType(0.5);
+}
+
+/** @brief Returns the maximum entrywise difference relative to the largest entry of the reference */
+ScalarType max_rel_diff(std::vector<ScalarType> const & vec, std::vector<ScalarType> const & ref);
+
+ScalarType max_rel_diff(std::vector<ScalarType> const & vec, std::vector<ScalarType> const & ref)
+{
+  ScalarType df = 0;
+  ScalarType mx = 0;
+  for (std::size_t i = 0; i < ref.size(); i++)
+  {
+    df = std::max<ScalarType>(std::fabs(vec[i] - ref[i]), df);
+    mx = std::max<ScalarType>(std::fabs(ref[i]), mx);
+  }
+  return df / mx;
+}
+
+/** @brief Direct DFT of a batch of interleaved complex sequences in double precision. Entries outside of the transforms are copied. */
+void dft_ref(std::vector<ScalarType> const & in, std::vector<ScalarType>& out, std::size_t size, std::size_t batch_num,
+    std::size_t stride, bool col_major, bool inverse);
+
+void dft_ref(std::vector<ScalarType> const & in, std::vector<ScalarType>& out, std::size_t size, std::size_t batch_num,
+    std::size_t stride, bool col_major, bool inverse)
+{
+  double pi = 3.1415926535897932384626433832795;
+  double sign = inverse ? 1.0 : -1.0;
+  out = in;
+  for (std::size_t b = 0; b < batch_num; b++)
+    for (std::size_t k = 0; k < size; k++)
+    {
+      std::complex<double> el;
+      for (std::size_t i = 0; i < size; i++)
+      {
+        std::size_t idx = col_major ? i * stride + b : b * stride + i;
+        double phi = sign * 2.0 * pi * double((i * k) % size) / double(size);
+        el += std::complex<double>(in[2 * idx], in[2 * idx + 1]) * std::complex<double>(std::cos(phi), std::sin(phi));
+      }
+      if (inverse)
+        el /= double(size);
+      std::size_t idx = col_major ? k * stride + b : b * stride + k;
+      out[2 * idx]     = ScalarType(el.real());
+      out[2 * idx + 1] = ScalarType(el.imag());
+    }
+}
+
+/** @brief Checks forward and inverse transforms of a plan on host arrays and vectors against the direct DFT, also with a stride differing from the one of the plan */
+int test_plan(std::size_t size, std::size_t batch_num, bool col_major, std::size_t stride, const std::string& name);
+
+int test_plan(std::size_t size, std::size_t batch_num, bool col_major, std::size_t stride, const std::string& name)
+{
+  namespace data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER;
+
+  std::cout << "*****************fft::plan::" << name << "***************************\n";
+
+  viennacl::fft_plan<ScalarType> plan(size, batch_num, ScalarType(-1), col_major ? data_order::COL_MAJOR : data_order::ROW_MAJOR, stride);
+  std::size_t plan_stride = plan.stride();
+
+  std::vector<ScalarType> input(plan.buffer_size());
+  fill_random(input);
+  std::vector<ScalarType> ref, ref_inverse;
+  dft_ref(input, ref, size, batch_num, plan_stride, col_major, false);
+  dft_ref(input, ref_inverse, size, batch_num, plan_stride, col_major, true);
+
+  std::vector<ScalarType> res(input);
+  plan.execute(&res[0]);
+  ScalarType df_forward = max_rel_diff(res, ref);
+  plan.execute(&res[0], true);
+  ScalarType df_round_trip = max_rel_diff(res, input);
+
+  res = input;
+  plan.execute(&res[0], true);
+  ScalarType df_inverse = max_rel_diff(res, ref_inverse);
+
+  // vectors, transformed via the free functions:
+  viennacl::vector<ScalarType> vcl_input(input.size());
+  viennacl::vector<ScalarType> vcl_output(input.size());
+  viennacl::fast_copy(input, vcl_input);
+  viennacl::fft(vcl_input, vcl_output, plan);
+  viennacl::fast_copy(vcl_output, res);
+  ScalarType df_vector = max_rel_diff(res, ref);
+  viennacl::inplace_ifft(vcl_output, plan);
+  viennacl::fast_copy(vcl_output, res);
+  df_vector = std::max(df_vector, max_rel_diff(res, input));
+
+  // different stride than the one of the plan:
+  std::size_t other_stride = plan_stride + 3;
+  std::vector<ScalarType> input_strided(2 * (col_major ? size : batch_num) * other_stride);
+  fill_random(input_strided);
+  dft_ref(input_strided, ref, size, batch_num, other_stride, col_major, false);
+  res = input_strided;
+  plan.execute_strided(&res[0], other_stride, false);
+  ScalarType df_strided = max_rel_diff(res, ref);
+  plan.execute_strided(&res[0], other_stride, true);
+  df_strided = std::max(df_strided, max_rel_diff(res, input_strided));
+
+  ScalarType df = std::max(std::max(df_forward, df_inverse), std::max(df_round_trip, std::max(df_vector, df_strided)));
+  printf("%7s SIZE=%6d; BATCH=%3d; STRIDE=%6d; DIFF=%3.15f;\n", ((df < ScalarType(1e-4)) ? "[Ok]" : "[Fail]"),
+      int(size), int(batch_num), int(plan_stride), df);
+
+  if (df >= ScalarType(1e-4))
+  {
+    std::cout << "# Error at operation: fft::plan::" << name << ", forward: " << df_forward << ", inverse: " << df_inverse
+              << ", round trip: " << df_round_trip << ", vector: " << df_vector << ", other stride: " << df_strided << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks the convolution with a precomputed plan against the direct circular convolution */
+int test_plan_convolve(std::size_t size);
+
+int test_plan_convolve(std::size_t size)
+{
+  std::cout << "*****************fft::plan::convolve***************************\n";
+
+  std::vector<ScalarType> in1(2 * size), in2(2 * size), res(2 * size), ref;
+  fill_random(in1);
+  fill_random(in2);
+  convolve_ref(in1, in2, ref);
+
+  viennacl::fft_plan<ScalarType> plan(size);
+  viennacl::vector<ScalarType> input1(in1.size());
+  viennacl::vector<ScalarType> input2(in2.size());
+  viennacl::vector<ScalarType> output(in1.size());
+  viennacl::fast_copy(in1, input1);
+  viennacl::fast_copy(in2, input2);
+  viennacl::linalg::convolve(input1, input2, output, plan);
+  viennacl::fast_copy(output, res);
+
+  ScalarType df = max_rel_diff(res, ref);
+  printf("%7s SIZE=%6d; DIFF=%3.15f;\n", ((df < ScalarType(1e-4)) ? "[Ok]" : "[Fail]"), int(size), df);
+  if (df >= ScalarType(1e-4))
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks large transforms (six-step algorithm with OpenMP) at selected frequencies against direct sums and by a round trip */
+int test_large_plan(std::size_t size, std::size_t batch_num, bool col_major, std::size_t stride, const std::string& name);
+
+int test_large_plan(std::size_t size, std::size_t batch_num, bool col_major, std::size_t stride, const std::string& name)
+{
+  namespace data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER;
+
+  std::cout << "*****************fft::plan::large::" << name << "***************************\n";
+
+  viennacl::fft_plan<ScalarType> plan(size, batch_num, ScalarType(-1), col_major ? data_order::COL_MAJOR : data_order::ROW_MAJOR, stride);
+  std::size_t plan_stride = plan.stride();
+
+  std::vector<ScalarType> input(plan.buffer_size());
+  fill_random(input);
+  std::vector<ScalarType> res(input);
+  plan.execute(&res[0]);
+
+  double pi = 3.1415926535897932384626433832795;
+  std::size_t freqs[] = {0, 1, 2, 3, 255, 256, 1000, size / 3, size / 2, size / 2 + 1, size - 2, size - 1};
+  double max_diff = 0;
+  double max_ref  = 0;
+  for (std::size_t b = 0; b < batch_num; b++)
+    for (std::size_t f = 0; f < sizeof(freqs) / sizeof(freqs[0]); f++)
+    {
+      std::size_t k = freqs[f];
+      std::complex<double> el;
+      for (std::size_t i = 0; i < size; i++)
+      {
+        std::size_t idx = col_major ? i * plan_stride + b : b * plan_stride + i;
+        double phi = -2.0 * pi * double((i * k) % size) / double(size);
+        el += std::complex<double>(input[2 * idx], input[2 * idx + 1]) * std::complex<double>(std::cos(phi), std::sin(phi));
+      }
+      std::size_t idx = col_major ? k * plan_stride + b : b * plan_stride + k;
+      max_diff = std::max(max_diff, std::abs(el - std::complex<double>(res[2 * idx], res[2 * idx + 1])));
+      max_ref  = std::max(max_ref, std::abs(el));
+    }
+  ScalarType df_forward = ScalarType(max_diff / max_ref);
+
+  plan.execute(&res[0], true);
+  ScalarType df_round_trip = max_rel_diff(res, input);
+
+  ScalarType df = std::max(df_forward, df_round_trip);
+  printf("%7s SIZE=%6d; BATCH=%3d; STRIDE=%6d; DIFF=%3.15f;\n", ((df < ScalarType(1e-4)) ? "[Ok]" : "[Fail]"),
+      int(size), int(batch_num), int(plan_stride), df);
+
+  if (df >= ScalarType(1e-4))
+  {
+    std::cout << "# Error at operation: fft::plan::large::" << name << ", forward: " << df_forward << ", round trip: " << df_round_trip << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks the half spectra of real transforms against the direct DFT and the round trip, on strided host arrays and on vectors and matrices */
+int test_real_plan(std::size_t size, std::size_t batch_num, std::size_t input_stride, std::size_t output_stride, const std::string& name);
+
+int test_real_plan(std::size_t size, std::size_t batch_num, std::size_t input_stride, std::size_t output_stride, const std::string& name)
+{
+  std::cout << "*****************fft::real_plan::" << name << "***************************\n";
+
+  viennacl::fft_real_plan<ScalarType> plan(size, batch_num);
+  std::size_t half = plan.spectrum_size();
+
+  std::vector<ScalarType> input(batch_num * input_stride);
+  fill_random(input);
+
+  // reference: complex transforms of the real sequences
+  std::vector<ScalarType> input_complex(2 * size * batch_num), ref_complex;
+  for (std::size_t b = 0; b < batch_num; b++)
+    for (std::size_t i = 0; i < size; i++)
+      input_complex[2 * (b * size + i)] = input[b * input_stride + i];
+  dft_ref(input_complex, ref_complex, size, batch_num, size, false, false);
+
+  // forward transform: compare the half spectra, the padding of the output must not be touched
+  std::vector<ScalarType> spectrum(batch_num * output_stride, ScalarType(42));
+  std::vector<ScalarType> ref_spectrum(spectrum);
+  for (std::size_t b = 0; b < batch_num; b++)
+    for (std::size_t k = 0; k < 2 * half; k++)
+      ref_spectrum[b * output_stride + k] = ref_complex[2 * b * size + k];
+  plan.execute(&input[0], input_stride, &spectrum[0], output_stride);
+  ScalarType df_forward = max_rel_diff(spectrum, ref_spectrum);
+
+  // inverse transform (the half spectra are now used as input with output_stride)
+  std::vector<ScalarType> res(batch_num * input_stride, ScalarType(42));
+  std::vector<ScalarType> ref(input);
+  for (std::size_t b = 0; b < batch_num; b++)
+    for (std::size_t i = size; i < input_stride; i++)
+      ref[b * input_stride + i] = ScalarType(42);
+  plan.execute(&spectrum[0], output_stride, &res[0], input_stride, true);
+  ScalarType df_round_trip = max_rel_diff(res, ref);
+
+  // dense vectors via the free functions:
+  std::vector<ScalarType> dense_input(size * batch_num);
+  for (std::size_t b = 0; b < batch_num; b++)
+    std::copy(input.begin() + long(b * input_stride), input.begin() + long(b * input_stride + size), dense_input.begin() + long(b * size));
+  viennacl::vector<ScalarType> vcl_input(dense_input.size());
+  viennacl::vector<ScalarType> vcl_spectrum;
+  viennacl::vector<ScalarType> vcl_result;
+  viennacl::fast_copy(dense_input, vcl_input);
+  viennacl::fft(vcl_input, vcl_spectrum, plan);
+  std::vector<ScalarType> dense_spectrum(vcl_spectrum.size()), dense_ref_spectrum(2 * half * batch_num);
+  viennacl::fast_copy(vcl_spectrum, dense_spectrum);
+  for (std::size_t b = 0; b < batch_num; b++)
+    std::copy(ref_complex.begin() + long(2 * b * size), ref_complex.begin() + long(2 * b * size + 2 * half), dense_ref_spectrum.begin() + long(2 * b * half));
+  ScalarType df_vector = (dense_spectrum.size() == dense_ref_spectrum.size()) ? max_rel_diff(dense_spectrum, dense_ref_spectrum) : ScalarType(1);
+  viennacl::ifft(vcl_spectrum, vcl_result, plan);
+  std::vector<ScalarType> dense_result(vcl_result.size());
+  viennacl::fast_copy(vcl_result, dense_result);
+  df_vector = std::max(df_vector, (dense_result.size() == dense_input.size()) ? max_rel_diff(dense_result, dense_input) : ScalarType(1));
+
+  // 2-D transform of a real matrix with batch_num rows:
+  std::vector<std::vector<ScalarType> > std_matrix(batch_num, std::vector<ScalarType>(size));
+  for (std::size_t b = 0; b < batch_num; b++)
+    std::copy(dense_input.begin() + long(b * size), dense_input.begin() + long((b + 1) * size), std_matrix[b].begin());
+  viennacl::matrix<ScalarType, viennacl::row_major> vcl_matrix(batch_num, size);
+  viennacl::matrix<ScalarType, viennacl::row_major> vcl_matrix_spectrum;
+  viennacl::matrix<ScalarType, viennacl::row_major> vcl_matrix_result;
+  viennacl::copy(std_matrix, vcl_matrix);
+  viennacl::fft(vcl_matrix, vcl_matrix_spectrum, plan);
+  viennacl::ifft(vcl_matrix_spectrum, vcl_matrix_result, plan);
+  std::vector<std::vector<ScalarType> > std_result(batch_num, std::vector<ScalarType>(size));
+  viennacl::copy(vcl_matrix_result, std_result);
+  for (std::size_t b = 0; b < batch_num; b++)
+    std::copy(std_result[b].begin(), std_result[b].end(), dense_result.begin() + long(b * size));
+  ScalarType df_matrix = max_rel_diff(dense_result, dense_input);
+
+  ScalarType df = std::max(std::max(df_forward, df_round_trip), std::max(df_vector, df_matrix));
+  printf("%7s SIZE=%6d; BATCH=%3d; STRIDES=%6d,%6d; DIFF=%3.15f;\n", ((df < ScalarType(1e-4)) ? "[Ok]" : "[Fail]"),
+      int(size), int(batch_num), int(input_stride), int(output_stride), df);
+
+  if (df >= ScalarType(1e-4))
+  {
+    std::cout << "# Error at operation: fft::real_plan::" << name << ", forward: " << df_forward << ", round trip: " << df_round_trip
+              << ", vector: " << df_vector << ", matrix: " << df_matrix << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks the streaming convolution of signals pushed in chunks of varying size against the direct linear convolution */
+int test_streaming_convolution(std::size_t filter_size, std::size_t block_size, viennacl::linalg::streaming_convolution_method method,
+    std::size_t signal_size, const std::string& name);
+
+int test_streaming_convolution(std::size_t filter_size, std::size_t block_size, viennacl::linalg::streaming_convolution_method method,
+    std::size_t signal_size, const std::string& name)
+{
+  std::cout << "*****************fft::streaming_convolution::" << name << "***************************\n";
+
+  std::vector<ScalarType> filter(filter_size);
+  fill_random(filter);
+  viennacl::linalg::streaming_convolution<ScalarType> conv(filter, block_size, method);
+  if (block_size > 0 && conv.block_size() < block_size)
+  {
+    std::cout << "# Error at operation: fft::streaming_convolution::" << name << ", block size " << conv.block_size() << " instead of " << block_size << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ScalarType df = 0;
+  // the second signal checks that flush() resets the history
+  for (std::size_t run = 0; run < 2; run++)
+  {
+    std::vector<ScalarType> signal(signal_size + run * 37);
+    fill_random(signal);
+
+    std::vector<ScalarType> ref(signal.size() + filter_size - 1);
+    for (std::size_t n = 0; n < ref.size(); n++)
+    {
+      double el = 0;
+      for (std::size_t k = 0; k < filter_size; k++)
+        if (n >= k && n - k < signal.size())
+          el += double(filter[k]) * double(signal[n - k]);
+      ref[n] = ScalarType(el);
+    }
+
+    std::vector<ScalarType> res;
+    std::size_t chunk_sizes[] = {1, 7, 0, 100, 3, 1000, 64, 2};
+    std::size_t pushed = 0;
+    for (std::size_t c = 0; pushed < signal.size(); c = (c + 1) % (sizeof(chunk_sizes) / sizeof(chunk_sizes[0])))
+    {
+      std::size_t count = std::min(chunk_sizes[c], signal.size() - pushed);
+      conv.push(&signal[0] + pushed, count, res);
+      pushed += count;
+      // only complete blocks are emitted, the remaining samples are pending:
+      if (res.size() % conv.block_size() != 0 || res.size() + conv.pending() != pushed)
+      {
+        std::cout << "# Error at operation: fft::streaming_convolution::" << name << ", " << res.size() << " outputs and "
+                  << conv.pending() << " pending samples after " << pushed << " samples" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    conv.flush(res);
+    if (res.size() != ref.size() || conv.pending() != 0)
+    {
+      std::cout << "# Error at operation: fft::streaming_convolution::" << name << ", " << res.size() << " outputs instead of " << ref.size() << std::endl;
+      return EXIT_FAILURE;
+    }
+    df = std::max(df, max_rel_diff(res, ref));
+  }
+
+  printf("%7s FILTER=%6d; BLOCK=%6d; FFT=%6d; SIGNAL=%6d; DIFF=%3.15f;\n", ((df < ScalarType(1e-4)) ? "[Ok]" : "[Fail]"),
+      int(filter_size), int(conv.block_size()), int(conv.fft_size()), int(signal_size), df);
+  if (df >= ScalarType(1e-4))
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
+
 int main()
 {
   std::cout << "*" << std::endl;
@@ -1065,6 +1414,113 @@ int main()
       &fft_reverse_direct) == EXIT_FAILURE)
     return EXIT_FAILURE;
 
+  //FFT plans: single, batched and strided transforms
+  if (test_plan(256, 1, false, 0, "single") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan(2, 3, false, 0, "tiny") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan(128, 7, false, 0, "batch::row_major") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan(64, 5, false, 70, "batch::row_major::strided") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan(32, 6, true, 0, "batch::col_major") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan(512, 3, true, 4, "batch::col_major::strided") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan_convolve(128) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  //FFT plans for non-power-of-two sizes: mixed-radix for small prime factors, Bluestein otherwise
+  if (viennacl::fft_plan<ScalarType>(3 * 5 * 7 * 64).radices().empty() || !viennacl::fft_plan<ScalarType>(67).radices().empty())
+  {
+    std::cout << "# Error at operation: fft::plan, wrong choice of mixed-radix and Bluestein algorithm" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (test_plan(3 * 5 * 7, 1, false, 0, "mixed_radix") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan(1000, 3, false, 0, "mixed_radix::batch") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan(2 * 9 * 49, 2, true, 5, "mixed_radix::col_major::strided") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan(61, 2, false, 64, "mixed_radix::prime::strided") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan(97, 1, false, 0, "bluestein::prime") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan(1009, 4, false, 0, "bluestein::prime::batch") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan(2 * 3 * 67, 3, true, 0, "bluestein::col_major") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan(101, 2, false, 110, "bluestein::prime::strided") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_plan_convolve(97) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  //large transforms, split into sub-transforms if there are fewer transforms than threads
+  if (test_large_plan(65536, 1, false, 0, "single") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_large_plan(81 * 125 * 7, 1, false, 0, "mixed_radix") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_large_plan(131072, 2, false, 131075, "batch::row_major::strided") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_large_plan(512 * 27 * 5, 2, true, 3, "batch::col_major::strided") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  //real-to-complex and complex-to-real plans: even sizes use a complex transform of half length, odd sizes of full length
+  if (test_real_plan(256, 1, 256, 258, "even") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_real_plan(2, 3, 2, 4, "even::tiny") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_real_plan(90, 5, 96, 100, "even::batch::strided") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_real_plan(2 * 97, 3, 2 * 97, 2 * 98, "even::bluestein::batch") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_real_plan(105, 1, 105, 106, "odd") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_real_plan(101, 4, 103, 107, "odd::batch::strided") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  //streaming convolution with overlap-save and overlap-add
+  if (test_streaming_convolution(33, 0, viennacl::linalg::OVERLAP_SAVE, 5000, "overlap_save") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_streaming_convolution(33, 0, viennacl::linalg::OVERLAP_ADD, 5000, "overlap_add") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_streaming_convolution(16, 5, viennacl::linalg::OVERLAP_SAVE, 777, "overlap_save::small_block") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_streaming_convolution(16, 5, viennacl::linalg::OVERLAP_ADD, 777, "overlap_add::small_block") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_streaming_convolution(1, 0, viennacl::linalg::OVERLAP_SAVE, 300, "overlap_save::single_tap") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (test_streaming_convolution(50, 200, viennacl::linalg::OVERLAP_ADD, 10, "overlap_add::short_signal") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
   std::cout << std::endl;
   std::cout << "------- Test completed --------" << std::endl;
   std::cout << std::endl;
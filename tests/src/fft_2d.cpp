@@ -24,6 +24,7 @@
 #include <cmath>
 #include <complex>
 #include <algorithm>
+#include <cstdlib>
 
 //#define VIENNACL_BUILD_INFO
 #include "viennacl/linalg/host_based/fft_operations.hpp"
@@ -308,6 +309,144 @@ int test_correctness(const std::string& log_tag, input_function_ptr input_functi
   return EXIT_SUCCESS;
 }
 
+void fill_random(std::vector<ScalarType>& data);
+
+void fill_random(std::vector<ScalarType>& data)
+{
+  for (std::size_t i = 0; i < data.size(); i++)
+    data[i] = ScalarType(std::rand()) / ScalarType(RAND_MAX) - ScalarType(0.5);
+}
+
+/** @brief Returns the maximum entrywise difference relative to the largest entry of the reference */
+ScalarType max_rel_diff(std::vector<ScalarType> const & vec, std::vector<ScalarType> const & ref);
+
+ScalarType max_rel_diff(std::vector<ScalarType> const & vec, std::vector<ScalarType> const & ref)
+{
+  ScalarType df = 0;
+  ScalarType mx = 0;
+  for (std::size_t i = 0; i < ref.size(); i++)
+  {
+    df = std::max<ScalarType>(std::fabs(vec[i] - ref[i]), df);
+    mx = std::max<ScalarType>(std::fabs(ref[i]), mx);
+  }
+  return df / mx;
+}
+
+/** @brief Direct 3-D DFT in double precision of batch_num row-major size0 x size1 x size2 arrays of interleaved complex numbers, computed one dimension after the other */
+void dft_3d_ref(std::vector<ScalarType> const & in, std::vector<ScalarType>& out, std::size_t batch_num,
+    std::size_t size0, std::size_t size1, std::size_t size2, bool inverse);
+
+void dft_3d_ref(std::vector<ScalarType> const & in, std::vector<ScalarType>& out, std::size_t batch_num,
+    std::size_t size0, std::size_t size1, std::size_t size2, bool inverse)
+{
+  double pi = 3.1415926535897932384626433832795;
+  double sign = inverse ? 1.0 : -1.0;
+  std::size_t sizes[3]   = {size0, size1, size2};
+  std::size_t strides[3] = {size1 * size2, size2, 1};
+  std::size_t total = size0 * size1 * size2;
+
+  std::vector<std::complex<double> > data(total * batch_num), line;
+  for (std::size_t i = 0; i < data.size(); i++)
+    data[i] = std::complex<double>(in[2 * i], in[2 * i + 1]);
+
+  for (std::size_t d = 0; d < 3; d++)
+  {
+    std::size_t n = sizes[d];
+    line.resize(n);
+    for (std::size_t start = 0; start < data.size(); start++)
+    {
+      // process each line along dimension d once, starting from its first entry:
+      if ((start % total / strides[d]) % n != 0)
+        continue;
+      for (std::size_t k = 0; k < n; k++)
+      {
+        line[k] = 0;
+        for (std::size_t i = 0; i < n; i++)
+        {
+          double phi = sign * 2.0 * pi * double((i * k) % n) / double(n);
+          line[k] += data[start + i * strides[d]] * std::complex<double>(std::cos(phi), std::sin(phi));
+        }
+        if (inverse)
+          line[k] /= double(n);
+      }
+      for (std::size_t k = 0; k < n; k++)
+        data[start + k * strides[d]] = line[k];
+    }
+  }
+
+  out.resize(2 * data.size());
+  for (std::size_t i = 0; i < data.size(); i++)
+  {
+    out[2 * i]     = ScalarType(data[i].real());
+    out[2 * i + 1] = ScalarType(data[i].imag());
+  }
+}
+
+/** @brief Checks forward, inverse and round-trip transforms of a plan on a host array and on vectors against the direct DFT */
+template<class PlanT>
+ScalarType test_plan_transforms(PlanT const & plan, std::size_t batch_num, std::size_t size0, std::size_t size1, std::size_t size2)
+{
+  std::vector<ScalarType> input(plan.buffer_size());
+  fill_random(input);
+  std::vector<ScalarType> ref, ref_inverse;
+  dft_3d_ref(input, ref, batch_num, size0, size1, size2, false);
+  dft_3d_ref(input, ref_inverse, batch_num, size0, size1, size2, true);
+
+  std::vector<ScalarType> res(input);
+  plan.execute(&res[0]);
+  ScalarType df = max_rel_diff(res, ref);
+  plan.execute(&res[0], true);
+  df = std::max(df, max_rel_diff(res, input));
+
+  res = input;
+  plan.execute(&res[0], true);
+  df = std::max(df, max_rel_diff(res, ref_inverse));
+
+  viennacl::vector<ScalarType> vcl_input(input.size());
+  viennacl::vector<ScalarType> vcl_output(input.size());
+  viennacl::fast_copy(input, vcl_input);
+  viennacl::fft(vcl_input, vcl_output, plan);
+  viennacl::fast_copy(vcl_output, res);
+  df = std::max(df, max_rel_diff(res, ref));
+  viennacl::inplace_ifft(vcl_output, plan);
+  viennacl::fast_copy(vcl_output, res);
+  df = std::max(df, max_rel_diff(res, input));
+
+  return df;
+}
+
+int test_plan_2d(std::size_t rows, std::size_t cols, std::size_t batch_num, const std::string& name);
+
+int test_plan_2d(std::size_t rows, std::size_t cols, std::size_t batch_num, const std::string& name)
+{
+  std::cout << "*****************fft::plan_2d::" << name << "***************************\n";
+
+  viennacl::fft_plan_2d<ScalarType> plan(rows, cols, batch_num);
+  ScalarType df = test_plan_transforms(plan, batch_num, 1, rows, cols);
+  printf("%7s ROWS=%6d COLS=%6d; BATCH=%3d; DIFF=%3.15f;\n", ((df < ScalarType(1e-4)) ? "[Ok]" : "[Fail]"),
+      int(rows), int(cols), int(batch_num), df);
+
+  if (df >= ScalarType(1e-4))
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
+
+int test_plan_3d(std::size_t size0, std::size_t size1, std::size_t size2, const std::string& name);
+
+int test_plan_3d(std::size_t size0, std::size_t size1, std::size_t size2, const std::string& name)
+{
+  std::cout << "*****************fft::plan_3d::" << name << "***************************\n";
+
+  viennacl::fft_plan_3d<ScalarType> plan(size0, size1, size2);
+  ScalarType df = test_plan_transforms(plan, 1, size0, size1, size2);
+  printf("%7s SIZES=%4d x %4d x %4d; DIFF=%3.15f;\n", ((df < ScalarType(1e-4)) ? "[Ok]" : "[Fail]"),
+      int(size0), int(size1), int(size2), df);
+
+  if (df >= ScalarType(1e-4))
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
+
 int main()
 {
   std::cout << "*" << std::endl;
@@ -327,6 +466,30 @@ int main()
   if (test_correctness("fft::transpose", read_matrices_pair, &transpose) == EXIT_FAILURE)
       return EXIT_FAILURE;
 
+  //2D plans, also for batches of images
+  if (test_plan_2d(16, 32, 1, "radix2") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+  if (test_plan_2d(12, 10, 3, "mixed_radix::batch") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+  if (test_plan_2d(7, 13, 2, "prime::batch") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+  if (test_plan_2d(67, 5, 2, "bluestein::batch") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+  if (test_plan_2d(1, 24, 4, "single_row::batch") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  //3D plans
+  if (test_plan_3d(8, 8, 8, "radix2") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+  if (test_plan_3d(6, 5, 7, "mixed_radix") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+  if (test_plan_3d(3, 67, 4, "bluestein") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+  if (test_plan_3d(20, 3, 2, "panels") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+  if (test_plan_3d(1, 16, 9, "single_slice") == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
   std::cout << std::endl;
   std::cout << "------- Test completed --------" << std::endl;
   std::cout << std::endl;
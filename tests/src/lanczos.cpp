@@ -0,0 +1,181 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** \file tests/src/lanczos.cpp  Tests the Lanczos eigenvalue solvers against the analytic spectrum of the 2D Laplacian.
+*   \test Tests the Lanczos eigenvalue solvers against the analytic spectrum of the 2D Laplacian.
+**/
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/lanczos.hpp"
+#include "viennacl/linalg/thick_restart_lanczos.hpp"
+#include "viennacl/tools/matrix_generation.hpp"
+
+
+typedef double   ScalarType;
+
+
+/** @brief Returns the eigenvalues 4 - 2 cos(i pi / (nx + 1)) - 2 cos(j pi / (ny + 1)) of the five-point Laplacian on an nx x ny grid in ascending order */
+std::vector<ScalarType> laplace_spectrum(std::size_t nx, std::size_t ny)
+{
+  ScalarType pi = ScalarType(3.1415926535897932384626433832795);
+  std::vector<ScalarType> spectrum;
+  for (std::size_t i = 1; i <= nx; ++i)
+    for (std::size_t j = 1; j <= ny; ++j)
+      spectrum.push_back(4 - 2 * std::cos(ScalarType(i) * pi / ScalarType(nx + 1)) - 2 * std::cos(ScalarType(j) * pi / ScalarType(ny + 1)));
+  std::sort(spectrum.begin(), spectrum.end());
+  return spectrum;
+}
+
+/** @brief Compares computed eigenvalues with the reference values, both ordered from the most extremal one */
+int check_eigenvalues(std::vector<ScalarType> const & computed, std::vector<ScalarType> const & reference, ScalarType tolerance, std::string const & name)
+{
+  if (computed.size() < reference.size())
+  {
+    std::cout << "# Error at operation: " << name << ", only " << computed.size() << " of " << reference.size() << " eigenvalues returned" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (std::size_t i = 0; i < reference.size(); ++i)
+    if (std::fabs(computed[i] - reference[i]) > tolerance * std::fabs(reference[i]))
+    {
+      std::cout << "# Error at operation: " << name << ", eigenvalue " << i << ": " << computed[i] << " vs. " << reference[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks the residuals ||A v - lambda v|| and the orthonormality of the eigenvectors */
+int check_eigenvectors(viennacl::compressed_matrix<ScalarType> const & A, viennacl::matrix<ScalarType> const & V, std::vector<ScalarType> const & eigenvalues,
+                       ScalarType tolerance, std::string const & name)
+{
+  for (std::size_t i = 0; i < eigenvalues.size(); ++i)
+  {
+    viennacl::vector<ScalarType> v = viennacl::column(V, static_cast<unsigned int>(i));
+    viennacl::vector<ScalarType> residual = viennacl::linalg::prod(A, v);
+    residual -= eigenvalues[i] * v;
+    ScalarType res = viennacl::linalg::norm_2(residual) / std::fabs(eigenvalues[i]);
+    if (res > tolerance)
+    {
+      std::cout << "# Error at operation: " << name << ", residual of eigenpair " << i << ": " << res << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    for (std::size_t j = 0; j <= i; ++j)
+    {
+      viennacl::vector<ScalarType> w = viennacl::column(V, static_cast<unsigned int>(j));
+      ScalarType expected = (i == j) ? 1 : 0;
+      if (std::fabs(viennacl::linalg::inner_prod(v, w) - expected) > 1e-8)
+      {
+        std::cout << "# Error at operation: " << name << ", orthonormality of eigenvectors " << i << " and " << j << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+
+int test_thick_restart(viennacl::compressed_matrix<ScalarType> const & A, std::vector<ScalarType> const & spectrum,
+                       int which, viennacl::vcl_size_t chebyshev_degree, std::string const & name)
+{
+  std::cout << "Testing thick-restart Lanczos, " << name << std::endl;
+
+  viennacl::vcl_size_t num_eig = 8;
+  viennacl::linalg::thick_restart_lanczos_tag tag(num_eig, 0, 1e-10, 500, which);
+  tag.chebyshev_degree(chebyshev_degree);
+
+  std::vector<ScalarType> reference(num_eig);
+  for (std::size_t i = 0; i < num_eig; ++i)
+    reference[i] = (which == viennacl::linalg::thick_restart_lanczos_tag::largest) ? spectrum[spectrum.size() - 1 - i] : spectrum[i];
+
+  viennacl::matrix<ScalarType> V(A.size1(), num_eig);
+  std::vector<ScalarType> eigenvalues = viennacl::linalg::eig(A, V, tag);
+  if (tag.num_converged() != num_eig || tag.restarts() >= tag.max_restarts())
+  {
+    std::cout << "# Error at operation: thick-restart Lanczos, " << name << ", converged: " << tag.num_converged() << ", restarts: " << tag.restarts() << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (check_eigenvalues(eigenvalues, reference, 1e-9, "thick-restart Lanczos, " + name) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check_eigenvectors(A, V, eigenvalues, 1e-8, "thick-restart Lanczos, " + name) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // eigenvalues only:
+  std::vector<ScalarType> eigenvalues_only = viennacl::linalg::eig(A, tag);
+  return check_eigenvalues(eigenvalues_only, reference, 1e-9, "thick-restart Lanczos without eigenvectors, " + name);
+}
+
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Lanczos Eigenvalue Solvers" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  // a rectangular grid avoids multiple eigenvalues:
+  std::size_t nx = 20, ny = 23;
+  viennacl::compressed_matrix<ScalarType> A;
+  viennacl::tools::generate_fdm_laplace(A, nx, ny);
+  std::vector<ScalarType> spectrum = laplace_spectrum(nx, ny);
+
+  // Lanczos with partial and full reorthogonalization, largest eigenvalue:
+  for (int method = 0; method < 2; ++method)
+  {
+    std::cout << "Testing Lanczos, reorthogonalization method " << method << std::endl;
+    viennacl::linalg::lanczos_tag tag(0.75, 4, method, 200);
+    std::vector<ScalarType> eigenvalues = viennacl::linalg::eig(A, tag);
+    std::vector<ScalarType> reference(1, spectrum.back());
+    if (check_eigenvalues(eigenvalues, reference, 1e-6, "Lanczos") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  if (test_thick_restart(A, spectrum, viennacl::linalg::thick_restart_lanczos_tag::largest,  0,  "largest")                    != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (test_thick_restart(A, spectrum, viennacl::linalg::thick_restart_lanczos_tag::smallest, 0,  "smallest")                   != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (test_thick_restart(A, spectrum, viennacl::linalg::thick_restart_lanczos_tag::largest,  8,  "largest, Chebyshev filter")  != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (test_thick_restart(A, spectrum, viennacl::linalg::thick_restart_lanczos_tag::smallest, 10, "smallest, Chebyshev filter") != EXIT_SUCCESS) return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
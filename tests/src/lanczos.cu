@@ -0,0 +1 @@
+lanczos.cpp
\ No newline at end of file
@@ -0,0 +1,482 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** \file tests/src/reordering.cpp  Tests graph partitioning and reorderings of sparse matrices.
+*   \test Tests graph partitioning and reorderings of sparse matrices.
+**/
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <cmath>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/permutation.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/ilu.hpp"
+#include "viennacl/misc/graph_partitioning.hpp"
+#include "viennacl/misc/bandwidth_reduction.hpp"
+#include "viennacl/tools/matrix_generation.hpp"
+#include "viennacl/tools/random.hpp"
+
+
+typedef double   ScalarType;
+
+
+/** @brief Returns the symmetrized sparsity pattern of A without the diagonal */
+std::vector< std::vector<unsigned int> > symmetric_pattern(viennacl::compressed_matrix<ScalarType> const & A)
+{
+  std::vector< std::map<unsigned int, ScalarType> > A_host(A.size1());
+  viennacl::copy(A, A_host);
+
+  std::vector< std::vector<unsigned int> > neighbors(A.size1());
+  for (std::size_t i = 0; i < A_host.size(); ++i)
+    for (std::map<unsigned int, ScalarType>::const_iterator it = A_host[i].begin(); it != A_host[i].end(); ++it)
+      if (it->first != i)
+      {
+        neighbors[i].push_back(it->first);
+        neighbors[it->first].push_back(static_cast<unsigned int>(i));
+      }
+  for (std::size_t i = 0; i < neighbors.size(); ++i)
+  {
+    std::sort(neighbors[i].begin(), neighbors[i].end());
+    neighbors[i].erase(std::unique(neighbors[i].begin(), neighbors[i].end()), neighbors[i].end());
+  }
+  return neighbors;
+}
+
+/** @brief A matrix with a nonsymmetric sparsity pattern: a 2D grid with couplings to the left and lower neighbors only, plus a few random entries */
+void generate_nonsymmetric(viennacl::compressed_matrix<ScalarType> & A, unsigned int grid_size)
+{
+  viennacl::tools::uniform_random_numbers<ScalarType> randomNumber;
+  unsigned int n = grid_size * grid_size;
+  std::vector< std::map<unsigned int, ScalarType> > A_host(n);
+  for (unsigned int i = 0; i < grid_size; ++i)
+    for (unsigned int j = 0; j < grid_size; ++j)
+    {
+      unsigned int row = i * grid_size + j;
+      A_host[row][row] = 4;
+      if (i > 0) A_host[row][row - grid_size] = -1;
+      if (j > 0) A_host[row][row - 1] = -1;
+    }
+  for (unsigned int k = 0; k < n / 20; ++k)
+  {
+    unsigned int row = static_cast<unsigned int>(randomNumber() * ScalarType(n - 1));
+    unsigned int col = static_cast<unsigned int>(randomNumber() * ScalarType(n - 1));
+    A_host[row][col] = ScalarType(0.1);
+  }
+  viennacl::copy(A_host, A);
+}
+
+
+int test_partition(viennacl::compressed_matrix<ScalarType> const & A, viennacl::vcl_size_t num_parts, double imbalance, std::string const & name)
+{
+  std::cout << "Testing graph partitioning, " << name << ", " << num_parts << " parts, imbalance " << imbalance << std::endl;
+
+  viennacl::multilevel_kway_tag tag(num_parts, imbalance);
+  std::vector<unsigned int> part = viennacl::partition(A, tag);
+
+  // every vertex is assigned to a valid part, and all parts are used:
+  std::vector<viennacl::vcl_size_t> part_sizes(num_parts, 0);
+  if (part.size() != A.size1())
+  {
+    std::cout << "# Error at operation: partition size, " << part.size() << " vs. " << A.size1() << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (std::size_t i = 0; i < part.size(); ++i)
+  {
+    if (part[i] >= num_parts)
+    {
+      std::cout << "# Error at operation: vertex " << i << " assigned to invalid part " << part[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+    ++part_sizes[part[i]];
+  }
+
+  // reported largest part and balance bound (1 + imbalance) * ceil(n / num_parts):
+  viennacl::vcl_size_t max_part_size = *std::max_element(part_sizes.begin(), part_sizes.end());
+  viennacl::vcl_size_t min_part_size = *std::min_element(part_sizes.begin(), part_sizes.end());
+  double balance_bound = (1.0 + tag.imbalance()) * double((A.size1() + num_parts - 1) / num_parts);
+  if (tag.max_part_size() != max_part_size || double(max_part_size) > balance_bound || min_part_size == 0)
+  {
+    std::cout << "# Error at operation: balance of partitioning" << std::endl;
+    std::cout << "  largest part: " << max_part_size << " (reported: " << tag.max_part_size() << ", bound: " << balance_bound << "), smallest part: " << min_part_size << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // reported edge cut of the symmetrized graph:
+  std::vector< std::vector<unsigned int> > neighbors = symmetric_pattern(A);
+  viennacl::vcl_size_t edge_cut = 0;
+  for (std::size_t i = 0; i < neighbors.size(); ++i)
+    for (std::size_t j = 0; j < neighbors[i].size(); ++j)
+      if (i < neighbors[i][j] && part[i] != part[neighbors[i][j]])
+        ++edge_cut;
+  if (tag.edge_cut() != edge_cut)
+  {
+    std::cout << "# Error at operation: edge cut, reported " << tag.edge_cut() << " vs. " << edge_cut << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // consecutive numbering of the parts:
+  std::vector< std::pair<viennacl::vcl_size_t, viennacl::vcl_size_t> > block_boundaries;
+  std::vector<unsigned int> r = viennacl::partition_permutation<unsigned int>(part, num_parts, block_boundaries);
+  std::vector<bool> used(r.size(), false);
+  std::vector<long> last_in_part(num_parts, -1);
+  bool ranges_ok = (r.size() == part.size() && block_boundaries.size() == num_parts && block_boundaries[0].first == 0 && block_boundaries[num_parts-1].second == part.size());
+  for (viennacl::vcl_size_t p = 0; p < num_parts && ranges_ok; ++p)
+    ranges_ok = (block_boundaries[p].second - block_boundaries[p].first == part_sizes[p]) && (p == 0 || block_boundaries[p].first == block_boundaries[p-1].second);
+  for (std::size_t i = 0; i < r.size() && ranges_ok; ++i)
+  {
+    ranges_ok = r[i] < r.size() && !used[r[i]]
+                && block_boundaries[part[i]].first <= r[i] && r[i] < block_boundaries[part[i]].second
+                && last_in_part[part[i]] < static_cast<long>(r[i]);  // order within each part is preserved
+    if (ranges_ok)
+    {
+      used[r[i]] = true;
+      last_in_part[part[i]] = static_cast<long>(r[i]);
+    }
+  }
+  if (!ranges_ok)
+  {
+    std::cout << "# Error at operation: partition_permutation()" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+/** @brief Returns the bandwidth of A after renumbering unknown i to r[i] */
+unsigned int reordered_bandwidth(std::vector< std::map<unsigned int, ScalarType> > const & A, std::vector<unsigned int> const & r)
+{
+  unsigned int bandwidth = 0;
+  for (std::size_t i = 0; i < A.size(); ++i)
+    for (std::map<unsigned int, ScalarType>::const_iterator it = A[i].begin(); it != A[i].end(); ++it)
+      bandwidth = std::max(bandwidth, (r[i] > r[it->first]) ? r[i] - r[it->first] : r[it->first] - r[i]);
+  return bandwidth;
+}
+
+/** @brief A randomly renumbered matrix consisting of 2D grids of the given sizes, which are not coupled with each other */
+void generate_components(viennacl::compressed_matrix<ScalarType> & A, std::vector<unsigned int> const & grid_sizes, std::vector<unsigned int> & component)
+{
+  std::vector< std::map<unsigned int, ScalarType> > A_blocks;
+  std::vector<unsigned int> block_component;
+  for (std::size_t c = 0; c < grid_sizes.size(); ++c)
+  {
+    unsigned int offset = static_cast<unsigned int>(A_blocks.size());
+    unsigned int m = grid_sizes[c];
+    A_blocks.resize(offset + m * m);
+    block_component.resize(offset + m * m, static_cast<unsigned int>(c));
+    for (unsigned int i = 0; i < m; ++i)
+      for (unsigned int j = 0; j < m; ++j)
+      {
+        unsigned int row = offset + i * m + j;
+        A_blocks[row][row] = 4;
+        if (i > 0)     A_blocks[row][row - m] = -1;
+        if (i + 1 < m) A_blocks[row][row + m] = -1;
+        if (j > 0)     A_blocks[row][row - 1] = -1;
+        if (j + 1 < m) A_blocks[row][row + 1] = -1;
+      }
+  }
+
+  // random renumbering such that the components are interleaved:
+  viennacl::tools::uniform_random_numbers<ScalarType> randomNumber;
+  std::vector<unsigned int> r(A_blocks.size());
+  for (std::size_t i = 0; i < r.size(); ++i)
+    r[i] = static_cast<unsigned int>(i);
+  for (std::size_t i = r.size(); i > 1; --i)
+    std::swap(r[i-1], r[static_cast<std::size_t>(randomNumber() * ScalarType(i - 1))]);
+
+  std::vector< std::map<unsigned int, ScalarType> > A_host(A_blocks.size());
+  component.resize(A_blocks.size());
+  for (std::size_t i = 0; i < A_blocks.size(); ++i)
+  {
+    component[r[i]] = block_component[i];
+    for (std::map<unsigned int, ScalarType>::const_iterator it = A_blocks[i].begin(); it != A_blocks[i].end(); ++it)
+      A_host[r[i]][r[it->first]] = it->second;
+  }
+  viennacl::copy(A_host, A);
+}
+
+/** @brief Checks that r is a permutation of 0, ..., n-1 */
+bool is_permutation(std::vector<unsigned int> const & r, std::size_t n)
+{
+  std::vector<bool> used(n, false);
+  if (r.size() != n)
+    return false;
+  for (std::size_t i = 0; i < r.size(); ++i)
+  {
+    if (r[i] >= n || used[r[i]])
+      return false;
+    used[r[i]] = true;
+  }
+  return true;
+}
+
+/** @brief Tests the Cuthill-McKee orderings of a compressed_matrix against the sequential implementation for STL matrices. If component is not empty, each connected component must be numbered consecutively. */
+int test_cuthill_mckee(viennacl::compressed_matrix<ScalarType> const & A, std::vector<unsigned int> const & component, std::string const & name)
+{
+  std::cout << "Testing Cuthill-McKee for compressed_matrix, " << name << std::endl;
+
+  std::vector< std::map<unsigned int, ScalarType> > A_host(A.size1());
+  viennacl::copy(A, A_host);
+  std::size_t n = A_host.size();
+
+  std::vector<unsigned int> r_cm  = viennacl::reorder(A, viennacl::cuthill_mckee_tag());
+  std::vector<unsigned int> r_rcm = viennacl::reorder(A, viennacl::reverse_cuthill_mckee_tag());
+  if (!is_permutation(r_cm, n) || !is_permutation(r_rcm, n))
+  {
+    std::cout << "# Error at operation: Cuthill-McKee result is not a permutation" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (std::size_t i = 0; i < n; ++i)
+    if (r_rcm[i] != n - 1 - r_cm[i])
+    {
+      std::cout << "# Error at operation: reverse Cuthill-McKee is not the reversed Cuthill-McKee numbering" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  if (!component.empty())
+  {
+    std::vector<unsigned int> first(n, static_cast<unsigned int>(n)), last(n, 0), size(n, 0);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      first[component[i]] = std::min(first[component[i]], r_cm[i]);
+      last[component[i]]  = std::max(last[component[i]], r_cm[i]);
+      ++size[component[i]];
+    }
+    for (std::size_t c = 0; c < n; ++c)
+      if (size[c] > 0 && last[c] - first[c] + 1 != size[c])
+      {
+        std::cout << "# Error at operation: component " << c << " not numbered consecutively" << std::endl;
+        return EXIT_FAILURE;
+      }
+  }
+
+  // the bandwidth is comparable to the one of the sequential implementation and much smaller than the original one:
+  std::vector<unsigned int> identity(n);
+  for (std::size_t i = 0; i < n; ++i)
+    identity[i] = static_cast<unsigned int>(i);
+  std::vector<unsigned int> r_serial = viennacl::reorder(A_host, viennacl::cuthill_mckee_tag());
+  unsigned int bw_original = reordered_bandwidth(A_host, identity);
+  unsigned int bw_serial   = reordered_bandwidth(A_host, r_serial);
+  unsigned int bw_cm       = reordered_bandwidth(A_host, r_cm);
+  unsigned int bw_rcm      = reordered_bandwidth(A_host, r_rcm);
+  if (bw_rcm != bw_cm || 4 * bw_cm > 5 * bw_serial + 4 || 4 * bw_cm > bw_original)
+  {
+    std::cout << "# Error at operation: bandwidth after Cuthill-McKee" << std::endl;
+    std::cout << "  original: " << bw_original << ", STL: " << bw_serial << ", CM: " << bw_cm << ", RCM: " << bw_rcm << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+ScalarType relative_residual(viennacl::compressed_matrix<ScalarType> const & A, viennacl::vector<ScalarType> const & x, viennacl::vector<ScalarType> const & rhs)
+{
+  viennacl::vector<ScalarType> residual = viennacl::linalg::prod(A, x);
+  residual -= rhs;
+  return viennacl::linalg::norm_2(residual) / viennacl::linalg::norm_2(rhs);
+}
+
+/** @brief Tests permute() and permute_inverse() for matrices and vectors as well as permuted_system for the reverse Cuthill-McKee ordering of A */
+int test_permutation(viennacl::compressed_matrix<ScalarType> const & A, bool symmetric, std::string const & name)
+{
+  std::cout << "Testing permutations, " << name << std::endl;
+
+  viennacl::permutation P(viennacl::reorder(A, viennacl::reverse_cuthill_mckee_tag()));
+  std::size_t n = P.size();
+
+  // out-of-place: B(P[i], P[j]) = A(i, j)
+  viennacl::compressed_matrix<ScalarType> B;
+  viennacl::permute(A, P, B);
+  std::vector< std::map<unsigned int, ScalarType> > A_host(n), B_host(n);
+  viennacl::copy(A, A_host);
+  viennacl::copy(B, B_host);
+  bool entries_ok = (B.nnz() == A.nnz());
+  for (std::size_t i = 0; i < n && entries_ok; ++i)
+  {
+    entries_ok = (B_host[P[i]].size() == A_host[i].size());
+    for (std::map<unsigned int, ScalarType>::const_iterator it = A_host[i].begin(); it != A_host[i].end() && entries_ok; ++it)
+    {
+      std::map<unsigned int, ScalarType>::const_iterator it_B = B_host[P[i]].find(P[it->first]);
+      entries_ok = (it_B != B_host[P[i]].end() && !(it_B->second < it->second) && !(it_B->second > it->second));
+    }
+  }
+
+  // in place, and back with the inverse permutation:
+  viennacl::compressed_matrix<ScalarType> C = A;
+  viennacl::permute(C, P);
+  std::vector< std::map<unsigned int, ScalarType> > C_host(n);
+  viennacl::copy(C, C_host);
+  bool in_place_ok = (C_host == B_host);
+  viennacl::permute(C, P.inverse());
+  std::vector< std::map<unsigned int, ScalarType> > C_back_host(n);
+  viennacl::copy(C, C_back_host);
+  bool round_trip_ok = (C_back_host == A_host);
+  if (!entries_ok || !in_place_ok || !round_trip_ok)
+  {
+    std::cout << "# Error at operation: permutation of matrix, entries: " << entries_ok << ", in place: " << in_place_ok << ", round trip: " << round_trip_ok << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // vectors: x[i] moves to P[i], round trip for contiguous and strided vectors, and (P A P^T)(P x) = P (A x)
+  std::vector<ScalarType> x_host(n);
+  for (std::size_t i = 0; i < n; ++i)
+    x_host[i] = ScalarType(i + 1);
+  viennacl::vector<ScalarType> x(n), x_strided_buffer(2 * n);
+  viennacl::copy(x_host, x);
+  viennacl::vector_slice<viennacl::vector<ScalarType> > x_strided(x_strided_buffer, viennacl::slice(1, 2, n));
+  x_strided = x;
+
+  viennacl::vector<ScalarType> Ax = viennacl::linalg::prod(A, x);
+  viennacl::permute(Ax, P);
+  viennacl::vector<ScalarType> Px = x;
+  viennacl::permute(Px, P);
+  viennacl::vector<ScalarType> BPx = viennacl::linalg::prod(B, Px);
+  std::vector<ScalarType> Px_host(n);
+  viennacl::copy(Px, Px_host);
+  bool vector_ok = true;
+  for (std::size_t i = 0; i < n && vector_ok; ++i)
+    vector_ok = !(Px_host[P[i]] < x_host[i]) && !(Px_host[P[i]] > x_host[i]);
+  viennacl::vector<ScalarType> diff = BPx - Ax;
+  bool product_ok = viennacl::linalg::norm_2(diff) <= 1e-14 * viennacl::linalg::norm_2(Ax);
+
+  viennacl::permute_inverse(Px, P);
+  diff = Px - x;
+  bool vector_round_trip_ok = viennacl::linalg::norm_2(diff) <= 0;
+  viennacl::permute(x_strided, P);
+  viennacl::permute_inverse(x_strided, P);
+  diff = x_strided - x;
+  bool strided_round_trip_ok = viennacl::linalg::norm_2(diff) <= 0;
+  if (!vector_ok || !product_ok || !vector_round_trip_ok || !strided_round_trip_ok)
+  {
+    std::cout << "# Error at operation: permutation of vectors, entries: " << vector_ok << ", product: " << product_ok
+              << ", round trip: " << vector_round_trip_ok << ", strided round trip: " << strided_round_trip_ok << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // solve in the reordered numbering, with and without a preconditioner set up for the permuted matrix:
+  viennacl::linalg::permuted_system<ScalarType> system(A, P);
+  viennacl::vector<ScalarType> rhs = viennacl::scalar_vector<ScalarType>(n, ScalarType(1));
+  viennacl::linalg::ilu0_precond<viennacl::compressed_matrix<ScalarType> > ilu0(system.matrix(), viennacl::linalg::ilu0_tag());
+  viennacl::vector<ScalarType> x_plain(n), x_precond(n);
+  viennacl::vcl_size_t iters_plain, iters_precond;
+  if (symmetric)
+  {
+    viennacl::linalg::cg_tag tag_plain(1e-10, 1000), tag_precond(1e-10, 1000);
+    x_plain   = system.solve(rhs, tag_plain);
+    x_precond = system.solve(rhs, tag_precond, ilu0);
+    iters_plain = tag_plain.iters();
+    iters_precond = tag_precond.iters();
+  }
+  else
+  {
+    viennacl::linalg::bicgstab_tag tag_plain(1e-10, 1000), tag_precond(1e-10, 1000);
+    x_plain   = system.solve(rhs, tag_plain);
+    x_precond = system.solve(rhs, tag_precond, ilu0);
+    iters_plain = tag_plain.iters();
+    iters_precond = tag_precond.iters();
+  }
+  ScalarType res_plain   = relative_residual(A, x_plain, rhs);
+  ScalarType res_precond = relative_residual(A, x_precond, rhs);
+  if (res_plain > 1e-8 || res_precond > 1e-8 || iters_precond >= iters_plain)
+  {
+    std::cout << "# Error at operation: permuted_system::solve()" << std::endl;
+    std::cout << "  residual: " << res_plain << " (" << iters_plain << " iterations), with ILU0: " << res_precond << " (" << iters_precond << " iterations)" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Graph Partitioning and Reordering" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  viennacl::compressed_matrix<ScalarType> A_laplace, A_nonsym;
+  viennacl::tools::generate_fdm_laplace(A_laplace, 40, 40);
+  generate_nonsymmetric(A_nonsym, 37);
+
+  viennacl::vcl_size_t part_counts[4] = { 1, 2, 7, 16 };
+  for (int k = 0; k < 4; ++k)
+  {
+    if (test_partition(A_laplace, part_counts[k], 0.03, "Laplace")              != EXIT_SUCCESS) return EXIT_FAILURE;
+    if (test_partition(A_laplace, part_counts[k], 0.01, "Laplace")              != EXIT_SUCCESS) return EXIT_FAILURE;
+    if (test_partition(A_nonsym,  part_counts[k], 0.03, "nonsymmetric pattern") != EXIT_SUCCESS) return EXIT_FAILURE;
+    if (test_partition(A_nonsym,  part_counts[k], 0.01, "nonsymmetric pattern") != EXIT_SUCCESS) return EXIT_FAILURE;
+  }
+
+  // Cuthill-McKee: connected graph and several components (including isolated vertices) in random numbering:
+  std::vector<unsigned int> grid_sizes;
+  grid_sizes.push_back(30);
+  viennacl::compressed_matrix<ScalarType> A_connected, A_components;
+  std::vector<unsigned int> connected_component, components;
+  generate_components(A_connected, grid_sizes, connected_component);
+  grid_sizes.push_back(17);
+  grid_sizes.push_back(5);
+  grid_sizes.push_back(1);
+  grid_sizes.push_back(1);
+  generate_components(A_components, grid_sizes, components);
+  if (test_cuthill_mckee(A_connected,  connected_component,       "connected")            != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (test_cuthill_mckee(A_components, components,                "five components")      != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (test_cuthill_mckee(A_nonsym,     std::vector<unsigned int>(), "nonsymmetric pattern") != EXIT_SUCCESS) return EXIT_FAILURE;
+
+  if (test_permutation(A_laplace, true,  "Laplace")              != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (test_permutation(A_nonsym,  false, "nonsymmetric pattern") != EXIT_SUCCESS) return EXIT_FAILURE;
+
+  // a two-way partition of the 40x40 grid should not cut much more than one grid line (40 edges):
+  viennacl::multilevel_kway_tag bisection_tag(2);
+  viennacl::partition(A_laplace, bisection_tag);
+  if (bisection_tag.edge_cut() > 80)
+  {
+    std::cout << "# Error at operation: edge cut of bisection of a 40x40 grid: " << bisection_tag.edge_cut() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
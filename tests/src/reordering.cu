@@ -0,0 +1 @@
+reordering.cpp
\ No newline at end of file
@@ -0,0 +1,334 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** \file tests/src/spai.cpp  Tests the host-based setup of the SPAI and FSPAI preconditioners.
+*   \test Tests the host-based setup of the SPAI and FSPAI preconditioners. With OpenCL enabled, the results are also compared with the uBLAS-based setup.
+**/
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#ifdef VIENNACL_WITH_OPENCL
+//
+// *** Boost
+//
+#include "boost/numeric/ublas/matrix_sparse.hpp"
+
+#define VIENNACL_WITH_UBLAS 1
+#endif
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/host_spai.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+#include "viennacl/linalg/spai.hpp"
+#endif
+
+
+typedef double                                               ScalarType;
+typedef std::vector< std::map<unsigned int, ScalarType> >   HostMatrixType;
+
+#ifdef VIENNACL_WITH_OPENCL
+typedef boost::numeric::ublas::compressed_matrix<ScalarType> UblasMatrixType;
+#endif
+
+
+/** @brief Finite difference discretization of -Laplace(u) + c * du/dx on a grid_size x grid_size grid. Symmetric for c = 0. */
+void fill_convection_diffusion(HostMatrixType & A, unsigned int grid_size, ScalarType convection)
+{
+  A.resize(grid_size * grid_size);
+  for (unsigned int i=0; i<grid_size; ++i)
+    for (unsigned int j=0; j<grid_size; ++j)
+    {
+      unsigned int row = i * grid_size + j;
+      A[row][row] = 4;
+      if (i > 0)           A[row][row - grid_size] = -1;
+      if (i < grid_size-1) A[row][row + grid_size] = -1;
+      if (j > 0)           A[row][row - 1] = -1 - convection;
+      if (j < grid_size-1) A[row][row + 1] = -1 + convection;
+    }
+}
+
+/** @brief Returns the product A * B of two sparse matrices on the host */
+HostMatrixType host_prod(HostMatrixType const & A, HostMatrixType const & B)
+{
+  HostMatrixType C(A.size());
+  for (std::size_t i=0; i<A.size(); ++i)
+    for (std::map<unsigned int, ScalarType>::const_iterator a_it = A[i].begin(); a_it != A[i].end(); ++a_it)
+      for (std::map<unsigned int, ScalarType>::const_iterator b_it = B[a_it->first].begin(); b_it != B[a_it->first].end(); ++b_it)
+        C[i][b_it->first] += a_it->second * b_it->second;
+  return C;
+}
+
+/** @brief Returns the transpose of a sparse n-by-n matrix on the host */
+HostMatrixType host_trans(HostMatrixType const & A)
+{
+  HostMatrixType At(A.size());
+  for (std::size_t i=0; i<A.size(); ++i)
+    for (std::map<unsigned int, ScalarType>::const_iterator it = A[i].begin(); it != A[i].end(); ++it)
+      At[it->first][static_cast<unsigned int>(i)] = it->second;
+  return At;
+}
+
+/** @brief Returns the largest magnitude of the entries of A at the nonzero positions of the pattern P, with the given value subtracted on the diagonal */
+ScalarType max_on_pattern(HostMatrixType const & A, HostMatrixType const & P, ScalarType diagonal)
+{
+  ScalarType max_entry = 0;
+  for (std::size_t i=0; i<P.size(); ++i)
+    for (std::map<unsigned int, ScalarType>::const_iterator it = P[i].begin(); it != P[i].end(); ++it)
+    {
+      std::map<unsigned int, ScalarType>::const_iterator a_it = A[i].find(it->first);
+      ScalarType value = (a_it != A[i].end()) ? a_it->second : 0;
+      if (it->first == i)
+        value -= diagonal;
+      max_entry = std::max(max_entry, std::fabs(value));
+    }
+  return max_entry;
+}
+
+/** @brief Checks the normal equations of the local least-squares problems: A^T (A M - I) vanishes on the pattern of M for a right preconditioner, (M A - I) A^T for a left preconditioner. */
+ScalarType spai_normal_equations_error(HostMatrixType const & A, HostMatrixType const & M, bool is_right)
+{
+  HostMatrixType E = is_right ? host_prod(A, M) : host_prod(M, A);
+  for (std::size_t i=0; i<E.size(); ++i)
+    E[i][static_cast<unsigned int>(i)] -= 1;
+  HostMatrixType G = is_right ? host_prod(host_trans(A), E) : host_prod(E, host_trans(A));
+  return max_on_pattern(G, M, 0);
+}
+
+ScalarType relative_residual(viennacl::compressed_matrix<ScalarType> const & A, viennacl::vector<ScalarType> const & x, viennacl::vector<ScalarType> const & rhs)
+{
+  viennacl::vector<ScalarType> residual = viennacl::linalg::prod(A, x);
+  residual -= rhs;
+  return viennacl::linalg::norm_2(residual) / viennacl::linalg::norm_2(rhs);
+}
+
+#ifdef VIENNACL_WITH_OPENCL
+/** @brief Returns the maximum entrywise difference of the two matrices relative to the largest entry of the reference, or a value larger than one if the sparsity patterns differ */
+ScalarType diff(viennacl::compressed_matrix<ScalarType> const & M, UblasMatrixType const & M_ref)
+{
+  HostMatrixType M_host(M.size1());
+  viennacl::copy(M, M_host);
+
+  ScalarType max_entry = 0;
+  ScalarType max_diff  = 0;
+  std::size_t nnz_ref = 0;
+  for (UblasMatrixType::const_iterator1 row_it = M_ref.begin1(); row_it != M_ref.end1(); ++row_it)
+    for (UblasMatrixType::const_iterator2 col_it = row_it.begin(); col_it != row_it.end(); ++col_it)
+    {
+      if (*col_it <= 0 && *col_it >= 0)
+        continue;
+      ++nnz_ref;
+      max_entry = std::max(max_entry, std::fabs(*col_it));
+
+      std::map<unsigned int, ScalarType>::const_iterator it = M_host[col_it.index1()].find(static_cast<unsigned int>(col_it.index2()));
+      if (it == M_host[col_it.index1()].end())
+        return ScalarType(2);
+      max_diff = std::max(max_diff, std::fabs(it->second - *col_it));
+    }
+
+  if (nnz_ref != M.nnz())
+    return ScalarType(2);
+  return max_diff / max_entry;
+}
+
+/** @brief Compares the host-based SPAI setup with the setup of spai_precond for uBLAS matrices */
+int compare_spai(viennacl::compressed_matrix<ScalarType> const & A, viennacl::compressed_matrix<ScalarType> const & M, viennacl::linalg::spai_tag const & tag, std::string const & name)
+{
+  UblasMatrixType ublas_A(A.size1(), A.size2());
+  viennacl::copy(A, ublas_A);
+
+  UblasMatrixType ublas_At, ublas_M;
+  if (!tag.getIsRight())
+    viennacl::linalg::detail::spai::sparse_transpose(ublas_A, ublas_At);
+  else
+    ublas_At = ublas_A;
+  viennacl::linalg::detail::spai::initPreconditioner(ublas_At, ublas_M);
+  viennacl::linalg::spai_tag ublas_tag(tag);
+  viennacl::linalg::detail::spai::computeSPAI(ublas_At, ublas_M, ublas_tag);
+
+  ScalarType difference = diff(M, ublas_M);
+  if (difference > 1e-10)
+  {
+    std::cout << "# Error at operation: host-based SPAI vs. uBLAS-based SPAI, " << name << std::endl;
+    std::cout << "  difference: " << difference << ", nonzeros: " << M.nnz() << " vs. " << ublas_M.nnz() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/** @brief Compares the host-based FSPAI factor with the setup of fspai_precond for uBLAS matrices */
+int compare_fspai(viennacl::compressed_matrix<ScalarType> const & A, viennacl::compressed_matrix<ScalarType> const & L, viennacl::linalg::fspai_tag const & tag)
+{
+  UblasMatrixType ublas_A(A.size1(), A.size2());
+  viennacl::copy(A, ublas_A);
+
+  UblasMatrixType ublas_pA = ublas_A;
+  UblasMatrixType ublas_L(A.size1(), A.size2()), ublas_L_trans(A.size1(), A.size2());
+  viennacl::linalg::detail::spai::computeFSPAI(ublas_A, ublas_pA, ublas_L, ublas_L_trans, tag);
+
+  ScalarType difference = diff(L, ublas_L);
+  if (difference > 1e-10)
+  {
+    std::cout << "# Error at operation: host-based FSPAI vs. uBLAS-based FSPAI" << std::endl;
+    std::cout << "  difference: " << difference << ", nonzeros: " << L.nnz() << " vs. " << ublas_L.nnz() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+#endif
+
+int test_spai(viennacl::compressed_matrix<ScalarType> const & A, HostMatrixType const & host_A, viennacl::linalg::spai_tag const & tag, std::string const & name)
+{
+  std::cout << "Testing SPAI, " << name << std::endl;
+
+  viennacl::linalg::host_spai_precond<viennacl::compressed_matrix<ScalarType> > host_spai(A, tag);
+
+  // the columns (rows) of M solve the local least-squares problems for the pattern of M:
+  HostMatrixType host_M(A.size1());
+  viennacl::copy(host_spai.matrix(), host_M);
+  ScalarType error = spai_normal_equations_error(host_A, host_M, tag.getIsRight());
+  if (error > 1e-10)
+  {
+    std::cout << "# Error at operation: normal equations of the local least-squares problems, " << name << std::endl;
+    std::cout << "  error: " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+#ifdef VIENNACL_WITH_OPENCL
+  if (compare_spai(A, host_spai.matrix(), tag, name) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+#endif
+
+  // BiCGStab converges with the preconditioner:
+  viennacl::vector<ScalarType> rhs(A.size1(), viennacl::traits::context(A));
+  rhs = viennacl::scalar_vector<ScalarType>(A.size1(), ScalarType(1), viennacl::traits::context(A));
+  viennacl::linalg::bicgstab_tag solver_tag(1e-10, 500);
+  viennacl::vector<ScalarType> x = viennacl::linalg::solve(A, rhs, solver_tag, host_spai);
+  ScalarType res = relative_residual(A, x, rhs);
+  if (solver_tag.iters() >= solver_tag.max_iterations() || res > 1e-8)
+  {
+    std::cout << "# Error at operation: BiCGStab with host-based SPAI, " << name << std::endl;
+    std::cout << "  iterations: " << solver_tag.iters() << ", residual: " << res << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int test_fspai(viennacl::compressed_matrix<ScalarType> const & A, HostMatrixType const & host_A)
+{
+  std::cout << "Testing FSPAI" << std::endl;
+
+  viennacl::linalg::fspai_tag tag;
+  viennacl::linalg::host_fspai_precond<viennacl::compressed_matrix<ScalarType> > host_fspai(A, tag);
+
+  // with G = L^T, the rows of G A vanish on the off-diagonal pattern of G, and G A G^T has unit diagonal:
+  HostMatrixType host_L(A.size1());
+  viennacl::copy(host_fspai.L(), host_L);
+  HostMatrixType host_G = host_trans(host_L);
+  HostMatrixType GA = host_prod(host_G, host_A);
+  HostMatrixType GAGt = host_prod(GA, host_trans(host_G));
+  HostMatrixType diagonal(A.size1());
+  for (std::size_t i=0; i<diagonal.size(); ++i)
+    diagonal[i][static_cast<unsigned int>(i)] = 1;
+  HostMatrixType G_offdiagonal = host_G;
+  for (std::size_t i=0; i<G_offdiagonal.size(); ++i)
+    G_offdiagonal[i].erase(static_cast<unsigned int>(i));
+
+  ScalarType error = std::max(max_on_pattern(GA, G_offdiagonal, 0), max_on_pattern(GAGt, diagonal, 1));
+  if (error > 1e-10)
+  {
+    std::cout << "# Error at operation: local systems of FSPAI" << std::endl;
+    std::cout << "  error: " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+#ifdef VIENNACL_WITH_OPENCL
+  if (compare_fspai(A, host_fspai.L(), tag) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+#endif
+
+  // CG converges with the preconditioner:
+  viennacl::vector<ScalarType> rhs(A.size1(), viennacl::traits::context(A));
+  rhs = viennacl::scalar_vector<ScalarType>(A.size1(), ScalarType(1), viennacl::traits::context(A));
+  viennacl::linalg::cg_tag solver_tag(1e-10, 500);
+  viennacl::vector<ScalarType> x = viennacl::linalg::solve(A, rhs, solver_tag, host_fspai);
+  ScalarType res = relative_residual(A, x, rhs);
+  if (solver_tag.iters() >= solver_tag.max_iterations() || res > 1e-8)
+  {
+    std::cout << "# Error at operation: CG with host-based FSPAI" << std::endl;
+    std::cout << "  iterations: " << solver_tag.iters() << ", residual: " << res << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Host-based SPAI and FSPAI" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  // the host-based setup and the uBLAS-based reference run on the host, so the system matrices reside in main memory:
+  viennacl::context host_context(viennacl::MAIN_MEMORY);
+
+  HostMatrixType std_A_sym, std_A_nonsym;
+  fill_convection_diffusion(std_A_sym,    10, ScalarType(0));
+  fill_convection_diffusion(std_A_nonsym, 10, ScalarType(0.5));
+
+  viennacl::compressed_matrix<ScalarType> A_sym(std_A_sym.size(), std_A_sym.size(), host_context);
+  viennacl::compressed_matrix<ScalarType> A_nonsym(std_A_nonsym.size(), std_A_nonsym.size(), host_context);
+  viennacl::copy(std_A_sym,    A_sym);
+  viennacl::copy(std_A_nonsym, A_nonsym);
+
+  if (test_spai(A_nonsym, std_A_nonsym, viennacl::linalg::spai_tag(1e-3, 3, 5e-2, true,  false), "static, left")   != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (test_spai(A_nonsym, std_A_nonsym, viennacl::linalg::spai_tag(1e-3, 3, 5e-2, false, false), "dynamic, left")  != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (test_spai(A_nonsym, std_A_nonsym, viennacl::linalg::spai_tag(1e-3, 3, 5e-2, true,  true),  "static, right")  != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (test_spai(A_nonsym, std_A_nonsym, viennacl::linalg::spai_tag(1e-3, 3, 5e-2, false, true),  "dynamic, right") != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (test_fspai(A_sym, std_A_sym) != EXIT_SUCCESS) return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -27,8 +27,14 @@
 #include <iostream>
 #include <vector>
 #include <map>
+#include <string>
+#include <cctype>
 #include <cmath>
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
 //
 // *** ViennaCL
 //
@@ -44,9 +50,20 @@
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/ichol.hpp"
+#include "viennacl/linalg/schwarz.hpp"
 #include "viennacl/linalg/detail/ilu/common.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/iterative_refinement.hpp"
+#include "viennacl/linalg/batched_solve.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/solver_statistics.hpp"
+#include "viennacl/linalg/sparse_triangular_solver.hpp"
 #include "viennacl/io/matrix_market.hpp"
 #include "viennacl/tools/random.hpp"
+#include "viennacl/tools/matrix_generation.hpp"
 
 
 
@@ -1070,6 +1087,1008 @@ int test(Epsilon const& epsilon)
   // --------------------------------------------------------------------------
   return retval;
 }
+
+
+//
+// -------------------------------------------------------------
+//
+template<typename MatrixT, typename NumericT>
+NumericT relative_residual(MatrixT const & A, viennacl::vector<NumericT> const & x, viennacl::vector<NumericT> const & rhs)
+{
+  viennacl::vector<NumericT> residual = viennacl::linalg::prod(A, x);
+  residual -= rhs;
+  return viennacl::linalg::norm_2(residual) / viennacl::linalg::norm_2(rhs);
+}
+
+template<typename NumericT, typename MatrixT, typename PreconditionerT>
+int cg_fused_test(MatrixT const & A, viennacl::vector<NumericT> const & rhs, PreconditionerT const & precond, std::string const & name)
+{
+  NumericT tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-10) : NumericT(1e-5);
+
+  viennacl::linalg::cg_tag fused_tag(tolerance, 1000);
+  viennacl::linalg::cg_tag classic_tag(tolerance, 1000);
+  classic_tag.use_fused(false);
+
+  viennacl::vector<NumericT> x_fused   = viennacl::linalg::solve(A, rhs, fused_tag, precond);
+  viennacl::vector<NumericT> x_classic = viennacl::linalg::solve(A, rhs, classic_tag, precond);
+
+  viennacl::vector<NumericT> x_diff = x_fused - x_classic;
+  NumericT rel_diff = viennacl::linalg::norm_2(x_diff) / viennacl::linalg::norm_2(x_classic);
+  NumericT res_fused = relative_residual(A, x_fused, rhs);
+
+  if (fused_tag.iters() > classic_tag.iters() + 1 || classic_tag.iters() > fused_tag.iters() + 1
+      || res_fused > 10 * tolerance || rel_diff > 100 * tolerance)
+  {
+    std::cout << "# Error at operation: fused CG vs. classical CG, " << name << std::endl;
+    std::cout << "  iterations: " << fused_tag.iters() << " vs. " << classic_tag.iters() << ", residual: " << res_fused << ", difference: " << rel_diff << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int cg_fused_test()
+{
+  std::cout << "Testing fused CG against classical CG" << std::endl;
+
+  viennacl::compressed_matrix<NumericT>  A_csr;
+  viennacl::coordinate_matrix<NumericT>  A_coo;
+  viennacl::ell_matrix<NumericT>         A_ell;
+  viennacl::sliced_ell_matrix<NumericT>  A_sell;
+  viennacl::hyb_matrix<NumericT>         A_hyb;
+  viennacl::tools::generate_fdm_laplace(A_csr,  20, 25);
+  viennacl::tools::generate_fdm_laplace(A_coo,  20, 25);
+  viennacl::tools::generate_fdm_laplace(A_ell,  20, 25);
+  viennacl::tools::generate_fdm_laplace(A_sell, 20, 25);
+  viennacl::tools::generate_fdm_laplace(A_hyb,  20, 25);
+
+  std::vector<NumericT> std_rhs(A_csr.size1());
+  for (std::size_t i=0; i<std_rhs.size(); ++i)
+    std_rhs[i] = NumericT(1) + NumericT(i % 7);
+  viennacl::vector<NumericT> rhs(A_csr.size1());
+  viennacl::copy(std_rhs, rhs);
+
+  viennacl::linalg::no_precond no_precond;
+  viennacl::linalg::jacobi_precond<viennacl::compressed_matrix<NumericT> > jacobi(A_csr, viennacl::linalg::jacobi_tag());
+
+  if (cg_fused_test(A_csr,  rhs, no_precond, "compressed_matrix")          != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (cg_fused_test(A_csr,  rhs, jacobi,     "compressed_matrix, Jacobi")  != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (cg_fused_test(A_coo,  rhs, no_precond, "coordinate_matrix")          != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (cg_fused_test(A_coo,  rhs, jacobi,     "coordinate_matrix, Jacobi")  != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (cg_fused_test(A_ell,  rhs, no_precond, "ell_matrix")                 != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (cg_fused_test(A_ell,  rhs, jacobi,     "ell_matrix, Jacobi")         != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (cg_fused_test(A_sell, rhs, no_precond, "sliced_ell_matrix")          != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (cg_fused_test(A_sell, rhs, jacobi,     "sliced_ell_matrix, Jacobi")  != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (cg_fused_test(A_hyb,  rhs, no_precond, "hyb_matrix")                 != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (cg_fused_test(A_hyb,  rhs, jacobi,     "hyb_matrix, Jacobi")         != EXIT_SUCCESS) return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+
+template<typename NumericT>
+int batched_solve_test()
+{
+  typedef viennacl::compressed_matrix<NumericT>                  MatrixType;
+  typedef viennacl::linalg::jacobi_precond<MatrixType>           PreconditionerType;
+
+  std::cout << "Testing batched solves" << std::endl;
+
+  NumericT tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-10) : NumericT(1e-5);
+  std::size_t num_systems = 6;
+
+  std::vector<MatrixType> A;
+  std::vector<viennacl::vector<NumericT> > rhs;
+  std::vector<PreconditionerType> precond;
+  std::vector<std::map<unsigned int, NumericT> > std_block_A;
+  std::vector<std::pair<viennacl::vcl_size_t, viennacl::vcl_size_t> > blocks;
+  for (std::size_t i=0; i<num_systems; ++i)
+  {
+    MatrixType system_A;
+    viennacl::tools::generate_fdm_laplace(system_A, 5 + 3 * i, 7 + i);
+    A.push_back(system_A);
+    rhs.push_back(viennacl::scalar_vector<NumericT>(A[i].size1(), NumericT(i + 1)));
+    precond.push_back(PreconditionerType(A[i], viennacl::linalg::jacobi_tag()));
+
+    std::vector<std::map<unsigned int, NumericT> > std_A(A[i].size1());
+    viennacl::copy(A[i], std_A);
+    std::size_t offset = std_block_A.size();
+    for (std::size_t row=0; row<std_A.size(); ++row)
+    {
+      std::map<unsigned int, NumericT> block_row;
+      for (typename std::map<unsigned int, NumericT>::const_iterator it = std_A[row].begin(); it != std_A[row].end(); ++it)
+        block_row[static_cast<unsigned int>(offset + it->first)] = it->second;
+      std_block_A.push_back(block_row);
+    }
+    blocks.push_back(std::make_pair(offset, std_block_A.size()));
+  }
+  rhs[2].clear(); // trivial system
+
+  viennacl::linalg::batched_tag<viennacl::linalg::cg_tag> tag(viennacl::linalg::cg_tag(tolerance, 500));
+  std::vector<viennacl::vector<NumericT> > x = viennacl::linalg::solve(A, rhs, tag);
+  std::vector<viennacl::vector<NumericT> > x_precond = viennacl::linalg::solve(A, rhs, tag, precond);
+  for (std::size_t i=0; i<num_systems; ++i)
+  {
+    NumericT res         = (i == 2) ? viennacl::linalg::norm_2(x[i])         : relative_residual(A[i], x[i], rhs[i]);
+    NumericT res_precond = (i == 2) ? viennacl::linalg::norm_2(x_precond[i]) : relative_residual(A[i], x_precond[i], rhs[i]);
+    if (res > 10 * tolerance || res_precond > 10 * tolerance || !tag.converged(i))
+    {
+      std::cout << "# Error at operation: batched CG, system " << i << std::endl;
+      std::cout << "  residual: " << res << ", with preconditioner: " << res_precond << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // block-diagonal system must give the same results:
+  MatrixType block_A;
+  viennacl::copy(std_block_A, block_A);
+  viennacl::vector<NumericT> block_rhs(block_A.size1());
+  for (std::size_t i=0; i<num_systems; ++i)
+    viennacl::vector_range<viennacl::vector<NumericT> >(block_rhs, viennacl::range(blocks[i].first, blocks[i].second)) = rhs[i];
+  viennacl::vector<NumericT> block_x = viennacl::linalg::solve(block_A, block_rhs, tag, blocks);
+  for (std::size_t i=0; i<num_systems; ++i)
+  {
+    viennacl::vector<NumericT> x_diff = viennacl::vector_range<viennacl::vector<NumericT> >(block_x, viennacl::range(blocks[i].first, blocks[i].second));
+    x_diff -= x[i];
+    if (viennacl::linalg::norm_2(x_diff) > 10 * tolerance * (viennacl::linalg::norm_2(x[i]) + 1) || !tag.converged(i))
+    {
+      std::cout << "# Error at operation: batched CG on block-diagonal matrix, block " << i << std::endl;
+      std::cout << "  difference: " << viennacl::linalg::norm_2(x_diff) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // systems stopped by the absolute tolerance are converged, systems stopped by the iteration limit are not:
+  viennacl::linalg::cg_tag abs_tag(0, 500);
+  abs_tag.abs_tolerance(1e-2);
+  viennacl::linalg::batched_tag<viennacl::linalg::cg_tag> abs_batched_tag(abs_tag);
+  x = viennacl::linalg::solve(A, rhs, abs_batched_tag);
+  x = viennacl::linalg::solve(A, rhs, abs_batched_tag, precond);
+  if (abs_batched_tag.num_converged() != num_systems)
+  {
+    std::cout << "# Error at operation: batched CG with absolute tolerance" << std::endl;
+    std::cout << "  converged systems: " << abs_batched_tag.num_converged() << " of " << num_systems << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::linalg::batched_tag<viennacl::linalg::cg_tag> short_tag(viennacl::linalg::cg_tag(tolerance, 3));
+  x = viennacl::linalg::solve(A, rhs, short_tag);
+  if (short_tag.num_converged() != 1 || !short_tag.converged(2) || short_tag.max_iters() != 3)
+  {
+    std::cout << "# Error at operation: batched CG with iteration limit" << std::endl;
+    std::cout << "  converged systems: " << short_tag.num_converged() << ", max. iterations: " << short_tag.max_iters() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+/** @brief Minimal recursive-descent JSON validator: Returns true and advances 'pos' past the value if a valid JSON value starts at 'pos' */
+bool parse_json_value(std::string const & str, std::size_t & pos);
+
+void skip_json_whitespace(std::string const & str, std::size_t & pos)
+{
+  while (pos < str.size() && std::isspace(static_cast<unsigned char>(str[pos])))
+    ++pos;
+}
+
+bool parse_json_string(std::string const & str, std::size_t & pos)
+{
+  if (pos >= str.size() || str[pos] != '"')
+    return false;
+  for (++pos; pos < str.size(); ++pos)
+  {
+    if (str[pos] == '\\')
+      ++pos;
+    else if (str[pos] == '"')
+    {
+      ++pos;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parse_json_number(std::string const & str, std::size_t & pos)
+{
+  std::size_t start = pos;
+  if (pos < str.size() && str[pos] == '-')
+    ++pos;
+  std::size_t digits_start = pos;
+  while (pos < str.size() && std::isdigit(static_cast<unsigned char>(str[pos])))
+    ++pos;
+  if (pos == digits_start)
+    return false;
+  if (pos < str.size() && str[pos] == '.')
+  {
+    ++pos;
+    std::size_t fraction_start = pos;
+    while (pos < str.size() && std::isdigit(static_cast<unsigned char>(str[pos])))
+      ++pos;
+    if (pos == fraction_start)
+      return false;
+  }
+  if (pos < str.size() && (str[pos] == 'e' || str[pos] == 'E'))
+  {
+    ++pos;
+    if (pos < str.size() && (str[pos] == '+' || str[pos] == '-'))
+      ++pos;
+    std::size_t exponent_start = pos;
+    while (pos < str.size() && std::isdigit(static_cast<unsigned char>(str[pos])))
+      ++pos;
+    if (pos == exponent_start)
+      return false;
+  }
+  return pos > start;
+}
+
+bool parse_json_value(std::string const & str, std::size_t & pos)
+{
+  skip_json_whitespace(str, pos);
+  if (pos >= str.size())
+    return false;
+
+  if (str[pos] == '{' || str[pos] == '[')
+  {
+    char closing = (str[pos] == '{') ? '}' : ']';
+    bool is_object = (closing == '}');
+    ++pos;
+    skip_json_whitespace(str, pos);
+    if (pos < str.size() && str[pos] == closing)
+    {
+      ++pos;
+      return true;
+    }
+    while (true)
+    {
+      if (is_object)
+      {
+        skip_json_whitespace(str, pos);
+        if (!parse_json_string(str, pos))
+          return false;
+        skip_json_whitespace(str, pos);
+        if (pos >= str.size() || str[pos] != ':')
+          return false;
+        ++pos;
+      }
+      if (!parse_json_value(str, pos))
+        return false;
+      skip_json_whitespace(str, pos);
+      if (pos >= str.size())
+        return false;
+      if (str[pos] == closing)
+      {
+        ++pos;
+        return true;
+      }
+      if (str[pos] != ',')
+        return false;
+      ++pos;
+    }
+  }
+  if (str[pos] == '"')
+    return parse_json_string(str, pos);
+  if (str.compare(pos, 4, "null") == 0 || str.compare(pos, 4, "true") == 0)
+  {
+    pos += 4;
+    return true;
+  }
+  if (str.compare(pos, 5, "false") == 0)
+  {
+    pos += 5;
+    return true;
+  }
+  return parse_json_number(str, pos);
+}
+
+bool is_valid_json(std::string const & str)
+{
+  std::size_t pos = 0;
+  if (!parse_json_value(str, pos))
+    return false;
+  skip_json_whitespace(str, pos);
+  return pos == str.size();
+}
+
+template<typename NumericT, typename MatrixT, typename SolverTagT, typename PreconditionerT>
+int solver_statistics_test(MatrixT const & A, viennacl::vector<NumericT> const & rhs, SolverTagT & tag, PreconditionerT const & precond, std::string const & name)
+{
+  viennacl::linalg::solver_statistics stats;
+  tag.statistics(&stats);
+  viennacl::vector<NumericT> x = viennacl::linalg::solve(A, rhs, tag, precond);
+  tag.statistics(NULL);
+
+  std::string json = stats.to_json();
+  if (stats.iterations != tag.iters() || stats.residual_history.size() != tag.iters() || stats.spmv.calls == 0 || !is_valid_json(json)
+      || std::fabs(stats.residual_history.back() - tag.error()) > 1e-3 * tag.error())
+  {
+    std::cout << "# Error at operation: solver statistics, " << name << std::endl;
+    std::cout << "  iterations: " << tag.iters() << ", recorded: " << stats.iterations << ", residual history: " << stats.residual_history.size() << std::endl;
+    std::cout << "  JSON: " << json << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (is_valid_json(json.substr(0, json.size() - 1)) || is_valid_json(json + "]") || !is_valid_json("{\"a\": [1, -2.5e-3, null], \"b\": {}}"))
+  {
+    std::cout << "# Error at operation: JSON validation in test" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int solver_statistics_test()
+{
+  std::cout << "Testing solver statistics" << std::endl;
+
+  viennacl::compressed_matrix<NumericT> A;
+  viennacl::tools::generate_fdm_laplace(A, 20, 20);
+  viennacl::vector<NumericT> rhs = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+  NumericT tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-10) : NumericT(1e-5);
+
+  viennacl::linalg::no_precond no_precond;
+  viennacl::linalg::jacobi_precond<viennacl::compressed_matrix<NumericT> > jacobi(A, viennacl::linalg::jacobi_tag());
+
+  viennacl::linalg::cg_tag cg(tolerance, 500);
+  viennacl::linalg::cg_tag cg_classic(tolerance, 500);
+  cg_classic.use_fused(false);
+  viennacl::linalg::bicgstab_tag bicgstab(tolerance, 500);
+  viennacl::linalg::gmres_tag gmres(tolerance, 500, 20);
+
+  if (solver_statistics_test(A, rhs, cg,         no_precond, "CG")                           != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (solver_statistics_test(A, rhs, cg,         jacobi,     "CG, Jacobi")                   != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (solver_statistics_test(A, rhs, cg_classic, no_precond, "pipelined CG")                 != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (solver_statistics_test(A, rhs, cg_classic, jacobi,     "classical CG, Jacobi")         != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (solver_statistics_test(A, rhs, bicgstab,   no_precond, "BiCGStab")                     != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (solver_statistics_test(A, rhs, bicgstab,   jacobi,     "BiCGStab, Jacobi")             != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (solver_statistics_test(A, rhs, gmres,      no_precond, "GMRES")                        != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (solver_statistics_test(A, rhs, gmres,      jacobi,     "GMRES, Jacobi")                != EXIT_SUCCESS) return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+
+/** @brief Generates the five-point discretization of -Laplace(u) + beta * (u_x + u_y) on an n x n grid (central differences, beta scaled by h/2) */
+template<typename NumericT>
+void generate_convection_diffusion(viennacl::compressed_matrix<NumericT> & A, unsigned int n, NumericT beta)
+{
+  std::vector<std::map<unsigned int, NumericT> > entries(n * n);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+    {
+      unsigned int row = i * n + j;
+      entries[row][row] = NumericT(4);
+      if (i > 0)     entries[row][row - n] = NumericT(-1) - beta;
+      if (i + 1 < n) entries[row][row + n] = NumericT(-1) + beta;
+      if (j > 0)     entries[row][row - 1] = NumericT(-1) - beta;
+      if (j + 1 < n) entries[row][row + 1] = NumericT(-1) + beta;
+    }
+  viennacl::copy(entries, A);
+}
+
+template<typename NumericT, typename PreconditionerT>
+int gmres_augmented_test(viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, PreconditionerT const & precond,
+                         bool check_spmv_savings, std::string const & name)
+{
+  NumericT tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-10) : NumericT(1e-5);
+
+  // 0: GMRES(10), 1: adaptive Krylov dimension, 2: augmentation (LGMRES), 3: both
+  viennacl::vcl_size_t spmv_calls[4];
+  for (int variant = 0; variant < 4; ++variant)
+  {
+    viennacl::linalg::gmres_tag tag(tolerance, 2000, 10);
+    if (variant == 1 || variant == 3)
+      tag.adaptive_krylov_dim(true);
+    if (variant == 2 || variant == 3)
+      tag.augmentation_dim(3);
+
+    viennacl::linalg::solver_statistics stats;
+    tag.statistics(&stats);
+    viennacl::vector<NumericT> x = viennacl::linalg::solve(A, rhs, tag, precond);
+    spmv_calls[variant] = stats.spmv.calls;
+
+    // the preconditioned residual is monitored, so allow for the scaling by the Jacobi preconditioner:
+    NumericT res = relative_residual(A, x, rhs);
+    if (tag.iters() >= tag.max_iterations() || tag.error() > tolerance || res > 100 * tolerance
+        || stats.residual_history.size() != tag.iters())
+    {
+      std::cout << "# Error at operation: GMRES with adaptive Krylov dimension/augmentation, variant " << variant << ", " << name << std::endl;
+      std::cout << "  iterations: " << tag.iters() << ", estimated error: " << tag.error() << ", residual: " << res << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // augmentation pays off for GMRES(10) on the Laplace operator, where plain restarts stall:
+  if (check_spmv_savings && (spmv_calls[2] >= spmv_calls[0] || spmv_calls[3] >= spmv_calls[0]))
+  {
+    std::cout << "# Error at operation: GMRES augmentation does not save matrix-vector products, " << name << std::endl;
+    std::cout << "  products: " << spmv_calls[0] << " (GMRES(10)), " << spmv_calls[2] << " (augmented), " << spmv_calls[3] << " (adaptive, augmented)" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int gmres_augmented_test()
+{
+  std::cout << "Testing GMRES with adaptive Krylov dimension and augmentation" << std::endl;
+
+  viennacl::compressed_matrix<NumericT> A_laplace;
+  viennacl::tools::generate_fdm_laplace(A_laplace, 30, 30);
+  viennacl::compressed_matrix<NumericT> A_convection;
+  generate_convection_diffusion(A_convection, 30, NumericT(0.5));
+  viennacl::vector<NumericT> rhs = viennacl::scalar_vector<NumericT>(A_laplace.size1(), NumericT(1));
+
+  viennacl::linalg::no_precond no_precond;
+  viennacl::linalg::jacobi_precond<viennacl::compressed_matrix<NumericT> > jacobi_laplace(A_laplace, viennacl::linalg::jacobi_tag());
+  viennacl::linalg::jacobi_precond<viennacl::compressed_matrix<NumericT> > jacobi_convection(A_convection, viennacl::linalg::jacobi_tag());
+
+  if (gmres_augmented_test(A_laplace,    rhs, no_precond,        true,  "Laplace")                         != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (gmres_augmented_test(A_laplace,    rhs, jacobi_laplace,    true,  "Laplace, Jacobi")                 != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (gmres_augmented_test(A_convection, rhs, no_precond,        false, "convection-diffusion")            != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (gmres_augmented_test(A_convection, rhs, jacobi_convection, false, "convection-diffusion, Jacobi")    != EXIT_SUCCESS) return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+
+template<typename NumericT>
+int ilut_parallel_test()
+{
+  std::cout << "Testing parallel ILUT" << std::endl;
+
+  viennacl::compressed_matrix<NumericT> A;
+  generate_convection_diffusion(A, 30, NumericT(0.5));
+  viennacl::linalg::ilut_tag tag(10, 1e-3);
+
+  // the factorization is computed row by row in a pipelined fashion if OpenMP is enabled, but must not depend on the number of threads:
+  viennacl::compressed_matrix<NumericT> L_serial(A.size1(), A.size2()), U_serial(A.size1(), A.size2());
+  viennacl::compressed_matrix<NumericT> L(A.size1(), A.size2()), U(A.size1(), A.size2());
+#ifdef VIENNACL_WITH_OPENMP
+  int num_threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  viennacl::linalg::precondition(A, L_serial, U_serial, tag);
+#ifdef VIENNACL_WITH_OPENMP
+  omp_set_num_threads(num_threads);
+#endif
+  viennacl::linalg::precondition(A, L, U, tag);
+
+  std::vector<std::map<unsigned int, NumericT> > L_serial_host(A.size1()), U_serial_host(A.size1()), L_host(A.size1()), U_host(A.size1());
+  viennacl::copy(L_serial, L_serial_host);
+  viennacl::copy(U_serial, U_serial_host);
+  viennacl::copy(L, L_host);
+  viennacl::copy(U, U_host);
+  if (L_host != L_serial_host || U_host != U_serial_host || L.nnz() == 0 || U.nnz() < A.size1())
+  {
+    std::cout << "# Error at operation: parallel ILUT vs. serial ILUT" << std::endl;
+    std::cout << "  nonzeros: " << L.nnz() << " vs. " << L_serial.nnz() << " (L), " << U.nnz() << " vs. " << U_serial.nnz() << " (U)" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // without dropping, the factors are the exact LU factorization:
+  viennacl::compressed_matrix<NumericT> A_small;
+  generate_convection_diffusion(A_small, 8, NumericT(0.5));
+  viennacl::compressed_matrix<NumericT> L_small(A_small.size1(), A_small.size2()), U_small(A_small.size1(), A_small.size2());
+  viennacl::linalg::precondition(A_small, L_small, U_small, viennacl::linalg::ilut_tag(static_cast<unsigned int>(A_small.size1()), 0));
+  viennacl::vector<NumericT> rhs = viennacl::scalar_vector<NumericT>(A_small.size1(), NumericT(1));
+  viennacl::vector<NumericT> x = rhs;
+  viennacl::linalg::inplace_solve(L_small, x, viennacl::linalg::unit_lower_tag());
+  viennacl::linalg::inplace_solve(U_small, x, viennacl::linalg::upper_tag());
+  NumericT tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-12) : NumericT(1e-5);
+  if (relative_residual(A_small, x, rhs) > tolerance)
+  {
+    std::cout << "# Error at operation: ILUT without dropping" << std::endl;
+    std::cout << "  residual: " << relative_residual(A_small, x, rhs) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a zero pivot in row 100 is reported, rows depending on it are not computed:
+  std::vector<std::map<unsigned int, NumericT> > B_host(200);
+  for (unsigned int i = 0; i < B_host.size(); ++i)
+  {
+    B_host[i][i] = NumericT(1);
+    if (i + 1 < B_host.size())
+      B_host[i][i+1] = NumericT(1);
+    if (i >= 100)
+      B_host[i][i-1] = NumericT(1);
+  }
+  viennacl::compressed_matrix<NumericT> B;
+  viennacl::copy(B_host, B);
+  viennacl::compressed_matrix<NumericT> L_B(B.size1(), B.size2()), U_B(B.size1(), B.size2());
+  bool zero_pivot_detected = false;
+  try
+  {
+    viennacl::linalg::precondition(B, L_B, U_B, tag);
+  }
+  catch (viennacl::zero_on_diagonal_exception const &)
+  {
+    zero_pivot_detected = true;
+  }
+  if (!zero_pivot_detected)
+  {
+    std::cout << "# Error at operation: ILUT with zero pivot" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+/** @brief Checks the sparse triangular solver for the triangular part of T given by tag. T_trans and tag_trans describe the transposed triangular matrix, which is the reference for apply_transposed(). */
+template<typename NumericT, typename MatrixT, typename TagT, typename TransMatrixT, typename TransTagT>
+int sparse_triangular_solver_test(viennacl::compressed_matrix<NumericT> const & A, MatrixT const & T, TagT tag, TransMatrixT const & T_trans, TransTagT tag_trans,
+                                  viennacl::vector<NumericT> const & rhs, std::string const & name)
+{
+  NumericT tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-12) : NumericT(1e-5);
+
+  viennacl::vector<NumericT> x_ref = rhs;
+  viennacl::linalg::inplace_solve(T, x_ref, tag);
+  viennacl::vector<NumericT> x_trans_ref = rhs;
+  viennacl::linalg::inplace_solve(T_trans, x_trans_ref, tag_trans);
+
+  viennacl::linalg::sparse_triangular_solver_strategy strategies[5] = { viennacl::linalg::SPTRSV_AUTO, viennacl::linalg::SPTRSV_SEQUENTIAL, viennacl::linalg::SPTRSV_LEVEL_SET,
+                                                                        viennacl::linalg::SPTRSV_SYNC_FREE, viennacl::linalg::SPTRSV_BLOCKED };
+  for (int s = 0; s < 5; ++s)
+  {
+    viennacl::linalg::sparse_triangular_solver<NumericT> solver(T, tag, strategies[s]);
+    viennacl::vector<NumericT> x = rhs;
+    solver.apply(x);
+    viennacl::vector<NumericT> x2 = x_ref; // reusing the analysis must not change the results of later solves
+    solver.apply(x2);
+    x2 = rhs;
+    solver.apply(x2);
+
+    // values can be refreshed without repeating the analysis:
+    viennacl::vector<NumericT> x3 = rhs;
+    solver.update_values(A);
+    solver.apply(x3);
+
+    // the transposed system is solved over the same rows:
+    viennacl::vector<NumericT> x_trans = rhs;
+    solver.release_value_map();
+    solver.apply_transposed(x_trans);
+
+    viennacl::vector<NumericT> diff = x - x_ref;
+    NumericT rel_diff = viennacl::linalg::norm_2(diff) / viennacl::linalg::norm_2(x_ref);
+    diff = x2 - x;
+    NumericT rel_diff_repeated = viennacl::linalg::norm_2(diff) / viennacl::linalg::norm_2(x_ref);
+    diff = x3 - x;
+    NumericT rel_diff_updated = viennacl::linalg::norm_2(diff) / viennacl::linalg::norm_2(x_ref);
+    diff = x_trans - x_trans_ref;
+    NumericT rel_diff_trans = viennacl::linalg::norm_2(diff) / viennacl::linalg::norm_2(x_trans_ref);
+    if (rel_diff > tolerance || rel_diff_repeated > 0 || rel_diff_updated > 0 || rel_diff_trans > tolerance
+        || solver.strategy() == viennacl::linalg::SPTRSV_AUTO || (s > 0 && solver.strategy() != strategies[s]))
+    {
+      std::cout << "# Error at operation: sparse triangular solver vs. inplace_solve(), strategy " << s << ", " << name << std::endl;
+      std::cout << "  difference: " << rel_diff << ", repeated solve: " << rel_diff_repeated << ", updated values: " << rel_diff_updated << ", transposed: " << rel_diff_trans << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int sparse_triangular_solver_test()
+{
+  std::cout << "Testing sparse triangular solver" << std::endl;
+
+  // a diagonally dominant matrix with an irregular sparsity pattern, so that rows have various numbers of dependencies:
+  viennacl::tools::uniform_random_numbers<NumericT> randomNumber;
+  unsigned int N = 400;
+  std::vector<std::map<unsigned int, NumericT> > A_host(N);
+  for (unsigned int i = 0; i < N; ++i)
+  {
+    A_host[i][i] = NumericT(4) + randomNumber();
+    for (int k = 0; k < 4; ++k)
+    {
+      unsigned int j = static_cast<unsigned int>(randomNumber() * NumericT(N - 1));
+      if (j != i)
+        A_host[i][j] = NumericT(0.5) * (randomNumber() - NumericT(0.5));
+    }
+  }
+  viennacl::compressed_matrix<NumericT> A;
+  viennacl::copy(A_host, A);
+  viennacl::vector<NumericT> rhs = viennacl::scalar_vector<NumericT>(N, NumericT(1));
+
+  viennacl::linalg::lower_tag      lower;
+  viennacl::linalg::unit_lower_tag unit_lower;
+  viennacl::linalg::upper_tag      upper;
+  viennacl::linalg::unit_upper_tag unit_upper;
+  if (sparse_triangular_solver_test(A, A,        lower,      trans(A), upper,      rhs, "lower")                   != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (sparse_triangular_solver_test(A, A,        unit_lower, trans(A), unit_upper, rhs, "unit lower")              != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (sparse_triangular_solver_test(A, A,        upper,      trans(A), lower,      rhs, "upper")                   != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (sparse_triangular_solver_test(A, A,        unit_upper, trans(A), unit_lower, rhs, "unit upper")              != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (sparse_triangular_solver_test(A, trans(A), lower,      A,        upper,      rhs, "transposed, lower")       != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (sparse_triangular_solver_test(A, trans(A), unit_lower, A,        unit_upper, rhs, "transposed, unit lower")  != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (sparse_triangular_solver_test(A, trans(A), upper,      A,        lower,      rhs, "transposed, upper")       != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (sparse_triangular_solver_test(A, trans(A), unit_upper, A,        unit_lower, rhs, "transposed, unit upper")  != EXIT_SUCCESS) return EXIT_FAILURE;
+
+  // ILU0 and ILUT preconditioners only keep the triangular solvers, check them against solves with the factors:
+  NumericT tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-12) : NumericT(1e-5);
+  for (int level_scheduling = 0; level_scheduling < 2; ++level_scheduling)
+  {
+    viennacl::linalg::ilu0_tag ilu0_tag(level_scheduling == 1);
+    viennacl::linalg::ilu0_precond<viennacl::compressed_matrix<NumericT> > ilu0(A, ilu0_tag);
+    viennacl::compressed_matrix<NumericT> LU = A;
+    viennacl::linalg::precondition(LU, ilu0_tag);
+    viennacl::vector<NumericT> x = rhs;
+    ilu0.apply(x);
+    viennacl::vector<NumericT> x_ref = rhs;
+    viennacl::linalg::inplace_solve(LU, x_ref, viennacl::linalg::unit_lower_tag());
+    viennacl::linalg::inplace_solve(LU, x_ref, viennacl::linalg::upper_tag());
+    viennacl::vector<NumericT> diff = x - x_ref;
+    if (viennacl::linalg::norm_2(diff) > tolerance * viennacl::linalg::norm_2(x_ref))
+    {
+      std::cout << "# Error at operation: ILU0 preconditioner vs. triangular solves with the factor, level scheduling: " << level_scheduling << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    viennacl::linalg::ilut_tag ilut_tag(10, 1e-4, level_scheduling == 1);
+    viennacl::linalg::ilut_precond<viennacl::compressed_matrix<NumericT> > ilut(A, ilut_tag);
+    viennacl::compressed_matrix<NumericT> L(N, N), U(N, N);
+    viennacl::linalg::precondition(A, L, U, ilut_tag);
+    x = rhs;
+    ilut.apply(x);
+    x_ref = rhs;
+    viennacl::linalg::inplace_solve(L, x_ref, viennacl::linalg::unit_lower_tag());
+    viennacl::linalg::inplace_solve(U, x_ref, viennacl::linalg::upper_tag());
+    diff = x - x_ref;
+    if (viennacl::linalg::norm_2(diff) > tolerance * viennacl::linalg::norm_2(x_ref))
+    {
+      std::cout << "# Error at operation: ILUT preconditioner vs. triangular solves with the factors, level scheduling: " << level_scheduling << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+template<typename NumericT>
+int chow_patel_icc_test()
+{
+  std::cout << "Testing CG with Chow-Patel incomplete Cholesky" << std::endl;
+
+  viennacl::compressed_matrix<NumericT> A;
+  viennacl::tools::generate_fdm_laplace(A, 30, 30);
+  viennacl::vector<NumericT> rhs = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+  NumericT tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-10) : NumericT(1e-5);
+
+  viennacl::tools::uniform_random_numbers<NumericT> randomNumber;
+  std::vector<NumericT> u_host(A.size1()), v_host(A.size1());
+  for (std::size_t i = 0; i < u_host.size(); ++i)
+  {
+    u_host[i] = randomNumber();
+    v_host[i] = randomNumber();
+  }
+  viennacl::vector<NumericT> u(A.size1()), v(A.size1());
+  viennacl::copy(u_host, u);
+  viennacl::copy(v_host, v);
+
+  // point-Jacobi, block-Jacobi, and block-Jacobi with a partial last block:
+  viennacl::vcl_size_t block_sizes[3] = { 1, 30, 64 };
+  for (int b = 0; b < 3; ++b)
+  {
+    viennacl::linalg::chow_patel_tag tag;
+    tag.jacobi_block_size(block_sizes[b]);
+    viennacl::linalg::chow_patel_icc_precond<viennacl::compressed_matrix<NumericT> > precond(A, tag);
+
+    // CG requires a symmetric preconditioner: <M u, v> = <u, M v>
+    viennacl::vector<NumericT> Mu = u;
+    viennacl::vector<NumericT> Mv = v;
+    precond.apply(Mu);
+    precond.apply(Mv);
+    NumericT uMv = viennacl::linalg::inner_prod(u, Mv);
+    NumericT asymmetry = std::fabs(viennacl::linalg::inner_prod(Mu, v) - uMv) / std::fabs(uMv);
+
+    viennacl::linalg::cg_tag cg(tolerance, 500);
+    viennacl::vector<NumericT> x = viennacl::linalg::solve(A, rhs, cg, precond);
+    NumericT res = relative_residual(A, x, rhs);
+    if (asymmetry > 10 * ((sizeof(NumericT) > 4) ? NumericT(1e-14) : NumericT(1e-6)) || cg.iters() >= cg.max_iterations() || res > 10 * tolerance)
+    {
+      std::cout << "# Error at operation: CG with Chow-Patel incomplete Cholesky, block size " << block_sizes[b] << std::endl;
+      std::cout << "  asymmetry: " << asymmetry << ", iterations: " << cg.iters() << ", residual: " << res << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+template<typename NumericT, typename PreconditionerT>
+int ichol_test(viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, PreconditionerT const & precond,
+               unsigned int max_iterations, std::string const & name)
+{
+  NumericT tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-10) : NumericT(1e-5);
+
+  // CG requires a symmetric preconditioner: <M u, v> = <u, M v>
+  viennacl::tools::uniform_random_numbers<NumericT> randomNumber;
+  std::vector<NumericT> u_host(A.size1()), v_host(A.size1());
+  for (std::size_t i = 0; i < u_host.size(); ++i)
+  {
+    u_host[i] = randomNumber();
+    v_host[i] = randomNumber();
+  }
+  viennacl::vector<NumericT> Mu(A.size1()), Mv(A.size1());
+  viennacl::copy(u_host, Mu);
+  viennacl::copy(v_host, Mv);
+  viennacl::vector<NumericT> u = Mu, v = Mv;
+  precond.apply(Mu);
+  precond.apply(Mv);
+  NumericT uMv = viennacl::linalg::inner_prod(u, Mv);
+  NumericT asymmetry = std::fabs(viennacl::linalg::inner_prod(Mu, v) - uMv) / std::fabs(uMv);
+
+  viennacl::linalg::cg_tag cg(tolerance, max_iterations);
+  viennacl::vector<NumericT> x = viennacl::linalg::solve(A, rhs, cg, precond);
+  NumericT res = relative_residual(A, x, rhs);
+  if (asymmetry > 10 * ((sizeof(NumericT) > 4) ? NumericT(1e-14) : NumericT(1e-6)) || cg.iters() >= cg.max_iterations() || res > 10 * tolerance)
+  {
+    std::cout << "# Error at operation: CG with incomplete Cholesky, " << name << std::endl;
+    std::cout << "  asymmetry: " << asymmetry << ", iterations: " << cg.iters() << ", residual: " << res << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int ichol_test()
+{
+  std::cout << "Testing CG with incomplete Cholesky" << std::endl;
+
+  viennacl::compressed_matrix<NumericT> A;
+  viennacl::tools::generate_fdm_laplace(A, 30, 30);
+  viennacl::vector<NumericT> rhs = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+  viennacl::vcl_size_t nnz_lower_A = (A.nnz() + A.size1()) / 2;
+
+  viennacl::linalg::cg_tag cg_plain((sizeof(NumericT) > 4) ? NumericT(1e-10) : NumericT(1e-5), 500);
+  viennacl::linalg::solve(A, rhs, cg_plain);
+  unsigned int plain_iters = static_cast<unsigned int>(cg_plain.iters());
+
+  // IChol(0) has the pattern of IChol0 and hence yields the same preconditioner:
+  viennacl::linalg::ichol0_tag ichol0_config;
+  viennacl::linalg::ichol0_precond<viennacl::compressed_matrix<NumericT> > ichol0(A, ichol0_config);
+  viennacl::linalg::icholk_precond<viennacl::compressed_matrix<NumericT> > ichol_level0(A, viennacl::linalg::icholk_tag(0));
+  viennacl::vector<NumericT> x_ichol0 = rhs;
+  viennacl::vector<NumericT> x_level0 = rhs;
+  ichol0.apply(x_ichol0);
+  ichol_level0.apply(x_level0);
+  viennacl::vector<NumericT> diff = x_level0 - x_ichol0;
+  if (viennacl::linalg::norm_2(diff) > ((sizeof(NumericT) > 4) ? NumericT(1e-12) : NumericT(1e-5)) * viennacl::linalg::norm_2(x_ichol0)
+      || ichol_level0.tag().nnz_L() != nnz_lower_A || ichol_level0.tag().fill_ratio() < 1 || ichol_level0.tag().fill_ratio() > 1)
+  {
+    std::cout << "# Error at operation: IChol(0) vs. IChol0" << std::endl;
+    std::cout << "  difference: " << viennacl::linalg::norm_2(diff) << ", nonzeros of L: " << ichol_level0.tag().nnz_L() << " vs. " << nnz_lower_A << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (ichol_test(A, rhs, ichol0, plain_iters, "IChol0") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // more fill-in: fewer iterations than without preconditioner, no shift for the M-matrix:
+  viennacl::linalg::icholk_precond<viennacl::compressed_matrix<NumericT> > ichol_level2(A, viennacl::linalg::icholk_tag(2));
+  viennacl::linalg::icholt_precond<viennacl::compressed_matrix<NumericT> > icholt(A, viennacl::linalg::icholt_tag(20, 1e-3));
+  if (ichol_level2.tag().fill_ratio() <= ichol_level0.tag().fill_ratio() || ichol_level2.tag().diagonal_shift() > 0
+      || icholt.tag().fill_ratio() <= 1 || icholt.tag().dropped_entries() == 0 || icholt.tag().diagonal_shift() > 0)
+  {
+    std::cout << "# Error at operation: fill statistics of incomplete Cholesky" << std::endl;
+    std::cout << "  IChol(2): fill ratio " << ichol_level2.tag().fill_ratio() << ", shift " << ichol_level2.tag().diagonal_shift()
+              << "; ICholT: fill ratio " << icholt.tag().fill_ratio() << ", dropped " << icholt.tag().dropped_entries() << ", shift " << icholt.tag().diagonal_shift() << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (ichol_test(A, rhs, ichol_level0, plain_iters, "IChol(0)")  != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (ichol_test(A, rhs, ichol_level2, plain_iters, "IChol(2)")  != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (ichol_test(A, rhs, icholt,       plain_iters, "ICholT")    != EXIT_SUCCESS) return EXIT_FAILURE;
+
+  // Kershaw's matrix is positive definite, but IChol(0) runs into a negative pivot. The factorization has to shift the diagonal:
+  std::vector<std::map<unsigned int, NumericT> > K_host(4);
+  NumericT K_entries[4][4] = { { 3, -2,  0,  2 }, { -2, 3, -2, 0 }, { 0, -2, 3, -2 }, { 2, 0, -2, 3 } };
+  for (unsigned int i = 0; i < 4; ++i)
+    for (unsigned int j = 0; j < 4; ++j)
+      if (K_entries[i][j] < 0 || K_entries[i][j] > 0)
+        K_host[i][j] = K_entries[i][j];
+  viennacl::compressed_matrix<NumericT> K;
+  viennacl::copy(K_host, K);
+  viennacl::vector<NumericT> K_rhs = viennacl::scalar_vector<NumericT>(4, NumericT(1));
+
+  viennacl::linalg::icholk_precond<viennacl::compressed_matrix<NumericT> > ichol_kershaw(K, viennacl::linalg::icholk_tag(0));
+  if (ichol_kershaw.tag().diagonal_shift() <= 0)
+  {
+    std::cout << "# Error at operation: diagonal shift of IChol(0) for Kershaw's matrix" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (ichol_test(K, K_rhs, ichol_kershaw, 10, "IChol(0), Kershaw's matrix") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+
+/** @brief Solves with an additive Schwarz preconditioner, using CG for the symmetric variant on a symmetric matrix and BiCGStab otherwise. Returns the number of iterations, or 0 on failure. */
+template<typename NumericT, typename LocalTagT>
+viennacl::vcl_size_t schwarz_test(viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, bool symmetric,
+                                  viennacl::linalg::schwarz_precond<viennacl::compressed_matrix<NumericT>, LocalTagT> const & precond, std::string const & name)
+{
+  NumericT tolerance = (sizeof(NumericT) > 4) ? NumericT(1e-10) : NumericT(1e-5);
+
+  viennacl::vector<NumericT> x(A.size1());
+  viennacl::vcl_size_t iters = 0;
+  unsigned int max_iters = 500;
+  if (symmetric)
+  {
+    viennacl::linalg::cg_tag cg(tolerance, max_iters);
+    x = viennacl::linalg::solve(A, rhs, cg, precond);
+    iters = cg.iters();
+  }
+  else
+  {
+    viennacl::linalg::bicgstab_tag bicgstab(tolerance, max_iters);
+    x = viennacl::linalg::solve(A, rhs, bicgstab, precond);
+    iters = bicgstab.iters();
+  }
+  NumericT res = relative_residual(A, x, rhs);
+  if (iters >= max_iters || res > 10 * tolerance)
+  {
+    std::cout << "# Error at operation: additive Schwarz, " << name << std::endl;
+    std::cout << "  iterations: " << iters << ", residual: " << res << std::endl;
+    return 0;
+  }
+  return std::max<viennacl::vcl_size_t>(iters, 1);
+}
+
+/** @brief Runs additive Schwarz (symmetric matrix only) and RAS with overlaps 0, 1, 2 and checks that the overlap does not increase the number of iterations for exact local solves */
+template<typename NumericT, typename LocalTagT>
+int schwarz_test(viennacl::compressed_matrix<NumericT> const & A, viennacl::vector<NumericT> const & rhs, bool symmetric, LocalTagT const & local_tag,
+                 bool check_overlap_benefit, std::string const & name)
+{
+  typedef viennacl::linalg::schwarz_precond<viennacl::compressed_matrix<NumericT>, LocalTagT>   PreconditionerType;
+
+  for (int restricted = symmetric ? 0 : 1; restricted < 2; ++restricted)
+  {
+    viennacl::vcl_size_t iters[3];
+    for (unsigned int overlap = 0; overlap < 3; ++overlap)
+    {
+      PreconditionerType precond(A, viennacl::linalg::schwarz_tag(8, overlap, restricted == 1), local_tag);
+      iters[overlap] = schwarz_test(A, rhs, symmetric && restricted == 0, precond, name);
+      if (!iters[overlap] || precond.num_subdomains() != 8)
+        return EXIT_FAILURE;
+    }
+    if (check_overlap_benefit && (iters[1] > iters[0] || iters[2] > iters[1]))
+    {
+      std::cout << "# Error at operation: additive Schwarz, more iterations with larger overlap, " << name << ", restricted: " << restricted << std::endl;
+      std::cout << "  iterations for overlap 0, 1, 2: " << iters[0] << ", " << iters[1] << ", " << iters[2] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int schwarz_test()
+{
+  std::cout << "Testing additive Schwarz preconditioners" << std::endl;
+
+  unsigned int n = 30;
+  viennacl::compressed_matrix<NumericT> A_laplace, A_convection;
+  viennacl::tools::generate_fdm_laplace(A_laplace, n, n);
+  generate_convection_diffusion(A_convection, n, NumericT(0.5));
+  viennacl::vector<NumericT> rhs = viennacl::scalar_vector<NumericT>(A_laplace.size1(), NumericT(1));
+
+  if (schwarz_test(A_laplace,    rhs, true,  viennacl::linalg::ilu0_tag(),       false, "Laplace, ILU0")                 != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (schwarz_test(A_laplace,    rhs, true,  viennacl::linalg::ilut_tag(),       false, "Laplace, ILUT")                 != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (schwarz_test(A_laplace,    rhs, true,  viennacl::linalg::dense_lu_tag(),   true,  "Laplace, dense LU")             != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (schwarz_test(A_convection, rhs, false, viennacl::linalg::ilu0_tag(),       false, "convection-diffusion, ILU0")     != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (schwarz_test(A_convection, rhs, false, viennacl::linalg::ilut_tag(),       false, "convection-diffusion, ILUT")     != EXIT_SUCCESS) return EXIT_FAILURE;
+  if (schwarz_test(A_convection, rhs, false, viennacl::linalg::dense_lu_tag(),   true,  "convection-diffusion, dense LU") != EXIT_SUCCESS) return EXIT_FAILURE;
+
+  // user-supplied partition into four horizontal strips of the grid:
+  std::vector<unsigned int> partition(A_convection.size1());
+  for (std::size_t i = 0; i < partition.size(); ++i)
+    partition[i] = static_cast<unsigned int>(i / (partition.size() / 4));
+  typedef viennacl::linalg::schwarz_precond<viennacl::compressed_matrix<NumericT>, viennacl::linalg::dense_lu_tag>   DenseSchwarzType;
+  DenseSchwarzType strips(A_convection, viennacl::linalg::schwarz_tag(8, 0), partition);
+  bool strips_ok = (strips.num_subdomains() == 4);
+  for (std::size_t s = 0; s < strips.num_subdomains() && strips_ok; ++s)
+  {
+    std::vector<unsigned int> const & indices = strips.subdomain(s);
+    strips_ok = (indices.size() == partition.size() / 4);
+    for (std::size_t i = 0; i < indices.size() && strips_ok; ++i)
+      strips_ok = (partition[indices[i]] == s);
+  }
+  DenseSchwarzType strips_overlap(A_convection, viennacl::linalg::schwarz_tag(8, 1), partition);
+  for (std::size_t s = 0; s < strips_overlap.num_subdomains() && strips_ok; ++s) // one grid line of overlap to each neighboring strip
+    strips_ok = (strips_overlap.subdomain(s).size() == partition.size() / 4 + ((s == 0 || s == 3) ? n : 2 * n));
+  if (!strips_ok || !schwarz_test(A_convection, rhs, false, strips, "user-supplied partition") || !schwarz_test(A_convection, rhs, false, strips_overlap, "user-supplied partition, overlap 1"))
+  {
+    std::cout << "# Error at operation: additive Schwarz with user-supplied partition" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a single subdomain with exact local solves is the exact inverse:
+  std::vector<unsigned int> single_partition(A_convection.size1(), 0);
+  DenseSchwarzType single(A_convection, viennacl::linalg::schwarz_tag(1, 0), single_partition);
+  viennacl::vcl_size_t single_iters = schwarz_test(A_convection, rhs, false, single, "single subdomain");
+  if (single_iters != 1)
+  {
+    std::cout << "# Error at operation: additive Schwarz with a single subdomain, iterations: " << single_iters << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+//
+// -------------------------------------------------------------
+//
+template<typename NumericT>
+int solver_test()
+{
+  int retval = cg_fused_test<NumericT>();
+  if (retval == EXIT_SUCCESS)
+    retval = batched_solve_test<NumericT>();
+  if (retval == EXIT_SUCCESS)
+    retval = solver_statistics_test<NumericT>();
+  if (retval == EXIT_SUCCESS)
+    retval = gmres_augmented_test<NumericT>();
+  if (retval == EXIT_SUCCESS)
+    retval = ilut_parallel_test<NumericT>();
+  if (retval == EXIT_SUCCESS)
+    retval = sparse_triangular_solver_test<NumericT>();
+  if (retval == EXIT_SUCCESS)
+    retval = chow_patel_icc_test<NumericT>();
+  if (retval == EXIT_SUCCESS)
+    retval = ichol_test<NumericT>();
+  if (retval == EXIT_SUCCESS)
+    retval = schwarz_test<NumericT>();
+  return retval;
+}
+
+
+int iterative_refinement_test()
+{
+  typedef double   NumericT;
+  typedef float    LowNumericT;
+
+  std::cout << "Testing mixed-precision iterative refinement" << std::endl;
+
+  viennacl::compressed_matrix<NumericT> A;
+  viennacl::tools::generate_fdm_laplace(A, 30, 30);
+  viennacl::vector<NumericT> rhs = viennacl::scalar_vector<NumericT>(A.size1(), NumericT(1));
+
+  viennacl::linalg::iterative_refinement_tag<viennacl::linalg::cg_tag> tag(viennacl::linalg::cg_tag(1e-4, 500), 1e-11);
+  viennacl::vector<NumericT> x = viennacl::linalg::solve(A, rhs, tag);
+  NumericT res = relative_residual(A, x, rhs);
+  if (res > 1e-11 || tag.refinements() < 2 || std::fabs(tag.error() - res) > 1e-13)
+  {
+    std::cout << "# Error at operation: iterative refinement with internal single precision copy" << std::endl;
+    std::cout << "  residual: " << res << ", reported: " << tag.error() << ", refinements: " << tag.refinements() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a low-precision matrix of the wrong sign doubles the residual in each step. The refinement has to stop and return the initial guess:
+  std::vector<std::map<unsigned int, LowNumericT> > std_A(A.size1());
+  std::vector<std::map<unsigned int, NumericT> > std_A_high(A.size1());
+  viennacl::copy(A, std_A_high);
+  for (std::size_t i=0; i<std_A_high.size(); ++i)
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = std_A_high[i].begin(); it != std_A_high[i].end(); ++it)
+      std_A[i][it->first] = -static_cast<LowNumericT>(it->second);
+  viennacl::compressed_matrix<LowNumericT> A_wrong;
+  viennacl::copy(std_A, A_wrong);
+
+  x = viennacl::linalg::solve(A, rhs, tag, A_wrong, viennacl::linalg::no_precond());
+  if (viennacl::linalg::norm_2(x) > 0 || tag.refinements() != 1 || std::fabs(tag.error() - 1.0) > 1e-13)
+  {
+    std::cout << "# Error at operation: iterative refinement with diverging inner solver" << std::endl;
+    std::cout << "  norm of result: " << viennacl::linalg::norm_2(x) << ", reported error: " << tag.error() << ", refinements: " << tag.refinements() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
 //
 // -------------------------------------------------------------
 //
@@ -1085,6 +2104,33 @@ int main()
 
   int retval = EXIT_SUCCESS;
 
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  {
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  solvers and preconditioners, numeric: float" << std::endl;
+    retval = solver_test<float>();
+    if ( retval == EXIT_SUCCESS )
+      std::cout << "# Test passed" << std::endl;
+    else
+      return retval;
+  }
+#ifdef VIENNACL_WITH_OPENCL
+  if ( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  solvers and preconditioners, numeric: double" << std::endl;
+    retval = solver_test<double>();
+    if ( retval == EXIT_SUCCESS )
+      retval = iterative_refinement_test();
+    if ( retval == EXIT_SUCCESS )
+      std::cout << "# Test passed" << std::endl;
+    else
+      return retval;
+  }
+
   std::cout << std::endl;
   std::cout << "----------------------------------------------" << std::endl;
   std::cout << std::endl;
@@ -26,6 +26,8 @@
 #include <cmath>
 #include <complex>
 #include <fstream>
+#include <string>
+#include <stdexcept>
 
 //#define VIENNACL_BUILD_INFO
 
@@ -35,7 +37,10 @@
 #include "viennacl/circulant_matrix.hpp"
 #include "viennacl/vandermonde_matrix.hpp"
 #include "viennacl/hankel_matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/vector_proxy.hpp"
 #include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/toeplitz_matrix_operations.hpp"
 
 #include "viennacl/fft.hpp"
 
@@ -558,6 +563,353 @@ int hankel_test(ScalarType epsilon)
     return EXIT_SUCCESS;
 }
 
+template<typename ScalarType>
+int check_result(std::string const & name, ScalarType df, ScalarType epsilon)
+{
+  std::cout << name << ": " << df;
+  if (df < epsilon)
+  {
+    std::cout << " [OK]" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  std::cout << " [FAILED]" << std::endl;
+  return EXIT_FAILURE;
+}
+
+/** @brief Returns the deviation of prod(A, x) for the structured matrix A from the product with the dense reference matrix m, vectors reside in ctx */
+template<typename MatrixT, typename ScalarType>
+ScalarType prod_diff(MatrixT const & A, dense_matrix<ScalarType> const & m, viennacl::context ctx)
+{
+  std::vector<ScalarType> x(m.size2()), y(m.size1()), y_ref(m.size1());
+  for (std::size_t j = 0; j < x.size(); j++)
+    x[j] = ScalarType(1) + ScalarType(j % 7) / ScalarType(7);
+  for (std::size_t i = 0; i < y_ref.size(); i++)
+  {
+    y_ref[i] = 0;
+    for (std::size_t j = 0; j < x.size(); j++)
+      y_ref[i] += m(i,j) * x[j];
+  }
+
+  viennacl::vector<ScalarType> vcl_x(x.size(), ctx);
+  viennacl::vector<ScalarType> vcl_y(y.size(), ctx);
+  viennacl::copy(x, vcl_x);
+  vcl_y = viennacl::linalg::prod(A, vcl_x);
+  viennacl::copy(vcl_y, y);
+  return diff_max(y, y_ref);
+}
+
+/** @brief Checks that products use the new entries after the matrices are modified via copy(), operator() and operator+= (i.e. the cached spectra are invalidated) */
+template<typename ScalarType>
+int spectrum_cache_test(ScalarType epsilon, viennacl::context ctx)
+{
+  std::size_t n = 29;
+  dense_matrix<ScalarType> m1(n, n), m2(n, n);
+
+  // Toeplitz:
+  viennacl::toeplitz_matrix<ScalarType> toep1(n, n), toep2(n, n);
+  toep1.elements().switch_memory_context(ctx);
+  toep2.elements().switch_memory_context(ctx);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+    {
+      long d = long(i) - long(j);
+      m1(i,j) = ScalarType(d % 5) + ScalarType(1) / ScalarType(1 + d * d);
+      m2(i,j) = ScalarType(d % 3) - ScalarType(d) / ScalarType(n);
+    }
+  viennacl::copy(m1, toep1);
+  if (check_result("Toeplitz product", prod_diff(toep1, m1, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  viennacl::copy(m2, toep1);
+  if (check_result("Toeplitz product after copy()", prod_diff(toep1, m2, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  toep1(5, 2) = ScalarType(3);
+  for (std::size_t i = 3; i < n; i++)
+    m2(i, i - 3) = ScalarType(3);
+  if (check_result("Toeplitz product after operator()", prod_diff(toep1, m2, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  viennacl::copy(m1, toep2);
+  toep1 += toep2;
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      m2(i,j) += m1(i,j);
+  if (check_result("Toeplitz product after operator+=", prod_diff(toep1, m2, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // Circulant:
+  viennacl::circulant_matrix<ScalarType> circ1(n, n), circ2(n, n);
+  circ1.elements().switch_memory_context(ctx);
+  circ2.elements().switch_memory_context(ctx);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+    {
+      std::size_t d = (i + n - j) % n;
+      m1(i,j) = ScalarType(d % 5) + ScalarType(1) / ScalarType(1 + d * d);
+      m2(i,j) = ScalarType(d % 3) - ScalarType(d) / ScalarType(n);
+    }
+  viennacl::copy(m1, circ1);
+  if (check_result("Circulant product", prod_diff(circ1, m1, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  viennacl::copy(m2, circ1);
+  if (check_result("Circulant product after copy()", prod_diff(circ1, m2, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  circ1(2, 5) = ScalarType(3);
+  for (std::size_t i = 0; i < n; i++)
+    m2(i, (i + 3) % n) = ScalarType(3);
+  if (check_result("Circulant product after operator()", prod_diff(circ1, m2, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  viennacl::copy(m1, circ2);
+  circ1 += circ2;
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      m2(i,j) += m1(i,j);
+  if (check_result("Circulant product after operator+=", prod_diff(circ1, m2, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // Hankel (the spectrum is cached by the underlying Toeplitz matrix):
+  viennacl::hankel_matrix<ScalarType> hank1(n, n), hank2(n, n);
+  hank1.elements().elements().switch_memory_context(ctx);
+  hank2.elements().elements().switch_memory_context(ctx);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+    {
+      std::size_t d = i + j;
+      m1(i,j) = ScalarType(d % 5) + ScalarType(1) / ScalarType(1 + d * d);
+      m2(i,j) = ScalarType(d % 3) - ScalarType(d) / ScalarType(n);
+    }
+  viennacl::copy(m1, hank1);
+  if (check_result("Hankel product", prod_diff(hank1, m1, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  viennacl::copy(m2, hank1);
+  if (check_result("Hankel product after copy()", prod_diff(hank1, m2, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  hank1(4, 3) = ScalarType(3);
+  for (std::size_t i = 0; i <= 7; i++)
+    m2(i, 7 - i) = ScalarType(3);
+  if (check_result("Hankel product after operator()", prod_diff(hank1, m2, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  viennacl::copy(m1, hank2);
+  hank1 += hank2;
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      m2(i,j) += m1(i,j);
+  if (check_result("Hankel product after operator+=", prod_diff(hank1, m2, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Compares the products of a structured matrix with the columns of a submatrix with the dense reference. Entries of the result outside of the submatrix must not be modified. */
+template<typename MatrixT, typename ScalarType, typename LayoutT>
+ScalarType multi_column_diff(MatrixT const & A, dense_matrix<ScalarType> const & m, viennacl::context ctx, LayoutT)
+{
+  std::size_t n = m.size1();
+  std::size_t k = 4;
+
+  std::vector<std::vector<ScalarType> > X(n, std::vector<ScalarType>(k + 2));
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < k + 2; j++)
+      X[i][j] = ScalarType(1) + ScalarType((i * (j + 1)) % 7) / ScalarType(7);
+  std::vector<std::vector<ScalarType> > Y(n + 3, std::vector<ScalarType>(k, ScalarType(42)));
+
+  viennacl::matrix<ScalarType, LayoutT> vcl_X(n, k + 2, ctx);
+  viennacl::matrix<ScalarType, LayoutT> vcl_Y(n + 3, k, ctx);
+  viennacl::copy(X, vcl_X);
+  viennacl::copy(Y, vcl_Y);
+
+  viennacl::matrix_range<viennacl::matrix<ScalarType, LayoutT> > vcl_X_sub(vcl_X, viennacl::range(0, n), viennacl::range(1, k + 1));
+  viennacl::matrix_range<viennacl::matrix<ScalarType, LayoutT> > vcl_Y_sub(vcl_Y, viennacl::range(2, n + 2), viennacl::range(0, k));
+  viennacl::linalg::prod_impl(A, vcl_X_sub, vcl_Y_sub);
+  viennacl::copy(vcl_Y, Y);
+
+  std::vector<ScalarType> y, y_ref;
+  for (std::size_t c = 0; c < k; c++)
+    for (std::size_t i = 0; i < n + 3; i++)
+    {
+      ScalarType entry = ScalarType(42);
+      if (i >= 2 && i < n + 2)
+      {
+        entry = 0;
+        for (std::size_t j = 0; j < n; j++)
+          entry += m(i - 2, j) * X[j][c + 1];
+      }
+      y.push_back(Y[i][c]);
+      y_ref.push_back(entry);
+    }
+  return diff_max(y, y_ref);
+}
+
+template<typename ScalarType, typename LayoutT>
+int multi_column_test(ScalarType epsilon, viennacl::context ctx, LayoutT layout)
+{
+  std::size_t n = 23;
+  dense_matrix<ScalarType> m(n, n);
+
+  viennacl::toeplitz_matrix<ScalarType> toep(n, n);
+  toep.elements().switch_memory_context(ctx);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      m(i,j) = ScalarType((long(i) - long(j)) % 4) + ScalarType(0.5);
+  viennacl::copy(m, toep);
+  if (check_result("Toeplitz product with several columns", multi_column_diff(toep, m, ctx, layout), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  viennacl::circulant_matrix<ScalarType> circ(n, n);
+  circ.elements().switch_memory_context(ctx);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      m(i,j) = ScalarType((i + n - j) % n % 4) + ScalarType(0.5);
+  viennacl::copy(m, circ);
+  if (check_result("Circulant product with several columns", multi_column_diff(circ, m, ctx, layout), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  viennacl::hankel_matrix<ScalarType> hank(n, n);
+  hank.elements().elements().switch_memory_context(ctx);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      m(i,j) = ScalarType((i + j) % 4) + ScalarType(0.5);
+  viennacl::copy(m, hank);
+  if (check_result("Hankel product with several columns", multi_column_diff(hank, m, ctx, layout), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  viennacl::vandermonde_matrix<ScalarType> vander(n, n);
+  vander.elements().switch_memory_context(ctx);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      m(i,j) = std::pow(ScalarType(1) + ScalarType(i) / ScalarType(100), ScalarType(j));
+  viennacl::copy(m, vander);
+  if (check_result("Vandermonde product", prod_diff(vander, m, ctx), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check_result("Vandermonde product with several columns", multi_column_diff(vander, m, ctx, layout), epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks reverse() for vectors of even and odd size and for a strided subvector */
+template<typename ScalarType>
+int reverse_test(viennacl::context ctx)
+{
+  for (std::size_t size = 1; size <= 8; size += 3)
+  {
+    std::vector<ScalarType> v(size);
+    for (std::size_t i = 0; i < size; i++)
+      v[i] = ScalarType(i);
+    viennacl::vector<ScalarType> vcl_v(size, ctx);
+    viennacl::copy(v, vcl_v);
+    viennacl::linalg::reverse(vcl_v);
+    viennacl::copy(vcl_v, v);
+    for (std::size_t i = 0; i < size; i++)
+      if (v[i] < ScalarType(size - i - 1) || v[i] > ScalarType(size - i - 1))
+      {
+        std::cout << "reverse(), size " << size << ", entry " << i << ": " << v[i] << " [FAILED]" << std::endl;
+        return EXIT_FAILURE;
+      }
+  }
+
+  std::vector<ScalarType> w(20), w_ref(20);
+  for (std::size_t i = 0; i < w.size(); i++)
+    w[i] = w_ref[i] = ScalarType(i);
+  for (std::size_t i = 0; i < 5; i++)
+    w_ref[2 + 3 * i] = ScalarType(2 + 3 * (4 - i));
+  viennacl::vector<ScalarType> vcl_w(w.size(), ctx);
+  viennacl::copy(w, vcl_w);
+  viennacl::vector_slice<viennacl::vector<ScalarType> > vcl_w_slice(vcl_w, viennacl::slice(2, 3, 5));
+  viennacl::linalg::reverse(vcl_w_slice);
+  viennacl::copy(vcl_w, w);
+  return check_result("reverse()", diff_max(w, w_ref), ScalarType(1e-12));
+}
+
+/** @brief Checks the residuals of Toeplitz systems solved with the Levinson recursion and the detection of a singular leading principal submatrix */
+template<typename ScalarType>
+int levinson_test(ScalarType epsilon, viennacl::context ctx)
+{
+  for (std::size_t variant = 0; variant < 2; variant++)
+  {
+    // diagonally dominant nonsymmetric, and symmetric indefinite tridiagonal with nonsingular leading principal submatrices:
+    std::size_t n = variant ? 20 : 40;
+    dense_matrix<ScalarType> m(n, n);
+    for (std::size_t i = 0; i < n; i++)
+      for (std::size_t j = 0; j < n; j++)
+      {
+        long d = long(i) - long(j);
+        if (variant == 0)
+          m(i,j) = (d == 0) ? ScalarType(6) : ((d > 0) ? ScalarType(1) / ScalarType(d + 1) : ScalarType(-0.5) / ScalarType(d * d));
+        else
+          m(i,j) = (d == 0) ? ScalarType(1) : ((d == 1 || d == -1) ? ScalarType(2) : ScalarType(0));
+      }
+    viennacl::toeplitz_matrix<ScalarType> toep(n, n);
+    toep.elements().switch_memory_context(ctx);
+    viennacl::copy(m, toep);
+
+    std::vector<ScalarType> b(n), x(n);
+    for (std::size_t i = 0; i < n; i++)
+      b[i] = ScalarType(1 + i % 5);
+    viennacl::vector<ScalarType> vcl_b(n, ctx);
+    viennacl::copy(b, vcl_b);
+    viennacl::vector<ScalarType> vcl_x = viennacl::linalg::solve(toep, vcl_b, viennacl::linalg::levinson_tag());
+    viennacl::copy(vcl_x, x);
+
+    ScalarType res = 0, norm_b = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+      ScalarType r = b[i];
+      for (std::size_t j = 0; j < n; j++)
+        r -= m(i,j) * x[j];
+      res += r * r;
+      norm_b += b[i] * b[i];
+    }
+    if (check_result(variant ? "Levinson residual, symmetric indefinite" : "Levinson residual, nonsymmetric", std::sqrt(res / norm_b), epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // zero in the upper left corner:
+  dense_matrix<ScalarType> m(3, 3);
+  for (std::size_t i = 0; i < 3; i++)
+    for (std::size_t j = 0; j < 3; j++)
+      m(i,j) = (i == j) ? ScalarType(0) : ScalarType(1);
+  viennacl::toeplitz_matrix<ScalarType> toep(3, 3);
+  toep.elements().switch_memory_context(ctx);
+  viennacl::copy(m, toep);
+  viennacl::vector<ScalarType> vcl_b = viennacl::scalar_vector<ScalarType>(3, ScalarType(1), ctx);
+  try
+  {
+    viennacl::linalg::solve(toep, vcl_b, viennacl::linalg::levinson_tag());
+  }
+  catch (std::runtime_error const &)
+  {
+    std::cout << "Levinson with singular leading principal submatrix: [OK]" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  std::cout << "Levinson with singular leading principal submatrix: no exception [FAILED]" << std::endl;
+  return EXIT_FAILURE;
+}
+
+/** @brief Runs the tests of cached spectra, products with several columns, reverse() and the Levinson solver on the default context and in main memory */
+template<typename ScalarType>
+int structured_products_test(ScalarType epsilon)
+{
+  std::vector<viennacl::context> contexts;
+  contexts.push_back(viennacl::context());
+  if (viennacl::context().memory_type() != viennacl::MAIN_MEMORY)
+    contexts.push_back(viennacl::context(viennacl::MAIN_MEMORY));
+
+  for (std::size_t c = 0; c < contexts.size(); c++)
+  {
+    std::cout << "Memory domain: " << ((contexts[c].memory_type() == viennacl::MAIN_MEMORY) ? "main memory" : "device") << std::endl;
+    if (spectrum_cache_test(epsilon, contexts[c]) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (multi_column_test(epsilon, contexts[c], viennacl::row_major()) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (multi_column_test(epsilon, contexts[c], viennacl::column_major()) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (reverse_test<ScalarType>(contexts[c]) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (levinson_test(epsilon, contexts[c]) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
 int main()
 {
   std::cout << std::endl;
@@ -590,10 +942,16 @@ int main()
   if (hankel_test<float>(static_cast<float>(eps)) == EXIT_FAILURE)
     return EXIT_FAILURE;
 
+  std::cout << " -- Cached spectra, products with several columns, Levinson solver -- " << std::endl;
+  if (structured_products_test<float>(static_cast<float>(eps)) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
 
   std::cout << std::endl;
 
+#ifdef VIENNACL_WITH_OPENCL
   if ( viennacl::ocl::current_device().double_support() )
+#endif
   {
     eps = 1e-10;
 
@@ -618,6 +976,10 @@ int main()
     std::cout << " -- Hankel matrix -- " << std::endl;
     if (hankel_test<double>(eps) == EXIT_FAILURE)
       return EXIT_FAILURE;
+
+    std::cout << " -- Cached spectra, products with several columns, Levinson solver -- " << std::endl;
+    if (structured_products_test<double>(eps) == EXIT_FAILURE)
+      return EXIT_FAILURE;
   }
 
   std::cout << std::endl;
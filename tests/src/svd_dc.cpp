@@ -0,0 +1,460 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+
+/** \file tests/src/svd_dc.cpp  Tests the divide-and-conquer and the randomized truncated singular value decomposition on the host.
+*   \test Tests the divide-and-conquer singular value decomposition on rectangular, rank-deficient, and repeated-singular-value matrices, and the randomized truncated SVD of dense and sparse low-rank matrices.
+**/
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+//
+// *** System
+//
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+#include <functional>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/svd_dc.hpp"
+#include "viennacl/linalg/randomized_svd.hpp"
+
+
+/** @brief Applies a few random Householder reflections from the left to the rows of the host matrix A, i.e. A <- H A */
+void random_reflections(std::vector<std::vector<double> > & A)
+{
+  std::size_t m = A.size(), n = A[0].size();
+  for (int reflection = 0; reflection < 4; ++reflection)
+  {
+    std::vector<double> v(m);
+    double norm = 0;
+    for (std::size_t i = 0; i < m; ++i)
+    {
+      v[i] = double(rand()) / double(RAND_MAX) - 0.5;
+      norm += v[i] * v[i];
+    }
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      double dot = 0;
+      for (std::size_t i = 0; i < m; ++i)
+        dot += v[i] * A[i][j];
+      for (std::size_t i = 0; i < m; ++i)
+        A[i][j] -= 2 * v[i] * dot / norm;
+    }
+  }
+}
+
+
+/** @brief Returns the M-by-N matrix U0 diag(sigma) V0^T with random orthogonal U0 and V0, so that sigma are its exact singular values */
+std::vector<std::vector<double> > matrix_with_singular_values(std::size_t m, std::size_t n, std::vector<double> const & sigma)
+{
+  std::vector<std::vector<double> > A(m, std::vector<double>(n, 0.0));
+  for (std::size_t i = 0; i < sigma.size(); ++i)
+    A[i][i] = sigma[i];
+  random_reflections(A);
+
+  std::vector<std::vector<double> > At(n, std::vector<double>(m));
+  for (std::size_t i = 0; i < m; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      At[j][i] = A[i][j];
+  random_reflections(At);
+
+  for (std::size_t i = 0; i < m; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      A[i][j] = At[j][i];
+  return A;
+}
+
+
+/** @brief Returns max |X^T X - I| for the columns of X */
+template<typename ScalarType>
+double orthogonality_error(std::vector<std::vector<ScalarType> > const & X)
+{
+  double error = 0;
+  for (std::size_t k = 0; k < X[0].size(); ++k)
+    for (std::size_t l = 0; l <= k; ++l)
+    {
+      double dot = (k == l) ? -1.0 : 0.0;
+      for (std::size_t i = 0; i < X.size(); ++i)
+        dot += double(X[i][k]) * double(X[i][l]);
+      error = std::max(error, std::fabs(dot));
+    }
+  return error;
+}
+
+
+/** @brief Checks the divide-and-conquer SVD of the host matrix A in the given mode of svd_dc_tag.
+*
+* Verifies the singular values against 'sigma_ref' (if not empty), the residuals A V - U S and A^T U - V S of all computed singular triplets,
+* the orthogonality of U and V, and the singular values computed without singular vectors.
+*/
+template<typename ScalarType>
+void test_svd_dc(std::vector<std::vector<double> > const & A, std::vector<double> sigma_ref, int mode, std::size_t rank, std::string const & name)
+{
+  std::size_t m = A.size(), n = A[0].size(), k = std::min(m, n);
+  double eps = std::numeric_limits<ScalarType>::epsilon();
+
+  double norm_A = 0;
+  for (std::size_t i = 0; i < m; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      norm_A = std::max(norm_A, std::fabs(A[i][j]));
+  double tol = 10 * eps * double(m + n) * std::max(norm_A, 1.0);
+  double tol_orth = 10 * eps * double(m + n);
+
+  std::vector<std::vector<ScalarType> > A_host(m, std::vector<ScalarType>(n));
+  for (std::size_t i = 0; i < m; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      A_host[i][j] = ScalarType(A[i][j]);
+
+  viennacl::matrix<ScalarType> vcl_A(m, n), vcl_U;
+  viennacl::matrix<ScalarType, viennacl::column_major> vcl_V;
+  viennacl::copy(A_host, vcl_A);
+
+  std::vector<ScalarType> S;
+  viennacl::linalg::svd_dc_tag tag(mode, rank);
+  viennacl::linalg::svd_dc(vcl_A, S, vcl_U, vcl_V, tag);
+
+  std::size_t num_sigma = (mode == viennacl::linalg::svd_dc_tag::truncated) ? std::min(rank, k) : k;
+  std::size_t left  = (mode == viennacl::linalg::svd_dc_tag::full) ? m : num_sigma;
+  std::size_t right = (mode == viennacl::linalg::svd_dc_tag::full) ? n : num_sigma;
+  bool ok = (S.size() == num_sigma) && (vcl_U.size1() == m) && (vcl_U.size2() == left) && (vcl_V.size1() == n) && (vcl_V.size2() == right);
+
+  double sigma_diff = 0, residual = 0, orth = 0, values_only_diff = 0;
+  if (ok)
+  {
+    std::vector<std::vector<ScalarType> > U(m, std::vector<ScalarType>(left)), V(n, std::vector<ScalarType>(right));
+    viennacl::copy(vcl_U, U);
+    viennacl::copy(vcl_V, V);
+
+    for (std::size_t i = 0; i + 1 < S.size(); ++i)
+      if (S[i] < S[i+1] || S[i+1] < 0)
+        ok = false;
+
+    std::sort(sigma_ref.begin(), sigma_ref.end(), std::greater<double>());
+    for (std::size_t i = 0; i < std::min(num_sigma, sigma_ref.size()); ++i)
+      sigma_diff = std::max(sigma_diff, std::fabs(double(S[i]) - sigma_ref[i]));
+
+    for (std::size_t l = 0; l < num_sigma; ++l)
+    {
+      for (std::size_t i = 0; i < m; ++i)   // A v_l - s_l u_l
+      {
+        double r = -double(S[l]) * double(U[i][l]);
+        for (std::size_t j = 0; j < n; ++j)
+          r += A[i][j] * double(V[j][l]);
+        residual = std::max(residual, std::fabs(r));
+      }
+      for (std::size_t j = 0; j < n; ++j)   // A^T u_l - s_l v_l
+      {
+        double r = -double(S[l]) * double(V[j][l]);
+        for (std::size_t i = 0; i < m; ++i)
+          r += A[i][j] * double(U[i][l]);
+        residual = std::max(residual, std::fabs(r));
+      }
+    }
+
+    // in full mode, the additional columns span the null spaces of A^T and A:
+    for (std::size_t l = num_sigma; l < left; ++l)
+      for (std::size_t j = 0; j < n; ++j)
+      {
+        double r = 0;
+        for (std::size_t i = 0; i < m; ++i)
+          r += A[i][j] * double(U[i][l]);
+        residual = std::max(residual, std::fabs(r));
+      }
+    for (std::size_t l = num_sigma; l < right; ++l)
+      for (std::size_t i = 0; i < m; ++i)
+      {
+        double r = 0;
+        for (std::size_t j = 0; j < n; ++j)
+          r += A[i][j] * double(V[j][l]);
+        residual = std::max(residual, std::fabs(r));
+      }
+
+    orth = std::max(orthogonality_error(U), orthogonality_error(V));
+
+    std::vector<ScalarType> S_only;
+    viennacl::linalg::svd_dc(vcl_A, S_only, tag);
+    if (S_only.size() != num_sigma)
+      ok = false;
+    else
+      for (std::size_t i = 0; i < num_sigma; ++i)
+        values_only_diff = std::max(values_only_diff, std::fabs(double(S_only[i]) - double(S[i])));
+  }
+  ok = ok && (sigma_diff <= tol) && (residual <= tol) && (orth <= tol_orth) && (values_only_diff <= tol);
+
+  printf("%6s [%dx%d] %40s sigma_diff = %.3g; residual = %.3g; orthogonality = %.3g\n", ok?"[[OK]]":"[FAIL]", (int)m, (int)n, name.c_str(), sigma_diff, residual, orth);
+  if (!ok)
+    exit(EXIT_FAILURE);
+}
+
+
+/** @brief Runs the divide-and-conquer SVD in all modes on rectangular, rank-deficient, and repeated-singular-value matrices */
+template<typename ScalarType>
+void test_svd_dc_all()
+{
+  typedef viennacl::linalg::svd_dc_tag   tag;
+
+  std::vector<double> distinct;
+  for (std::size_t i = 0; i < 90; ++i)
+    distinct.push_back(1.0 + double(i) * 0.1);
+
+  std::vector<double> rank_deficient(100, 0.0);
+  for (std::size_t i = 0; i < 60; ++i)
+    rank_deficient[i] = 1.0 + double(i);
+
+  std::vector<double> repeated;
+  for (std::size_t i = 0; i < 30; ++i) repeated.push_back(5.0);
+  for (std::size_t i = 0; i < 40; ++i) repeated.push_back(2.0);
+  for (std::size_t i = 0; i < 20; ++i) repeated.push_back(1.0 + double(i) * 1e-9);
+  for (std::size_t i = 0; i < 10; ++i) repeated.push_back(0.5 + double(i) * 0.25);
+
+  std::vector<std::vector<double> > tall = matrix_with_singular_values(150, 90, distinct);
+  std::vector<std::vector<double> > wide = matrix_with_singular_values(90, 130, distinct);
+  std::vector<std::vector<double> > deficient = matrix_with_singular_values(120, 100, rank_deficient);
+  std::vector<std::vector<double> > deficient_wide = matrix_with_singular_values(100, 120, rank_deficient);
+  std::vector<std::vector<double> > multiple = matrix_with_singular_values(100, 100, repeated);
+
+  // exactly zero blocks in the bidiagonal form:
+  std::vector<std::vector<double> > diagonal(100, std::vector<double>(80, 0.0));
+  std::vector<double> diagonal_sigma(80, 0.0);
+  for (std::size_t i = 0; i < 6; ++i)
+    diagonal[i][i] = diagonal_sigma[i] = 6.0 - double(i);
+
+  std::vector<std::vector<double> > zero(40, std::vector<double>(30, 0.0));
+  std::vector<std::vector<double> > column(70, std::vector<double>(1));
+  std::vector<std::vector<double> > row(1, std::vector<double>(70));
+  std::vector<double> column_sigma(1, 0.0);
+  for (std::size_t i = 0; i < 70; ++i)
+  {
+    column[i][0] = row[0][i] = double(rand()) / double(RAND_MAX) - 0.5;
+    column_sigma[0] += column[i][0] * column[i][0];
+  }
+  column_sigma[0] = std::sqrt(column_sigma[0]);
+
+  for (int mode = tag::full; mode <= tag::economy; ++mode)
+  {
+    std::string suffix = (mode == tag::full) ? ", full" : ", economy";
+    test_svd_dc<ScalarType>(tall,           distinct,       mode, 0, "tall" + suffix);
+    test_svd_dc<ScalarType>(wide,           distinct,       mode, 0, "wide" + suffix);
+    test_svd_dc<ScalarType>(deficient,      rank_deficient, mode, 0, "rank-deficient" + suffix);
+    test_svd_dc<ScalarType>(deficient_wide, rank_deficient, mode, 0, "rank-deficient wide" + suffix);
+    test_svd_dc<ScalarType>(multiple,       repeated,       mode, 0, "repeated singular values" + suffix);
+    test_svd_dc<ScalarType>(diagonal,       diagonal_sigma, mode, 0, "diagonal low-rank" + suffix);
+    test_svd_dc<ScalarType>(zero,           std::vector<double>(30, 0.0), mode, 0, "zero" + suffix);
+    test_svd_dc<ScalarType>(column,         column_sigma,   mode, 0, "single column" + suffix);
+    test_svd_dc<ScalarType>(row,            column_sigma,   mode, 0, "single row" + suffix);
+  }
+
+  test_svd_dc<ScalarType>(tall,      distinct,       tag::truncated, 10,  "tall, truncated");
+  test_svd_dc<ScalarType>(wide,      distinct,       tag::truncated, 200, "wide, truncated beyond size");
+  test_svd_dc<ScalarType>(deficient, rank_deficient, tag::truncated, 70,  "rank-deficient, truncated");
+  test_svd_dc<ScalarType>(multiple,  repeated,       tag::truncated, 45,  "repeated, truncated in cluster");
+}
+
+
+/** @brief Returns the maximum deviation of a truncated SVD (S, U, V) from the exact one (S_ref, U_ref, V_ref).
+*
+* Singular vectors are compared up to their sign. If 'reconstruct' is true, the deviation of U diag(S) V^T from A is included.
+*/
+template<typename ScalarType>
+double truncated_svd_diff(std::vector<std::vector<double> > const & A,
+                          std::vector<ScalarType> const & S, viennacl::matrix<ScalarType> const & vcl_U, viennacl::matrix<ScalarType> const & vcl_V,
+                          std::vector<ScalarType> const & S_ref, viennacl::matrix<ScalarType> const & vcl_U_ref, viennacl::matrix<ScalarType> const & vcl_V_ref,
+                          bool reconstruct)
+{
+  std::size_t m = A.size(), n = A[0].size(), rank = S.size();
+  std::vector<std::vector<ScalarType> > U(m, std::vector<ScalarType>(rank)), V(n, std::vector<ScalarType>(rank));
+  std::vector<std::vector<ScalarType> > U_ref(m, std::vector<ScalarType>(rank)), V_ref(n, std::vector<ScalarType>(rank));
+  viennacl::copy(vcl_U, U);
+  viennacl::copy(vcl_V, V);
+  viennacl::copy(vcl_U_ref, U_ref);
+  viennacl::copy(vcl_V_ref, V_ref);
+
+  double diff = 0;
+  for (std::size_t l = 0; l < rank; ++l)
+  {
+    diff = std::max(diff, std::fabs(double(S[l]) - double(S_ref[l])));
+
+    double dot_u = 0, dot_v = 0;
+    for (std::size_t i = 0; i < m; ++i)
+      dot_u += double(U[i][l]) * double(U_ref[i][l]);
+    for (std::size_t j = 0; j < n; ++j)
+      dot_v += double(V[j][l]) * double(V_ref[j][l]);
+    diff = std::max(diff, std::max(1.0 - std::fabs(dot_u), 1.0 - std::fabs(dot_v)));
+  }
+
+  // A = U S V^T if the rank of A does not exceed the number of computed singular triplets:
+  if (reconstruct)
+    for (std::size_t i = 0; i < m; ++i)
+      for (std::size_t j = 0; j < n; ++j)
+      {
+        double r = A[i][j];
+        for (std::size_t l = 0; l < rank; ++l)
+          r -= double(U[i][l]) * double(S[l]) * double(V[j][l]);
+        diff = std::max(diff, std::fabs(r));
+      }
+
+  return diff;
+}
+
+
+/** @brief Compares the randomized truncated SVD of the low-rank host matrix A in dense and sparse format with the exact SVD from svd_dc() */
+template<typename ScalarType>
+void test_randomized_svd(std::vector<std::vector<double> > const & A, std::size_t rank, std::string const & name)
+{
+  std::size_t m = A.size(), n = A[0].size();
+  double eps = std::numeric_limits<ScalarType>::epsilon();
+
+  std::vector<std::vector<ScalarType> > A_host(m, std::vector<ScalarType>(n));
+  std::vector<std::map<unsigned int, ScalarType> > A_sparse(m);
+  double norm_A = 0;
+  for (std::size_t i = 0; i < m; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      A_host[i][j] = ScalarType(A[i][j]);
+      if (A[i][j] < 0 || A[i][j] > 0)
+        A_sparse[i][static_cast<unsigned int>(j)] = ScalarType(A[i][j]);
+      norm_A = std::max(norm_A, std::fabs(A[i][j]));
+    }
+  double tol = 100 * eps * double(m + n) * std::max(norm_A, 1.0);
+
+  viennacl::matrix<ScalarType> vcl_A(m, n), U_ref, U_dense, U_sparse;
+  viennacl::matrix<ScalarType> V_ref, V_dense, V_sparse;
+  viennacl::compressed_matrix<ScalarType> vcl_A_sparse(m, n);
+  viennacl::copy(A_host, vcl_A);
+  viennacl::copy(viennacl::tools::const_sparse_matrix_adapter<ScalarType>(A_sparse, m, n), vcl_A_sparse);
+
+  std::vector<ScalarType> S_ref, S_dense, S_sparse, S_dense_only, S_sparse_only;
+  viennacl::linalg::svd_dc(vcl_A, S_ref, U_ref, V_ref, viennacl::linalg::svd_dc_tag(viennacl::linalg::svd_dc_tag::truncated, rank));
+  std::vector<ScalarType> S_all;
+  viennacl::linalg::svd_dc(vcl_A, S_all);
+
+  viennacl::linalg::randomized_svd_tag tag(rank, 10, 2);
+  viennacl::linalg::randomized_svd(vcl_A,        S_dense,  U_dense,  V_dense,  tag);
+  viennacl::linalg::randomized_svd(vcl_A_sparse, S_sparse, U_sparse, V_sparse, tag);
+  viennacl::linalg::randomized_svd(vcl_A,        S_dense_only,  tag);
+  viennacl::linalg::randomized_svd(vcl_A_sparse, S_sparse_only, tag);
+
+  bool ok = (S_dense.size() == rank) && (S_sparse.size() == rank) && (S_dense_only.size() == rank) && (S_sparse_only.size() == rank)
+            && (U_dense.size1() == m) && (U_dense.size2() == rank) && (V_dense.size1() == n) && (V_dense.size2() == rank)
+            && (U_sparse.size1() == m) && (U_sparse.size2() == rank) && (V_sparse.size1() == n) && (V_sparse.size2() == rank);
+
+  double dense_diff = 0, sparse_diff = 0;
+  if (ok)
+  {
+    bool reconstruct = (rank >= S_all.size()) || (double(S_all[rank]) <= tol);
+    dense_diff  = truncated_svd_diff(A, S_dense,  U_dense,  V_dense,  S_ref, U_ref, V_ref, reconstruct);
+    sparse_diff = truncated_svd_diff(A, S_sparse, U_sparse, V_sparse, S_ref, U_ref, V_ref, reconstruct);
+    for (std::size_t l = 0; l < rank; ++l)
+    {
+      dense_diff  = std::max(dense_diff,  std::fabs(double(S_dense_only[l])  - double(S_ref[l])));
+      sparse_diff = std::max(sparse_diff, std::fabs(double(S_sparse_only[l]) - double(S_ref[l])));
+    }
+  }
+  ok = ok && (dense_diff <= tol) && (sparse_diff <= tol);
+
+  printf("%6s [%dx%d] %40s rank = %d; dense_diff = %.3g; sparse_diff = %.3g\n", ok?"[[OK]]":"[FAIL]", (int)m, (int)n, name.c_str(), (int)rank, dense_diff, sparse_diff);
+  if (!ok)
+    exit(EXIT_FAILURE);
+}
+
+
+/** @brief Runs the randomized truncated SVD on low-rank matrices, requesting all and only some of the nonzero singular triplets */
+template<typename ScalarType>
+void test_randomized_svd_all()
+{
+  // dense matrix of rank 8 with well separated singular values:
+  std::vector<double> sigma(8);
+  for (std::size_t i = 0; i < sigma.size(); ++i)
+    sigma[i] = 10.0 - double(i);
+  std::vector<std::vector<double> > dense = matrix_with_singular_values(200, 120, sigma);
+
+  test_randomized_svd<ScalarType>(dense, 8, "dense low-rank, full rank");
+  test_randomized_svd<ScalarType>(dense, 5, "dense low-rank, partial rank");
+
+  // sparse matrix of rank 6 as a sum of outer products of sparse vectors:
+  std::size_t m = 300, n = 250;
+  std::vector<std::vector<double> > sparse(m, std::vector<double>(n, 0.0));
+  for (std::size_t l = 0; l < 6; ++l)
+  {
+    std::vector<double> a(m, 0.0), b(n, 0.0);
+    for (std::size_t i = 0; i < m; ++i)
+      if (rand() % 8 == 0)
+        a[i] = double(rand()) / double(RAND_MAX) - 0.5;
+    for (std::size_t j = 0; j < n; ++j)
+      if (rand() % 8 == 0)
+        b[j] = double(rand()) / double(RAND_MAX) - 0.5;
+    for (std::size_t i = 0; i < m; ++i)
+      for (std::size_t j = 0; j < n; ++j)
+        sparse[i][j] += double(6 - l) * a[i] * b[j];
+  }
+
+  test_randomized_svd<ScalarType>(sparse, 6, "sparse low-rank, full rank");
+  test_randomized_svd<ScalarType>(sparse, 3, "sparse low-rank, partial rank");
+}
+
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Divide-and-Conquer Singular Value Decomposition" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  test_svd_dc_all<float>();
+  test_randomized_svd_all<float>();
+  std::cout << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if ( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    test_svd_dc_all<double>();
+    test_randomized_svd_all<double>();
+    std::cout << std::endl;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
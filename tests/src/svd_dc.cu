@@ -0,0 +1 @@
+svd_dc.cpp
\ No newline at end of file
@@ -0,0 +1,374 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** \file tests/src/symmetric_eig.cpp  Tests the divide-and-conquer symmetric eigensolver on repeated and clustered eigenvalues, which exercise the deflation paths.
+*   \test Tests the divide-and-conquer symmetric eigensolver on repeated and clustered eigenvalues, which exercise the deflation paths.
+**/
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/symmetric_eig.hpp"
+
+
+typedef std::vector<std::vector<double> >   HostMatrix;
+
+
+/** @brief Returns a symmetric tridiagonal matrix with diagonal d and off-diagonal e */
+HostMatrix tridiagonal(std::vector<double> const & d, std::vector<double> const & e)
+{
+  HostMatrix A(d.size(), std::vector<double>(d.size()));
+  for (std::size_t i = 0; i < d.size(); ++i)
+  {
+    A[i][i] = d[i];
+    if (i + 1 < d.size())
+      A[i][i+1] = A[i+1][i] = e[i];
+  }
+  return A;
+}
+
+/** @brief Returns the number of eigenvalues of the symmetric tridiagonal matrix (d, e) smaller than x (Sturm sequence) */
+std::size_t sturm_count(std::vector<double> const & d, std::vector<double> const & e, double x)
+{
+  std::size_t count = 0;
+  double q = 1;
+  for (std::size_t i = 0; i < d.size(); ++i)
+  {
+    double e2 = (i > 0) ? e[i-1] * e[i-1] : 0;
+    q = d[i] - x - ((i > 0) ? e2 / q : 0);
+    if (std::fabs(q) < 1e-300)
+      q = -1e-300;
+    if (q < 0)
+      ++count;
+  }
+  return count;
+}
+
+/** @brief Computes the eigenvalues of a symmetric tridiagonal matrix in ascending order by bisection */
+std::vector<double> tridiagonal_spectrum(std::vector<double> const & d, std::vector<double> const & e)
+{
+  double bound = 0;
+  for (std::size_t i = 0; i < d.size(); ++i)
+    bound = std::max(bound, std::fabs(d[i]) + ((i > 0) ? std::fabs(e[i-1]) : 0) + ((i + 1 < d.size()) ? std::fabs(e[i]) : 0));
+
+  std::vector<double> spectrum(d.size());
+  for (std::size_t k = 0; k < d.size(); ++k)
+  {
+    double lower = -bound - 1, upper = bound + 1;
+    for (int iter = 0; iter < 200 && upper - lower > 1e-15 * (bound + 1); ++iter)
+    {
+      double mid = (lower + upper) / 2;
+      if (sturm_count(d, e, mid) > k)
+        upper = mid;
+      else
+        lower = mid;
+    }
+    spectrum[k] = (lower + upper) / 2;
+  }
+  return spectrum;
+}
+
+/** @brief Returns Q diag(spectrum) Q^T for an orthogonal Q made of a few random Householder reflections */
+HostMatrix rotated_diagonal(std::vector<double> const & spectrum)
+{
+  std::size_t n = spectrum.size();
+  HostMatrix A(n, std::vector<double>(n));
+  for (std::size_t i = 0; i < n; ++i)
+    A[i][i] = spectrum[i];
+
+  for (int reflection = 0; reflection < 3; ++reflection)
+  {
+    // A <- H A H with H = I - 2 v v^T:
+    std::vector<double> v(n), Av(n, 0);
+    double norm = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      v[i] = double(std::rand()) / double(RAND_MAX) - 0.5;
+      norm += v[i] * v[i];
+    }
+    for (std::size_t i = 0; i < n; ++i)
+      v[i] /= std::sqrt(norm);
+
+    double vAv = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      for (std::size_t j = 0; j < n; ++j)
+        Av[i] += A[i][j] * v[j];
+      vAv += v[i] * Av[i];
+    }
+    for (std::size_t i = 0; i < n; ++i)
+      for (std::size_t j = 0; j < n; ++j)
+        A[i][j] += -2 * v[i] * Av[j] - 2 * Av[i] * v[j] + 4 * vAv * v[i] * v[j];
+  }
+
+  // symmetrize exactly:
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < i; ++j)
+      A[i][j] = A[j][i] = (A[i][j] + A[j][i]) / 2;
+  return A;
+}
+
+/** @brief Runs the eigensolver on A and checks eigenvalues, residual ||A V - V D||, orthogonality ||V^T V - I||, and the eigenvalue-only variant
+*
+* @param A           The symmetric test matrix
+* @param reference   The exact eigenvalues in ascending order (may be empty if unknown)
+* @param tolerance   Tolerance relative to machine epsilon, ||A|| and the matrix size
+* @param name        Name of the test case
+* @param garbage     If true, the upper triangle passed to the solver is overwritten, since it must not be referenced
+*/
+template<typename NumericT, typename F>
+int test_eig(HostMatrix const & A, std::vector<double> const & reference, double tolerance, std::string const & name, bool garbage = false)
+{
+  std::cout << "Testing " << name << ", size " << A.size() << std::endl;
+
+  std::size_t n = A.size();
+  double eps = std::numeric_limits<NumericT>::epsilon();
+
+  double norm_A = 0;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    double row_sum = 0;
+    for (std::size_t j = 0; j < n; ++j)
+      row_sum += std::fabs(A[i][j]);
+    norm_A = std::max(norm_A, row_sum);
+  }
+  if (norm_A <= 0)
+    norm_A = 1;
+  double bound = tolerance * eps * norm_A * double(n + 1);
+
+  std::vector<std::vector<NumericT> > A_host(n, std::vector<NumericT>(n));
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      A_host[i][j] = (garbage && j > i) ? NumericT(1000) : NumericT(A[i][j]);
+
+  viennacl::matrix<NumericT, F> vcl_A(n, n), vcl_Q(n, n);
+  viennacl::copy(A_host, vcl_A);
+
+  std::vector<NumericT> D;
+  viennacl::linalg::symmetric_eig(vcl_A, D, vcl_Q);
+
+  std::vector<std::vector<NumericT> > Q(n, std::vector<NumericT>(n));
+  viennacl::copy(vcl_Q, Q);
+
+  if (D.size() != n)
+  {
+    std::cout << "# Error at operation: " << name << ", " << D.size() << " eigenvalues returned" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (std::size_t i = 0; i + 1 < n; ++i)
+    if (D[i] > D[i+1])
+    {
+      std::cout << "# Error at operation: " << name << ", eigenvalues not in ascending order at " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  for (std::size_t i = 0; i < reference.size(); ++i)
+    if (std::fabs(double(D[i]) - reference[i]) > bound)
+    {
+      std::cout << "# Error at operation: " << name << ", eigenvalue " << i << ": " << D[i] << " vs. " << reference[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  double residual = 0, orthogonality = 0;
+  for (std::size_t k = 0; k < n; ++k)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      double r = -double(D[k]) * double(Q[i][k]);
+      for (std::size_t j = 0; j < n; ++j)
+        r += A[i][j] * double(Q[j][k]);
+      residual = std::max(residual, std::fabs(r));
+    }
+    for (std::size_t l = 0; l <= k; ++l)
+    {
+      double dot = (k == l) ? -1.0 : 0.0;
+      for (std::size_t i = 0; i < n; ++i)
+        dot += double(Q[i][k]) * double(Q[i][l]);
+      orthogonality = std::max(orthogonality, std::fabs(dot));
+    }
+  }
+  if (residual > bound)
+  {
+    std::cout << "# Error at operation: " << name << ", residual " << residual << " exceeds " << bound << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (orthogonality > tolerance * eps * double(n + 1))
+  {
+    std::cout << "# Error at operation: " << name << ", loss of orthogonality " << orthogonality << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // eigenvalues only (QL iteration instead of divide-and-conquer), written to a ViennaCL vector:
+  viennacl::vector<NumericT> vcl_D(n);
+  viennacl::linalg::symmetric_eig(vcl_A, vcl_D);
+  std::vector<NumericT> D_only(n);
+  viennacl::copy(vcl_D, D_only);
+  for (std::size_t i = 0; i < n; ++i)
+    if (std::fabs(double(D_only[i]) - double(D[i])) > bound)
+    {
+      std::cout << "# Error at operation: " << name << " without eigenvectors, eigenvalue " << i << ": " << D_only[i] << " vs. " << D[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int test_both_layouts(HostMatrix const & A, std::vector<double> const & reference, double tolerance, std::string const & name, bool garbage = false)
+{
+  if (test_eig<NumericT, viennacl::row_major>(A, reference, tolerance, name + ", row-major", garbage) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  return test_eig<NumericT, viennacl::column_major>(A, reference, tolerance, name + ", column-major", garbage);
+}
+
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Symmetric Eigensolver" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  double tol = 50;
+
+  // repeated eigenvalues, a tight cluster, and distinct ones; the tridiagonal form decouples (zero weights in the merges):
+  {
+    std::vector<double> spectrum;
+    for (std::size_t i = 0; i < 40; ++i) spectrum.push_back(1.0);
+    for (std::size_t i = 0; i < 30; ++i) spectrum.push_back(2.0);
+    for (std::size_t i = 0; i < 20; ++i) spectrum.push_back(3.0 + double(i) * 1e-10);
+    for (std::size_t i = 0; i < 60; ++i) spectrum.push_back(-1.0 - double(i) * 0.1);
+    std::random_shuffle(spectrum.begin(), spectrum.end());
+    HostMatrix A = rotated_diagonal(spectrum);
+    std::sort(spectrum.begin(), spectrum.end());
+    if (test_both_layouts<double>(A, spectrum, tol, "repeated and clustered eigenvalues") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (test_eig<double, viennacl::row_major>(A, spectrum, tol, "repeated and clustered eigenvalues, upper triangle not referenced", true) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // diagonal matrix with repeated entries: all couplings vanish, every merge deflates completely:
+  {
+    std::vector<double> d(130), e(129, 0.0);
+    for (std::size_t i = 0; i < d.size(); ++i)
+      d[i] = double(int(i % 7) - 3);
+    std::vector<double> spectrum(d);
+    std::sort(spectrum.begin(), spectrum.end());
+    if (test_both_layouts<double>(tridiagonal(d, e), spectrum, tol, "diagonal matrix") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // zero matrix (all eigenvalues zero, no scaling possible):
+  if (test_both_layouts<double>(HostMatrix(70, std::vector<double>(70, 0.0)), std::vector<double>(70, 0.0), tol, "zero matrix") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // all-ones matrix: eigenvalue 0 of multiplicity n-1 and the simple eigenvalue n:
+  {
+    std::size_t n = 100;
+    std::vector<double> spectrum(n, 0.0);
+    spectrum[n-1] = double(n);
+    if (test_both_layouts<double>(HostMatrix(n, std::vector<double>(n, 1.0)), spectrum, tol, "all-ones matrix") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // Laplacian blocks with a zero coupling right at the top-level merge point (rho = 0) and one inside a subproblem:
+  {
+    std::vector<double> d(128, 2.0), e(127, -1.0);
+    e[63] = 0;
+    e[95] = 0;
+    if (test_both_layouts<double>(tridiagonal(d, e), tridiagonal_spectrum(d, e), tol, "decoupled Laplacian blocks") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // Wilkinson matrix W+: pairs of eigenvalues agreeing to many digits:
+  {
+    std::size_t m = 50;
+    std::vector<double> d(2*m+1), e(2*m, 1.0);
+    for (std::size_t i = 0; i < d.size(); ++i)
+      d[i] = std::fabs(double(m) - double(i));
+    if (test_both_layouts<double>(tridiagonal(d, e), tridiagonal_spectrum(d, e), tol, "Wilkinson matrix") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // glued Wilkinson matrices: clusters of eigenvalues that are equal up to the glue, deflated by Givens rotations:
+  {
+    std::vector<double> d, e;
+    for (std::size_t block = 0; block < 6; ++block)
+      for (std::size_t i = 0; i < 21; ++i)
+      {
+        d.push_back(std::fabs(10.0 - double(i)));
+        e.push_back((i < 20) ? 1.0 : 1e-9);
+      }
+    e.pop_back();
+    if (test_both_layouts<double>(tridiagonal(d, e), tridiagonal_spectrum(d, e), tol, "glued Wilkinson matrices") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  // small sizes including the leaf size and the first divide-and-conquer step, random symmetric matrices:
+  {
+    std::size_t sizes[] = {1, 2, 3, 32, 33, 65};
+    for (std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+    {
+      std::size_t n = sizes[k];
+      HostMatrix A(n, std::vector<double>(n));
+      for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j <= i; ++j)
+          A[i][j] = A[j][i] = double(std::rand()) / double(RAND_MAX) - 0.5;
+      if (test_both_layouts<double>(A, std::vector<double>(), tol, "random matrix") != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+    }
+  }
+
+  // single precision with repeated eigenvalues:
+  {
+    std::vector<double> spectrum;
+    for (std::size_t i = 0; i < 50; ++i) spectrum.push_back(-0.5);
+    for (std::size_t i = 0; i < 50; ++i) spectrum.push_back(0.25 * double(i));
+    HostMatrix A = rotated_diagonal(spectrum);
+    std::sort(spectrum.begin(), spectrum.end());
+    if (test_both_layouts<float>(A, spectrum, tol, "repeated eigenvalues, single precision") != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
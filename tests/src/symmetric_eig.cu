@@ -0,0 +1 @@
+symmetric_eig.cpp
\ No newline at end of file
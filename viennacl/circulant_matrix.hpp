@@ -24,7 +24,9 @@
 
 #include "viennacl/forwards.h"
 #include "viennacl/vector.hpp"
+#ifdef VIENNACL_WITH_OPENCL
 #include "viennacl/ocl/backend.hpp"
+#endif
 
 #include "viennacl/linalg/circulant_matrix_operations.hpp"
 
@@ -71,6 +73,7 @@ public:
   void resize(vcl_size_t sz, bool preserve = true)
   {
     elements_.resize(sz, preserve);
+    spectrum_.invalidate();
   }
 
   /** @brief Returns the OpenCL handle
@@ -83,9 +86,21 @@ public:
     * @brief Returns an internal viennacl::vector, which represents a circulant matrix elements
     *
     */
-  viennacl::vector<NumericT, AlignmentV> & elements() { return elements_; }
+  viennacl::vector<NumericT, AlignmentV> & elements() { spectrum_.invalidate(); return elements_; }
   viennacl::vector<NumericT, AlignmentV> const & elements() const { return elements_; }
 
+  /**
+    * @brief Returns the spectrum of the matrix, which is computed on first use and reused by all products until the entries are modified
+    *
+    * Modifications of the entries are detected through the non-const member functions, so references obtained from elements() must not be kept across products.
+    */
+  viennacl::detail::fft::circulant_spectrum<NumericT> const & spectrum() const
+  {
+    if (!spectrum_.valid())
+      spectrum_.setup(elements_);
+    return spectrum_;
+  }
+
   /**
     * @brief Returns the number of rows of the matrix
     */
@@ -118,6 +133,7 @@ public:
 
     while (index < 0)
       index += static_cast<long>(size1());
+    spectrum_.invalidate();
     return elements_[static_cast<vcl_size_t>(index)];
   }
 
@@ -130,6 +146,7 @@ public:
   circulant_matrix<NumericT, AlignmentV>& operator +=(circulant_matrix<NumericT, AlignmentV>& that)
   {
     elements_ += that.elements();
+    spectrum_.invalidate();
     return *this;
   }
 
@@ -138,6 +155,7 @@ private:
   circulant_matrix & operator=(circulant_matrix const & t);
 
   viennacl::vector<NumericT, AlignmentV> elements_;
+  mutable viennacl::detail::fft::circulant_spectrum<NumericT> spectrum_;
 };
 
 /** @brief Copies a circulant matrix from the std::vector to the OpenCL device (either GPU or multi-core CPU)
@@ -27,8 +27,12 @@
 
 #include "viennacl/linalg/fft_operations.hpp"
 #include "viennacl/traits/handle.hpp"
+#include "viennacl/tools/shared_ptr.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <complex>
+#include <vector>
 
 #include <stdexcept>
 /// @cond
@@ -45,6 +49,726 @@ namespace fft
 } //namespace fft
 } //namespace detail
 
+/**
+ * @brief A plan for repeated 1-D Fourier transformations of the same size and layout.
+ *
+ * The twiddle factors are computed once when the plan is created and reused by all transforms executed with the plan in main memory.
+ * Sizes with prime factors up to detail::fft::MAX_MIXED_RADIX are transformed with a mixed-radix Stockham algorithm,
+ * other sizes with Bluestein's algorithm, for which also the transformed chirp is precomputed.
+ * With OpenMP, large mixed-radix transforms (at least detail::fft::FOUR_STEP_MIN_SIZE points) in batches smaller than the number of threads
+ * use the six-step algorithm, so that also a single transform runs on all cores.
+ * The same plan serves forward and inverse transforms, the inverse transform uses the complex conjugate twiddle factors.
+ * For data in other memory domains the plan falls back to the generic transforms.
+ */
+template<class NumericT>
+class fft_plan
+{
+public:
+  typedef viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER  data_order_type;
+
+  /**
+   * @brief Creates the plan.
+   *
+   * @param size        Length of each transform
+   * @param batch_num   Number of transforms
+   * @param sign        Sign of exponent of the forward transform, default is -1.0
+   * @param data_order  ROW_MAJOR if the elements of each transform are contiguous, COL_MAJOR if the transforms are interleaved
+   * @param stride      Distance between consecutive transforms (ROW_MAJOR) or consecutive elements (COL_MAJOR) in complex numbers. Zero selects the densely packed layout.
+   */
+  explicit fft_plan(vcl_size_t size, vcl_size_t batch_num = 1, NumericT sign = NumericT(-1),
+                    data_order_type data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR,
+                    vcl_size_t stride = 0)
+    : size_(size), batch_num_(batch_num), sign_(sign), data_order_(data_order),
+      stride_(stride > 0 ? stride : (data_order ? batch_num : size))
+  {
+    if (size_ < 2)
+      return;
+
+    radices_ = viennacl::linalg::host_based::detail::fft::mixed_radix_factors(size_);
+    if (radices_.back() <= viennacl::linalg::host_based::detail::fft::MAX_MIXED_RADIX)
+    {
+      viennacl::linalg::host_based::detail::fft::stockham_twiddles(twiddles_, radices_, size_, sign_);
+#ifdef VIENNACL_WITH_OPENMP
+      if (size_ >= viennacl::linalg::host_based::detail::fft::FOUR_STEP_MIN_SIZE)
+        viennacl::linalg::host_based::detail::fft::setup_four_step(four_step_, size_, radices_, sign_);
+#endif
+    }
+    else
+    {
+      radices_.clear();
+      viennacl::linalg::host_based::detail::fft::setup_bluestein(bluestein_, size_, sign_);
+    }
+  }
+
+  /** @brief Returns the length of each transform */
+  vcl_size_t size() const { return size_; }
+  /** @brief Returns the number of transforms */
+  vcl_size_t batch_num() const { return batch_num_; }
+  /** @brief Returns the sign of the exponent of the forward transform */
+  NumericT sign() const { return sign_; }
+  /** @brief Returns the layout of the batch */
+  data_order_type data_order() const { return data_order_; }
+  /** @brief Returns the distance between consecutive transforms (ROW_MAJOR) or consecutive elements (COL_MAJOR) in complex numbers */
+  vcl_size_t stride() const { return stride_; }
+  /** @brief Returns the number of real values (twice the number of complex values) the data buffer must hold */
+  vcl_size_t buffer_size() const { return 2 * (data_order_ ? size_ * stride_ : batch_num_ * stride_); }
+  /** @brief Returns the radices of the mixed-radix transform. Empty if Bluestein's algorithm is used. */
+  std::vector<vcl_size_t> const & radices() const { return radices_; }
+
+  /** @brief Executes the transform in-place on interleaved complex data in main memory. Inverse transforms are normalized. */
+  void execute(NumericT * data, bool inverse = false) const
+  {
+    execute_strided(data, stride_, inverse);
+  }
+
+  /** @brief Same as execute(), but with a stride (in complex numbers) differing from the one the plan was created with. */
+  void execute_strided(NumericT * data, vcl_size_t stride, bool inverse) const
+  {
+    if (size_ < 2)
+      return;
+
+    NumericT scale = inverse ? NumericT(1) / NumericT(size_) : NumericT(1);
+#ifdef VIENNACL_WITH_OPENMP
+    // too few transforms to keep all threads busy: split each transform into sub-transforms
+    if (four_step_.n1 > 0 && batch_num_ < vcl_size_t(omp_get_max_threads()))
+      viennacl::linalg::host_based::fft_four_step_tables(data, size_, stride, batch_num_, four_step_, sign_, inverse, scale, data_order_);
+    else
+#endif
+    if (radices_.size() > 0)
+      viennacl::linalg::host_based::fft_stockham_tables(data, size_, stride, batch_num_, radices_, &twiddles_[0], sign_, inverse, scale, data_order_);
+    else
+      viennacl::linalg::host_based::fft_bluestein_tables(data, size_, stride, batch_num_, bluestein_, sign_, inverse, scale, data_order_);
+  }
+
+  /** @brief Executes the transform in-place on a vector holding interleaved complex data. Inverse transforms are normalized. */
+  template<unsigned int AlignmentV>
+  void execute(viennacl::vector<NumericT, AlignmentV> & data, bool inverse = false) const
+  {
+    assert(data.size() >= buffer_size() && bool("Vector too small for FFT plan"));
+
+    if (viennacl::traits::active_handle_id(data) == viennacl::MAIN_MEMORY)
+      execute(viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data), inverse);
+    else
+    {
+      NumericT sign = inverse ? -sign_ : sign_;
+      if (viennacl::detail::fft::is_radix2(size_))
+        viennacl::linalg::radix2(data, size_, stride_, batch_num_, sign, data_order_);
+      else
+      {
+        viennacl::vector<NumericT, AlignmentV> output(data.size(), viennacl::traits::context(data));
+        viennacl::linalg::direct(data, output, size_, stride_, batch_num_, sign, data_order_);
+        data = output;
+      }
+      if (inverse)
+        data *= NumericT(1) / NumericT(size_);
+    }
+  }
+
+private:
+  vcl_size_t      size_;
+  vcl_size_t      batch_num_;
+  NumericT        sign_;
+  data_order_type data_order_;
+  vcl_size_t      stride_;
+
+  std::vector<vcl_size_t>                                                 radices_;
+  std::vector<std::complex<NumericT> >                                    twiddles_;
+  viennacl::linalg::host_based::detail::fft::bluestein_tables<NumericT>   bluestein_;
+  viennacl::linalg::host_based::detail::fft::four_step_tables<NumericT>   four_step_;
+};
+
+namespace detail
+{
+namespace fft
+{
+  /** @brief Executes a plan on a vector of interleaved complex numbers. Vectors outside main memory are transferred to main memory. */
+  template<class PlanT, class NumericT, unsigned int AlignmentV>
+  void execute_on_host(PlanT const & plan, viennacl::vector<NumericT, AlignmentV> & data, bool inverse)
+  {
+    assert(data.size() >= plan.buffer_size() && bool("Vector too small for FFT plan"));
+
+    if (viennacl::traits::active_handle_id(data) == viennacl::MAIN_MEMORY)
+    {
+      plan.execute(viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data), inverse);
+      return;
+    }
+
+    std::vector<NumericT> host_data(plan.buffer_size());
+    viennacl::backend::memory_read(data.handle(), 0, sizeof(NumericT) * host_data.size(), &host_data[0]);
+    plan.execute(&host_data[0], inverse);
+    viennacl::backend::memory_write(data.handle(), 0, sizeof(NumericT) * host_data.size(), &host_data[0]);
+  }
+} //namespace fft
+} //namespace detail
+
+/**
+ * @brief A plan for repeated 2-D Fourier transformations of a stack of images.
+ *
+ * The images are stored consecutively as row-major arrays of rows x cols interleaved complex numbers.
+ * The rows of all images are transformed as one batch, the columns are transformed in panels of neighboring columns,
+ * which are gathered and scattered row by row, so that no explicit transposes of the images are required.
+ */
+template<class NumericT>
+class fft_plan_2d
+{
+public:
+  /**
+   * @brief Creates the plan.
+   *
+   * @param rows        Number of rows of each image
+   * @param cols        Number of columns of each image
+   * @param batch_num   Number of images
+   * @param sign        Sign of exponent of the forward transform, default is -1.0
+   */
+  fft_plan_2d(vcl_size_t rows, vcl_size_t cols, vcl_size_t batch_num = 1, NumericT sign = NumericT(-1))
+    : rows_(rows), cols_(cols), batch_num_(batch_num),
+      row_plan_(cols, rows * batch_num, sign),
+      col_plan_(rows, cols, sign, viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::COL_MAJOR, cols) {}
+
+  /** @brief Returns the number of rows of each image */
+  vcl_size_t rows() const { return rows_; }
+  /** @brief Returns the number of columns of each image */
+  vcl_size_t cols() const { return cols_; }
+  /** @brief Returns the number of images */
+  vcl_size_t batch_num() const { return batch_num_; }
+  /** @brief Returns the sign of the exponent of the forward transform */
+  NumericT sign() const { return row_plan_.sign(); }
+  /** @brief Returns the number of real values (twice the number of complex values) the data buffer must hold */
+  vcl_size_t buffer_size() const { return 2 * rows_ * cols_ * batch_num_; }
+
+  /** @brief Executes the transform in-place on interleaved complex data in main memory. Inverse transforms are normalized. */
+  void execute(NumericT * data, bool inverse = false) const
+  {
+    row_plan_.execute(data, inverse);
+    for (vcl_size_t b = 0; b < batch_num_; ++b)
+      col_plan_.execute(data + 2 * rows_ * cols_ * b, inverse);
+  }
+
+  /** @brief Executes the transform in-place on a vector holding interleaved complex data. Inverse transforms are normalized. */
+  template<unsigned int AlignmentV>
+  void execute(viennacl::vector<NumericT, AlignmentV> & data, bool inverse = false) const
+  {
+    viennacl::detail::fft::execute_on_host(*this, data, inverse);
+  }
+
+private:
+  vcl_size_t rows_;
+  vcl_size_t cols_;
+  vcl_size_t batch_num_;
+
+  fft_plan<NumericT> row_plan_;
+  fft_plan<NumericT> col_plan_;
+};
+
+/**
+ * @brief A plan for repeated 3-D Fourier transformations.
+ *
+ * The data is stored as flat row-major array of size0 x size1 x size2 interleaved complex numbers,
+ * i.e. the entry (i0, i1, i2) is located at the complex index (i0 * size1 + i1) * size2 + i2.
+ * The size1 x size2 slices are transformed as a batch of 2-D transforms (see fft_plan_2d),
+ * the transforms along the first dimension are computed in panels of neighboring transforms.
+ */
+template<class NumericT>
+class fft_plan_3d
+{
+public:
+  /**
+   * @brief Creates the plan.
+   *
+   * @param size0       Extent of the first (slowest varying) dimension
+   * @param size1       Extent of the second dimension
+   * @param size2       Extent of the third (contiguous) dimension
+   * @param sign        Sign of exponent of the forward transform, default is -1.0
+   */
+  fft_plan_3d(vcl_size_t size0, vcl_size_t size1, vcl_size_t size2, NumericT sign = NumericT(-1))
+    : slice_plan_(size1, size2, size0, sign),
+      plan0_(size0, size1 * size2, sign, viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::COL_MAJOR, size1 * size2) {}
+
+  /** @brief Returns the extent of the first (slowest varying) dimension */
+  vcl_size_t size0() const { return slice_plan_.batch_num(); }
+  /** @brief Returns the extent of the second dimension */
+  vcl_size_t size1() const { return slice_plan_.rows(); }
+  /** @brief Returns the extent of the third (contiguous) dimension */
+  vcl_size_t size2() const { return slice_plan_.cols(); }
+  /** @brief Returns the sign of the exponent of the forward transform */
+  NumericT sign() const { return slice_plan_.sign(); }
+  /** @brief Returns the number of real values (twice the number of complex values) the data buffer must hold */
+  vcl_size_t buffer_size() const { return slice_plan_.buffer_size(); }
+
+  /** @brief Executes the transform in-place on interleaved complex data in main memory. Inverse transforms are normalized. */
+  void execute(NumericT * data, bool inverse = false) const
+  {
+    slice_plan_.execute(data, inverse);
+    plan0_.execute(data, inverse);
+  }
+
+  /** @brief Executes the transform in-place on a vector holding interleaved complex data. Inverse transforms are normalized. */
+  template<unsigned int AlignmentV>
+  void execute(viennacl::vector<NumericT, AlignmentV> & data, bool inverse = false) const
+  {
+    viennacl::detail::fft::execute_on_host(*this, data, inverse);
+  }
+
+private:
+  fft_plan_2d<NumericT> slice_plan_;
+  fft_plan<NumericT>    plan0_;
+};
+
+/**
+ * @brief A plan for repeated 1-D Fourier transformations of real data (real-to-complex and complex-to-real).
+ *
+ * The forward transform maps real sequences of length size to the non-redundant half size/2 + 1 of their Hermitian spectrum,
+ * which is stored as interleaved complex numbers. The inverse transform maps such half spectra back to real sequences.
+ * For even sizes the real data is transformed as complex data of half length, which is post-processed to the spectrum,
+ * so that neither the memory nor the work for a complex transform of full length is needed.
+ * Odd sizes are transformed as complex data of full length.
+ */
+template<class NumericT>
+class fft_real_plan
+{
+public:
+  /**
+   * @brief Creates the plan.
+   *
+   * @param size        Length of each real transform
+   * @param batch_num   Number of transforms
+   * @param sign        Sign of exponent of the forward transform, default is -1.0
+   */
+  explicit fft_real_plan(vcl_size_t size, vcl_size_t batch_num = 1, NumericT sign = NumericT(-1))
+    : size_(size), batch_num_(batch_num), sign_(sign),
+      complex_plan_(size % 2 == 0 ? size / 2 : size, batch_num, sign)
+  {
+    if (size_ % 2 == 0)
+    {
+      double const NUM_PI = 3.14159265358979323846;
+      omega_.resize(size_ / 4 + 1);
+      for (vcl_size_t k = 0; k < omega_.size(); ++k)
+      {
+        double arg = double(sign_) * 2.0 * NUM_PI * double(k) / double(size_);
+        omega_[k] = std::complex<NumericT>(NumericT(std::cos(arg)), NumericT(std::sin(arg)));
+      }
+    }
+  }
+
+  /** @brief Returns the length of each real transform */
+  vcl_size_t size() const { return size_; }
+  /** @brief Returns the number of transforms */
+  vcl_size_t batch_num() const { return batch_num_; }
+  /** @brief Returns the sign of the exponent of the forward transform */
+  NumericT sign() const { return sign_; }
+  /** @brief Returns the number of complex numbers in each half spectrum, i.e. size/2 + 1 */
+  vcl_size_t spectrum_size() const { return size_ / 2 + 1; }
+
+  /**
+   * @brief Executes the transform on data in main memory.
+   *
+   * The forward transform reads real sequences from input and writes half spectra to output,
+   * the (normalized) inverse transform reads half spectra from input and writes real sequences to output.
+   * The input is not modified.
+   *
+   * @param input          Input data
+   * @param input_stride   Distance between consecutive transforms in the input in real numbers
+   * @param output         Output data
+   * @param output_stride  Distance between consecutive transforms in the output in real numbers. Must be even for transforms of even size.
+   * @param inverse        If true, the inverse transform is computed
+   */
+  void execute(NumericT const * input, vcl_size_t input_stride, NumericT * output, vcl_size_t output_stride, bool inverse = false) const
+  {
+    if (size_ == 0)
+      return;
+
+    if (size_ % 2 == 0)
+    {
+      // the output is transformed in-place as complex data of half length:
+      assert(output_stride % 2 == 0 && bool("Output stride must be even for real FFTs of even size"));
+      if (!inverse)
+      {
+        viennacl::linalg::host_based::fft_copy_batches(input, input_stride, output, output_stride, size_, batch_num_);
+        complex_plan_.execute_strided(output, output_stride / 2, false);
+        viennacl::linalg::host_based::fft_real_postprocess(output, size_, output_stride, batch_num_, &omega_[0]);
+      }
+      else
+      {
+        viennacl::linalg::host_based::fft_real_preprocess(input, input_stride, output, output_stride, size_, batch_num_, &omega_[0]);
+        complex_plan_.execute_strided(output, output_stride / 2, true);
+      }
+      return;
+    }
+
+    // odd sizes: complex transform of full length
+    vcl_size_t half = spectrum_size();
+    std::vector<NumericT> work(2 * size_ * batch_num_);
+    for (vcl_size_t b = 0; b < batch_num_; ++b)
+    {
+      NumericT const * in = input + b * input_stride;
+      NumericT * w = &work[2 * size_ * b];
+      if (!inverse)
+        for (vcl_size_t i = 0; i < size_; ++i)
+        {
+          w[2*i]   = in[i];
+          w[2*i+1] = 0;
+        }
+      else
+        for (vcl_size_t i = 0; i < size_; ++i)
+        {
+          vcl_size_t k = (i < half) ? i : size_ - i;
+          w[2*i]   = in[2*k];
+          w[2*i+1] = (i < half) ? in[2*k+1] : -in[2*k+1];
+        }
+    }
+    complex_plan_.execute(&work[0], inverse);
+    for (vcl_size_t b = 0; b < batch_num_; ++b)
+    {
+      NumericT * out = output + b * output_stride;
+      NumericT const * w = &work[2 * size_ * b];
+      if (!inverse)
+        for (vcl_size_t i = 0; i < 2 * half; ++i)
+          out[i] = w[i];
+      else
+        for (vcl_size_t i = 0; i < size_; ++i)
+          out[i] = w[2*i];
+    }
+  }
+
+private:
+  vcl_size_t      size_;
+  vcl_size_t      batch_num_;
+  NumericT        sign_;
+
+  fft_plan<NumericT>                   complex_plan_;
+  std::vector<std::complex<NumericT> > omega_;
+};
+
+namespace detail
+{
+namespace fft
+{
+  /** @brief Executes a real transform on (possibly non-host) buffers, which are accessed via their handles. Buffers outside main memory are transferred to main memory. */
+  template<class NumericT>
+  void execute_real(viennacl::backend::mem_handle const & input,  vcl_size_t input_start,  vcl_size_t input_stride,
+                    viennacl::backend::mem_handle       & output, vcl_size_t output_start, vcl_size_t output_stride,
+                    fft_real_plan<NumericT> const & plan, bool inverse)
+  {
+    vcl_size_t input_size  = input_stride  * (plan.batch_num() - 1) + (inverse ? 2 * plan.spectrum_size() : plan.size());
+    vcl_size_t output_size = output_stride * (plan.batch_num() - 1) + (inverse ? plan.size() : 2 * plan.spectrum_size());
+
+    if (input.get_active_handle_id() == viennacl::MAIN_MEMORY && output.get_active_handle_id() == viennacl::MAIN_MEMORY)
+    {
+      NumericT const * in  = reinterpret_cast<NumericT const *>(input.ram_handle().get()) + input_start;
+      NumericT       * out = reinterpret_cast<NumericT *>(output.ram_handle().get()) + output_start;
+      if (in + input_size > out && out + output_size > in)  // overlapping buffers
+      {
+        std::vector<NumericT> in_copy(in, in + input_size);
+        plan.execute(&in_copy[0], input_stride, out, output_stride, inverse);
+      }
+      else
+        plan.execute(in, input_stride, out, output_stride, inverse);
+      return;
+    }
+
+    std::vector<NumericT> in_host(input_size);
+    std::vector<NumericT> out_host(output_size);
+    viennacl::backend::memory_read(input,   sizeof(NumericT) * input_start,  sizeof(NumericT) * input_size,  &in_host[0]);
+    viennacl::backend::memory_read(output,  sizeof(NumericT) * output_start, sizeof(NumericT) * output_size, &out_host[0]);  // preserve padding
+    plan.execute(&in_host[0], input_stride, &out_host[0], output_stride, inverse);
+    viennacl::backend::memory_write(output, sizeof(NumericT) * output_start, sizeof(NumericT) * output_size, &out_host[0]);
+  }
+
+  /** @brief Transforms the columns of a row-major matrix of interleaved complex numbers. Inverse transforms are normalized. */
+  template<class NumericT, unsigned int AlignmentV>
+  void column_fft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> & mat, NumericT sign, bool inverse)
+  {
+    vcl_size_t rows_num = mat.size1();
+    vcl_size_t cols_num = mat.size2() >> 1;
+    vcl_size_t cols_int = mat.internal_size2() >> 1;
+
+    if (viennacl::traits::active_handle_id(mat) == viennacl::MAIN_MEMORY)
+    {
+      fft_plan<NumericT>(rows_num, cols_num, sign, viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::COL_MAJOR, cols_int)
+        .execute(viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(mat), inverse);
+      return;
+    }
+
+    if (inverse)
+      sign = -sign;
+    if (is_radix2(rows_num))
+      viennacl::linalg::radix2(mat, rows_num, cols_int, cols_num, sign,
+                               viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::COL_MAJOR);
+    else
+    {
+      viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> tmp(mat);
+      viennacl::linalg::direct(tmp, mat, rows_num, cols_int, cols_num, sign,
+                               viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::COL_MAJOR);
+    }
+    if (inverse)
+      mat *= NumericT(1) / NumericT(rows_num);
+  }
+} //namespace fft
+} //namespace detail
+
+/**
+ * @brief Inplace version of 1-D Fourier transformation using a precomputed plan.
+ *
+ * @param input       Input vector, result will be stored here.
+ * @param plan        Plan matching the size and layout of input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void inplace_fft(viennacl::vector<NumericT, AlignmentV>& input, fft_plan<NumericT> const & plan)
+{
+  plan.execute(input);
+}
+
+/**
+ * @brief 1-D Fourier transformation using a precomputed plan.
+ *
+ * @param input       Input vector.
+ * @param output      Output vector.
+ * @param plan        Plan matching the size and layout of input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void fft(viennacl::vector<NumericT, AlignmentV> const & input,
+         viennacl::vector<NumericT, AlignmentV>       & output, fft_plan<NumericT> const & plan)
+{
+  if (&input != &output)
+    output = input;
+  plan.execute(output);
+}
+
+/**
+ * @brief Inplace version of inverse 1-D Fourier transformation using a precomputed plan.
+ *
+ * The same plan as for the forward transform is used, the result is normalized.
+ *
+ * @param input       Input vector, result will be stored here.
+ * @param plan        Plan matching the size and layout of input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void inplace_ifft(viennacl::vector<NumericT, AlignmentV>& input, fft_plan<NumericT> const & plan)
+{
+  plan.execute(input, true);
+}
+
+/**
+ * @brief Inverse 1-D Fourier transformation using a precomputed plan.
+ *
+ * @param input       Input vector.
+ * @param output      Output vector.
+ * @param plan        Plan matching the size and layout of input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void ifft(viennacl::vector<NumericT, AlignmentV> const & input,
+          viennacl::vector<NumericT, AlignmentV>       & output, fft_plan<NumericT> const & plan)
+{
+  if (&input != &output)
+    output = input;
+  plan.execute(output, true);
+}
+
+/**
+ * @brief Inplace version of 2-D Fourier transformation using a precomputed plan.
+ *
+ * @param input       Input vector, result will be stored here.
+ * @param plan        Plan matching the image sizes and the number of images in input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void inplace_fft(viennacl::vector<NumericT, AlignmentV>& input, fft_plan_2d<NumericT> const & plan)
+{
+  plan.execute(input);
+}
+
+/**
+ * @brief 2-D Fourier transformation using a precomputed plan.
+ *
+ * @param input       Input vector.
+ * @param output      Output vector.
+ * @param plan        Plan matching the image sizes and the number of images in input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void fft(viennacl::vector<NumericT, AlignmentV> const & input,
+         viennacl::vector<NumericT, AlignmentV>       & output, fft_plan_2d<NumericT> const & plan)
+{
+  if (&input != &output)
+    output = input;
+  plan.execute(output);
+}
+
+/**
+ * @brief Inplace version of inverse 2-D Fourier transformation using a precomputed plan. The result is normalized.
+ *
+ * @param input       Input vector, result will be stored here.
+ * @param plan        Plan matching the image sizes and the number of images in input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void inplace_ifft(viennacl::vector<NumericT, AlignmentV>& input, fft_plan_2d<NumericT> const & plan)
+{
+  plan.execute(input, true);
+}
+
+/**
+ * @brief Inverse 2-D Fourier transformation using a precomputed plan. The result is normalized.
+ *
+ * @param input       Input vector.
+ * @param output      Output vector.
+ * @param plan        Plan matching the image sizes and the number of images in input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void ifft(viennacl::vector<NumericT, AlignmentV> const & input,
+          viennacl::vector<NumericT, AlignmentV>       & output, fft_plan_2d<NumericT> const & plan)
+{
+  if (&input != &output)
+    output = input;
+  plan.execute(output, true);
+}
+
+/**
+ * @brief Inplace version of 3-D Fourier transformation using a precomputed plan.
+ *
+ * @param input       Input vector, result will be stored here.
+ * @param plan        Plan matching the extents of input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void inplace_fft(viennacl::vector<NumericT, AlignmentV>& input, fft_plan_3d<NumericT> const & plan)
+{
+  plan.execute(input);
+}
+
+/**
+ * @brief 3-D Fourier transformation using a precomputed plan.
+ *
+ * @param input       Input vector.
+ * @param output      Output vector.
+ * @param plan        Plan matching the extents of input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void fft(viennacl::vector<NumericT, AlignmentV> const & input,
+         viennacl::vector<NumericT, AlignmentV>       & output, fft_plan_3d<NumericT> const & plan)
+{
+  if (&input != &output)
+    output = input;
+  plan.execute(output);
+}
+
+/**
+ * @brief Inplace version of inverse 3-D Fourier transformation using a precomputed plan. The result is normalized.
+ *
+ * @param input       Input vector, result will be stored here.
+ * @param plan        Plan matching the extents of input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void inplace_ifft(viennacl::vector<NumericT, AlignmentV>& input, fft_plan_3d<NumericT> const & plan)
+{
+  plan.execute(input, true);
+}
+
+/**
+ * @brief Inverse 3-D Fourier transformation using a precomputed plan. The result is normalized.
+ *
+ * @param input       Input vector.
+ * @param output      Output vector.
+ * @param plan        Plan matching the extents of input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void ifft(viennacl::vector<NumericT, AlignmentV> const & input,
+          viennacl::vector<NumericT, AlignmentV>       & output, fft_plan_3d<NumericT> const & plan)
+{
+  if (&input != &output)
+    output = input;
+  plan.execute(output, true);
+}
+
+/**
+ * @brief 1-D Fourier transformation of real data using a precomputed plan.
+ *
+ * The output holds the non-redundant part of the spectrum of each transform, i.e. plan.spectrum_size() interleaved complex numbers.
+ *
+ * @param input       Input vector with plan.batch_num() real sequences of length plan.size()
+ * @param output      Output vector, resized to hold the half spectra if necessary
+ * @param plan        Plan for real transforms matching the size of input
+ */
+template<class NumericT, unsigned int AlignmentV>
+void fft(viennacl::vector<NumericT, AlignmentV> const & input,
+         viennacl::vector<NumericT, AlignmentV>       & output, fft_real_plan<NumericT> const & plan)
+{
+  assert(input.size() >= plan.size() * plan.batch_num() && bool("Input vector too small for FFT plan"));
+
+  vcl_size_t output_size = 2 * plan.spectrum_size() * plan.batch_num();
+  if (output.size() != output_size)
+    output.resize(output_size, false);
+
+  viennacl::detail::fft::execute_real(input.handle(), input.start(), plan.size(),
+                                      output.handle(), output.start(), 2 * plan.spectrum_size(), plan, false);
+}
+
+/**
+ * @brief Inverse 1-D Fourier transformation to real data using a precomputed plan.
+ *
+ * The input holds the non-redundant parts of Hermitian spectra as computed by the real forward transform, the result is normalized.
+ *
+ * @param input       Input vector with plan.batch_num() half spectra of plan.spectrum_size() complex numbers
+ * @param output      Output vector, resized to hold the real sequences if necessary
+ * @param plan        Plan for real transforms
+ */
+template<class NumericT, unsigned int AlignmentV>
+void ifft(viennacl::vector<NumericT, AlignmentV> const & input,
+          viennacl::vector<NumericT, AlignmentV>       & output, fft_real_plan<NumericT> const & plan)
+{
+  assert(input.size() >= 2 * plan.spectrum_size() * plan.batch_num() && bool("Input vector too small for FFT plan"));
+
+  vcl_size_t output_size = plan.size() * plan.batch_num();
+  if (output.size() != output_size)
+    output.resize(output_size, false);
+
+  viennacl::detail::fft::execute_real(input.handle(), input.start(), 2 * plan.spectrum_size(),
+                                      output.handle(), output.start(), plan.size(), plan, true);
+}
+
+/**
+ * @brief 2-D Fourier transformation of a real matrix using a precomputed plan for the rows.
+ *
+ * The output holds the non-redundant part of the spectrum, i.e. input.size1() rows with plan.spectrum_size() interleaved complex numbers each.
+ *
+ * @param input       Input matrix with real entries
+ * @param output      Output matrix, resized to hold the half spectrum if necessary
+ * @param plan        Plan for real transforms of length input.size2() in batches of input.size1()
+ */
+template<class NumericT, unsigned int AlignmentV>
+void fft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const & input,
+         viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>       & output, fft_real_plan<NumericT> const & plan)
+{
+  assert(input.size2() == plan.size() && input.size1() == plan.batch_num() && bool("Matrix size does not match FFT plan"));
+
+  if (output.size1() != input.size1() || output.size2() != 2 * plan.spectrum_size())
+    output.resize(input.size1(), 2 * plan.spectrum_size(), false);
+
+  viennacl::detail::fft::execute_real(input.handle(), 0, input.internal_size2(),
+                                      output.handle(), 0, output.internal_size2(), plan, false);
+  viennacl::detail::fft::column_fft(output, plan.sign(), false);
+}
+
+/**
+ * @brief Inverse 2-D Fourier transformation to a real matrix using a precomputed plan for the rows.
+ *
+ * The input holds the non-redundant part of the spectrum as computed by the real forward transform, the result is normalized.
+ *
+ * @param input       Input matrix with plan.batch_num() rows of plan.spectrum_size() complex numbers
+ * @param output      Output matrix, resized to plan.batch_num() rows and plan.size() columns if necessary
+ * @param plan        Plan for real transforms
+ */
+template<class NumericT, unsigned int AlignmentV>
+void ifft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const & input,
+          viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>       & output, fft_real_plan<NumericT> const & plan)
+{
+  assert(input.size2() == 2 * plan.spectrum_size() && input.size1() == plan.batch_num() && bool("Matrix size does not match FFT plan"));
+
+  if (output.size1() != input.size1() || output.size2() != plan.size())
+    output.resize(input.size1(), plan.size(), false);
+
+  viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> tmp(input);
+  viennacl::detail::fft::column_fft(tmp, plan.sign(), true);
+  viennacl::detail::fft::execute_real(tmp.handle(), 0, tmp.internal_size2(),
+                                      output.handle(), 0, output.internal_size2(), plan, true);
+}
+
 /**
  * @brief Generic inplace version of 1-D Fourier transformation.
  *
@@ -58,7 +782,9 @@ void inplace_fft(viennacl::vector<NumericT, AlignmentV>& input, vcl_size_t batch
 {
   vcl_size_t size = (input.size() >> 1) / batch_num;
 
-  if (!viennacl::detail::fft::is_radix2(size))
+  if (viennacl::traits::active_handle_id(input) == viennacl::MAIN_MEMORY)
+    fft_plan<NumericT>(size, batch_num, sign).execute(input);
+  else if (!viennacl::detail::fft::is_radix2(size))
   {
     viennacl::vector<NumericT, AlignmentV> output(input.size());
     viennacl::linalg::direct(input, output, size, size, batch_num, sign);
@@ -81,7 +807,12 @@ void fft(viennacl::vector<NumericT, AlignmentV>& input,
          viennacl::vector<NumericT, AlignmentV>& output, vcl_size_t batch_num = 1, NumericT sign = -1.0)
 {
   vcl_size_t size = (input.size() >> 1) / batch_num;
-  if (viennacl::detail::fft::is_radix2(size))
+  if (viennacl::traits::active_handle_id(input) == viennacl::MAIN_MEMORY)
+  {
+    viennacl::copy(input, output);
+    fft_plan<NumericT>(size, batch_num, sign).execute(output);
+  }
+  else if (viennacl::detail::fft::is_radix2(size))
   {
     viennacl::copy(input, output);
     viennacl::linalg::radix2(output, size, size, batch_num, sign);
@@ -105,6 +836,14 @@ void inplace_fft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>& in
 
   vcl_size_t cols_int = input.internal_size2() >> 1;
 
+  if (viennacl::traits::active_handle_id(input) == viennacl::MAIN_MEMORY)
+  {
+    NumericT * data = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(input);
+    fft_plan<NumericT>(cols_num, rows_num, sign, viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR, cols_int).execute(data);
+    fft_plan<NumericT>(rows_num, cols_num, sign, viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::COL_MAJOR, cols_int).execute(data);
+    return;
+  }
+
   // batch with rows
   if (viennacl::detail::fft::is_radix2(cols_num))
     viennacl::linalg::radix2(input, cols_num, cols_int, rows_num, sign,
@@ -145,14 +884,21 @@ void inplace_fft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>& in
  * @param sign       Sign of exponent, default is -1.0
  */
 template<class NumericT, unsigned int AlignmentV>
-void fft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>& input, //TODO
-         viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>& output, NumericT sign = -1.0)
+void fft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const & input,
+         viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>       & output, NumericT sign = -1.0)
 {
 
   vcl_size_t rows_num = input.size1();
   vcl_size_t cols_num = input.size2() >> 1;
   vcl_size_t cols_int = input.internal_size2() >> 1;
 
+  if (viennacl::traits::active_handle_id(input) == viennacl::MAIN_MEMORY)
+  {
+    output = input;
+    viennacl::inplace_fft(output, sign);
+    return;
+  }
+
   // batch with rows
   if (viennacl::detail::fft::is_radix2(cols_num))
   {
@@ -166,18 +912,13 @@ void fft(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>& input, //T
 
   // batch with cols
   if (viennacl::detail::fft::is_radix2(rows_num))
-  {
-    //std::cout<<"output"<<output<<std::endl;
-
     viennacl::linalg::radix2(output, rows_num, cols_int, cols_num, sign,
                              viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::COL_MAJOR);
-  }
   else
   {
     viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> tmp(output.size1(),
                                                                     output.size2());
     tmp = output;
-    //std::cout<<"tmp"<<tmp<<std::endl;
     viennacl::linalg::direct(tmp, output, rows_num, cols_int, cols_num, sign,
                              viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::COL_MAJOR);
   }
@@ -217,6 +958,160 @@ void ifft(viennacl::vector<NumericT, AlignmentV>& input,
   viennacl::linalg::normalize(output);
 }
 
+namespace detail
+{
+namespace fft
+{
+  /**
+   * @brief The cached spectrum of a real circulant matrix, which is given by its first column (the generator).
+   *
+   * Used by the structured matrices (circulant, Toeplitz, Hankel), so that products only require one forward and one inverse FFT of the vector.
+   * In main memory the half spectrum computed by a real FFT plan is stored on the host, otherwise the full complex spectrum is kept in the memory domain of the generator.
+   */
+  template<class NumericT>
+  class circulant_spectrum
+  {
+  public:
+    circulant_spectrum() : size_(0), valid_(false) {}
+
+    /** @brief Returns true if the spectrum has been computed and the generator has not been modified since. */
+    bool valid() const { return valid_; }
+    /** @brief Marks the spectrum as outdated, e.g. after the generator has been modified */
+    void invalidate() { valid_ = false; }
+
+    /** @brief Computes the spectrum of the circulant matrix with the given first column */
+    template<unsigned int AlignmentV>
+    void setup(viennacl::vector<NumericT, AlignmentV> const & generator)
+    {
+      size_ = generator.size();
+      memory_type_ = viennacl::traits::active_handle_id(generator);
+
+      if (memory_type_ == viennacl::MAIN_MEMORY)
+      {
+        plan_ = viennacl::tools::shared_ptr<fft_real_plan<NumericT> >(new fft_real_plan<NumericT>(size_));
+        host_spectrum_.resize(2 * plan_->spectrum_size());
+        plan_->execute(viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(generator), size_,
+                       &host_spectrum_[0], host_spectrum_.size());
+      }
+      else
+      {
+        device_spectrum_ = viennacl::vector<NumericT>(2 * size_, viennacl::traits::context(generator));
+        viennacl::linalg::real_to_complex(generator, device_spectrum_, size_);
+        viennacl::inplace_fft(device_spectrum_);
+      }
+      valid_ = true;
+    }
+
+    /** @brief Computes the first y.size() entries of the product of the circulant matrix with x, padded by zeros to the size of the generator */
+    void apply(viennacl::vector_base<NumericT> const & x, viennacl::vector_base<NumericT> & y) const
+    {
+      assert(valid_ && bool("Spectrum not set up"));
+      assert(x.size() <= size_ && y.size() <= size_ && bool("Size mismatch"));
+
+      if (memory_type_ == viennacl::MAIN_MEMORY && viennacl::traits::active_handle_id(x) == viennacl::MAIN_MEMORY)
+      {
+        apply(viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(x) + x.start(), x.stride(), x.size(),
+              viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(y) + y.start(), y.stride(), y.size());
+        return;
+      }
+
+      viennacl::vector<NumericT> tmp = viennacl::zero_vector<NumericT>(size_, viennacl::traits::context(x));
+      viennacl::project(tmp, viennacl::range(0, x.size())) = x;
+
+      viennacl::vector<NumericT> tmp2(2 * size_, viennacl::traits::context(x));
+      viennacl::vector<NumericT> tmp3(2 * size_, viennacl::traits::context(x));
+      viennacl::linalg::real_to_complex(tmp, tmp2, size_);
+      viennacl::inplace_fft(tmp2);
+      if (memory_type_ == viennacl::MAIN_MEMORY)
+      {
+        // spectrum on the host, but vectors in another memory domain (rare): transfer the full spectrum
+        std::vector<NumericT> full(2 * size_);
+        for (vcl_size_t k = 0; k < size_; ++k)
+        {
+          vcl_size_t kk = (2 * k <= size_) ? k : size_ - k;
+          full[2*k]   = host_spectrum_[2*kk];
+          full[2*k+1] = (2 * k <= size_) ? host_spectrum_[2*kk+1] : -host_spectrum_[2*kk+1];
+        }
+        viennacl::vector<NumericT> spectrum(2 * size_, viennacl::traits::context(x));
+        viennacl::copy(full, spectrum);
+        viennacl::linalg::multiply_complex(tmp2, spectrum, tmp3);
+      }
+      else
+        viennacl::linalg::multiply_complex(tmp2, device_spectrum_, tmp3);
+      viennacl::inplace_ifft(tmp3);
+      viennacl::linalg::complex_to_real(tmp3, tmp, size_);
+      y = viennacl::project(tmp, viennacl::range(0, y.size()));
+    }
+
+    /** @brief Same as apply() for vectors in main memory, given by pointer, increment and size. Can be called concurrently from several threads. */
+    void apply(NumericT const * x, vcl_size_t x_inc, vcl_size_t x_size,
+               NumericT       * y, vcl_size_t y_inc, vcl_size_t y_size) const
+    {
+      std::vector<NumericT> work(size_);
+      std::vector<NumericT> spectrum(host_spectrum_.size());
+      for (vcl_size_t i = 0; i < x_size; ++i)
+        work[i] = x[i * x_inc];
+
+      plan_->execute(&work[0], size_, &spectrum[0], spectrum.size());
+      for (vcl_size_t k = 0; k < spectrum.size(); k += 2)
+      {
+        NumericT a_r = spectrum[k],        a_i = spectrum[k+1];
+        NumericT b_r = host_spectrum_[k],  b_i = host_spectrum_[k+1];
+        spectrum[k]   = a_r * b_r - a_i * b_i;
+        spectrum[k+1] = a_r * b_i + a_i * b_r;
+      }
+      plan_->execute(&spectrum[0], spectrum.size(), &work[0], size_, true);
+
+      for (vcl_size_t i = 0; i < y_size; ++i)
+        y[i * y_inc] = work[i];
+    }
+
+    /** @brief Computes the products with all columns of X (see apply() for vectors) and writes them to the columns of Y */
+    void apply(viennacl::matrix_base<NumericT> const & X, viennacl::matrix_base<NumericT> & Y) const
+    {
+      assert(X.size2() == Y.size2() && bool("Size mismatch"));
+
+      vcl_size_t x_inc = X.row_major() ? X.stride1() * X.internal_size2() : X.stride1();
+      vcl_size_t y_inc = Y.row_major() ? Y.stride1() * Y.internal_size2() : Y.stride1();
+      vcl_size_t x_col = X.row_major() ? X.stride2() : X.stride2() * X.internal_size1();
+      vcl_size_t y_col = Y.row_major() ? Y.stride2() : Y.stride2() * Y.internal_size1();
+      vcl_size_t x_start = X.row_major() ? X.start1() * X.internal_size2() + X.start2() : X.start1() + X.start2() * X.internal_size1();
+      vcl_size_t y_start = Y.row_major() ? Y.start1() * Y.internal_size2() + Y.start2() : Y.start1() + Y.start2() * Y.internal_size1();
+
+      if (memory_type_ == viennacl::MAIN_MEMORY && viennacl::traits::active_handle_id(X) == viennacl::MAIN_MEMORY)
+      {
+        NumericT const * x = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(X) + x_start;
+        NumericT       * y = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(Y) + y_start;
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (X.size2() > 1)
+#endif
+        for (long j2 = 0; j2 < long(X.size2()); ++j2)
+        {
+          vcl_size_t j = vcl_size_t(j2);
+          apply(x + j * x_col, x_inc, X.size1(), y + j * y_col, y_inc, Y.size1());
+        }
+        return;
+      }
+
+      for (vcl_size_t j = 0; j < X.size2(); ++j)
+      {
+        viennacl::vector_base<NumericT> x_j(const_cast<viennacl::backend::mem_handle &>(X.handle()), X.size1(), x_start + j * x_col, x_inc);
+        viennacl::vector_base<NumericT> y_j(Y.handle(), Y.size1(), y_start + j * y_col, y_inc);
+        apply(x_j, y_j);
+      }
+    }
+
+  private:
+    vcl_size_t                                                  size_;
+    bool                                                        valid_;
+    viennacl::memory_types                                      memory_type_;
+    viennacl::tools::shared_ptr<fft_real_plan<NumericT> >       plan_;
+    std::vector<NumericT>                                       host_spectrum_;
+    viennacl::vector<NumericT>                                  device_spectrum_;
+  };
+} //namespace fft
+} //namespace detail
+
 namespace linalg
 {
   /**
@@ -275,6 +1170,199 @@ namespace linalg
 
     viennacl::inplace_ifft(output);
   }
+
+  /**
+   * @brief 1-D convolution of two vectors using a precomputed plan.
+   *
+   * This function does not make any changes to input vectors
+   *
+   * @param input1     Input vector #1.
+   * @param input2     Input vector #2.
+   * @param output     Output vector.
+   * @param plan       Plan matching the size of the input vectors
+   */
+  template<class NumericT, unsigned int AlignmentV>
+  void convolve(viennacl::vector<NumericT, AlignmentV> const & input1,
+                viennacl::vector<NumericT, AlignmentV> const & input2,
+                viennacl::vector<NumericT, AlignmentV>       & output,
+                viennacl::fft_plan<NumericT> const & plan)
+  {
+    assert(input1.size() == input2.size());
+    assert(input1.size() == output.size());
+
+    viennacl::vector<NumericT, AlignmentV> tmp1(input1);
+    viennacl::vector<NumericT, AlignmentV> tmp2(input2);
+    plan.execute(tmp1);
+    plan.execute(tmp2);
+
+    viennacl::linalg::multiply_complex(tmp1, tmp2, output);
+    plan.execute(output, true);
+  }
+
+  /** @brief The block convolution methods of streaming_convolution */
+  enum streaming_convolution_method
+  {
+    OVERLAP_SAVE,
+    OVERLAP_ADD
+  };
+
+  /**
+   * @brief Streaming FFT-based convolution of a long (or unbounded) real signal with a short real filter.
+   *
+   * Samples are pushed incrementally and collected in blocks of block_size() samples. Each complete block is convolved
+   * with the filter by real FFTs of length fft_size() = block_size() + filter length - 1 with the overlap-save or the overlap-add method,
+   * where the spectrum of the filter is computed once on construction. Hence, the memory is constant and the cost per sample is
+   * O(log(fft_size())). The output is the linear convolution of the signal with the filter, delayed by up to one block:
+   * Each completed block yields block_size() output samples, flush() emits the remaining samples including the tail of the filter.
+   *
+   * Example:
+   * \code
+   *   viennacl::linalg::streaming_convolution<double> conv(filter);
+   *   std::vector<double> out;
+   *   conv.push(samples, out);   // repeatedly, out grows by multiples of conv.block_size()
+   *   conv.flush(out);           // out now holds samples.size() + filter.size() - 1 values in total
+   * \endcode
+   */
+  template<class NumericT>
+  class streaming_convolution
+  {
+  public:
+    /**
+     * @brief Sets up the convolution with the given filter.
+     *
+     * @param filter      Filter coefficients (impulse response)
+     * @param block_size  Number of input samples per block. Zero selects a block size of about seven times the filter length.
+     * @param method      OVERLAP_SAVE or OVERLAP_ADD
+     */
+    explicit streaming_convolution(std::vector<NumericT> const & filter, vcl_size_t block_size = 0,
+                                   streaming_convolution_method method = OVERLAP_SAVE)
+      : filter_size_(filter.size()), method_(method),
+        fft_size_(choose_fft_size(filter.size(), block_size)),
+        block_size_(fft_size_ - filter_size_ + 1),
+        plan_(fft_size_),
+        filter_spectrum_(2 * plan_.spectrum_size()),
+        spectrum_(2 * plan_.spectrum_size()),
+        input_(fft_size_),
+        output_(fft_size_),
+        tail_(filter_size_ - 1),
+        pending_(0)
+    {
+      assert(filter.size() > 0 && bool("Filter must not be empty"));
+
+      std::vector<NumericT> padded(fft_size_);
+      std::copy(filter.begin(), filter.end(), padded.begin());
+      plan_.execute(&padded[0], fft_size_, &filter_spectrum_[0], filter_spectrum_.size());
+    }
+
+    /** @brief Returns the number of input samples per block */
+    vcl_size_t block_size() const { return block_size_; }
+    /** @brief Returns the length of the FFTs */
+    vcl_size_t fft_size() const { return fft_size_; }
+    /** @brief Returns the number of coefficients of the filter */
+    vcl_size_t filter_size() const { return filter_size_; }
+    /** @brief Returns the number of pushed samples which have not been processed yet */
+    vcl_size_t pending() const { return pending_; }
+
+    /** @brief Pushes count samples. The output of all blocks completed by the new samples is appended to output. */
+    void push(NumericT const * samples, vcl_size_t count, std::vector<NumericT> & output)
+    {
+      vcl_size_t offset = (method_ == OVERLAP_SAVE) ? filter_size_ - 1 : 0;
+      while (count > 0)
+      {
+        vcl_size_t n = std::min(count, block_size_ - pending_);
+        std::copy(samples, samples + n, input_.begin() + long(offset + pending_));
+        pending_ += n;
+        samples  += n;
+        count    -= n;
+        if (pending_ == block_size_)
+          process_block(output);
+      }
+    }
+
+    /** @brief Pushes the samples. The output of all blocks completed by the new samples is appended to output. */
+    void push(std::vector<NumericT> const & samples, std::vector<NumericT> & output)
+    {
+      if (samples.size() > 0)
+        push(&samples[0], samples.size(), output);
+    }
+
+    /** @brief Ends the signal: Appends the output for the pending samples and the tail of the filter to output and resets the convolution. */
+    void flush(std::vector<NumericT> & output)
+    {
+      vcl_size_t remaining = pending_ + filter_size_ - 1;
+      vcl_size_t target = output.size() + remaining;
+      std::vector<NumericT> zeros(block_size_);
+      while (output.size() < target)
+        push(&zeros[0], block_size_ - pending_, output);
+      output.resize(target);
+      reset();
+    }
+
+    /** @brief Discards all pending samples and the history, so that a new signal can be processed */
+    void reset()
+    {
+      std::fill(input_.begin(), input_.end(), NumericT(0));
+      std::fill(tail_.begin(), tail_.end(), NumericT(0));
+      pending_ = 0;
+    }
+
+  private:
+    static vcl_size_t choose_fft_size(vcl_size_t filter_size, vcl_size_t block_size)
+    {
+      vcl_size_t n = 64;
+      if (block_size > 0)
+        n = block_size + filter_size - 1;
+      else
+        while (n < 8 * filter_size)
+          n *= 2;
+      return n + n % 2;  // even sizes use the half-length real transform
+    }
+
+    void process_block(std::vector<NumericT> & output)
+    {
+      if (method_ == OVERLAP_ADD)
+        std::fill(input_.begin() + long(block_size_), input_.end(), NumericT(0));
+
+      plan_.execute(&input_[0], fft_size_, &spectrum_[0], spectrum_.size());
+      for (vcl_size_t k = 0; k < spectrum_.size(); k += 2)
+      {
+        NumericT a_r = spectrum_[k],         a_i = spectrum_[k+1];
+        NumericT b_r = filter_spectrum_[k],  b_i = filter_spectrum_[k+1];
+        spectrum_[k]   = a_r * b_r - a_i * b_i;
+        spectrum_[k+1] = a_r * b_i + a_i * b_r;
+      }
+      plan_.execute(&spectrum_[0], spectrum_.size(), &output_[0], fft_size_, true);
+
+      vcl_size_t history = filter_size_ - 1;
+      if (method_ == OVERLAP_SAVE)
+      {
+        // the first filter_size - 1 outputs are aliased, the last samples of the block are the history of the next block
+        output.insert(output.end(), output_.begin() + long(history), output_.end());
+        std::copy(input_.end() - long(history), input_.end(), input_.begin());
+      }
+      else
+      {
+        // add the tail of the previous block, keep the tail of this block
+        for (vcl_size_t i = 0; i < history; ++i)
+          output_[i] += tail_[i];
+        output.insert(output.end(), output_.begin(), output_.begin() + long(block_size_));
+        std::copy(output_.begin() + long(block_size_), output_.end(), tail_.begin());
+      }
+      pending_ = 0;
+    }
+
+    vcl_size_t                         filter_size_;
+    streaming_convolution_method       method_;
+    vcl_size_t                         fft_size_;
+    vcl_size_t                         block_size_;
+    viennacl::fft_real_plan<NumericT>  plan_;
+    std::vector<NumericT>              filter_spectrum_;
+    std::vector<NumericT>              spectrum_;
+    std::vector<NumericT>              input_;
+    std::vector<NumericT>              output_;
+    std::vector<NumericT>              tail_;
+    vcl_size_t                         pending_;
+  };
 }      //namespace linalg
 }      //namespace viennacl
 
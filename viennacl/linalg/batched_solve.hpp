@@ -0,0 +1,322 @@
+#ifndef VIENNACL_LINALG_BATCHED_SOLVE_HPP_
+#define VIENNACL_LINALG_BATCHED_SOLVE_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/batched_solve.hpp
+    @brief Iterative solution of many small independent sparse systems, one system per thread.
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/detail/ilu/block_ilu.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+
+class cg_tag;
+
+/** @brief A tag for solving a batch of independent systems with the same iterative solver. Used for supplying solver parameters and for dispatching the solve() function
+*
+* After the solver run, the number of iterations, the estimated relative error and the convergence flag of each system can be queried.
+*
+* @tparam SolverTagT   The tag of the iterative solver used for each system (cg_tag, bicgstab_tag, gmres_tag)
+*/
+template<typename SolverTagT>
+class batched_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param solver_tag   The solver tag applied to each of the systems
+  */
+  batched_tag(SolverTagT const & solver_tag = SolverTagT()) : solver_tag_(solver_tag) {}
+
+  /** @brief Returns the solver tag applied to each of the systems */
+  SolverTagT const & solver_tag() const { return solver_tag_; }
+
+  /** @brief Returns the number of systems solved in the last run */
+  vcl_size_t size() const { return iters_.size(); }
+
+  /** @brief Returns the number of solver iterations for the i-th system */
+  vcl_size_t iters(vcl_size_t i) const { return iters_[i]; }
+  /** @brief Returns the estimated relative error at the end of the solver run for the i-th system */
+  double error(vcl_size_t i) const { return errors_[i]; }
+  /** @brief Returns true if the i-th system converged to the prescribed tolerance */
+  bool converged(vcl_size_t i) const { return converged_[i] != 0; }
+
+  /** @brief Returns the convergence mask, i.e. a flag for each system indicating whether the solver converged */
+  std::vector<bool> convergence_mask() const { return std::vector<bool>(converged_.begin(), converged_.end()); }
+  /** @brief Returns the number of systems for which the solver converged */
+  vcl_size_t num_converged() const { return static_cast<vcl_size_t>(std::count(converged_.begin(), converged_.end(), 1)); }
+  /** @brief Returns the maximum number of iterations over all systems */
+  vcl_size_t max_iters() const { return iters_.size() > 0 ? *std::max_element(iters_.begin(), iters_.end()) : 0; }
+
+  /** @brief Resets the per-system statistics for a batch of the given size. Called by the solver. */
+  void resize(vcl_size_t num_systems) const
+  {
+    iters_.assign(num_systems, 0);
+    errors_.assign(num_systems, 0);
+    converged_.assign(num_systems, 0);
+  }
+
+  /** @brief Stores the statistics of the i-th system from the solver tag used for its solution. Called by the solver.
+  *
+  * @param i            Index of the system
+  * @param system_tag   The solver tag used for the solution of the system
+  * @param norm_rhs     The norm of the right hand side the solver measures the relative error against. Required for evaluating the absolute tolerance.
+  */
+  void set(vcl_size_t i, SolverTagT const & system_tag, double norm_rhs) const
+  {
+    if (norm_rhs <= system_tag.abs_tolerance()) // the solver returns the zero vector without iterating
+    {
+      iters_[i]     = 0;
+      errors_[i]    = 0;
+      converged_[i] = 1;
+      return;
+    }
+
+    iters_[i]     = static_cast<vcl_size_t>(system_tag.iters());
+    errors_[i]    = system_tag.error();
+    converged_[i] = (system_tag.error() < system_tag.tolerance() || system_tag.error() * norm_rhs < system_tag.abs_tolerance()) ? 1 : 0;
+  }
+
+private:
+  SolverTagT solver_tag_;
+
+  //return values from solver
+  mutable std::vector<vcl_size_t> iters_;
+  mutable std::vector<double>     errors_;
+  mutable std::vector<char>       converged_;   // no std::vector<bool> here, as entries are written concurrently
+};
+
+
+namespace detail
+{
+  /** @brief Returns the system indices ordered by decreasing number of nonzeros. Processing large systems first balances the load for dynamic scheduling. */
+  template<typename SizeT>
+  std::vector<vcl_size_t> batched_schedule(std::vector<SizeT> const & work_per_system)
+  {
+    std::vector<std::pair<SizeT, vcl_size_t> > work(work_per_system.size());
+    for (vcl_size_t i=0; i<work_per_system.size(); ++i)
+      work[i] = std::make_pair(work_per_system[i], i);
+    std::stable_sort(work.begin(), work.end(), std::greater<std::pair<SizeT, vcl_size_t> >());
+
+    std::vector<vcl_size_t> order(work.size());
+    for (vcl_size_t i=0; i<work.size(); ++i)
+      order[i] = work[i].second;
+    return order;
+  }
+
+  /** @brief Returns the norm of the right hand side used by the solver for the relative error: The Euclidean norm by default */
+  template<typename SolverTagT, typename NumericT, typename PreconditionerT>
+  NumericT batched_rhs_norm(SolverTagT const &, viennacl::vector<NumericT> const & rhs, PreconditionerT const &)
+  {
+    return viennacl::linalg::norm_2(rhs);
+  }
+
+  /** @brief Returns the norm of the right hand side used by the solver for the relative error: The preconditioned CG method measures the residual in the norm induced by the preconditioner */
+  template<typename NumericT, typename PreconditionerT>
+  NumericT batched_rhs_norm(cg_tag const &, viennacl::vector<NumericT> const & rhs, PreconditionerT const & precond)
+  {
+    viennacl::vector<NumericT> z(rhs);
+    precond.apply(z);
+    return std::sqrt(std::fabs(viennacl::linalg::inner_prod(rhs, z)));
+  }
+
+  template<typename NumericT>
+  NumericT batched_rhs_norm(cg_tag const &, viennacl::vector<NumericT> const & rhs, viennacl::linalg::no_precond)
+  {
+    return viennacl::linalg::norm_2(rhs);
+  }
+
+  /** @brief Provides the same no_precond object for each system of a batch */
+  struct batched_no_precond
+  {
+    viennacl::linalg::no_precond operator[](vcl_size_t) const { return viennacl::linalg::no_precond(); }
+  };
+
+  /** @brief Solves the systems of a batch concurrently, where precond[i] is the preconditioner for the i-th system */
+  template<typename NumericT, unsigned int AlignmentV, typename SolverTagT, typename PreconditionerListT>
+  std::vector< viennacl::vector<NumericT> > batched_solve(std::vector< viennacl::compressed_matrix<NumericT, AlignmentV> > const & A,
+                                                          std::vector< viennacl::vector<NumericT> > const & rhs,
+                                                          batched_tag<SolverTagT> const & tag,
+                                                          PreconditionerListT const & precond)
+  {
+    assert(A.size() == rhs.size() && bool("Number of system matrices and right hand side vectors do not match!"));
+
+    std::vector< viennacl::vector<NumericT> > results;  // no results(A.size()) here: copies of an uninitialized vector are not permitted
+    results.reserve(A.size());
+    for (vcl_size_t i=0; i<A.size(); ++i)
+      results.push_back(viennacl::vector<NumericT>(rhs[i].size(), viennacl::traits::context(rhs[i])));
+    tag.resize(A.size());
+
+    bool all_in_host_memory = true;
+    std::vector<vcl_size_t> nnz_per_system(A.size());
+    for (vcl_size_t i=0; i<A.size(); ++i)
+    {
+      nnz_per_system[i] = A[i].nnz();
+      if (viennacl::traits::active_handle_id(A[i]) != viennacl::MAIN_MEMORY)
+        all_in_host_memory = false;
+    }
+    std::vector<vcl_size_t> order = batched_schedule(nnz_per_system);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic) if (all_in_host_memory)
+#endif
+    for (long k=0; k<static_cast<long>(order.size()); ++k)
+    {
+      vcl_size_t i = order[static_cast<vcl_size_t>(k)];
+      SolverTagT system_tag(tag.solver_tag());
+      system_tag.statistics(NULL); // instrumentation records cannot be shared among concurrent solver runs
+      results[i] = viennacl::linalg::solve(A[i], rhs[i], system_tag, precond[i]);
+      tag.set(i, system_tag, batched_rhs_norm(system_tag, rhs[i], precond[i]));
+    }
+    (void)all_in_host_memory;
+
+    return results;
+  }
+}
+
+
+/** @brief Solves a batch of independent sparse systems A[i] x[i] = rhs[i] with the iterative solver specified by the tag.
+*
+* If all matrices reside in main memory and OpenMP is enabled, the systems are distributed over the threads with one system per thread at a time,
+* largest systems first. The OpenMP-parallel kernels used within each solver run are then executed by the respective thread only (unless nested parallelism is enabled).
+* Otherwise, the systems are solved one after another.
+*
+* @param A      The system matrices
+* @param rhs    The right hand side vectors. Must have the same length as A.
+* @param tag    The batched solver tag holding the tag for the individual systems. Per-system statistics are written to this tag.
+* @return The vector of result vectors
+*/
+template<typename NumericT, unsigned int AlignmentV, typename SolverTagT>
+std::vector< viennacl::vector<NumericT> > solve(std::vector< viennacl::compressed_matrix<NumericT, AlignmentV> > const & A,
+                                                std::vector< viennacl::vector<NumericT> > const & rhs,
+                                                batched_tag<SolverTagT> const & tag)
+{
+  return detail::batched_solve(A, rhs, tag, detail::batched_no_precond());
+}
+
+/** @brief Solves a batch of independent sparse systems A[i] x[i] = rhs[i] with the iterative solver specified by the tag, where precond[i] is the preconditioner for the i-th system.
+*
+* The preconditioners are applied concurrently if the systems are solved concurrently, see above.
+*
+* @param A        The system matrices
+* @param rhs      The right hand side vectors. Must have the same length as A.
+* @param tag      The batched solver tag holding the tag for the individual systems. Per-system statistics are written to this tag.
+* @param precond  The preconditioners set up for the individual system matrices. Must have the same length as A.
+* @return The vector of result vectors
+*/
+template<typename NumericT, unsigned int AlignmentV, typename SolverTagT, typename PreconditionerT>
+std::vector< viennacl::vector<NumericT> > solve(std::vector< viennacl::compressed_matrix<NumericT, AlignmentV> > const & A,
+                                                std::vector< viennacl::vector<NumericT> > const & rhs,
+                                                batched_tag<SolverTagT> const & tag,
+                                                std::vector<PreconditionerT> const & precond)
+{
+  assert(A.size() == precond.size() && bool("Number of system matrices and preconditioners do not match!"));
+  return detail::batched_solve(A, rhs, tag, precond);
+}
+
+
+/** @brief Solves a block-diagonal system with independent diagonal blocks, where each block is solved by a separate iterative solver run.
+*
+* Entries outside the diagonal blocks are ignored. Blocks are extracted from the matrix and solved concurrently on the host, one block per thread at a time.
+*
+* @param A                  The block-diagonal system matrix
+* @param rhs                The right hand side vector
+* @param tag                The batched solver tag holding the tag for the individual blocks. Per-block statistics are written to this tag.
+* @param block_boundaries   The index ranges [a, b) of the diagonal blocks
+* @return The result vector
+*/
+template<typename NumericT, unsigned int AlignmentV, typename SolverTagT>
+viennacl::vector<NumericT> solve(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                                 viennacl::vector<NumericT> const & rhs,
+                                 batched_tag<SolverTagT> const & tag,
+                                 std::vector<std::pair<vcl_size_t, vcl_size_t> > const & block_boundaries)
+{
+  viennacl::context host_context(viennacl::MAIN_MEMORY);
+
+  viennacl::compressed_matrix<NumericT> host_A(host_context);
+  host_A = A;
+  viennacl::vector<NumericT> host_rhs(rhs);
+  viennacl::switch_memory_context(host_rhs, host_context);
+  viennacl::vector<NumericT> host_result = viennacl::zero_vector<NumericT>(rhs.size(), host_context);
+
+  unsigned int const * row_buffer  = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(host_A.handle1());
+  NumericT     const * rhs_buffer  = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(host_rhs.handle());
+  NumericT           * result_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(host_result.handle());
+
+  tag.resize(block_boundaries.size());
+
+  std::vector<unsigned int> nnz_per_block(block_boundaries.size());
+  for (vcl_size_t i=0; i<block_boundaries.size(); ++i)
+    nnz_per_block[i] = row_buffer[block_boundaries[i].second] - row_buffer[block_boundaries[i].first];
+  std::vector<vcl_size_t> order = detail::batched_schedule(nnz_per_block);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for (long k=0; k<static_cast<long>(order.size()); ++k)
+  {
+    vcl_size_t i = order[static_cast<vcl_size_t>(k)];
+    vcl_size_t block_start = block_boundaries[i].first;
+    vcl_size_t block_size  = block_boundaries[i].second - block_start;
+
+    viennacl::compressed_matrix<NumericT> block_A(block_size, block_size, nnz_per_block[i], host_context);
+    viennacl::linalg::detail::extract_block_matrix(host_A, block_A, block_start, block_boundaries[i].second);
+
+    viennacl::vector<NumericT> block_rhs(block_size, host_context);
+    NumericT * block_rhs_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(block_rhs.handle());
+    std::copy(rhs_buffer + block_start, rhs_buffer + block_start + block_size, block_rhs_buffer);
+
+    SolverTagT system_tag(tag.solver_tag());
+    system_tag.statistics(NULL); // instrumentation records cannot be shared among concurrent solver runs
+    viennacl::vector<NumericT> block_result = viennacl::linalg::solve(block_A, block_rhs, system_tag);
+    tag.set(i, system_tag, detail::batched_rhs_norm(system_tag, block_rhs, viennacl::linalg::no_precond()));
+
+    NumericT const * block_result_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(block_result.handle());
+    std::copy(block_result_buffer, block_result_buffer + block_size, result_buffer + block_start);
+  }
+
+  viennacl::switch_memory_context(host_result, viennacl::traits::context(rhs));
+  return host_result;
+}
+
+}
+}
+
+#endif
@@ -36,6 +36,7 @@
 #include "viennacl/traits/context.hpp"
 #include "viennacl/meta/result_of.hpp"
 #include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/linalg/solver_statistics.hpp"
 
 namespace viennacl
 {
@@ -54,7 +55,7 @@ public:
   * @param max_iters_before_restart   The maximum number of iterations before BiCGStab is reinitialized (to avoid accumulation of round-off errors)
   */
   bicgstab_tag(double tol = 1e-8, vcl_size_t max_iters = 400, vcl_size_t max_iters_before_restart = 200)
-    : tol_(tol), abs_tol_(0), iterations_(max_iters), iterations_before_restart_(max_iters_before_restart) {}
+    : tol_(tol), abs_tol_(0), iterations_(max_iters), iterations_before_restart_(max_iters_before_restart), stats_(NULL) {}
 
   /** @brief Returns the relative tolerance */
   double tolerance() const { return tol_; }
@@ -78,11 +79,17 @@ public:
   /** @brief Sets the estimated relative error at the end of the solver run */
   void error(double e) const { last_error_ = e; }
 
+  /** @brief Attaches an instrumentation record which is filled by subsequent solver runs. Pass NULL (default) to disable instrumentation. */
+  void statistics(solver_statistics * stats) { stats_ = stats; }
+  /** @brief Returns the attached instrumentation record, or NULL if instrumentation is disabled */
+  solver_statistics * statistics() const { return stats_; }
+
 private:
   double tol_;
   double abs_tol_;
   vcl_size_t iterations_;
   vcl_size_t iterations_before_restart_;
+  solver_statistics * stats_;
 
   //return values from solver
   mutable vcl_size_t iters_taken_;
@@ -102,6 +109,8 @@ namespace detail
                                              bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
                                              void *monitor_data = NULL)
   {
+    detail::solver_statistics_recorder rec(tag.statistics(), rhs.size(), sizeof(NumericT));
+
     viennacl::vector<NumericT> result = viennacl::zero_vector<NumericT>(rhs.size(), viennacl::traits::context(rhs));
 
     viennacl::vector<NumericT> residual = rhs;
@@ -147,6 +156,7 @@ namespace detail
       // Ap_dot_r0 = <Ap, r_0^*>
       viennacl::linalg::pipelined_bicgstab_prod(A, p, Ap, r0star,
                                                 inner_prod_buffer, buffer_size_per_vector, 3*buffer_size_per_vector);
+      rec.record(solver_statistics::SPMV, detail::spmv_bytes(A) + rec.vector_bytes(1));
 
       //////// first (weak) synchronization point ////
 
@@ -167,6 +177,7 @@ namespace detail
       // dump alpha at end of inner_prod_buffer
       viennacl::linalg::pipelined_bicgstab_update_s(s, residual, Ap,
                                                     inner_prod_buffer, buffer_size_per_vector, 5*buffer_size_per_vector);
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(3));
 
       // As = A*s_j
       // As_dot_As = <As, As>
@@ -174,6 +185,7 @@ namespace detail
       // As_dot_r0 = <As, r_0^*>
       viennacl::linalg::pipelined_bicgstab_prod(A, s, As, r0star,
                                                 inner_prod_buffer, buffer_size_per_vector, 4*buffer_size_per_vector);
+      rec.record(solver_statistics::SPMV, detail::spmv_bytes(A) + rec.vector_bytes(1));
 
       //////// second (strong) synchronization point ////
 
@@ -193,10 +205,13 @@ namespace detail
       omega =   As_dot_s  / As_dot_As;
 
       residual_norm = std::sqrt(s_dot_s - NumericT(2.0) * omega * As_dot_s + omega * omega *  As_dot_As);
+      rec.record(solver_statistics::REDUCTION, static_cast<double>(sizeof(NumericT) * inner_prod_buffer.size()));
+      rec.residual(std::fabs(residual_norm / norm_rhs_host));
       if (monitor && monitor(result, std::fabs(residual_norm / norm_rhs_host), monitor_data))
         break;
       if (std::fabs(residual_norm / norm_rhs_host) < tag.tolerance() || residual_norm < tag.abs_tolerance())
         break;
+      rec.mark();
 
       // x_{j+1} = x_j + alpha * p_j + omega * s_j
       // r_{j+1} = s_j - omega * t_j
@@ -206,10 +221,12 @@ namespace detail
                                                           residual, As,
                                                           beta, Ap,
                                                           r0star, inner_prod_buffer, buffer_size_per_vector);
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(12));
     }
 
     //store last error estimate:
     tag.error(residual_norm / norm_rhs_host);
+    rec.iterations(tag.iters());
 
     return result;
   }
@@ -302,6 +319,9 @@ namespace detail
   {
     typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
     typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
+
+    detail::solver_statistics_recorder rec(tag.statistics(), viennacl::traits::size(rhs), sizeof(CPU_NumericType));
+
     VectorT result = rhs;
     viennacl::traits::clear(result);
 
@@ -326,39 +346,52 @@ namespace detail
 
     bool restart_flag = true;
     vcl_size_t last_restart = 0;
+    rec.mark();
     for (vcl_size_t i = 0; i < tag.max_iterations(); ++i)
     {
       if (restart_flag)
       {
         residual = viennacl::linalg::prod(matrix, result);
+        rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
         residual = rhs - residual;
         p = residual;
         r0star = residual;
+        rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(6));
         ip_rr0star = viennacl::linalg::norm_2(residual);
         ip_rr0star *= ip_rr0star;
+        rec.record(solver_statistics::REDUCTION, rec.vector_bytes(1));
         restart_flag = false;
         last_restart = i;
       }
 
       tag.iters(i+1);
       tmp0 = viennacl::linalg::prod(matrix, p);
+      rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
       alpha = ip_rr0star / viennacl::linalg::inner_prod(tmp0, r0star);
+      rec.record(solver_statistics::REDUCTION, rec.vector_bytes(2));
 
       s = residual - alpha*tmp0;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(3));
 
       tmp1 = viennacl::linalg::prod(matrix, s);
+      rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
       CPU_NumericType norm_tmp1 = viennacl::linalg::norm_2(tmp1);
       omega = viennacl::linalg::inner_prod(tmp1, s) / (norm_tmp1 * norm_tmp1);
+      rec.record(solver_statistics::REDUCTION, rec.vector_bytes(3));
 
       result += alpha * p + omega * s;
       residual = s - omega * tmp1;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(7));
 
       new_ip_rr0star = viennacl::linalg::inner_prod(residual, r0star);
       residual_norm = viennacl::linalg::norm_2(residual);
+      rec.record(solver_statistics::REDUCTION, rec.vector_bytes(3));
+      rec.residual(std::fabs(residual_norm / norm_rhs_host));
       if (monitor && monitor(result, std::fabs(residual_norm / norm_rhs_host), monitor_data))
         break;
       if (std::fabs(residual_norm / norm_rhs_host) < tag.tolerance() || residual_norm < tag.abs_tolerance())
         break;
+      rec.mark();
 
       beta = new_ip_rr0star / ip_rr0star * alpha/omega;
       ip_rr0star = new_ip_rr0star;
@@ -374,10 +407,12 @@ namespace detail
       // without introducing temporary vectors:
       p -= omega * tmp0;
       p = residual + beta * p;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(6));
     }
 
     //store last error estimate:
     tag.error(residual_norm / norm_rhs_host);
+    rec.iterations(tag.iters());
 
     return result;
   }
@@ -405,6 +440,9 @@ namespace detail
   {
     typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
     typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
+
+    detail::solver_statistics_recorder rec(tag.statistics(), viennacl::traits::size(rhs), sizeof(CPU_NumericType));
+
     VectorT result = rhs;
     viennacl::traits::clear(result);
 
@@ -429,43 +467,61 @@ namespace detail
 
     bool restart_flag = true;
     vcl_size_t last_restart = 0;
+    rec.mark();
     for (unsigned int i = 0; i < tag.max_iterations(); ++i)
     {
       if (restart_flag)
       {
         residual = viennacl::linalg::prod(matrix, result);
+        rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
         residual = rhs - residual;
+        rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(3));
         precond.apply(residual);
+        rec.record(solver_statistics::PRECONDITIONER, detail::preconditioner_bytes(precond, rec));
         p = residual;
         r0star = residual;
+        rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(4));
         ip_rr0star = viennacl::linalg::norm_2(residual);
         ip_rr0star *= ip_rr0star;
+        rec.record(solver_statistics::REDUCTION, rec.vector_bytes(1));
         restart_flag = false;
         last_restart = i;
       }
 
       tag.iters(i+1);
       tmp0 = viennacl::linalg::prod(matrix, p);
+      rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
       precond.apply(tmp0);
+      rec.record(solver_statistics::PRECONDITIONER, detail::preconditioner_bytes(precond, rec));
       alpha = ip_rr0star / viennacl::linalg::inner_prod(tmp0, r0star);
+      rec.record(solver_statistics::REDUCTION, rec.vector_bytes(2));
 
       s = residual - alpha*tmp0;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(3));
 
       tmp1 = viennacl::linalg::prod(matrix, s);
+      rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
       precond.apply(tmp1);
+      rec.record(solver_statistics::PRECONDITIONER, detail::preconditioner_bytes(precond, rec));
       CPU_NumericType norm_tmp1 = viennacl::linalg::norm_2(tmp1);
       omega = viennacl::linalg::inner_prod(tmp1, s) / (norm_tmp1 * norm_tmp1);
+      rec.record(solver_statistics::REDUCTION, rec.vector_bytes(3));
 
       result += alpha * p + omega * s;
       residual = s - omega * tmp1;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(7));
 
       residual_norm = viennacl::linalg::norm_2(residual);
+      rec.record(solver_statistics::REDUCTION, rec.vector_bytes(1));
+      rec.residual(std::fabs(residual_norm / norm_rhs_host));
       if (monitor && monitor(result, std::fabs(residual_norm / norm_rhs_host), monitor_data))
         break;
       if (residual_norm / norm_rhs_host < tag.tolerance() || residual_norm < tag.abs_tolerance())
         break;
+      rec.mark();
 
       new_ip_rr0star = viennacl::linalg::inner_prod(residual, r0star);
+      rec.record(solver_statistics::REDUCTION, rec.vector_bytes(2));
 
       beta = new_ip_rr0star / ip_rr0star * alpha/omega;
       ip_rr0star = new_ip_rr0star;
@@ -478,12 +534,14 @@ namespace detail
       // without introducing temporary vectors:
       p -= omega * tmp0;
       p = residual + beta * p;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(6));
 
       //std::cout << "Rel. Residual in current step: " << std::sqrt(std::fabs(viennacl::linalg::inner_prod(residual, residual) / norm_rhs_host)) << std::endl;
     }
 
     //store last error estimate:
     tag.error(residual_norm / norm_rhs_host);
+    rec.iterations(tag.iters());
 
     return result;
   }
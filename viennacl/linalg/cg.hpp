@@ -35,8 +35,11 @@
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/traits/clear.hpp"
 #include "viennacl/traits/size.hpp"
+#include "viennacl/traits/context.hpp"
+#include "viennacl/traits/handle.hpp"
 #include "viennacl/meta/result_of.hpp"
 #include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/linalg/solver_statistics.hpp"
 
 namespace viennacl
 {
@@ -53,7 +56,7 @@ public:
   * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||r_initial||)
   * @param max_iterations   The maximum number of iterations
   */
-  cg_tag(double tol = 1e-8, unsigned int max_iterations = 300) : tol_(tol), abs_tol_(0), iterations_(max_iterations) {}
+  cg_tag(double tol = 1e-8, unsigned int max_iterations = 300) : tol_(tol), abs_tol_(0), iterations_(max_iterations), use_fused_(true), stats_(NULL) {}
 
   /** @brief Returns the relative tolerance */
   double tolerance() const { return tol_; }
@@ -66,6 +69,11 @@ public:
   /** @brief Returns the maximum number of iterations */
   unsigned int max_iterations() const { return iterations_; }
 
+  /** @brief Returns whether the fused classical CG iteration is used for sparse matrices in main memory (default: true) */
+  bool use_fused() const { return use_fused_; }
+  /** @brief Enables or disables the fused classical CG iteration. If disabled, the pipelined (no preconditioner) or the classical implementation is used on all backends. */
+  void use_fused(bool b) { use_fused_ = b; }
+
   /** @brief Return the number of solver iterations: */
   unsigned int iters() const { return iters_taken_; }
   void iters(unsigned int i) const { iters_taken_ = i; }
@@ -75,11 +83,18 @@ public:
   /** @brief Sets the estimated relative error at the end of the solver run */
   void error(double e) const { last_error_ = e; }
 
+  /** @brief Attaches an instrumentation record which is filled by subsequent solver runs. Pass NULL (default) to disable instrumentation. */
+  void statistics(solver_statistics * stats) { stats_ = stats; }
+  /** @brief Returns the attached instrumentation record, or NULL if instrumentation is disabled */
+  solver_statistics * statistics() const { return stats_; }
+
 
 private:
   double tol_;
   double abs_tol_;
   unsigned int iterations_;
+  bool use_fused_;
+  solver_statistics * stats_;
 
   //return values from solver
   mutable unsigned int iters_taken_;
@@ -135,6 +150,8 @@ namespace detail
   {
     typedef typename viennacl::vector<NumericT>::difference_type   difference_type;
 
+    detail::solver_statistics_recorder rec(tag.statistics(), rhs.size(), sizeof(NumericT));
+
     viennacl::vector<NumericT> result(rhs);
     viennacl::traits::clear(result);
 
@@ -162,7 +179,9 @@ namespace detail
       tag.iters(i+1);
 
       viennacl::linalg::pipelined_cg_vector_update(result, alpha, p, residual, Ap, beta, inner_prod_buffer);
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(7));
       viennacl::linalg::pipelined_cg_prod(A, p, Ap, inner_prod_buffer);
+      rec.record(solver_statistics::SPMV, detail::spmv_bytes(A));
 
       // bring back the partial results to the host:
       viennacl::fast_copy(inner_prod_buffer.begin(), inner_prod_buffer.end(), host_inner_prod_buffer.begin());
@@ -170,9 +189,12 @@ namespace detail
       inner_prod_rr   = std::accumulate(host_inner_prod_buffer.begin(),                                host_inner_prod_buffer.begin() +     buffer_offset_per_vector, NumericT(0));
       inner_prod_ApAp = std::accumulate(host_inner_prod_buffer.begin() +     buffer_offset_per_vector, host_inner_prod_buffer.begin() + 2 * buffer_offset_per_vector, NumericT(0));
       inner_prod_pAp  = std::accumulate(host_inner_prod_buffer.begin() + 2 * buffer_offset_per_vector, host_inner_prod_buffer.begin() + 3 * buffer_offset_per_vector, NumericT(0));
+      rec.record(solver_statistics::REDUCTION, static_cast<double>(sizeof(NumericT) * inner_prod_buffer.size()));
+      rec.residual(std::sqrt(std::fabs(inner_prod_rr / norm_rhs_squared)));
 
       if (monitor && monitor(result, std::sqrt(std::fabs(inner_prod_rr / norm_rhs_squared)), monitor_data))
         break;
+      rec.mark();
       if (std::fabs(inner_prod_rr / norm_rhs_squared) < tag.tolerance() *  tag.tolerance() || std::fabs(inner_prod_rr) < tag.abs_tolerance() * tag.abs_tolerance())    //squared norms involved here
         break;
 
@@ -182,89 +204,29 @@ namespace detail
 
     //store last error estimate:
     tag.error(std::sqrt(std::fabs(inner_prod_rr) / norm_rhs_squared));
+    rec.iterations(tag.iters());
 
     return result;
   }
 
 
-  /** @brief Overload for the pipelined CG implementation for the ViennaCL sparse matrix types */
-  template<typename NumericT>
-  viennacl::vector<NumericT> solve_impl(viennacl::compressed_matrix<NumericT> const & A,
-                                        viennacl::vector<NumericT> const & rhs,
-                                        cg_tag const & tag,
-                                        viennacl::linalg::no_precond,
-                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
-                                        void *monitor_data = NULL)
-  {
-    return pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
-  }
-
-
-  /** @brief Overload for the pipelined CG implementation for the ViennaCL sparse matrix types */
-  template<typename NumericT>
-  viennacl::vector<NumericT> solve_impl(viennacl::coordinate_matrix<NumericT> const & A,
-                                        viennacl::vector<NumericT> const & rhs,
-                                        cg_tag const & tag,
-                                        viennacl::linalg::no_precond,
-                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
-                                        void *monitor_data = NULL)
-  {
-    return detail::pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
-  }
-
-
-
-  /** @brief Overload for the pipelined CG implementation for the ViennaCL sparse matrix types */
-  template<typename NumericT>
-  viennacl::vector<NumericT> solve_impl(viennacl::ell_matrix<NumericT> const & A,
-                                        viennacl::vector<NumericT> const & rhs,
-                                        cg_tag const & tag,
-                                        viennacl::linalg::no_precond,
-                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
-                                        void *monitor_data = NULL)
-  {
-    return detail::pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
-  }
-
-
-
-  /** @brief Overload for the pipelined CG implementation for the ViennaCL sparse matrix types */
-  template<typename NumericT>
-  viennacl::vector<NumericT> solve_impl(viennacl::sliced_ell_matrix<NumericT> const & A,
-                                        viennacl::vector<NumericT> const & rhs,
-                                        cg_tag const & tag,
-                                        viennacl::linalg::no_precond,
-                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
-                                        void *monitor_data = NULL)
-  {
-    return detail::pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
-  }
-
-
-  /** @brief Overload for the pipelined CG implementation for the ViennaCL sparse matrix types */
-  template<typename NumericT>
-  viennacl::vector<NumericT> solve_impl(viennacl::hyb_matrix<NumericT> const & A,
-                                        viennacl::vector<NumericT> const & rhs,
-                                        cg_tag const & tag,
-                                        viennacl::linalg::no_precond,
-                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
-                                        void *monitor_data = NULL)
-  {
-    return detail::pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
-  }
-
-
+  /** @brief Implementation of the classical preconditioned conjugate gradient algorithm, generic implementation for arbitrary matrix and vector types.
+  *
+  * Following Algorithm 9.1 in "Iterative Methods for Sparse Linear Systems" by Y. Saad
+  */
   template<typename MatrixT, typename VectorT, typename PreconditionerT>
-  VectorT solve_impl(MatrixT const & matrix,
-                     VectorT const & rhs,
-                     cg_tag const & tag,
-                     PreconditionerT const & precond,
-                     bool (*monitor)(VectorT const &, typename viennacl::result_of::cpu_value_type<typename viennacl::result_of::value_type<VectorT>::type>::type, void*) = NULL,
-                     void *monitor_data = NULL)
+  VectorT classic_solve(MatrixT const & matrix,
+                        VectorT const & rhs,
+                        cg_tag const & tag,
+                        PreconditionerT const & precond,
+                        bool (*monitor)(VectorT const &, typename viennacl::result_of::cpu_value_type<typename viennacl::result_of::value_type<VectorT>::type>::type, void*) = NULL,
+                        void *monitor_data = NULL)
   {
     typedef typename viennacl::result_of::value_type<VectorT>::type           NumericType;
     typedef typename viennacl::result_of::cpu_value_type<NumericType>::type   CPU_NumericType;
 
+    detail::solver_statistics_recorder rec(tag.statistics(), viennacl::traits::size(rhs), sizeof(CPU_NumericType));
+
     VectorT result = rhs;
     viennacl::traits::clear(result);
 
@@ -273,10 +235,15 @@ namespace detail
     detail::z_handler<VectorT, PreconditionerT> zhandler(residual);
     VectorT & z = zhandler.get();
 
+    rec.mark();
     precond.apply(z);
+    if (detail::has_preconditioner(precond))
+      rec.record(solver_statistics::PRECONDITIONER, detail::preconditioner_bytes(precond, rec));
     VectorT p = z;
 
+    rec.mark();
     CPU_NumericType ip_rr = viennacl::linalg::inner_prod(residual, z);
+    rec.record(solver_statistics::REDUCTION, rec.vector_bytes(2));
     CPU_NumericType alpha;
     CPU_NumericType new_ip_rr = 0;
     CPU_NumericType beta;
@@ -290,37 +257,260 @@ namespace detail
     {
       tag.iters(i+1);
       tmp = viennacl::linalg::prod(matrix, p);
+      rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
 
       alpha = ip_rr / viennacl::linalg::inner_prod(tmp, p);
+      rec.record(solver_statistics::REDUCTION, rec.vector_bytes(2));
 
       result += alpha * p;
       residual -= alpha * tmp;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(6));
       z = residual;
       precond.apply(z);
+      if (detail::has_preconditioner(precond))
+        rec.record(solver_statistics::PRECONDITIONER, detail::preconditioner_bytes(precond, rec));
 
       if (static_cast<VectorT*>(&residual)==static_cast<VectorT*>(&z))
         new_ip_rr = static_cast<CPU_NumericType>(std::pow(viennacl::linalg::norm_2(residual),2));
       else
         new_ip_rr = viennacl::linalg::inner_prod(residual, z);
+      rec.record(solver_statistics::REDUCTION, rec.vector_bytes(2));
 
       new_ipp_rr_over_norm_rhs = new_ip_rr / norm_rhs_squared;
+      rec.residual(std::sqrt(std::fabs(new_ipp_rr_over_norm_rhs)));
       if (monitor && monitor(result, std::sqrt(std::fabs(new_ipp_rr_over_norm_rhs)), monitor_data))
         break;
       if (std::fabs(new_ipp_rr_over_norm_rhs) < tag.tolerance() *  tag.tolerance() || std::fabs(new_ip_rr) < tag.abs_tolerance() * tag.abs_tolerance())    //squared norms involved here
         break;
+      rec.mark();
 
       beta = new_ip_rr / ip_rr;
       ip_rr = new_ip_rr;
 
       p = z + beta*p;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(3));
     }
 
     //store last error estimate:
     tag.error(std::sqrt(std::fabs(new_ip_rr / norm_rhs_squared)));
+    rec.iterations(tag.iters());
 
     return result;
   }
 
+
+  /** @brief Implementation of the classical preconditioned conjugate gradient algorithm with fused operations for the ViennaCL sparse matrix types on the host.
+  *
+  * Computes the same iterates as classic_solve(), but requires only two parallel regions per iteration (plus the preconditioner application):
+  *  - The update of the search direction p = z + beta * p is followed by the matrix-vector product Ap = prod(A, p) within the same parallel region, which also computes <p, Ap>.
+  *  - The updates of the result and the residual are computed together with <r, r>.
+  * In contrast to the pipelined variant, the residual norm is computed from the updated residual rather than by a recurrence.
+  *
+  * @param A            The system matrix
+  * @param rhs          The load vector
+  * @param tag          Solver configuration tag
+  * @param precond      A preconditioner. Precondition operation is done via member function apply()
+  * @param monitor      A callback routine which is called in each iteration
+  * @param monitor_data Data pointer to be passed to the callback routine to pass on user-specific data
+  * @return The result vector
+  */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> fused_solve(MatrixT const & A,
+                                         viennacl::vector<NumericT> const & rhs,
+                                         cg_tag const & tag,
+                                         PreconditionerT const & precond,
+                                         bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                         void *monitor_data = NULL)
+  {
+    detail::solver_statistics_recorder rec(tag.statistics(), rhs.size(), sizeof(NumericT));
+
+    viennacl::vector<NumericT> result = viennacl::zero_vector<NumericT>(rhs.size(), viennacl::traits::context(rhs));
+
+    viennacl::vector<NumericT> residual(rhs);
+    detail::z_handler<viennacl::vector<NumericT>, PreconditionerT> zhandler(residual);
+    viennacl::vector<NumericT> & z = zhandler.get();
+
+    rec.mark();
+    precond.apply(z);
+    if (detail::has_preconditioner(precond))
+      rec.record(solver_statistics::PRECONDITIONER, detail::preconditioner_bytes(precond, rec));
+
+    viennacl::vector<NumericT> p = viennacl::zero_vector<NumericT>(rhs.size(), viennacl::traits::context(rhs));
+    viennacl::vector<NumericT> Ap(rhs.size(), viennacl::traits::context(rhs));
+
+    // Layout of temporary buffer:
+    //  entry 0: <r, r>
+    //  entry 1: <p, Ap>
+    viennacl::vector<NumericT> inner_prod_buffer = viennacl::zero_vector<NumericT>(2, viennacl::traits::context(rhs));
+    std::vector<NumericT>      host_inner_prod_buffer(inner_prod_buffer.size());
+
+    rec.mark();
+    NumericT ip_rr = viennacl::linalg::inner_prod(residual, z);
+    rec.record(solver_statistics::REDUCTION, rec.vector_bytes(2));
+    NumericT new_ip_rr = 0;
+    NumericT norm_rhs_squared = ip_rr;
+    NumericT alpha;
+    NumericT beta = 0;
+
+    if (std::fabs(norm_rhs_squared) <= tag.abs_tolerance() * tag.abs_tolerance()) //solution is zero if RHS norm (squared) is zero
+      return result;
+
+    for (unsigned int i = 0; i < tag.max_iterations(); ++i)
+    {
+      tag.iters(i+1);
+
+      // p = z + beta * p, Ap = prod(A, p):
+      viennacl::linalg::fused_cg_prod(A, z, beta, p, Ap, inner_prod_buffer);
+      rec.record(solver_statistics::SPMV, detail::spmv_bytes(A) + rec.vector_bytes(2));
+      viennacl::fast_copy(inner_prod_buffer.begin(), inner_prod_buffer.end(), host_inner_prod_buffer.begin());
+      rec.record(solver_statistics::REDUCTION, static_cast<double>(sizeof(NumericT) * inner_prod_buffer.size()));
+
+      alpha = ip_rr / host_inner_prod_buffer[1];
+
+      // result += alpha * p, residual -= alpha * Ap:
+      viennacl::linalg::fused_cg_vector_update(result, alpha, p, residual, Ap, inner_prod_buffer);
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(6));
+
+      if (static_cast<viennacl::vector<NumericT>*>(&residual)==static_cast<viennacl::vector<NumericT>*>(&z))
+      {
+        viennacl::fast_copy(inner_prod_buffer.begin(), inner_prod_buffer.end(), host_inner_prod_buffer.begin());
+        new_ip_rr = host_inner_prod_buffer[0];
+        rec.record(solver_statistics::REDUCTION, static_cast<double>(sizeof(NumericT) * inner_prod_buffer.size()));
+      }
+      else
+      {
+        z = residual;
+        precond.apply(z);
+        rec.record(solver_statistics::PRECONDITIONER, detail::preconditioner_bytes(precond, rec));
+        new_ip_rr = viennacl::linalg::inner_prod(residual, z);
+        rec.record(solver_statistics::REDUCTION, rec.vector_bytes(2));
+      }
+
+      rec.residual(std::sqrt(std::fabs(new_ip_rr / norm_rhs_squared)));
+      if (monitor && monitor(result, std::sqrt(std::fabs(new_ip_rr / norm_rhs_squared)), monitor_data))
+        break;
+      if (std::fabs(new_ip_rr / norm_rhs_squared) < tag.tolerance() *  tag.tolerance() || std::fabs(new_ip_rr) < tag.abs_tolerance() * tag.abs_tolerance())    //squared norms involved here
+        break;
+      rec.mark();
+
+      beta = new_ip_rr / ip_rr;
+      ip_rr = new_ip_rr;
+    }
+
+    //store last error estimate:
+    tag.error(std::sqrt(std::fabs(new_ip_rr / norm_rhs_squared)));
+    rec.iterations(tag.iters());
+
+    return result;
+  }
+
+
+  /** @brief Dispatches the unpreconditioned CG method for the ViennaCL sparse matrix types: Fused classical CG on the host (unless disabled in the tag), pipelined CG otherwise. */
+  template<typename MatrixT, typename NumericT>
+  viennacl::vector<NumericT> sparse_solve_impl(MatrixT const & A,
+                                               viennacl::vector<NumericT> const & rhs,
+                                               cg_tag const & tag,
+                                               viennacl::linalg::no_precond,
+                                               bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*),
+                                               void *monitor_data)
+  {
+    if (tag.use_fused() && viennacl::traits::active_handle_id(rhs) == viennacl::MAIN_MEMORY)
+      return detail::fused_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
+    return detail::pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
+  }
+
+  /** @brief Dispatches the preconditioned CG method for the ViennaCL sparse matrix types: Fused classical CG on the host (unless disabled in the tag), classical CG otherwise. */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> sparse_solve_impl(MatrixT const & A,
+                                               viennacl::vector<NumericT> const & rhs,
+                                               cg_tag const & tag,
+                                               PreconditionerT const & precond,
+                                               bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*),
+                                               void *monitor_data)
+  {
+    if (tag.use_fused() && viennacl::traits::active_handle_id(rhs) == viennacl::MAIN_MEMORY)
+      return detail::fused_solve(A, rhs, tag, precond, monitor, monitor_data);
+    return detail::classic_solve(A, rhs, tag, precond, monitor, monitor_data);
+  }
+
+
+  /** @brief Overload for the CG implementation for the ViennaCL sparse matrix types */
+  template<typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> solve_impl(viennacl::compressed_matrix<NumericT> const & A,
+                                        viennacl::vector<NumericT> const & rhs,
+                                        cg_tag const & tag,
+                                        PreconditionerT const & precond,
+                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                        void *monitor_data = NULL)
+  {
+    return detail::sparse_solve_impl(A, rhs, tag, precond, monitor, monitor_data);
+  }
+
+
+  /** @brief Overload for the CG implementation for the ViennaCL sparse matrix types */
+  template<typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> solve_impl(viennacl::coordinate_matrix<NumericT> const & A,
+                                        viennacl::vector<NumericT> const & rhs,
+                                        cg_tag const & tag,
+                                        PreconditionerT const & precond,
+                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                        void *monitor_data = NULL)
+  {
+    return detail::sparse_solve_impl(A, rhs, tag, precond, monitor, monitor_data);
+  }
+
+
+  /** @brief Overload for the CG implementation for the ViennaCL sparse matrix types */
+  template<typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> solve_impl(viennacl::ell_matrix<NumericT> const & A,
+                                        viennacl::vector<NumericT> const & rhs,
+                                        cg_tag const & tag,
+                                        PreconditionerT const & precond,
+                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                        void *monitor_data = NULL)
+  {
+    return detail::sparse_solve_impl(A, rhs, tag, precond, monitor, monitor_data);
+  }
+
+
+  /** @brief Overload for the CG implementation for the ViennaCL sparse matrix types */
+  template<typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> solve_impl(viennacl::sliced_ell_matrix<NumericT> const & A,
+                                        viennacl::vector<NumericT> const & rhs,
+                                        cg_tag const & tag,
+                                        PreconditionerT const & precond,
+                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                        void *monitor_data = NULL)
+  {
+    return detail::sparse_solve_impl(A, rhs, tag, precond, monitor, monitor_data);
+  }
+
+
+  /** @brief Overload for the CG implementation for the ViennaCL sparse matrix types */
+  template<typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> solve_impl(viennacl::hyb_matrix<NumericT> const & A,
+                                        viennacl::vector<NumericT> const & rhs,
+                                        cg_tag const & tag,
+                                        PreconditionerT const & precond,
+                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                        void *monitor_data = NULL)
+  {
+    return detail::sparse_solve_impl(A, rhs, tag, precond, monitor, monitor_data);
+  }
+
+
+  /** @brief Generic implementation of the preconditioned CG method for matrix and vector types other than the ViennaCL sparse matrix types. */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT>
+  VectorT solve_impl(MatrixT const & matrix,
+                     VectorT const & rhs,
+                     cg_tag const & tag,
+                     PreconditionerT const & precond,
+                     bool (*monitor)(VectorT const &, typename viennacl::result_of::cpu_value_type<typename viennacl::result_of::value_type<VectorT>::type>::type, void*) = NULL,
+                     void *monitor_data = NULL)
+  {
+    return detail::classic_solve(matrix, rhs, tag, precond, monitor, monitor_data);
+  }
+
 }
 
 
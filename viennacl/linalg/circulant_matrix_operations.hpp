@@ -23,7 +23,9 @@
 */
 
 #include "viennacl/forwards.h"
+#ifdef VIENNACL_WITH_OPENCL
 #include "viennacl/ocl/backend.hpp"
+#endif
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
@@ -52,20 +54,28 @@ void prod_impl(viennacl::circulant_matrix<NumericT, AlignmentV> const & mat,
 {
   assert(mat.size1() == result.size() && bool("Dimension mismatch"));
   assert(mat.size2() == vec.size() && bool("Dimension mismatch"));
-  //result.clear();
-
-  //std::cout << "prod(circulant_matrix" << ALIGNMENT << ", vector) called with internal_nnz=" << mat.internal_nnz() << std::endl;
-
-  viennacl::vector<NumericT> circ(mat.elements().size() * 2);
-  viennacl::linalg::real_to_complex(mat.elements(), circ, mat.elements().size());
 
-  viennacl::vector<NumericT> tmp(vec.size() * 2);
-  viennacl::vector<NumericT> tmp2(vec.size() * 2);
+  mat.spectrum().apply(vec, result);
+}
 
-  viennacl::linalg::real_to_complex(vec, tmp, vec.size());
-  viennacl::linalg::convolve(circ, tmp, tmp2);
-  viennacl::linalg::complex_to_real(tmp2, result, vec.size());
+/** @brief Multiplies a circulant_matrix with all columns of a dense matrix: result = mat * vecs
+*
+* The columns are processed in parallel, each with one forward and one inverse FFT.
+*
+* @param mat    The matrix
+* @param vecs   The dense matrix holding the vectors as columns
+* @param result The dense result matrix
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_impl(viennacl::circulant_matrix<NumericT, AlignmentV> const & mat,
+               viennacl::matrix_base<NumericT> const & vecs,
+               viennacl::matrix_base<NumericT>       & result)
+{
+  assert(mat.size1() == result.size1() && bool("Dimension mismatch"));
+  assert(mat.size2() == vecs.size1() && bool("Dimension mismatch"));
+  assert(vecs.size2() == result.size2() && bool("Dimension mismatch"));
 
+  mat.spectrum().apply(vecs, result);
 }
 
 } //namespace linalg
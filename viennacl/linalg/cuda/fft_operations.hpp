@@ -829,14 +829,14 @@ void complex_to_real(viennacl::vector_base<NumericT> const & in,
 }
 
 template<typename NumericT>
-__global__ void reverse_inplace(NumericT * vec, unsigned int size)
+__global__ void reverse_inplace(NumericT * vec, unsigned int start, unsigned int inc, unsigned int size)
 {
   for (unsigned int i = blockIdx.x * blockDim.x + threadIdx.x; i < (size >> 1); i+=gridDim.x * blockDim.x)
   {
-    NumericT val1 = vec[i];
-    NumericT val2 = vec[size - i - 1];
-    vec[i] = val2;
-    vec[size - i - 1] = val1;
+    NumericT val1 = vec[start + i * inc];
+    NumericT val2 = vec[start + (size - i - 1) * inc];
+    vec[start + i * inc] = val2;
+    vec[start + (size - i - 1) * inc] = val1;
   }
 }
 
@@ -847,7 +847,10 @@ template<typename NumericT>
 void reverse(viennacl::vector_base<NumericT>& in)
 {
   vcl_size_t size = in.size();
-  reverse_inplace<<<128,128>>>(viennacl::cuda_arg(in), static_cast<unsigned int>(size));
+  reverse_inplace<<<128,128>>>(viennacl::cuda_arg(in),
+                               static_cast<unsigned int>(viennacl::traits::start(in)),
+                               static_cast<unsigned int>(viennacl::traits::stride(in)),
+                               static_cast<unsigned int>(size));
   VIENNACL_CUDA_LAST_ERROR_CHECK("reverse_inplace");
 }
 
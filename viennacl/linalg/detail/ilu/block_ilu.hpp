@@ -225,7 +225,8 @@ private:
   {
     L.resize(mat_block.size1(), mat_block.size2());
     U.resize(mat_block.size1(), mat_block.size2());
-    viennacl::linalg::precondition(mat_block, L, U, tag_);
+    viennacl::linalg::ilut_tag block_tag(tag_); // blocks are factored concurrently, fill statistics must not be written to a shared tag
+    viennacl::linalg::precondition(mat_block, L, U, block_tag);
   }
 
   template<typename VectorT>
@@ -589,7 +590,8 @@ private:
   {
     L.resize(mat_block.size1(), mat_block.size2());
     U.resize(mat_block.size1(), mat_block.size2());
-    viennacl::linalg::precondition(mat_block, L, U, tag_);
+    viennacl::linalg::ilut_tag block_tag(tag_); // blocks are factored concurrently, fill statistics must not be written to a shared tag
+    viennacl::linalg::precondition(mat_block, L, U, block_tag);
   }
 
 
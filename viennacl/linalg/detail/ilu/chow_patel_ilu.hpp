@@ -31,6 +31,7 @@
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/detail/ilu/common.hpp"
 #include "viennacl/linalg/ilu_operations.hpp"
+#include "viennacl/linalg/host_based/ilu_operations.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/backend/memory.hpp"
 
@@ -49,7 +50,7 @@ public:
     * @param num_sweeps        Number of sweeps in setup phase
     * @param num_jacobi_iters  Number of Jacobi iterations for each triangular 'solve' when applying the preconditioner to a vector
     */
-  chow_patel_tag(vcl_size_t num_sweeps = 3, vcl_size_t num_jacobi_iters = 2) : sweeps_(num_sweeps), jacobi_iters_(num_jacobi_iters) {}
+  chow_patel_tag(vcl_size_t num_sweeps = 3, vcl_size_t num_jacobi_iters = 2) : sweeps_(num_sweeps), jacobi_iters_(num_jacobi_iters), jacobi_block_size_(1) {}
 
   /** @brief Returns the number of sweeps (i.e. number of nonlinear iterations) in the solver setup stage */
   vcl_size_t sweeps() const { return sweeps_; }
@@ -61,9 +62,19 @@ public:
   /** @brief Sets the number of Jacobi iterations for each triangular 'solve' when applying the preconditioner to a vector. */
   void       jacobi_iters(vcl_size_t num) { jacobi_iters_ = num; }
 
+  /** @brief Returns the number of consecutive rows solved exactly within each Jacobi iteration. A value of one denotes point-Jacobi iterations. */
+  vcl_size_t jacobi_block_size() const { return jacobi_block_size_; }
+  /** @brief Sets the number of consecutive rows solved exactly within each Jacobi iteration (block-Jacobi) when applying the preconditioner to a vector in main memory.
+    *
+    * Larger blocks increase the accuracy of the triangular 'solves' at the cost of less parallelism. Ignored for vectors not residing in main memory.
+    * Block-Jacobi iterations start from zero, hence the first iteration solves with the diagonal blocks exactly and jacobi_iters() iterations follow.
+    */
+  void       jacobi_block_size(vcl_size_t num) { jacobi_block_size_ = (num > 0) ? num : 1; }
+
 private:
   vcl_size_t sweeps_;
   vcl_size_t jacobi_iters_;
+  vcl_size_t jacobi_block_size_;
 };
 
 namespace detail
@@ -189,6 +200,13 @@ public:
   template<typename VectorT>
   void apply(VectorT & vec) const
   {
+    if (viennacl::traits::active_handle_id(vec) == viennacl::MAIN_MEMORY && viennacl::traits::active_handle_id(L_) == viennacl::MAIN_MEMORY) // fused sweeps
+    {
+      viennacl::linalg::host_based::ilu_jacobi_solve(L_,       diag_L_, vec, x_k_, b_, tag_.jacobi_iters(), tag_.jacobi_block_size(), true);
+      viennacl::linalg::host_based::ilu_jacobi_solve(L_trans_, diag_L_, vec, x_k_, b_, tag_.jacobi_iters(), tag_.jacobi_block_size(), false);
+      return;
+    }
+
     //
     // y = L^{-1} b through Jacobi iteration y_{k+1} = (I - D^{-1}L)y_k + D^{-1}x
     //
@@ -268,6 +286,13 @@ public:
   template<typename VectorT>
   void apply(VectorT & vec) const
   {
+    if (viennacl::traits::active_handle_id(vec) == viennacl::MAIN_MEMORY && viennacl::traits::active_handle_id(L_) == viennacl::MAIN_MEMORY) // fused sweeps
+    {
+      viennacl::linalg::host_based::ilu_jacobi_solve(L_, diag_L_, vec, x_k_, b_, tag_.jacobi_iters(), tag_.jacobi_block_size(), true);
+      viennacl::linalg::host_based::ilu_jacobi_solve(U_, diag_U_, vec, x_k_, b_, tag_.jacobi_iters(), tag_.jacobi_block_size(), false);
+      return;
+    }
+
     //
     // y = L^{-1} b through Jacobi iteration y_{k+1} = (I - D^{-1}L)y_k + D^{-1}x
     //
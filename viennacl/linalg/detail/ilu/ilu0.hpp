@@ -41,6 +41,7 @@
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/detail/ilu/common.hpp"
+#include "viennacl/linalg/sparse_triangular_solver.hpp"
 #include "viennacl/compressed_matrix.hpp"
 #include "viennacl/backend/memory.hpp"
 
@@ -192,9 +193,7 @@ class ilu0_precond< viennacl::compressed_matrix<NumericT, AlignmentV> >
   typedef viennacl::compressed_matrix<NumericT, AlignmentV>   MatrixType;
 
 public:
-  ilu0_precond(MatrixType const & mat, ilu0_tag const & tag)
-    : tag_(tag),
-      LU_(mat.size1(), mat.size2(), viennacl::traits::context(mat))
+  ilu0_precond(MatrixType const & mat, ilu0_tag const & tag) : tag_(tag)
   {
     //initialize preconditioner:
     //std::cout << "Start GPU precond" << std::endl;
@@ -230,8 +229,8 @@ public:
       {
         viennacl::context old_context = viennacl::traits::context(vec);
         viennacl::switch_memory_context(vec, host_context);
-        viennacl::linalg::inplace_solve(LU_, vec, unit_lower_tag());
-        viennacl::linalg::inplace_solve(LU_, vec, upper_tag());
+        L_solver_.apply(vec);
+        U_solver_.apply(vec);
         viennacl::switch_memory_context(vec, old_context);
       }
     }
@@ -258,8 +257,8 @@ public:
       }
       else
       {
-        viennacl::linalg::inplace_solve(LU_, vec, unit_lower_tag());
-        viennacl::linalg::inplace_solve(LU_, vec, upper_tag());
+        L_solver_.apply(vec);
+        U_solver_.apply(vec);
       }
     }
   }
@@ -269,20 +268,28 @@ public:
 private:
   void init(MatrixType const & mat)
   {
+    // the factor is only needed for the setup, the triangular solves keep their own copies:
     viennacl::context host_context(viennacl::MAIN_MEMORY);
-    viennacl::switch_memory_context(LU_, host_context);
-    LU_ = mat;
-    viennacl::linalg::precondition(LU_, tag_);
+    viennacl::compressed_matrix<NumericT> LU(mat.size1(), mat.size2(), viennacl::traits::context(mat));
+    viennacl::switch_memory_context(LU, host_context);
+    LU = mat;
+    viennacl::linalg::precondition(LU, tag_);
 
     if (!tag_.use_level_scheduling())
+    {
+      L_solver_.init(LU, unit_lower_tag());
+      L_solver_.release_value_map();
+      U_solver_.init(LU, upper_tag());
+      U_solver_.release_value_map();
       return;
+    }
 
     // multifrontal part:
     viennacl::switch_memory_context(multifrontal_U_diagonal_, host_context);
-    multifrontal_U_diagonal_.resize(LU_.size1(), false);
-    host_based::detail::row_info(LU_, multifrontal_U_diagonal_, viennacl::linalg::detail::SPARSE_ROW_DIAGONAL);
+    multifrontal_U_diagonal_.resize(LU.size1(), false);
+    host_based::detail::row_info(LU, multifrontal_U_diagonal_, viennacl::linalg::detail::SPARSE_ROW_DIAGONAL);
 
-    detail::level_scheduling_setup_L(LU_,
+    detail::level_scheduling_setup_L(LU,
                                      multifrontal_U_diagonal_, //dummy
                                      multifrontal_L_row_index_arrays_,
                                      multifrontal_L_row_buffers_,
@@ -291,7 +298,7 @@ private:
                                      multifrontal_L_row_elimination_num_list_);
 
 
-    detail::level_scheduling_setup_U(LU_,
+    detail::level_scheduling_setup_U(LU,
                                      multifrontal_U_diagonal_,
                                      multifrontal_U_row_index_arrays_,
                                      multifrontal_U_row_buffers_,
@@ -352,7 +359,8 @@ private:
   }
 
   ilu0_tag tag_;
-  viennacl::compressed_matrix<NumericT> LU_;
+  viennacl::linalg::sparse_triangular_solver<NumericT> L_solver_;
+  viennacl::linalg::sparse_triangular_solver<NumericT> U_solver_;
 
   std::list<viennacl::backend::mem_handle> multifrontal_L_row_index_arrays_;
   std::list<viennacl::backend::mem_handle> multifrontal_L_row_buffers_;
@@ -25,15 +25,21 @@
 #include <vector>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
+#include <functional>
+#include <utility>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 
 #include "viennacl/linalg/detail/ilu/common.hpp"
+#include "viennacl/linalg/sparse_triangular_solver.hpp"
 #include "viennacl/compressed_matrix.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
 
-#include <map>
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
 
 namespace viennacl
 {
@@ -57,7 +63,8 @@ class ilut_tag
       : entries_per_row_(entries_per_row),
         drop_tolerance_(drop_tolerance),
         use_level_scheduling_(with_level_scheduling),
-        solve_iters_(0) {}
+        solve_iters_(0),
+        nnz_A_(0), nnz_L_(0), nnz_U_(0), dropped_entries_(0) {}
 
     void set_drop_tolerance(double tol)
     {
@@ -85,107 +92,279 @@ class ilut_tag
     /** @brief Returns the number of iterations for approximate solves. Returns 0 if no approximate solvers are used. */
     unsigned int approximate_solves() const { return solve_iters_; }
 
+    /** @brief Returns the number of nonzeros of L computed in the last factorization. The unit diagonal is not stored. */
+    vcl_size_t nnz_L() const { return nnz_L_; }
+    /** @brief Returns the number of nonzeros of U (including the diagonal) computed in the last factorization */
+    vcl_size_t nnz_U() const { return nnz_U_; }
+    /** @brief Returns the number of nonzero entries dropped in the last factorization, either because of the drop tolerance or because of the limit on the number of entries per row */
+    vcl_size_t dropped_entries() const { return dropped_entries_; }
+    /** @brief Returns the fill ratio (nnz(L) + nnz(U)) / nnz(A) of the last factorization */
+    double fill_ratio() const { return (nnz_A_ > 0) ? static_cast<double>(nnz_L_ + nnz_U_) / static_cast<double>(nnz_A_) : 0; }
+
+    /** @brief Sets the fill statistics. Called by the factorization routine. */
+    void fill_statistics(vcl_size_t nnz_A, vcl_size_t nnz_L, vcl_size_t nnz_U, vcl_size_t dropped_entries) const
+    {
+      nnz_A_ = nnz_A;
+      nnz_L_ = nnz_L;
+      nnz_U_ = nnz_U;
+      dropped_entries_ = dropped_entries;
+    }
+
   private:
     unsigned int entries_per_row_;
     double       drop_tolerance_;
     bool         use_level_scheduling_;
     unsigned int solve_iters_;
+
+    //return values from factorization
+    mutable vcl_size_t nnz_A_;
+    mutable vcl_size_t nnz_L_;
+    mutable vcl_size_t nnz_U_;
+    mutable vcl_size_t dropped_entries_;
 };
 
 
 namespace detail
 {
-  /** @brief Helper struct for holding a sparse vector in linear memory. For internal use only.
+  /** @brief Sparse accumulator for the working row of ILUT: A dense array of values, an occupancy marker, and the list of occupied columns. For internal use only.
     *
-    * Unfortunately, the 'naive' implementation using a std::map<> is almost always too slow.
+    * A column is occupied in the current row i if its marker equals i, hence the dense arrays never need to be cleared.
+    * The occupied lower-triangular columns are additionally kept in a min-heap, because they are eliminated in ascending order.
+    */
+  template<typename NumericT>
+  struct ilut_sparse_accumulator
+  {
+    ilut_sparse_accumulator(vcl_size_t n) : values_(n), marker_(n, static_cast<unsigned int>(n)) {}
+
+    std::vector<NumericT>     values_;
+    std::vector<unsigned int> marker_;
+    std::vector<unsigned int> indices_;
+    std::vector<unsigned int> lower_heap_;
+    std::vector<std::pair<unsigned int, NumericT> > entries_;
+  };
+
+  /** @brief Orders (column, value)-pairs by decreasing absolute value */
+  struct ilut_abs_greater
+  {
+    template<typename PairT>
+    bool operator()(PairT const & a, PairT const & b) const { return std::fabs(a.second) > std::fabs(b.second); }
+  };
+
+  /** @brief Keeps the (at most) max_entries largest entries in absolute value and sorts them by column index.
     *
+    * @return The number of entries discarded
     */
   template<typename NumericT>
-  struct ilut_sparse_vector
+  vcl_size_t ilut_keep_largest(std::vector<std::pair<unsigned int, NumericT> > & entries, vcl_size_t max_entries)
+  {
+    vcl_size_t num_discarded = 0;
+    if (entries.size() > max_entries)
+    {
+      std::nth_element(entries.begin(), entries.begin() + static_cast<long>(max_entries), entries.end(), ilut_abs_greater());
+      num_discarded = entries.size() - max_entries;
+      entries.resize(max_entries);
+    }
+    std::sort(entries.begin(), entries.end());
+    return num_discarded;
+  }
+
+  /** @brief States of a row in the pipelined factorization. Rows depending on a failed row are not computed, so that a zero pivot does not spread Inf/NaN. */
+  enum ilut_row_state
   {
-    ilut_sparse_vector(vcl_size_t alloc_size = 0) : size_(0), col_indices_(alloc_size), elements_(alloc_size) {}
+    ILUT_ROW_PENDING = 0,
+    ILUT_ROW_DONE,
+    ILUT_ROW_FAILED   // zero diagonal in this row or in a row of U it depends on
+  };
 
-    void resize_if_bigger(vcl_size_t s)
+  /** @brief Blocks until row k of U has been finalized by some thread and returns its state. Rows are published by ilut_publish_row() after a flush, and a second flush after the state is observed orders the subsequent reads of the row. */
+  inline char ilut_wait_for_row(char const * row_done, unsigned int k)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    for (;;)
     {
-      if (s > elements_.size())
+      #pragma omp flush
+      char state = *static_cast<char const volatile *>(row_done + k);
+      if (state != ILUT_ROW_PENDING)
       {
-        col_indices_.resize(s);
-        elements_.resize(s);
+        #pragma omp flush   // acquire: the entries of row k must not be read before its state
+        return state;
       }
-      size_ = s;
     }
+#else
+    return row_done[k];
+#endif
+  }
 
-    vcl_size_t size_;
-    std::vector<unsigned int> col_indices_;
-    std::vector<NumericT>     elements_;
-  };
+  /** @brief Makes row i of U available to the other threads. */
+  inline void ilut_publish_row(char * row_done, unsigned int i, char state)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp flush
+#endif
+    *static_cast<char volatile *>(row_done + i) = state;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp flush
+#endif
+  }
 
-  /** @brief Subtracts a scaled sparse vector u from a sparse vector w and writes the output to z: z = w - alpha * u
+  /** @brief Computes row i of the ILUT factors. Rows of L and U are written to fixed-size slots of entries_per_row and entries_per_row+1 entries, respectively.
     *
-    * Sparsity pattern of u and w are usually different.
+    * Refer to Algorithm 10.6 by Saad's book (1996 edition). Row i only depends on the rows of U referenced by the lower triangular part of the working row.
+    * These rows are awaited if they are not available yet, so that rows can be computed concurrently in a pipelined fashion.
     *
-    * @return Length of new vector
+    * @return The number of entries dropped (by the drop tolerance or the limit on the number of entries per row),
+    *         or -1 if the diagonal entry is zero or the row depends on a row with zero diagonal. Such rows are left empty.
     */
-  template<typename IndexT, typename NumericT>
-  IndexT merge_subtract_sparse_rows(IndexT const * w_coords, NumericT const * w_elements, IndexT w_size,
-                                    IndexT const * u_coords, NumericT const * u_elements, IndexT u_size, NumericT alpha,
-                                    IndexT       * z_coords, NumericT       * z_elements)
+  template<typename NumericT>
+  long ilut_factorize_row(unsigned int i,
+                          unsigned int const * row_buffer_A, unsigned int const * col_buffer_A, NumericT const * elements_A,
+                          unsigned int * col_buffer_L, NumericT * elements_L, unsigned int * row_size_L,
+                          unsigned int * col_buffer_U, NumericT * elements_U, unsigned int * row_size_U,
+                          char * row_done,
+                          ilut_tag const & tag,
+                          ilut_sparse_accumulator<NumericT> & w)
   {
-    IndexT index_w = 0;
-    IndexT index_u = 0;
-    IndexT index_z = 0;
+    vcl_size_t entries_per_row = tag.get_entries_per_row();
+    long num_dropped = 0;
 
-    while (1)
+    //line 2: set up w
+    w.indices_.clear();
+    w.lower_heap_.clear();
+    NumericT row_norm = 0;
+    for (unsigned int j = row_buffer_A[i]; j < row_buffer_A[i+1]; ++j)
     {
-      if (index_w < w_size && index_u < u_size)
+      unsigned int col = col_buffer_A[j];
+      NumericT entry = elements_A[j];
+      if (w.marker_[col] != i)
       {
-        if (w_coords[index_w] < u_coords[index_u])
-        {
-          z_coords[index_z]     = w_coords[index_w];
-          z_elements[index_z++] = w_elements[index_w++];
-        }
-        else if (w_coords[index_w] == u_coords[index_u])
-        {
-          z_coords[index_z]     = w_coords[index_w];
-          z_elements[index_z++] = w_elements[index_w++] - alpha * u_elements[index_u++];
-        }
-        else
-        {
-          z_coords[index_z]     = u_coords[index_u];
-          z_elements[index_z++] = - alpha * u_elements[index_u++];
-        }
+        w.marker_[col] = i;
+        w.values_[col] = entry;
+        w.indices_.push_back(col);
+        if (col < i)
+          w.lower_heap_.push_back(col);
       }
-      else if (index_w == w_size && index_u < u_size)
+      else
+        w.values_[col] += entry;
+      row_norm += entry * entry;
+    }
+    row_norm = std::sqrt(row_norm);
+    NumericT tau_i = static_cast<NumericT>(tag.get_drop_tolerance()) * row_norm;
+    std::make_heap(w.lower_heap_.begin(), w.lower_heap_.end(), std::greater<unsigned int>());
+
+    //line 3: Iterate over lower diagonal parts of w in ascending order (fill-in from rows of U is always to the right of the current column):
+    while (!w.lower_heap_.empty())
+    {
+      std::pop_heap(w.lower_heap_.begin(), w.lower_heap_.end(), std::greater<unsigned int>());
+      unsigned int k = w.lower_heap_.back();
+      w.lower_heap_.pop_back();
+
+      if (ilut_wait_for_row(row_done, k) == ILUT_ROW_FAILED)
+      {
+        row_size_L[i] = 0;
+        row_size_U[i] = 0;
+        ilut_publish_row(row_done, i, ILUT_ROW_FAILED);
+        return -1;
+      }
+      unsigned int const * col_U_k = col_buffer_U + vcl_size_t(k) * (entries_per_row + 1);
+      NumericT     const * elem_U_k = elements_U  + vcl_size_t(k) * (entries_per_row + 1);
+
+      //line 4:
+      NumericT w_k_entry = w.values_[k] / elem_U_k[0];
+
+      //lines 5,6: (dropping rule to w_k)
+      if (std::fabs(w_k_entry) <= tau_i)
       {
-        z_coords[index_z]     = u_coords[index_u];
-        z_elements[index_z++] = - alpha * u_elements[index_u++];
+        w.values_[k] = 0;
+        if (w_k_entry < 0 || w_k_entry > 0)
+          ++num_dropped;
+        continue;
       }
-      else if (index_w < w_size && index_u == u_size)
+      w.values_[k] = w_k_entry;
+
+      //line 7: w = w - w_k * u_k, skipping the diagonal of u_k
+      for (unsigned int j = 1; j < row_size_U[k]; ++j)
       {
-        z_coords[index_z]     = w_coords[index_w];
-        z_elements[index_z++] = w_elements[index_w++];
+        unsigned int col = col_U_k[j];
+        if (w.marker_[col] == i)
+          w.values_[col] -= w_k_entry * elem_U_k[j];
+        else
+        {
+          w.marker_[col] = i;
+          w.values_[col] = - w_k_entry * elem_U_k[j];
+          w.indices_.push_back(col);
+          if (col < i)
+          {
+            w.lower_heap_.push_back(col);
+            std::push_heap(w.lower_heap_.begin(), w.lower_heap_.end(), std::greater<unsigned int>());
+          }
+        }
       }
-      else
-        return index_z;
     }
+
+    //Lines 10-12: Apply a dropping rule to w, write the largest p values to L and U. The diagonal is never dropped.
+    NumericT diagonal = (w.marker_[i] == i) ? w.values_[i] : NumericT(0);
+    if (diagonal <= 0 && diagonal >= 0) // rows waiting for this one must not divide by the zero pivot
+    {
+      row_size_L[i] = 0;
+      row_size_U[i] = 0;
+      ilut_publish_row(row_done, i, ILUT_ROW_FAILED);
+      return -1;
+    }
+
+    w.entries_.clear();
+    for (vcl_size_t r = 0; r < w.indices_.size(); ++r)
+    {
+      unsigned int col = w.indices_[r];
+      if (col < i && std::fabs(w.values_[col]) > 0)
+        w.entries_.push_back(std::make_pair(col, w.values_[col]));
+    }
+    num_dropped += static_cast<long>(ilut_keep_largest(w.entries_, entries_per_row));
+    for (vcl_size_t r = 0; r < w.entries_.size(); ++r)
+    {
+      col_buffer_L[vcl_size_t(i) * entries_per_row + r] = w.entries_[r].first;
+      elements_L[vcl_size_t(i) * entries_per_row + r]   = w.entries_[r].second;
+    }
+    row_size_L[i] = static_cast<unsigned int>(w.entries_.size());
+
+    w.entries_.clear();
+    for (vcl_size_t r = 0; r < w.indices_.size(); ++r)
+    {
+      unsigned int col = w.indices_[r];
+      if (col > i && std::fabs(w.values_[col]) > 0)
+        w.entries_.push_back(std::make_pair(col, w.values_[col]));
+    }
+    num_dropped += static_cast<long>(ilut_keep_largest(w.entries_, entries_per_row));
+    vcl_size_t offset_U = vcl_size_t(i) * (entries_per_row + 1);
+    col_buffer_U[offset_U] = i;
+    elements_U[offset_U]   = diagonal;
+    for (vcl_size_t r = 0; r < w.entries_.size(); ++r)
+    {
+      col_buffer_U[offset_U + r + 1] = w.entries_[r].first;
+      elements_U[offset_U + r + 1]   = w.entries_[r].second;
+    }
+    row_size_U[i] = static_cast<unsigned int>(w.entries_.size() + 1);
+
+    ilut_publish_row(row_done, i, ILUT_ROW_DONE);
+    return num_dropped;
   }
 
-  template<typename SizeT, typename NumericT>
-  void insert_with_value_sort(std::vector<std::pair<SizeT, NumericT> > & map,
-                              SizeT index, NumericT value)
+  /** @brief Compacts rows stored in fixed-size slots to CSR format in place. Returns the number of nonzeros. */
+  template<typename NumericT>
+  unsigned int ilut_compact_rows(vcl_size_t num_rows, vcl_size_t slot_size, unsigned int const * row_sizes,
+                                 unsigned int * row_buffer, unsigned int * col_buffer, NumericT * elements)
   {
-    NumericT abs_value = std::fabs(value);
-    if (abs_value > 0)
+    unsigned int offset = 0;
+    for (vcl_size_t i=0; i<num_rows; ++i)
     {
-      // find first element with smaller absolute value:
-      std::size_t first_smaller_index = 0;
-      while (first_smaller_index < map.size() && std::fabs(map[first_smaller_index].second) > abs_value)
-        ++first_smaller_index;
-
-      std::pair<SizeT, NumericT> tmp(index, value);
-      for (std::size_t j=first_smaller_index; j<map.size(); ++j)
-        std::swap(map[j], tmp);
+      row_buffer[i] = offset;
+      for (unsigned int j=0; j<row_sizes[i]; ++j, ++offset) // destination is never to the right of the source
+      {
+        col_buffer[offset] = col_buffer[i * slot_size + j];
+        elements[offset]   = elements[i * slot_size + j];
+      }
     }
+    row_buffer[num_rows] = offset;
+    return offset;
   }
 
 }
@@ -194,7 +373,12 @@ namespace detail
 *
 * refer to Algorithm 10.6 by Saad's book (1996 edition)
 *
-*  @param A       The input matrix. Either a compressed_matrix or of type std::vector< std::map<T, U> >
+* The working row is held in a dense sparse accumulator of the size of the system per thread.
+* If OpenMP is enabled, rows are distributed cyclically over the threads and computed concurrently: Each thread waits for a row of U only when it is needed for the elimination.
+* The factors are identical to the ones computed sequentially. Fill statistics are written to the tag.
+* If a diagonal entry is computed to zero, the rows depending on it are not computed and a zero_on_diagonal_exception is thrown.
+*
+*  @param A       The input matrix.
 *  @param L       The output matrix for L.
 *  @param U       The output matrix for U.
 *  @param tag     An ilut_tag in order to dispatch among several other preconditioners.
@@ -208,151 +392,84 @@ void precondition(viennacl::compressed_matrix<NumericT> const & A,
   assert(A.size1() == L.size1() && bool("Output matrix size mismatch") );
   assert(A.size1() == U.size1() && bool("Output matrix size mismatch") );
 
-  L.reserve( tag.get_entries_per_row()      * A.size1());
-  U.reserve((tag.get_entries_per_row() + 1) * A.size1());
+  vcl_size_t num_rows = A.size1();
+  vcl_size_t entries_per_row = tag.get_entries_per_row();
 
-  vcl_size_t avg_nnz_per_row = static_cast<vcl_size_t>(A.nnz() / A.size1());
-  detail::ilut_sparse_vector<NumericT> w1(tag.get_entries_per_row() * (avg_nnz_per_row + 10));
-  detail::ilut_sparse_vector<NumericT> w2(tag.get_entries_per_row() * (avg_nnz_per_row + 10));
-  detail::ilut_sparse_vector<NumericT> * w_in  = &w1;
-  detail::ilut_sparse_vector<NumericT> * w_out = &w2;
-  std::vector<NumericT> diagonal_U(A.size1());
+  L.reserve( entries_per_row      * num_rows);
+  U.reserve((entries_per_row + 1) * num_rows);
 
   NumericT     const * elements_A   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
   unsigned int const * row_buffer_A = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
   unsigned int const * col_buffer_A = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
 
   NumericT           * elements_L   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(L.handle());
-  unsigned int       * row_buffer_L = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L.handle1()); row_buffer_L[0] = 0;
+  unsigned int       * row_buffer_L = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L.handle1());
   unsigned int       * col_buffer_L = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(L.handle2());
 
   NumericT           * elements_U   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(U.handle());
-  unsigned int       * row_buffer_U = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U.handle1()); row_buffer_U[0] = 0;
+  unsigned int       * row_buffer_U = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U.handle1());
   unsigned int       * col_buffer_U = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(U.handle2());
 
-  std::vector<std::pair<unsigned int, NumericT> > sorted_entries_L(tag.get_entries_per_row());
-  std::vector<std::pair<unsigned int, NumericT> > sorted_entries_U(tag.get_entries_per_row());
-
-  for (vcl_size_t i=0; i<viennacl::traits::size1(A); ++i)  // Line 1
+  std::vector<unsigned int> row_size_L(num_rows + 1);
+  std::vector<unsigned int> row_size_U(num_rows + 1);
+  std::vector<char>         row_done(num_rows + 1, detail::ILUT_ROW_PENDING); // no std::vector<bool> here, as entries are written concurrently
+
+#ifdef VIENNACL_WITH_OPENMP
+  // threads busy-wait for rows of U, hence the processors must not be oversubscribed:
+  int num_threads = std::max(1, std::min(omp_get_max_threads(), omp_get_num_procs()));
+  std::vector<long> thread_dropped(static_cast<vcl_size_t>(num_threads), 0);
+  std::vector<long> thread_zero_row(static_cast<vcl_size_t>(num_threads), -1);
+  #pragma omp parallel num_threads(num_threads)
+#else
+  std::vector<long> thread_dropped(1, 0);
+  std::vector<long> thread_zero_row(1, -1);
+#endif
   {
-    std::fill(sorted_entries_L.begin(), sorted_entries_L.end(), std::pair<unsigned int, NumericT>(0, NumericT(0)));
-    std::fill(sorted_entries_U.begin(), sorted_entries_U.end(), std::pair<unsigned int, NumericT>(0, NumericT(0)));
-
-    //line 2: set up w
-    w_in->resize_if_bigger(row_buffer_A[i+1] - row_buffer_A[i]);
-    NumericT row_norm = 0;
-    unsigned int k = 0;
-    for (unsigned int j = row_buffer_A[i]; j < row_buffer_A[i+1]; ++j, ++k)
-    {
-      w_in->col_indices_[k] = col_buffer_A[j];
-      NumericT entry = elements_A[j];
-      w_in->elements_[k] = entry;
-      row_norm += entry * entry;
-    }
-    row_norm = std::sqrt(row_norm);
-    NumericT tau_i = static_cast<NumericT>(tag.get_drop_tolerance()) * row_norm;
-
-    //line 3: Iterate over lower diagonal parts of A:
-    k = 0;
-    unsigned int current_col = (row_buffer_A[i+1] > row_buffer_A[i]) ? w_in->col_indices_[k] : static_cast<unsigned int>(i); // mind empty rows here!
-    while (current_col < i)
-    {
-      //line 4:
-      NumericT a_kk = diagonal_U[current_col];
-
-      NumericT w_k_entry = w_in->elements_[k] / a_kk;
-      w_in->elements_[k] = w_k_entry;
-
-      //lines 5,6: (dropping rule to w_k)
-      if ( std::fabs(w_k_entry) > tau_i)
-      {
-        //line 7:
-        unsigned int row_U_begin = row_buffer_U[current_col];
-        unsigned int row_U_end   = row_buffer_U[current_col + 1];
-
-        if (row_U_end > row_U_begin)
-        {
-          w_out->resize_if_bigger(w_in->size_ + (row_U_end - row_U_begin) - 1);
-          w_out->size_ = detail::merge_subtract_sparse_rows(&(w_in->col_indices_[0]), &(w_in->elements_[0]), static_cast<unsigned int>(w_in->size_),
-                                                            col_buffer_U + row_U_begin + 1, elements_U + row_U_begin + 1, (row_U_end - row_U_begin) - 1, w_k_entry,
-                                                            &(w_out->col_indices_[0]), &(w_out->elements_[0])
-                                                           );
-          ++k;
-        }
-      }
-      else // drop element
-      {
-        w_out->resize_if_bigger(w_in->size_ - 1);
-        for (unsigned int r = 0; r < k; ++r)
-        {
-          w_out->col_indices_[r] = w_in->col_indices_[r];
-          w_out->elements_[r]    = w_in->elements_[r];
-        }
-        for (unsigned int r = k+1; r < w_in->size_; ++r)
-        {
-          w_out->col_indices_[r-1] = w_in->col_indices_[r];
-          w_out->elements_[r-1]    = w_in->elements_[r];
-        }
-
-        // Note: No increment to k here, element was dropped!
-      }
-
-      // swap pointers to w1 and w2
-      std::swap(w_in, w_out);
-
-      // process next entry:
-      current_col = (k < w_in->size_) ? w_in->col_indices_[k] : static_cast<unsigned int>(i);
-    } // while()
+    vcl_size_t thread_id = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    thread_id = static_cast<vcl_size_t>(omp_get_thread_num());
+#endif
+    detail::ilut_sparse_accumulator<NumericT> w(num_rows);
 
-    // Line 10: Apply a dropping rule to w
-    // To do so, we write values to a temporary array
-    for (unsigned int r = 0; r < w_in->size_; ++r)
+    // Static cyclic distribution: Each thread processes its rows in ascending order, hence the lowest unfinished row can always proceed.
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(static, 1)
+#endif
+    for (long i2=0; i2<static_cast<long>(num_rows); ++i2)
     {
-      unsigned int col   = w_in->col_indices_[r];
-      NumericT     value = w_in->elements_[r];
-
-      if (col < i) // entry for L:
-        detail::insert_with_value_sort(sorted_entries_L, col, value);
-      else if (col == i) // do not drop diagonal element
+      unsigned int i = static_cast<unsigned int>(i2);
+      long num_dropped = detail::ilut_factorize_row(i, row_buffer_A, col_buffer_A, elements_A,
+                                                    col_buffer_L, elements_L, &(row_size_L[0]),
+                                                    col_buffer_U, elements_U, &(row_size_U[0]),
+                                                    &(row_done[0]), tag, w);
+      if (num_dropped < 0)
       {
-        diagonal_U[i] = value;
-        if (value <= 0 && value >= 0)
-        {
-          std::cerr << "ViennaCL: FATAL ERROR in ILUT(): Diagonal entry computed to zero (" << value << ") in row " << i << "!" << std::endl;
-          throw zero_on_diagonal_exception("ILUT zero diagonal!");
-        }
+        if (thread_zero_row[thread_id] < 0)
+          thread_zero_row[thread_id] = i2;
       }
-      else // entry for U:
-        detail::insert_with_value_sort(sorted_entries_U, col, value);
+      else
+        thread_dropped[thread_id] += num_dropped;
     }
+  }
 
-    //Lines 10-12: Apply a dropping rule to w, write the largest p values to L and U
-    unsigned int offset_L = row_buffer_L[i];
-    std::sort(sorted_entries_L.begin(), sorted_entries_L.end());
-    for (unsigned int j=0; j<tag.get_entries_per_row(); ++j)
-      if (std::fabs(sorted_entries_L[j].second) > 0)
-      {
-        col_buffer_L[offset_L] = sorted_entries_L[j].first;
-        elements_L[offset_L]   = sorted_entries_L[j].second;
-        ++offset_L;
-      }
-    row_buffer_L[i+1] = offset_L;
-
-    unsigned int offset_U = row_buffer_U[i];
-    col_buffer_U[offset_U] = static_cast<unsigned int>(i);
-    elements_U[offset_U]   = diagonal_U[i];
-    ++offset_U;
-    std::sort(sorted_entries_U.begin(), sorted_entries_U.end());
-    for (unsigned int j=0; j<tag.get_entries_per_row(); ++j)
-      if (std::fabs(sorted_entries_U[j].second) > 0)
-      {
-        col_buffer_U[offset_U] = sorted_entries_U[j].first;
-        elements_U[offset_U]   = sorted_entries_U[j].second;
-        ++offset_U;
-      }
-    row_buffer_U[i+1] = offset_U;
+  long zero_row = -1;
+  vcl_size_t num_dropped = 0;
+  for (vcl_size_t j=0; j<thread_dropped.size(); ++j)
+  {
+    num_dropped += static_cast<vcl_size_t>(thread_dropped[j]);
+    if (thread_zero_row[j] >= 0 && (zero_row < 0 || thread_zero_row[j] < zero_row))
+      zero_row = thread_zero_row[j];
+  }
+  if (zero_row >= 0)
+  {
+    std::cerr << "ViennaCL: FATAL ERROR in ILUT(): Diagonal entry computed to zero in row " << zero_row << "!" << std::endl;
+    throw zero_on_diagonal_exception("ILUT zero diagonal!");
+  }
 
-  } //for i
+  vcl_size_t nnz_L = detail::ilut_compact_rows(num_rows, entries_per_row,     &(row_size_L[0]), row_buffer_L, col_buffer_L, elements_L);
+  vcl_size_t nnz_U = detail::ilut_compact_rows(num_rows, entries_per_row + 1, &(row_size_U[0]), row_buffer_U, col_buffer_U, elements_U);
+
+  tag.fill_statistics(row_buffer_A[num_rows], nnz_L, nnz_U, num_dropped);
 }
 
 
@@ -372,6 +489,9 @@ public:
     //std::cout << "End CPU precond" << std::endl;
   }
 
+  /** @brief Returns the tag, which holds the fill statistics of the factorization */
+  ilut_tag const & tag() const { return tag_; }
+
   template<typename VectorT>
   void apply(VectorT & vec) const
   {
@@ -435,6 +555,9 @@ public:
     //std::cout << "End GPU precond" << std::endl;
   }
 
+  /** @brief Returns the tag, which holds the fill statistics of the factorization */
+  ilut_tag const & tag() const { return tag_; }
+
   void apply(viennacl::vector<NumericT> & vec) const
   {
     if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
@@ -495,8 +618,8 @@ public:
           viennacl::context host_context(viennacl::MAIN_MEMORY);
           viennacl::context old_context = viennacl::traits::context(vec);
           viennacl::switch_memory_context(vec, host_context);
-          viennacl::linalg::inplace_solve(L_, vec, unit_lower_tag());
-          viennacl::linalg::inplace_solve(U_, vec, upper_tag());
+          L_solver_.apply(vec);
+          U_solver_.apply(vec);
           viennacl::switch_memory_context(vec, old_context);
         }
 
@@ -535,8 +658,8 @@ public:
       }
       else
       {
-        viennacl::linalg::inplace_solve(L_, vec, unit_lower_tag());
-        viennacl::linalg::inplace_solve(U_, vec, upper_tag());
+        L_solver_.apply(vec);
+        U_solver_.apply(vec);
       }
     }
   }
@@ -562,6 +685,14 @@ private:
       viennacl::linalg::precondition(cpu_mat, L_, U_, tag_);
     }
 
+    if (tag_.approximate_solves() == 0)
+    {
+      L_solver_.init(L_, unit_lower_tag());
+      L_solver_.release_value_map();
+      U_solver_.init(U_, upper_tag());
+      U_solver_.release_value_map();
+    }
+
     if (tag_.approximate_solves() > 0)
     {
       viennacl::switch_memory_context(multifrontal_U_diagonal_, host_context);
@@ -578,7 +709,10 @@ private:
     }
 
     if (!tag_.use_level_scheduling())
+    {
+      release_factors();
       return;
+    }
 
     //
     // multifrontal part:
@@ -656,12 +790,24 @@ private:
                                                                      ++it)
       viennacl::backend::switch_memory_context<NumericT>(*it, viennacl::traits::context(mat));
 
+    release_factors();
+  }
 
+  /** @brief The factors are only applied directly in approximate solves. Otherwise, the triangular solvers and the level scheduling hold their own copies. */
+  void release_factors()
+  {
+    if (tag_.approximate_solves() == 0)
+    {
+      L_.clear();
+      U_.clear();
+    }
   }
 
   ilut_tag tag_;
   viennacl::compressed_matrix<NumericT> L_;
   viennacl::compressed_matrix<NumericT> U_;
+  viennacl::linalg::sparse_triangular_solver<NumericT> L_solver_;
+  viennacl::linalg::sparse_triangular_solver<NumericT> U_solver_;
 
   std::list<viennacl::backend::mem_handle> multifrontal_L_row_index_arrays_;
   std::list<viennacl::backend::mem_handle> multifrontal_L_row_buffers_;
@@ -48,6 +48,7 @@
 #include "viennacl/linalg/cg.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
 #include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/detail/spai/spai_tag.hpp"
 //#include <omp.h>
 
 /** @file viennacl/linalg/detail/spai/fspai.hpp
@@ -63,56 +64,6 @@ namespace detail
 namespace spai
 {
 
-/** @brief A tag for FSPAI. Experimental.
-*
-* Contains values for the algorithm.
-* Must be passed to spai_precond constructor
-*/
-class fspai_tag
-{
-public:
-  /** @brief Constructor
-   *
-   * @param residual_norm_threshold Calculate until the norm of the residual falls below this threshold
-   * @param iteration_limit maximum number of iterations
-   * @param is_static determines if static version of SPAI should be used
-   * @param is_right determines if left or right preconditioner should be used
-   */
-  fspai_tag(
-          double residual_norm_threshold = 1e-3,
-          unsigned int iteration_limit = 5,
-          bool is_static = false,
-          bool is_right = false)
-    : residual_norm_threshold_(residual_norm_threshold),
-      iteration_limit_(iteration_limit),
-      is_static_(is_static),
-      is_right_(is_right) {}
-
-  inline double getResidualNormThreshold() const { return residual_norm_threshold_; }
-  inline unsigned long getIterationLimit () const { return iteration_limit_; }
-  inline bool getIsStatic() const { return is_static_; }
-  inline bool getIsRight() const  { return is_right_; }
-  inline void setResidualNormThreshold(double residual_norm_threshold)
-  {
-    if (residual_norm_threshold > 0)
-      residual_norm_threshold_ = residual_norm_threshold;
-  }
-  inline void setIterationLimit(unsigned long iteration_limit)
-  {
-    if (iteration_limit > 0)
-      iteration_limit_ = iteration_limit;
-  }
-  inline void setIsRight(bool is_right)   { is_right_  = is_right; }
-  inline void setIsStatic(bool is_static) { is_static_ = is_static; }
-
-private:
-  double residual_norm_threshold_;
-  unsigned long iteration_limit_;
-  bool is_static_;
-  bool is_right_;
-};
-
-
 //
 // Helper: Store A in an STL container of type, exploiting symmetry
 // Reason: ublas interface does not allow to iterate over nonzeros of a particular row without starting an iterator1 from the very beginning of the matrix...
@@ -0,0 +1,635 @@
+#ifndef VIENNACL_LINALG_DETAIL_SPAI_HOST_SPAI_HPP
+#define VIENNACL_LINALG_DETAIL_SPAI_HOST_SPAI_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/spai/host_spai.hpp
+    @brief Host-based setup of SPAI and FSPAI preconditioners for compressed_matrix. Experimental.
+
+    The local least-squares problems (SPAI) and the local Cholesky problems (FSPAI) are solved column by column with OpenMP.
+    Each thread owns a dense workspace and appends its results to thread-local buffers, which are assembled into CSR format without any std::map.
+    Neither OpenCL nor Boost.uBLAS are required.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <cmath>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/ilu_operations.hpp"
+#include "viennacl/linalg/detail/spai/spai_tag.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+namespace spai
+{
+
+/** @brief Open-addressing hash map from global indices to their positions in a local index set (I or J) of the host-based SPAI setup.
+*
+* Only the 32-bit positions are stored, the keys are looked up in the index set itself.
+* The table is a power of two with at least twice as many slots as the index set has entries and is rebuilt whenever the index set outgrows it,
+* hence it holds fewer than 4 |I| (or 4 |J|) slots, but at least 16.
+*/
+class host_spai_index_map
+{
+public:
+  host_spai_index_map() { reset(0); }
+
+  /** @brief Empties the map and sizes the table for the given number of indices */
+  void reset(vcl_size_t expected_size)
+  {
+    vcl_size_t num_slots = 16;
+    while (num_slots < 2 * expected_size)
+      num_slots *= 2;
+    slots_.assign(num_slots, empty_slot());
+  }
+
+  /** @brief Fills the map with all entries of the index set, which must not contain duplicates */
+  void assign(std::vector<unsigned int> const & index_set)
+  {
+    reset(index_set.size());
+    for (vcl_size_t i = 0; i < index_set.size(); ++i)
+      place(index_set, i);
+  }
+
+  /** @brief Returns the position of the global index in the index set, or -1 if it is not contained */
+  long find(std::vector<unsigned int> const & index_set, unsigned int index) const
+  {
+    vcl_size_t mask = slots_.size() - 1;
+    for (vcl_size_t slot = hash(index) & mask; slots_[slot] != empty_slot(); slot = (slot + 1) & mask)
+      if (index_set[slots_[slot]] == index)
+        return static_cast<long>(slots_[slot]);
+    return -1;
+  }
+
+  /** @brief Adds the last entry of the index set to the map. The entry must not be contained yet. */
+  void insert_last(std::vector<unsigned int> const & index_set)
+  {
+    if (2 * index_set.size() > slots_.size())
+      assign(index_set);
+    else
+      place(index_set, index_set.size() - 1);
+  }
+
+private:
+  static unsigned int empty_slot() { return ~0u; }
+
+  static vcl_size_t hash(unsigned int index)
+  {
+    unsigned int h = index * 2654435761u;  // Knuth's multiplicative hash, mixed down such that strided indices spread over the low bits
+    return static_cast<vcl_size_t>(h ^ (h >> 16));
+  }
+
+  void place(std::vector<unsigned int> const & index_set, vcl_size_t position)
+  {
+    vcl_size_t mask = slots_.size() - 1;
+    vcl_size_t slot = hash(index_set[position]) & mask;
+    while (slots_[slot] != empty_slot())
+      slot = (slot + 1) & mask;
+    slots_[slot] = static_cast<unsigned int>(position);
+  }
+
+  std::vector<unsigned int> slots_;
+};
+
+
+/** @brief Thread-local workspace for the host-based SPAI and FSPAI setup.
+*
+* All buffers grow with the largest local problem only: With the index sets I and J of the largest local problem,
+* a workspace holds O(|I| |J|) entries for the dense block and O(|I| + |J|) entries otherwise, independent of the size of the system matrix.
+* The computed columns are appended to out_indices and out_values, which are assembled into the final matrix after all columns have been processed.
+*/
+template<typename NumericT>
+struct host_spai_workspace
+{
+  host_spai_index_map       row_map;        // positions of the global row indices in I
+  host_spai_index_map       col_map;        // positions of the global column indices in J
+  std::vector<unsigned int> I;              // row index set of the local problem
+  std::vector<unsigned int> J;              // column index set of the local problem
+  std::vector<NumericT>     block;          // dense column-major A(I, J), overwritten by its factorization
+  std::vector<NumericT>     betas;          // Householder coefficients of the QR factorization
+  std::vector<NumericT>     rhs;            // right hand side, overwritten by the solution of the local problem
+  std::vector<NumericT>     residual;       // residual of the local least-squares problem on I
+
+  std::vector<std::pair<NumericT, unsigned int> > candidates;  // scored candidates for the augmentation of J
+  std::vector<std::pair<unsigned int, NumericT> > column;      // the computed column, sorted by index
+
+  std::vector<unsigned int> out_indices;
+  std::vector<NumericT>     out_values;
+};
+
+
+/** @brief In-place Householder QR factorization of a dense column-major m-by-n block, cf. Golub, Van Loan "Matrix Computations" 3rd edition p.224.
+*
+* Same algorithm as single_qr() in qr.hpp: The Householder vectors are stored below the diagonal with implicit unit leading entry.
+* Only the leading min(m, n) columns are reduced.
+*/
+template<typename NumericT>
+void host_householder_qr(NumericT * R, vcl_size_t m, vcl_size_t n, NumericT * betas)
+{
+  vcl_size_t steps = std::min(m, n);
+  for (vcl_size_t j = 0; j < steps; ++j)
+  {
+    NumericT * v = R + j * m;
+
+    NumericT sigma = 0;
+    for (vcl_size_t i = j+1; i < m; ++i)
+      sigma += v[i] * v[i];
+
+    if (sigma <= 0)
+    {
+      betas[j] = 0;
+      continue;
+    }
+
+    NumericT mu = std::sqrt(v[j] * v[j] + sigma);
+    NumericT v0 = (v[j] <= 0) ? v[j] - mu : -sigma / (v[j] + mu);
+    NumericT beta = 2 * v0 * v0 / (sigma + v0 * v0);
+    for (vcl_size_t i = j+1; i < m; ++i)
+      v[i] /= v0;
+
+    // a_c -= beta * v * (v^T a_c) for the remaining columns:
+    for (vcl_size_t c = j+1; c < n; ++c)
+    {
+      NumericT * a = R + c * m;
+      NumericT s = a[j];
+      for (vcl_size_t i = j+1; i < m; ++i)
+        s += v[i] * a[i];
+      s *= beta;
+      a[j] -= s;
+      for (vcl_size_t i = j+1; i < m; ++i)
+        a[i] -= s * v[i];
+    }
+
+    v[j] = mu;
+    betas[j] = beta;
+  }
+}
+
+/** @brief Solves the least-squares problem min ||R x - y|| with the factorization computed by host_householder_qr(). The first n entries of y are overwritten with x. */
+template<typename NumericT>
+void host_householder_solve(NumericT const * R, vcl_size_t m, vcl_size_t n, NumericT const * betas, NumericT * y)
+{
+  vcl_size_t steps = std::min(m, n);
+
+  // y = Q^T y:
+  for (vcl_size_t j = 0; j < steps; ++j)
+  {
+    NumericT const * v = R + j * m;
+    NumericT s = y[j];
+    for (vcl_size_t i = j+1; i < m; ++i)
+      s += v[i] * y[i];
+    s *= betas[j];
+    y[j] -= s;
+    for (vcl_size_t i = j+1; i < m; ++i)
+      y[i] -= s * v[i];
+  }
+
+  // back substitution with R. Columns of a rank-deficient block get zero weight:
+  for (vcl_size_t j = steps; j < n; ++j)
+    y[j] = 0;
+  for (vcl_size_t j = steps; j-- > 0; )
+  {
+    NumericT s = y[j];
+    for (vcl_size_t c = j+1; c < steps; ++c)
+      s -= R[j + c * m] * y[c];
+    y[j] = (R[j + j * m] != 0) ? s / R[j + j * m] : 0;
+  }
+}
+
+
+/** @brief Appends the rows of the given columns of B to the row index set I of the workspace */
+template<typename NumericT>
+void host_spai_add_rows(unsigned int const * B_col_buffer,
+                        unsigned int const * B_row_indices,
+                        vcl_size_t first_col,
+                        host_spai_workspace<NumericT> & ws)
+{
+  for (vcl_size_t j = first_col; j < ws.J.size(); ++j)
+    for (unsigned int k = B_col_buffer[ws.J[j]]; k < B_col_buffer[ws.J[j] + 1]; ++k)
+    {
+      unsigned int row = B_row_indices[k];
+      if (ws.row_map.find(ws.I, row) < 0)
+      {
+        ws.I.push_back(row);
+        ws.row_map.insert_last(ws.I);
+      }
+    }
+}
+
+/** @brief Computes the k-th column of the SPAI preconditioner for the matrix B given in compressed column format.
+*
+* Minimizes ||B m_k - e_k|| over the pattern of the k-th column of B.
+* If the residual norm exceeds the threshold and the tag requests a dynamic pattern, the pattern is augmented with the most profitable
+* candidates as in buildAugmentedIndexSet() (cf. Grote and Huckle) and the local problem is factored anew.
+* The result is written to ws.column.
+*
+* @return The norm of the residual of the local least-squares problem
+*/
+template<typename NumericT>
+NumericT host_spai_column(unsigned int const * B_col_buffer,
+                          unsigned int const * B_row_indices,
+                          NumericT     const * B_elements,
+                          unsigned int k,
+                          spai_tag const & tag,
+                          host_spai_workspace<NumericT> & ws)
+{
+  ws.I.clear();
+  ws.J.clear();
+  ws.row_map.reset(B_col_buffer[k+1] - B_col_buffer[k]);
+  ws.col_map.reset(B_col_buffer[k+1] - B_col_buffer[k]);
+  for (unsigned int i = B_col_buffer[k]; i < B_col_buffer[k+1]; ++i)
+  {
+    ws.J.push_back(B_row_indices[i]);
+    ws.col_map.insert_last(ws.J);
+  }
+  host_spai_add_rows(B_col_buffer, B_row_indices, 0, ws);
+
+  NumericT residual_norm = 0;
+  for (unsigned int iter = 0; ; ++iter)
+  {
+    vcl_size_t m = ws.I.size();
+    vcl_size_t n = ws.J.size();
+
+    // set up and factor A(I, J):
+    ws.block.assign(m * n, NumericT(0));
+    for (vcl_size_t j = 0; j < n; ++j)
+      for (unsigned int i = B_col_buffer[ws.J[j]]; i < B_col_buffer[ws.J[j] + 1]; ++i)
+        ws.block[static_cast<vcl_size_t>(ws.row_map.find(ws.I, B_row_indices[i])) + j * m] = B_elements[i];
+    ws.betas.resize(std::max<vcl_size_t>(n, 1));
+    host_householder_qr(&(ws.block[0]), m, n, &(ws.betas[0]));
+
+    // least-squares solution for e_k:
+    long k_position = ws.row_map.find(ws.I, k);
+    ws.rhs.assign(std::max(m, n), NumericT(0));
+    if (k_position >= 0)
+      ws.rhs[static_cast<vcl_size_t>(k_position)] = 1;
+    if (n > 0)
+      host_householder_solve(&(ws.block[0]), m, n, &(ws.betas[0]), &(ws.rhs[0]));
+
+    // residual B(:, J) m_k - e_k, which is nonzero on I only:
+    ws.residual.assign(m, NumericT(0));
+    if (k_position >= 0)
+      ws.residual[static_cast<vcl_size_t>(k_position)] = -1;
+    for (vcl_size_t j = 0; j < n; ++j)
+      for (unsigned int i = B_col_buffer[ws.J[j]]; i < B_col_buffer[ws.J[j] + 1]; ++i)
+        ws.residual[static_cast<vcl_size_t>(ws.row_map.find(ws.I, B_row_indices[i]))] += B_elements[i] * ws.rhs[j];
+
+    residual_norm = (k_position >= 0) ? 0 : 1;
+    for (vcl_size_t i = 0; i < m; ++i)
+      residual_norm += ws.residual[i] * ws.residual[i];
+    residual_norm = std::sqrt(residual_norm);
+
+    if (tag.getIsStatic() || residual_norm <= tag.getResidualNormThreshold() || iter + 1 >= tag.getIterationLimit())
+      break;
+
+    // score candidates j with large residual entries by the reduction of the residual norm, (r^T B(:,j))^2 / ||B(:,j)||^2:
+    ws.candidates.clear();
+    for (vcl_size_t r = 0; r < m; ++r)
+    {
+      unsigned int col = ws.I[r];
+      if (ws.col_map.find(ws.J, col) >= 0 || std::fabs(ws.residual[r]) <= tag.getResidualThreshold())
+        continue;
+
+      NumericT inner_prod = 0;
+      NumericT norm_squared = 0;
+      for (unsigned int i = B_col_buffer[col]; i < B_col_buffer[col + 1]; ++i)
+      {
+        long pos = ws.row_map.find(ws.I, B_row_indices[i]);
+        if (pos >= 0)
+          inner_prod += ws.residual[static_cast<vcl_size_t>(pos)] * B_elements[i];
+        norm_squared += B_elements[i] * B_elements[i];
+      }
+      if (norm_squared > 0)
+        ws.candidates.push_back(std::make_pair(inner_prod * inner_prod / norm_squared, col));
+    }
+    if (ws.candidates.empty())
+      break;
+
+    // augment J by at most |J| of the best candidates:
+    vcl_size_t num_new = std::min(n, ws.candidates.size());
+    std::partial_sort(ws.candidates.begin(), ws.candidates.begin() + static_cast<long>(num_new), ws.candidates.end(),
+                      std::greater<std::pair<NumericT, unsigned int> >());
+    for (vcl_size_t i = 0; i < num_new; ++i)
+    {
+      ws.J.push_back(ws.candidates[i].second);
+      ws.col_map.insert_last(ws.J);
+    }
+    host_spai_add_rows(B_col_buffer, B_row_indices, n, ws);
+  }
+
+  // store the column sorted by index:
+  ws.column.resize(ws.J.size());
+  for (vcl_size_t j = 0; j < ws.J.size(); ++j)
+    ws.column[j] = std::make_pair(ws.J[j], ws.rhs[j]);
+  std::sort(ws.column.begin(), ws.column.end());
+
+  return residual_norm;
+}
+
+
+/** @brief Computes the k-th row of the transposed FSPAI factor for a symmetric matrix A in CSR format.
+*
+* With the pattern J_k of the entries below the diagonal in the k-th column of A, the local system A(J_k, J_k) y_k = A(J_k, k) is solved by a dense Cholesky factorization.
+* The column of the factor L is then given by L(k,k) = (a_kk - A(k, J_k) y_k)^{-1/2} and L(J_k, k) = -L(k,k) y_k, cf. computeL().
+* The result is written to ws.column.
+*/
+template<typename NumericT>
+void host_fspai_column(unsigned int const * A_row_buffer,
+                       unsigned int const * A_col_buffer,
+                       NumericT     const * A_elements,
+                       unsigned int k,
+                       host_spai_workspace<NumericT> & ws)
+{
+  ws.J.clear();
+  NumericT a_kk = 0;
+  for (unsigned int i = A_row_buffer[k]; i < A_row_buffer[k+1]; ++i)
+  {
+    if (A_col_buffer[i] == k)
+      a_kk = A_elements[i];
+    else if (A_col_buffer[i] > k)
+      ws.J.push_back(A_col_buffer[i]);
+  }
+  std::sort(ws.J.begin(), ws.J.end());
+
+  vcl_size_t n = ws.J.size();
+  ws.col_map.assign(ws.J);
+
+  // lower triangular part of A(J_k, J_k) and right hand side A(J_k, k):
+  ws.block.assign(n * n, NumericT(0));
+  ws.rhs.assign(n, NumericT(0));
+  for (vcl_size_t j = 0; j < n; ++j)
+    for (unsigned int i = A_row_buffer[ws.J[j]]; i < A_row_buffer[ws.J[j] + 1]; ++i)
+    {
+      unsigned int col = A_col_buffer[i];
+      if (col == k)
+        ws.rhs[j] = A_elements[i];
+      else
+      {
+        long pos = ws.col_map.find(ws.J, col);
+        if (pos >= 0 && static_cast<vcl_size_t>(pos) <= j)
+          ws.block[j + static_cast<vcl_size_t>(pos) * n] = A_elements[i];
+      }
+    }
+
+  ws.residual = ws.rhs;  // keep A(J_k, k) for the computation of L(k,k)
+
+  // in-place Cholesky factorization, cf. cholesky_decompose():
+  NumericT * C = (n > 0) ? &(ws.block[0]) : NULL;
+  for (vcl_size_t c = 0; c < n; ++c)
+  {
+    assert(C[c + c * n] > 0 && bool("Matrix not positive definite in Cholesky factorization."));
+    C[c + c * n] = std::sqrt(C[c + c * n]);
+    for (vcl_size_t i = c+1; i < n; ++i)
+      C[i + c * n] /= C[c + c * n];
+    for (vcl_size_t j = c+1; j < n; ++j)
+      for (vcl_size_t i = j; i < n; ++i)
+        C[i + j * n] -= C[i + c * n] * C[j + c * n];
+  }
+
+  // forward and backward substitution, cf. cholesky_solve():
+  for (vcl_size_t i = 0; i < n; ++i)
+  {
+    NumericT s = ws.rhs[i];
+    for (vcl_size_t j = 0; j < i; ++j)
+      s -= C[i + j * n] * ws.rhs[j];
+    ws.rhs[i] = s / C[i + i * n];
+  }
+  for (vcl_size_t i = n; i-- > 0; )
+  {
+    NumericT s = ws.rhs[i];
+    for (vcl_size_t j = i+1; j < n; ++j)
+      s -= C[j + i * n] * ws.rhs[j];
+    ws.rhs[i] = s / C[i + i * n];
+  }
+
+  NumericT L_kk = a_kk;
+  for (vcl_size_t j = 0; j < n; ++j)
+    L_kk -= ws.residual[j] * ws.rhs[j];
+  assert(L_kk > 0 && bool("Matrix not positive definite in FSPAI setup."));
+  L_kk = NumericT(1) / std::sqrt(L_kk);
+
+  // row k of L^T, sorted by index:
+  ws.column.resize(n + 1);
+  ws.column[0] = std::make_pair(k, L_kk);
+  for (vcl_size_t j = 0; j < n; ++j)
+    ws.column[j+1] = std::make_pair(ws.J[j], -L_kk * ws.rhs[j]);
+  std::sort(ws.column.begin(), ws.column.end());
+}
+
+
+/** @brief Returns the number of workspaces required for the host-based setup, i.e. the maximum number of OpenMP threads */
+inline vcl_size_t host_spai_num_threads()
+{
+#ifdef VIENNACL_WITH_OPENMP
+  return static_cast<vcl_size_t>(omp_get_max_threads());
+#else
+  return 1;
+#endif
+}
+
+/** @brief Assembles the rows stored in the thread-local output buffers into a CSR matrix on the host.
+*
+* @param workspaces    The thread-local workspaces holding the rows in their output buffers
+* @param row_thread    The index of the workspace holding each row
+* @param row_offset    The offset of each row in the output buffers of its workspace
+* @param row_sizes     The number of nonzeros in each row. Overwritten.
+* @param M             The resulting matrix in main memory
+*/
+template<typename NumericT>
+void host_spai_assemble(std::vector<host_spai_workspace<NumericT> > const & workspaces,
+                        std::vector<unsigned int> const & row_thread,
+                        std::vector<vcl_size_t>   const & row_offset,
+                        std::vector<unsigned int>       & row_sizes,
+                        viennacl::compressed_matrix<NumericT> & M)
+{
+  vcl_size_t n = row_thread.size();
+
+  // exclusive scan of the row sizes:
+  row_sizes.push_back(0);
+  unsigned int nnz = 0;
+  for (vcl_size_t i = 0; i <= n; ++i)
+  {
+    unsigned int tmp = row_sizes[i];
+    row_sizes[i] = nnz;
+    nnz += tmp;
+  }
+
+  M = viennacl::compressed_matrix<NumericT>(n, n, nnz, viennacl::context(viennacl::MAIN_MEMORY));
+  unsigned int * M_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(M.handle1());
+  unsigned int * M_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(M.handle2());
+  NumericT     * M_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(M.handle());
+
+  std::copy(row_sizes.begin(), row_sizes.end(), M_row_buffer);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for
+#endif
+  for (long i2 = 0; i2 < static_cast<long>(n); ++i2)
+  {
+    vcl_size_t i = static_cast<vcl_size_t>(i2);
+    host_spai_workspace<NumericT> const & ws = workspaces[row_thread[i]];
+    vcl_size_t row_nnz = row_sizes[i+1] - row_sizes[i];
+    std::copy(ws.out_indices.begin() + static_cast<long>(row_offset[i]), ws.out_indices.begin() + static_cast<long>(row_offset[i] + row_nnz), M_col_buffer + row_sizes[i]);
+    std::copy(ws.out_values.begin()  + static_cast<long>(row_offset[i]), ws.out_values.begin()  + static_cast<long>(row_offset[i] + row_nnz), M_elements   + row_sizes[i]);
+  }
+
+  M.generate_row_block_information();
+}
+
+/** @brief Appends the column in the workspace to its output buffers and records its location */
+template<typename NumericT>
+void host_spai_store_column(host_spai_workspace<NumericT> & ws,
+                            unsigned int thread_id,
+                            vcl_size_t k,
+                            std::vector<unsigned int> & row_thread,
+                            std::vector<vcl_size_t>   & row_offset,
+                            std::vector<unsigned int> & row_sizes)
+{
+  row_thread[k] = thread_id;
+  row_offset[k] = ws.out_indices.size();
+  row_sizes[k]  = static_cast<unsigned int>(ws.column.size());
+  for (vcl_size_t i = 0; i < ws.column.size(); ++i)
+  {
+    ws.out_indices.push_back(ws.column[i].first);
+    ws.out_values.push_back(ws.column[i].second);
+  }
+}
+
+
+/** @brief Computes the SPAI preconditioner M of a matrix A residing in main memory.
+*
+* Follows computeSPAI(): For a left preconditioner (default) the rows of M approximate the rows of the inverse, i.e. M A \approx I,
+* for a right preconditioner (see spai_tag::setIsRight()) the columns of M are computed such that A M \approx I.
+*
+* @param A     The system matrix in main memory
+* @param M     The preconditioner in main memory
+* @param tag   The SPAI configuration
+*/
+template<typename NumericT>
+void host_compute_spai(viennacl::compressed_matrix<NumericT> const & A,
+                       viennacl::compressed_matrix<NumericT>       & M,
+                       spai_tag const & tag)
+{
+  // The local problems require column access to B = A (right preconditioner) or B = A^T (left preconditioner).
+  // The compressed column format of A^T is the CSR format of A, hence a transposition is only needed for right preconditioners.
+  viennacl::compressed_matrix<NumericT> A_trans(viennacl::context(viennacl::MAIN_MEMORY));
+  if (tag.getIsRight())
+    viennacl::linalg::host_based::ilu_transpose(A, A_trans);
+  viennacl::compressed_matrix<NumericT> const & B_csc = tag.getIsRight() ? A_trans : A;
+
+  unsigned int const * B_col_buffer  = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(B_csc.handle1());
+  unsigned int const * B_row_indices = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(B_csc.handle2());
+  NumericT     const * B_elements    = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(B_csc.handle());
+
+  vcl_size_t n = A.size1();
+  std::vector<host_spai_workspace<NumericT> > workspaces(host_spai_num_threads(), host_spai_workspace<NumericT>());
+  std::vector<unsigned int> row_thread(n);
+  std::vector<vcl_size_t>   row_offset(n);
+  std::vector<unsigned int> row_sizes(n);
+
+  // dynamic scheduling, since the effort per column varies with the pattern updates:
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic, 64)
+#endif
+  for (long k2 = 0; k2 < static_cast<long>(n); ++k2)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    unsigned int thread_id = static_cast<unsigned int>(omp_get_thread_num());
+#else
+    unsigned int thread_id = 0;
+#endif
+    host_spai_workspace<NumericT> & ws = workspaces[thread_id];
+    host_spai_column(B_col_buffer, B_row_indices, B_elements, static_cast<unsigned int>(k2), tag, ws);
+    host_spai_store_column(ws, thread_id, static_cast<vcl_size_t>(k2), row_thread, row_offset, row_sizes);
+  }
+
+  if (tag.getIsRight())
+  {
+    // columns of M have been computed, hence M^T is assembled and transposed:
+    host_spai_assemble(workspaces, row_thread, row_offset, row_sizes, A_trans);
+    viennacl::linalg::host_based::ilu_transpose(A_trans, M);
+  }
+  else
+    host_spai_assemble(workspaces, row_thread, row_offset, row_sizes, M);
+}
+
+
+/** @brief Computes the FSPAI preconditioner L L^T of a symmetric positive definite matrix A residing in main memory.
+*
+* The factor L is lower triangular with the pattern of the lower triangular part of A.
+* computeFSPAI() additionally includes the indices above the diagonal in J_k, for which it sets the right hand side to zero.
+*
+* @param A        The system matrix in main memory
+* @param L        The factor L in main memory
+* @param L_trans  The transposed factor L^T in main memory
+*/
+template<typename NumericT>
+void host_compute_fspai(viennacl::compressed_matrix<NumericT> const & A,
+                        viennacl::compressed_matrix<NumericT>       & L,
+                        viennacl::compressed_matrix<NumericT>       & L_trans,
+                        fspai_tag const &)
+{
+  unsigned int const * A_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * A_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+  NumericT     const * A_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+
+  vcl_size_t n = A.size1();
+  std::vector<host_spai_workspace<NumericT> > workspaces(host_spai_num_threads(), host_spai_workspace<NumericT>());
+  std::vector<unsigned int> row_thread(n);
+  std::vector<vcl_size_t>   row_offset(n);
+  std::vector<unsigned int> row_sizes(n);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic, 64)
+#endif
+  for (long k2 = 0; k2 < static_cast<long>(n); ++k2)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    unsigned int thread_id = static_cast<unsigned int>(omp_get_thread_num());
+#else
+    unsigned int thread_id = 0;
+#endif
+    host_spai_workspace<NumericT> & ws = workspaces[thread_id];
+    host_fspai_column(A_row_buffer, A_col_buffer, A_elements, static_cast<unsigned int>(k2), ws);
+    host_spai_store_column(ws, thread_id, static_cast<vcl_size_t>(k2), row_thread, row_offset, row_sizes);
+  }
+
+  host_spai_assemble(workspaces, row_thread, row_offset, row_sizes, L_trans);
+  viennacl::linalg::host_based::ilu_transpose(L_trans, L);
+}
+
+} //namespace spai
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+#endif
@@ -20,33 +20,14 @@
 
 
 /** @file viennacl/linalg/detail/spai/spai_tag.hpp
-    @brief Implementation of the spai tag holding SPAI configuration parameters. Experimental.
+    @brief Implementation of the spai and fspai tags holding SPAI and FSPAI configuration parameters. Experimental.
+
+    The tags do not depend on OpenCL or Boost.uBLAS, so that they can be shared with the host-based setup in host_spai.hpp.
 
     SPAI code contributed by Nikolay Lukash
 */
 
 
-#include <utility>
-#include <iostream>
-#include <fstream>
-#include <string>
-#include <algorithm>
-#include <vector>
-#include <math.h>
-#include <cmath>
-#include <sstream>
-#include "viennacl/ocl/backend.hpp"
-#include "boost/numeric/ublas/vector.hpp"
-#include "boost/numeric/ublas/matrix.hpp"
-#include "boost/numeric/ublas/matrix_proxy.hpp"
-#include "boost/numeric/ublas/storage.hpp"
-#include "boost/numeric/ublas/io.hpp"
-#include "boost/numeric/ublas/matrix_expression.hpp"
-#include "boost/numeric/ublas/detail/matrix_assign.hpp"
-
-#include "viennacl/linalg/detail/spai/block_matrix.hpp"
-#include "viennacl/linalg/detail/spai/block_vector.hpp"
-
 namespace viennacl
 {
 namespace linalg
@@ -136,6 +117,56 @@ private:
   bool          is_right_;
 };
 
+/** @brief A tag for FSPAI. Experimental.
+*
+* Contains values for the algorithm.
+* Must be passed to spai_precond constructor
+*/
+class fspai_tag
+{
+public:
+  /** @brief Constructor
+   *
+   * @param residual_norm_threshold Calculate until the norm of the residual falls below this threshold
+   * @param iteration_limit maximum number of iterations
+   * @param is_static determines if static version of SPAI should be used
+   * @param is_right determines if left or right preconditioner should be used
+   */
+  fspai_tag(
+          double residual_norm_threshold = 1e-3,
+          unsigned int iteration_limit = 5,
+          bool is_static = false,
+          bool is_right = false)
+    : residual_norm_threshold_(residual_norm_threshold),
+      iteration_limit_(iteration_limit),
+      is_static_(is_static),
+      is_right_(is_right) {}
+
+  inline double getResidualNormThreshold() const { return residual_norm_threshold_; }
+  inline unsigned long getIterationLimit () const { return iteration_limit_; }
+  inline bool getIsStatic() const { return is_static_; }
+  inline bool getIsRight() const  { return is_right_; }
+  inline void setResidualNormThreshold(double residual_norm_threshold)
+  {
+    if (residual_norm_threshold > 0)
+      residual_norm_threshold_ = residual_norm_threshold;
+  }
+  inline void setIterationLimit(unsigned long iteration_limit)
+  {
+    if (iteration_limit > 0)
+      iteration_limit_ = iteration_limit;
+  }
+  inline void setIsRight(bool is_right)   { is_right_  = is_right; }
+  inline void setIsStatic(bool is_static) { is_static_ = is_static; }
+
+private:
+  double residual_norm_threshold_;
+  unsigned long iteration_limit_;
+  bool is_static_;
+  bool is_right_;
+};
+
+
 }
 }
 }
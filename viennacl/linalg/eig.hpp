@@ -25,5 +25,7 @@
 #include "viennacl/linalg/bisect.hpp"
 #include "viennacl/linalg/lanczos.hpp"
 #include "viennacl/linalg/power_iter.hpp"
+#include "viennacl/linalg/symmetric_eig.hpp"
+#include "viennacl/linalg/thick_restart_lanczos.hpp"
 
 #endif
@@ -25,6 +25,7 @@
 #include <vector>
 #include <cmath>
 #include <limits>
+#include <algorithm>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/norm_2.hpp"
@@ -36,6 +37,7 @@
 #include "viennacl/meta/result_of.hpp"
 
 #include "viennacl/linalg/iterative_operations.hpp"
+#include "viennacl/linalg/solver_statistics.hpp"
 #include "viennacl/vector_proxy.hpp"
 
 
@@ -56,7 +58,8 @@ public:
   * @param krylov_dim     The maximum dimension of the Krylov space before restart (number of restarts is found by max_iterations / krylov_dim)
   */
   gmres_tag(double tol = 1e-10, unsigned int max_iterations = 300, unsigned int krylov_dim = 20)
-   : tol_(tol), abs_tol_(0), iterations_(max_iterations), krylov_dim_(krylov_dim), iters_taken_(0) {}
+   : tol_(tol), abs_tol_(0), iterations_(max_iterations), krylov_dim_(krylov_dim),
+     adaptive_krylov_dim_(false), min_krylov_dim_(1), augmentation_dim_(0), stats_(NULL), iters_taken_(0) {}
 
   /** @brief Returns the relative tolerance */
   double tolerance() const { return tol_; }
@@ -79,6 +82,25 @@ public:
     return ret;
   }
 
+  /** @brief Returns true if the Krylov space dimension is adapted between restarts */
+  bool adaptive_krylov_dim() const { return adaptive_krylov_dim_; }
+  /** @brief Enables or disables the adaptation of the Krylov space dimension between restarts.
+  *
+  * If enabled, the Krylov space dimension is decreased down to min_krylov_dim() while the residual decreases at a moderate rate,
+  * and reset to krylov_dim() if the restarted method stagnates. The total number of iterations is then bounded by max_iterations().
+  */
+  void adaptive_krylov_dim(bool enable) { adaptive_krylov_dim_ = enable; }
+
+  /** @brief Returns the minimum dimension of the Krylov space before restart if the dimension is adapted */
+  unsigned int min_krylov_dim() const { return min_krylov_dim_; }
+  /** @brief Sets the minimum dimension of the Krylov space before restart if the dimension is adapted */
+  void min_krylov_dim(unsigned int dim) { if (dim > 0) min_krylov_dim_ = dim; }
+
+  /** @brief Returns the number of approximation error vectors from previous restart cycles used for augmenting the Krylov space */
+  unsigned int augmentation_dim() const { return augmentation_dim_; }
+  /** @brief Sets the number of approximation error vectors from previous restart cycles used for augmenting the Krylov space (LGMRES). Zero disables augmentation. */
+  void augmentation_dim(unsigned int dim) { augmentation_dim_ = dim; }
+
   /** @brief Return the number of solver iterations: */
   unsigned int iters() const { return iters_taken_; }
   /** @brief Set the number of solver iterations (should only be modified by the solver) */
@@ -89,11 +111,20 @@ public:
   /** @brief Sets the estimated relative error at the end of the solver run */
   void error(double e) const { last_error_ = e; }
 
+  /** @brief Attaches an instrumentation record which is filled by subsequent solver runs. Pass NULL (default) to disable instrumentation. */
+  void statistics(solver_statistics * stats) { stats_ = stats; }
+  /** @brief Returns the attached instrumentation record, or NULL if instrumentation is disabled */
+  solver_statistics * statistics() const { return stats_; }
+
 private:
   double tol_;
   double abs_tol_;
   unsigned int iterations_;
   unsigned int krylov_dim_;
+  bool adaptive_krylov_dim_;
+  unsigned int min_krylov_dim_;
+  unsigned int augmentation_dim_;
+  solver_statistics * stats_;
 
   //return values from solver
   mutable unsigned int iters_taken_;
@@ -166,6 +197,261 @@ namespace detail
   }
 
 
+  /** @brief Implementation of restarted GMRES with adaptive Krylov space dimension and augmentation of the Krylov space with approximation errors from previous restart cycles.
+  *
+  * The Krylov space dimension is adapted after each restart cycle following the strategy proposed by Baker, Jessup, and Kolev in
+  * "A simple strategy for varying the restart parameter in GMRES(m)", J. Comput. Appl. Math. 230(2), 751-761 (2009):
+  * If the ratio of the residual norms of two consecutive cycles indicates stagnation, the maximum dimension is used.
+  * Otherwise the dimension is decreased for moderate convergence rates in order to save orthogonalization work.
+  *
+  * The augmentation follows LGMRES as proposed by Baker, Jessup, and Manteuffel in "A technique for accelerating the convergence of restarted GMRES",
+  * SIAM J. Matrix Anal. Appl. 26(4), 962-984 (2005): The corrections z of the last restart cycles are appended to the basis of the search space.
+  * Since the (preconditioned) product A*z is available as a linear combination of the Arnoldi vectors, augmentation does not require additional matrix-vector products.
+  *
+  * Uses modified Gram-Schmidt and Givens rotations. The preconditioner is applied from the left as in the classical implementation.
+  *
+  * @param matrix       The system matrix
+  * @param rhs          The load vector
+  * @param tag          Solver configuration tag
+  * @param precond      A preconditioner. Precondition operation is done via member function apply()
+  * @param monitor      A callback routine which is called at each GMRES restart
+  * @param monitor_data Data pointer to be passed to the callback routine to pass on user-specific data
+  * @return The result vector
+  */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT>
+  VectorT augmented_solve(MatrixT const & matrix,
+                          VectorT const & rhs,
+                          gmres_tag const & tag,
+                          PreconditionerT const & precond,
+                          bool (*monitor)(VectorT const &, typename viennacl::result_of::cpu_value_type<typename viennacl::result_of::value_type<VectorT>::type>::type, void*) = NULL,
+                          void *monitor_data = NULL)
+  {
+    typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
+    typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
+
+    detail::solver_statistics_recorder rec(tag.statistics(), viennacl::traits::size(rhs), sizeof(CPU_NumericType));
+
+    vcl_size_t problem_size = viennacl::traits::size(rhs);
+    VectorT result = rhs;
+    viennacl::traits::clear(result);
+
+    vcl_size_t max_krylov_dim = std::min<vcl_size_t>(tag.krylov_dim(), problem_size); //A Krylov space larger than the matrix is pointless
+    vcl_size_t min_krylov_dim = std::min<vcl_size_t>(tag.min_krylov_dim(), max_krylov_dim);
+    vcl_size_t max_augmentation_dim = tag.augmentation_dim();
+    vcl_size_t max_cycle_dim = max_krylov_dim + max_augmentation_dim;
+
+    // Thresholds for the convergence rate of a cycle (Baker, Jessup, and Kolev): Cosines of 8 and 80 degrees
+    CPU_NumericType const rate_stagnation = CPU_NumericType(0.99026806874157);
+    CPU_NumericType const rate_fast       = CPU_NumericType(0.17364817766693);
+    vcl_size_t const krylov_dim_decrement = 3;
+
+    VectorT res = rhs;
+    std::vector<VectorT> V(max_cycle_dim + 1, rhs);   // Arnoldi vectors
+    std::vector<VectorT> Z(max_augmentation_dim, rhs);   // approximation errors of previous cycles (normalized)
+    std::vector<VectorT> AZ(max_augmentation_dim, rhs);  // preconditioned matrix times the approximation errors
+    std::vector<vcl_size_t> augmentation_order;           // indices into Z and AZ, most recent first
+
+    std::vector< std::vector<CPU_NumericType> > H(max_cycle_dim, std::vector<CPU_NumericType>(max_cycle_dim + 1));      // Hessenberg matrix, column-wise
+    std::vector< std::vector<CPU_NumericType> > H_rot(max_cycle_dim, std::vector<CPU_NumericType>(max_cycle_dim + 1));  // Hessenberg matrix after Givens rotations (upper triangular)
+    std::vector<CPU_NumericType> rot_cos(max_cycle_dim);
+    std::vector<CPU_NumericType> rot_sin(max_cycle_dim);
+    std::vector<CPU_NumericType> projection_rhs(max_cycle_dim + 1);
+    std::vector<CPU_NumericType> y(max_cycle_dim);
+
+    CPU_NumericType norm_rhs = viennacl::linalg::norm_2(rhs);
+
+    tag.iters(0);
+    tag.error(0);
+
+    if (norm_rhs <= tag.abs_tolerance()) //solution is zero if RHS norm is zero
+      return result;
+
+    vcl_size_t krylov_dim = max_krylov_dim;
+    CPU_NumericType previous_rho_0 = 0;
+    rec.mark();
+
+    while (tag.iters() < tag.max_iterations())
+    {
+      //
+      // (Re-)Initialize residual: r = b - A*x (without temporary for the result of A*x)
+      //
+      res = viennacl::linalg::prod(matrix, result);
+      rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
+      res = rhs - res;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(3));
+      precond.apply(res);
+      if (detail::has_preconditioner(precond))
+        rec.record(solver_statistics::PRECONDITIONER, detail::preconditioner_bytes(precond, rec));
+
+      CPU_NumericType rho_0 = viennacl::linalg::norm_2(res);
+      rec.record(solver_statistics::REDUCTION, rec.vector_bytes(1));
+
+      tag.error(rho_0 / norm_rhs);
+      if (rho_0 / norm_rhs < tag.tolerance() || rho_0 < tag.abs_tolerance())
+        break;
+
+      //
+      // Adapt Krylov space dimension based on the convergence rate of the last cycle:
+      //
+      if (tag.adaptive_krylov_dim() && previous_rho_0 > 0)
+      {
+        CPU_NumericType rate = rho_0 / previous_rho_0;
+        if (rate > rate_stagnation)
+          krylov_dim = max_krylov_dim;
+        else if (rate > rate_fast)
+          krylov_dim = (krylov_dim >= min_krylov_dim + krylov_dim_decrement) ? krylov_dim - krylov_dim_decrement : max_krylov_dim;
+      }
+      previous_rho_0 = rho_0;
+
+      V[0] = res;
+      V[0] /= rho_0;
+      std::fill(projection_rhs.begin(), projection_rhs.end(), CPU_NumericType(0));
+      projection_rhs[0] = rho_0;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(2));
+
+      //
+      // Arnoldi process on the Krylov vectors, followed by the approximation errors of the previous cycles:
+      //
+      vcl_size_t cycle_dim = krylov_dim + augmentation_order.size();
+      CPU_NumericType rho = rho_0;
+      vcl_size_t k = 0;
+      while (k < cycle_dim && tag.iters() < tag.max_iterations())
+      {
+        tag.iters(tag.iters() + 1);
+
+        VectorT & w = V[k+1];
+        if (k < krylov_dim)
+        {
+          w = viennacl::linalg::prod(matrix, V[k]);
+          rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
+          precond.apply(w);
+          if (detail::has_preconditioner(precond))
+            rec.record(solver_statistics::PRECONDITIONER, detail::preconditioner_bytes(precond, rec));
+        }
+        else
+        {
+          w = AZ[augmentation_order[k - krylov_dim]];
+          rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(2));
+        }
+
+        // modified Gram-Schmidt:
+        for (vcl_size_t i = 0; i <= k; ++i)
+        {
+          H[k][i] = viennacl::linalg::inner_prod(w, V[i]);
+          w -= H[k][i] * V[i];
+        }
+        H[k][k+1] = viennacl::linalg::norm_2(w);
+        rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(static_cast<double>(5 * (k + 1) + 1)));
+
+        // apply previous Givens rotations to the new column, then compute the rotation eliminating the subdiagonal entry:
+        H_rot[k] = H[k];
+        for (vcl_size_t i = 0; i < k; ++i)
+        {
+          CPU_NumericType tmp = rot_cos[i] * H_rot[k][i] + rot_sin[i] * H_rot[k][i+1];
+          H_rot[k][i+1]       = rot_cos[i] * H_rot[k][i+1] - rot_sin[i] * H_rot[k][i];
+          H_rot[k][i]         = tmp;
+        }
+        CPU_NumericType diag_norm = std::sqrt(H_rot[k][k] * H_rot[k][k] + H_rot[k][k+1] * H_rot[k][k+1]);
+        rot_cos[k] = (diag_norm > 0) ? H_rot[k][k]   / diag_norm : CPU_NumericType(1);
+        rot_sin[k] = (diag_norm > 0) ? H_rot[k][k+1] / diag_norm : CPU_NumericType(0);
+        H_rot[k][k]   = diag_norm;
+        H_rot[k][k+1] = 0;
+
+        projection_rhs[k+1] = -rot_sin[k] * projection_rhs[k];
+        projection_rhs[k]   =  rot_cos[k] * projection_rhs[k];
+        rho = std::fabs(projection_rhs[k+1]);
+        rec.residual(rho / norm_rhs);
+
+        bool breakdown = !(H[k][k+1] > 0); // exact solution in current search space
+        if (!breakdown)
+        {
+          w /= H[k][k+1];
+          rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(2));
+        }
+        ++k;
+
+        if (breakdown || rho / norm_rhs < tag.tolerance() || rho < tag.abs_tolerance())
+          break;
+      }
+
+      //
+      // Solve upper triangular system for the coefficients:
+      //
+      for (vcl_size_t i2 = k; i2 > 0; --i2)
+      {
+        vcl_size_t i = i2 - 1;
+        y[i] = projection_rhs[i];
+        for (vcl_size_t j = i+1; j < k; ++j)
+          y[i] -= H_rot[j][i] * y[j];
+        y[i] = (H_rot[i][i] > 0 || H_rot[i][i] < 0) ? y[i] / H_rot[i][i] : CPU_NumericType(0);
+      }
+
+      //
+      // Correction z = sum_i y_i w_i, where w_i are the Krylov vectors and approximation errors the Arnoldi process was applied to:
+      //
+      rec.mark();
+      viennacl::traits::clear(res);
+      for (vcl_size_t i = 0; i < k; ++i)
+      {
+        if (i < krylov_dim)
+          res += y[i] * V[i];
+        else
+          res += y[i] * Z[augmentation_order[i - krylov_dim]];
+      }
+      result += res;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(static_cast<double>(3 * k + 3)));
+
+      //
+      // Store correction and its (preconditioned) image A*z = V*H*y as augmentation vector for the next cycles:
+      //
+      if (max_augmentation_dim > 0 && k > 0)
+      {
+        vcl_size_t slot = augmentation_order.size();
+        if (augmentation_order.size() == max_augmentation_dim)
+        {
+          slot = augmentation_order.back();
+          augmentation_order.pop_back();
+        }
+
+        CPU_NumericType norm_z = viennacl::linalg::norm_2(res);
+        if (norm_z > 0)
+        {
+          Z[slot] = res;
+          Z[slot] /= norm_z;
+
+          viennacl::traits::clear(AZ[slot]);
+          for (vcl_size_t i = 0; i <= k; ++i)
+          {
+            CPU_NumericType coeff = 0;
+            for (vcl_size_t j = (i > 0) ? i-1 : 0; j < k; ++j)
+              coeff += H[j][i] * y[j];
+            if (i < k || H[k-1][k] > 0)   // last Arnoldi vector is not normalized after breakdown, but its coefficient is zero anyway
+              AZ[slot] += (coeff / norm_z) * V[i];
+          }
+          augmentation_order.insert(augmentation_order.begin(), slot);
+        }
+        rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(static_cast<double>(3 * k + 6)));
+      }
+
+      //
+      // Check for convergence:
+      //
+      tag.error(rho / norm_rhs);
+      rec.iterations(tag.iters());
+
+      if (monitor && monitor(result, rho / norm_rhs, monitor_data))
+        break;
+      rec.mark();
+
+      if (tag.error() < tag.tolerance() || rho < tag.abs_tolerance())
+        break;
+    }
+
+    rec.iterations(tag.iters());
+    return result;
+  }
+
+
   /** @brief Implementation of a pipelined GMRES solver without preconditioner
   *
   * Following algorithm 2.1 proposed by Walker in "A Simpler GMRES", but uses classical Gram-Schmidt instead of modified Gram-Schmidt for better parallelization.
@@ -186,6 +472,11 @@ namespace detail
                                                bool (*monitor)(viennacl::vector<ScalarType> const &, ScalarType, void*) = NULL,
                                                void *monitor_data = NULL)
   {
+    if (tag.adaptive_krylov_dim() || tag.augmentation_dim() > 0)
+      return detail::augmented_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
+
+    detail::solver_statistics_recorder rec(tag.statistics(), rhs.size(), sizeof(ScalarType));
+
     viennacl::vector<ScalarType> residual(rhs);
     viennacl::vector<ScalarType> result = viennacl::zero_vector<ScalarType>(rhs.size(), viennacl::traits::context(rhs));
 
@@ -209,6 +500,7 @@ namespace detail
     ScalarType rho = ScalarType(1);
 
     tag.iters(0);
+    rec.mark();
 
     for (unsigned int restart_count = 0; restart_count <= tag.max_restarts(); ++restart_count)
     {
@@ -219,15 +511,19 @@ namespace detail
       {
         // compute new residual without introducing a temporary for A*x:
         residual = viennacl::linalg::prod(A, result);
+        rec.record(solver_statistics::SPMV, detail::spmv_bytes(A));
         residual = rhs - residual;
+        rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(3));
 
         rho_0 = viennacl::linalg::norm_2(residual);
+        rec.record(solver_statistics::REDUCTION, rec.vector_bytes(1));
       }
 
       if (rho_0 <= ScalarType(tag.abs_tolerance()))  // trivial right hand side?
         break;
 
       residual /= rho_0;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(2));
       rho = ScalarType(1);
 
       // check for convergence:
@@ -245,12 +541,14 @@ namespace detail
           // compute v0 = A*r and perform first reduction stage for ||v0||
           viennacl::vector_range<viennacl::vector<ScalarType> > v0(device_krylov_basis, viennacl::range(0, rhs.size()));
           viennacl::linalg::pipelined_gmres_prod(A, residual, v0, device_inner_prod_buffer);
+          rec.record(solver_statistics::SPMV, detail::spmv_bytes(A));
 
           // Normalize v_1 and compute first reduction stage for <r, v_0> in device_r_dot_vk_buffer:
           viennacl::linalg::pipelined_gmres_normalize_vk(v0, residual,
                                                          device_buffer_R, k*tag.krylov_dim() + k,
                                                          device_inner_prod_buffer, device_r_dot_vk_buffer,
                                                          buffer_size_per_vector, k*buffer_size_per_vector);
+          rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(3));
         }
         else
         {
@@ -258,11 +556,13 @@ namespace detail
           viennacl::vector_range<viennacl::vector<ScalarType> > vk        (device_krylov_basis, viennacl::range( k   *rhs.internal_size(),  k   *rhs.internal_size() + rhs.size()));
           viennacl::vector_range<viennacl::vector<ScalarType> > vk_minus_1(device_krylov_basis, viennacl::range((k-1)*rhs.internal_size(), (k-1)*rhs.internal_size() + rhs.size()));
           viennacl::linalg::pipelined_gmres_prod(A, vk_minus_1, vk, device_inner_prod_buffer);
+          rec.record(solver_statistics::SPMV, detail::spmv_bytes(A));
 
           //
           // Gram-Schmidt, stage 1: compute first reduction stage of <v_i, v_k>
           //
           viennacl::linalg::pipelined_gmres_gram_schmidt_stage1(device_krylov_basis, rhs.size(), rhs.internal_size(), k, device_vi_in_vk_buffer, buffer_size_per_vector);
+          rec.record(solver_statistics::REDUCTION, rec.vector_bytes(static_cast<double>(k + 1)));
 
           //
           // Gram-Schmidt, stage 2: compute second reduction stage of <v_i, v_k> and use that to compute v_k -= sum_i <v_i, v_k> v_i.
@@ -272,6 +572,7 @@ namespace detail
                                                                 device_vi_in_vk_buffer,
                                                                 device_buffer_R, tag.krylov_dim(),
                                                                 device_inner_prod_buffer, buffer_size_per_vector);
+          rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(static_cast<double>(k + 2)));
 
           //
           // Normalize v_k and compute first reduction stage for <r, v_k> in device_r_dot_vk_buffer:
@@ -280,6 +581,7 @@ namespace detail
                                                          device_buffer_R, k*tag.krylov_dim() + k,
                                                          device_inner_prod_buffer, device_r_dot_vk_buffer,
                                                          buffer_size_per_vector, k*buffer_size_per_vector);
+          rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(3));
         }
       }
 
@@ -299,6 +601,7 @@ namespace detail
       // Bring values in R  back to host:
       //
       viennacl::fast_copy(device_buffer_R.begin(), device_buffer_R.end(), host_buffer_R.begin());
+      rec.record(solver_statistics::REDUCTION, static_cast<double>(sizeof(ScalarType) * (device_r_dot_vk_buffer.size() + device_buffer_R.size())));
 
       //
       // Check for premature convergence: If the diagonal element drops too far below the first norm, we're done and restrict the Krylov size accordingly.
@@ -322,12 +625,14 @@ namespace detail
         // check for accumulation of round-off errors for poorly conditioned systems
         if (host_values_xi_k[i] >= rho || host_values_xi_k[i] <= -rho)
         {
+          rec.residual(std::fabs(rho*rho_0 / norm_rhs)); // the iteration is counted, but does not improve the error estimate
           k = i;
           break;  // restrict Krylov space at this point. No gain from using additional basis vectors, since orthogonality is lost.
         }
 
         // update error estimator
         rho *= std::sin( std::acos(host_values_xi_k[i] / rho) );
+        rec.residual(std::fabs(rho*rho_0 / norm_rhs));
       }
 
       //
@@ -353,14 +658,18 @@ namespace detail
 
       viennacl::fast_copy(host_update_coefficients.begin(), host_update_coefficients.end(), device_values_xi_k.begin()); //reuse device_values_xi_k_buffer here for simplicity
 
+      rec.mark();
       viennacl::linalg::pipelined_gmres_update_result(result, residual,
                                                       device_krylov_basis, rhs.size(), rhs.internal_size(),
                                                       device_values_xi_k, k);
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(static_cast<double>(k + 3)));
 
       tag.error( std::fabs(rho*rho_0 / norm_rhs) );
+      rec.iterations(tag.iters());
 
       if (monitor && monitor(result, std::fabs(rho*rho_0 / norm_rhs), monitor_data))
         break;
+      rec.mark();
     }
 
     return result;
@@ -457,6 +766,11 @@ namespace detail
     typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
     typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
 
+    if (tag.adaptive_krylov_dim() || tag.augmentation_dim() > 0)
+      return detail::augmented_solve(matrix, rhs, tag, precond, monitor, monitor_data);
+
+    detail::solver_statistics_recorder rec(tag.statistics(), viennacl::traits::size(rhs), sizeof(CPU_NumericType));
+
     unsigned int problem_size = static_cast<unsigned int>(viennacl::traits::size(rhs));
     VectorT result = rhs;
     viennacl::traits::clear(result);
@@ -481,6 +795,7 @@ namespace detail
       return result;
 
     tag.iters(0);
+    rec.mark();
 
     for (unsigned int it = 0; it <= tag.max_restarts(); ++it)
     {
@@ -488,10 +803,15 @@ namespace detail
       // (Re-)Initialize residual: r = b - A*x (without temporary for the result of A*x)
       //
       res = viennacl::linalg::prod(matrix, result);  //initial guess zero
+      rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
       res = rhs - res;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(3));
       precond.apply(res);
+      if (detail::has_preconditioner(precond))
+        rec.record(solver_statistics::PRECONDITIONER, detail::preconditioner_bytes(precond, rec));
 
       CPU_NumericType rho_0 = viennacl::linalg::norm_2(res);
+      rec.record(solver_statistics::REDUCTION, rec.vector_bytes(1));
 
       //
       // Check for premature convergence
@@ -499,6 +819,7 @@ namespace detail
       if (rho_0 / norm_rhs < tag.tolerance() || rho_0 < tag.abs_tolerance()) // norm_rhs is known to be nonzero here
       {
         tag.error(rho_0 / norm_rhs);
+        rec.iterations(tag.iters());
         return result;
       }
 
@@ -506,6 +827,7 @@ namespace detail
       // Normalize residual and set 'rho' to 1 as requested in 'A Simpler GMRES' by Walker and Zhou.
       //
       res /= rho_0;
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(2));
       CPU_NumericType rho = static_cast<CPU_NumericType>(1.0);
 
 
@@ -524,8 +846,12 @@ namespace detail
         //compute v_k = A * v_{k-1} via Householder matrices
         if (k == 0)
         {
+          rec.mark();
           v_k_tilde = viennacl::linalg::prod(matrix, res);
+          rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
           precond.apply(v_k_tilde);
+          if (detail::has_preconditioner(precond))
+            rec.record(solver_statistics::PRECONDITIONER, detail::preconditioner_bytes(precond, rec));
         }
         else
         {
@@ -535,14 +861,19 @@ namespace detail
           //Householder rotations, part 1: Compute P_1 * P_2 * ... * P_{k-1} * e_{k-1}
           for (int i = static_cast<int>(k)-1; i > -1; --i)
             detail::gmres_householder_reflect(v_k_tilde, householder_reflectors[vcl_size_t(i)], betas[vcl_size_t(i)]);
+          rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(static_cast<double>(5 * k + 1)));
 
           v_k_tilde_temp = viennacl::linalg::prod(matrix, v_k_tilde);
+          rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
           precond.apply(v_k_tilde_temp);
+          if (detail::has_preconditioner(precond))
+            rec.record(solver_statistics::PRECONDITIONER, detail::preconditioner_bytes(precond, rec));
           v_k_tilde = v_k_tilde_temp;
 
           //Householder rotations, part 2: Compute P_{k-1} * ... * P_{1} * v_k_tilde
           for (vcl_size_t i = 0; i < k; ++i)
             detail::gmres_householder_reflect(v_k_tilde, householder_reflectors[i], betas[i]);
+          rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(static_cast<double>(5 * k + 2)));
         }
 
         //
@@ -550,6 +881,7 @@ namespace detail
         //
         CPU_NumericType rho_k_k = 0;
         detail::gmres_setup_householder_vector(v_k_tilde, householder_reflectors[k], betas[k], rho_k_k, k);
+        rec.record(solver_statistics::REDUCTION, rec.vector_bytes(3));
 
         //
         // copy first k entries from v_k_tilde to R[k] in order to fill k-th column with result of
@@ -570,8 +902,10 @@ namespace detail
         if (res[k] < -rho) //machine precision reached
           res[k] = -rho;
         projection_rhs[k] = res[k];
+        rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(5));
 
         rho *= std::sin( std::acos(projection_rhs[k] / rho) );
+        rec.residual(std::fabs(rho * rho_0 / norm_rhs));
 
         if (std::fabs(rho * rho_0 / norm_rhs) < tag.tolerance())  // Residual is sufficiently reduced, stop here
         {
@@ -598,6 +932,7 @@ namespace detail
       // Note: 'projection_rhs' now holds the solution (eta_1, ..., eta_k)
       //
 
+      rec.mark();
       res *= projection_rhs[0];
 
       if (k > 0)
@@ -614,14 +949,17 @@ namespace detail
 
       res *= rho_0;
       result += res;  // x += rho_0 * z    in the paper
+      rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(static_cast<double>(5 * k + 5)));
 
       //
       // Check for convergence:
       //
       tag.error(std::fabs(rho*rho_0 / norm_rhs));
+      rec.iterations(tag.iters());
 
       if (monitor && monitor(result, std::fabs(rho*rho_0 / norm_rhs), monitor_data))
         break;
+      rec.mark();
 
       if ( tag.error() < tag.tolerance() )
         return result;
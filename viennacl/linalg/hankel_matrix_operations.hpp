@@ -23,7 +23,9 @@
 */
 
 #include "viennacl/forwards.h"
+#ifdef VIENNACL_WITH_OPENCL
 #include "viennacl/ocl/backend.hpp"
+#endif
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
@@ -57,6 +59,33 @@ void prod_impl(viennacl::hankel_matrix<NumericT, AlignmentV> const & A,
   viennacl::linalg::reverse(result);
 }
 
+/** @brief Multiplies a hankel_matrix with all columns of a dense matrix: result = A * vecs
+*
+* @param A      The matrix
+* @param vecs   The dense matrix holding the vectors as columns
+* @param result The dense result matrix
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_impl(viennacl::hankel_matrix<NumericT, AlignmentV> const & A,
+               viennacl::matrix_base<NumericT> const & vecs,
+               viennacl::matrix_base<NumericT>       & result)
+{
+  assert(A.size1() == result.size1() && bool("Dimension mismatch"));
+  assert(A.size2() == vecs.size1()   && bool("Dimension mismatch"));
+
+  prod_impl(A.elements(), vecs, result);
+
+  // A is the Toeplitz matrix with reversed rows
+  vcl_size_t inc   = result.row_major() ? result.stride1() * result.internal_size2() : result.stride1();
+  vcl_size_t col   = result.row_major() ? result.stride2() : result.stride2() * result.internal_size1();
+  vcl_size_t start = result.row_major() ? result.start1() * result.internal_size2() + result.start2() : result.start1() + result.start2() * result.internal_size1();
+  for (vcl_size_t j = 0; j < result.size2(); ++j)
+  {
+    viennacl::vector_base<NumericT> result_j(result.handle(), result.size1(), start + j * col, inc);
+    viennacl::linalg::reverse(result_j);
+  }
+}
+
 } //namespace linalg
 
 
@@ -31,6 +31,8 @@
 #include <stdexcept>
 #include <cmath>
 #include <complex>
+#include <vector>
+#include <algorithm>
 
 namespace viennacl
 {
@@ -180,6 +182,474 @@ namespace detail
       viennacl::copy(temp, in);
     }
 
+    /** @brief Computes the twiddle factors exp(sign * i * pi * g / ss) of all stages of a radix-2 transform of the given size.
+    *
+    * The factors of the stage with half-span ss are stored contiguously at offsets ss-1, ..., 2*ss-2, hence size-1 entries in total.
+    * The angles are evaluated in double precision also for single precision transforms.
+    */
+    template<typename NumericT>
+    void radix2_twiddles(std::vector<std::complex<NumericT> > & twiddles, vcl_size_t size, NumericT sign)
+    {
+      double const NUM_PI = 3.14159265358979323846;
+
+      twiddles.resize(size > 0 ? size - 1 : 0);
+      for (vcl_size_t ss = 1; ss < size; ss <<= 1)
+        for (vcl_size_t g = 0; g < ss; ++g)
+        {
+          double arg = double(sign) * NUM_PI * double(g) / double(ss);
+          twiddles[ss - 1 + g] = std::complex<NumericT>(NumericT(std::cos(arg)), NumericT(std::sin(arg)));
+        }
+    }
+
+    /** @brief Computes the roots of unity exp(sign * 2 * i * pi * k / size) for k = 0, ..., size-1 */
+    template<typename NumericT>
+    void roots_of_unity(std::vector<std::complex<NumericT> > & roots, vcl_size_t size, NumericT sign)
+    {
+      double const NUM_PI = 3.14159265358979323846;
+
+      roots.resize(size);
+      for (vcl_size_t k = 0; k < size; ++k)
+      {
+        double arg = double(sign) * 2.0 * NUM_PI * double(k) / double(size);
+        roots[k] = std::complex<NumericT>(NumericT(std::cos(arg)), NumericT(std::sin(arg)));
+      }
+    }
+
+    /** @brief Computes the bit-reversal permutation for a power-of-two size */
+    inline void bit_reversal_table(std::vector<vcl_size_t> & table, vcl_size_t size)
+    {
+      vcl_size_t bit_size = num_bits(size);
+      table.resize(size);
+      for (vcl_size_t i = 0; i < size; ++i)
+      {
+        vcl_size_t v = 0;
+        for (vcl_size_t b = 0; b < bit_size; ++b)
+          v |= ((i >> b) & 1) << (bit_size - b - 1);
+        table[i] = v;
+      }
+    }
+
+    /** @brief Splits a transform size into the radices of a mixed-radix transform: Radix 4 as often as possible, then radix 2, then the odd prime factors in ascending order. */
+    inline std::vector<vcl_size_t> mixed_radix_factors(vcl_size_t size)
+    {
+      std::vector<vcl_size_t> radices;
+      while (size % 4 == 0 && size > 1)
+      {
+        radices.push_back(4);
+        size /= 4;
+      }
+      if (size % 2 == 0 && size > 1)
+      {
+        radices.push_back(2);
+        size /= 2;
+      }
+      for (vcl_size_t p = 3; p * p <= size; p += 2)
+        while (size % p == 0)
+        {
+          radices.push_back(p);
+          size /= p;
+        }
+      if (size > 1)
+        radices.push_back(size);
+      return radices;
+    }
+
+    /** @brief Largest radix up to which the mixed-radix transform is used. Sizes with larger prime factors are transformed with Bluestein's algorithm. */
+    const vcl_size_t MAX_MIXED_RADIX = 64;
+
+    /** @brief Computes the twiddle factors of all stages of a mixed-radix Stockham transform.
+    *
+    * The stage with radix r operating on subsequences of length n_cur = r * m stores exp(sign * 2 * i * pi * p * u / n_cur) for p < m and 1 <= u < r,
+    * followed by the r-th roots of unity for radices other than 2 and 4.
+    */
+    template<typename NumericT>
+    void stockham_twiddles(std::vector<std::complex<NumericT> > & twiddles, std::vector<vcl_size_t> const & radices, vcl_size_t size, NumericT sign)
+    {
+      double const NUM_PI = 3.14159265358979323846;
+
+      twiddles.clear();
+      vcl_size_t n_cur = size;
+      for (vcl_size_t i = 0; i < radices.size(); ++i)
+      {
+        vcl_size_t r = radices[i];
+        vcl_size_t m = n_cur / r;
+        vcl_size_t num_u = (r == 4) ? 2 : r;   // radix 4 only stores exp(... p ...), the remaining factors are obtained from products
+        for (vcl_size_t p = 0; p < m; ++p)
+          for (vcl_size_t u = 1; u < num_u; ++u)
+          {
+            double arg = double(sign) * 2.0 * NUM_PI * double(p * u) / double(n_cur);
+            twiddles.push_back(std::complex<NumericT>(NumericT(std::cos(arg)), NumericT(std::sin(arg))));
+          }
+        if (r != 2 && r != 4)
+          for (vcl_size_t k = 0; k < r; ++k)
+          {
+            double arg = double(sign) * 2.0 * NUM_PI * double(k) / double(r);
+            twiddles.push_back(std::complex<NumericT>(NumericT(std::cos(arg)), NumericT(std::sin(arg))));
+          }
+        n_cur = m;
+      }
+    }
+
+    /** @brief Mixed-radix Stockham autosort transform of a single contiguous sequence of interleaved complex numbers.
+    *
+    * No bit-reversal permutation is required, instead each stage writes to the other of the two buffers.
+    * The inner loops run over contiguous memory, so that the butterflies can be vectorized by the compiler.
+    *
+    * @param x          Input sequence, overwritten
+    * @param y          Work buffer of the same size
+    * @param size       Length of the sequence
+    * @param radices    Radices as computed by mixed_radix_factors()
+    * @param twiddles   Twiddle factors as computed by stockham_twiddles()
+    * @param sign       Sign of the exponent the twiddle factors were computed with
+    * @param conjugate  If true, the transform in the opposite direction is computed
+    * @return           Pointer to the buffer (x or y) holding the result
+    */
+    template<typename NumericT>
+    NumericT * stockham_transform(NumericT * x, NumericT * y, vcl_size_t size,
+                                  std::vector<vcl_size_t> const & radices, std::complex<NumericT> const * twiddles,
+                                  NumericT sign, bool conjugate)
+    {
+      NumericT conj_sign = conjugate ? NumericT(-1) : NumericT(1);
+      NumericT eff_sign  = sign * conj_sign;
+
+      std::vector<NumericT> a, b;
+      vcl_size_t n_cur = size;
+      vcl_size_t s = 1;
+      std::complex<NumericT> const * tw = twiddles;
+      for (vcl_size_t i = 0; i < radices.size(); ++i)
+      {
+        vcl_size_t r = radices[i];
+        vcl_size_t m = n_cur / r;
+
+        if (r == 2)
+        {
+          for (vcl_size_t p = 0; p < m; ++p)
+          {
+            NumericT wr = tw[p].real();
+            NumericT wi = conj_sign * tw[p].imag();
+            NumericT const * x0 = x + 2 * s * p;
+            NumericT const * x1 = x + 2 * s * (p + m);
+            NumericT       * y0 = y + 2 * s * (2 * p);
+            NumericT       * y1 = y + 2 * s * (2 * p + 1);
+            for (vcl_size_t q = 0; q < 2 * s; q += 2)
+            {
+              NumericT dr = x0[q]   - x1[q];
+              NumericT di = x0[q+1] - x1[q+1];
+              y0[q]   = x0[q]   + x1[q];
+              y0[q+1] = x0[q+1] + x1[q+1];
+              y1[q]   = dr * wr - di * wi;
+              y1[q+1] = dr * wi + di * wr;
+            }
+          }
+          tw += m;
+        }
+        else if (r == 4)
+        {
+          for (vcl_size_t p = 0; p < m; ++p)
+          {
+            NumericT w1r = tw[p].real(), w1i = conj_sign * tw[p].imag();
+            NumericT w2r = w1r * w1r - w1i * w1i, w2i = 2 * w1r * w1i;
+            NumericT w3r = w2r * w1r - w2i * w1i, w3i = w2r * w1i + w2i * w1r;
+            NumericT const * x0 = x + 2 * s * p;
+            NumericT const * x1 = x + 2 * s * (p + m);
+            NumericT const * x2 = x + 2 * s * (p + 2 * m);
+            NumericT const * x3 = x + 2 * s * (p + 3 * m);
+            NumericT       * y0 = y + 2 * s * (4 * p);
+            NumericT       * y1 = y + 2 * s * (4 * p + 1);
+            NumericT       * y2 = y + 2 * s * (4 * p + 2);
+            NumericT       * y3 = y + 2 * s * (4 * p + 3);
+            for (vcl_size_t q = 0; q < 2 * s; q += 2)
+            {
+              NumericT t0r = x0[q]   + x2[q],   t0i = x0[q+1] + x2[q+1];
+              NumericT t1r = x0[q]   - x2[q],   t1i = x0[q+1] - x2[q+1];
+              NumericT t2r = x1[q]   + x3[q],   t2i = x1[q+1] + x3[q+1];
+              NumericT dr  = x1[q]   - x3[q],   di  = x1[q+1] - x3[q+1];
+              NumericT t3r = -eff_sign * di,    t3i = eff_sign * dr;   // multiplication by the fourth root of unity
+
+              NumericT b1r = t1r + t3r, b1i = t1i + t3i;
+              NumericT b2r = t0r - t2r, b2i = t0i - t2i;
+              NumericT b3r = t1r - t3r, b3i = t1i - t3i;
+
+              y0[q]   = t0r + t2r;
+              y0[q+1] = t0i + t2i;
+              y1[q]   = b1r * w1r - b1i * w1i;
+              y1[q+1] = b1r * w1i + b1i * w1r;
+              y2[q]   = b2r * w2r - b2i * w2i;
+              y2[q+1] = b2r * w2i + b2i * w2r;
+              y3[q]   = b3r * w3r - b3i * w3i;
+              y3[q+1] = b3r * w3i + b3i * w3r;
+            }
+          }
+          tw += m;
+        }
+        else // odd radix: pairwise symmetric evaluation of the r-point DFT
+        {
+          std::complex<NumericT> const * roots = tw + m * (r - 1);
+          vcl_size_t half = (r - 1) / 2;
+          a.resize(2 * r);
+          b.resize(2 * r);
+          for (vcl_size_t p = 0; p < m; ++p)
+          {
+            for (vcl_size_t q = 0; q < s; ++q)
+            {
+              for (vcl_size_t t = 0; t < r; ++t)
+              {
+                a[2*t]   = x[2 * (q + s * (p + t * m))];
+                a[2*t+1] = x[2 * (q + s * (p + t * m)) + 1];
+              }
+              for (vcl_size_t u = 0; u < r; ++u)
+              {
+                NumericT br = a[0];
+                NumericT bi = a[1];
+                vcl_size_t k = 0;   // (t * u) mod r
+                for (vcl_size_t t = 1; t <= half; ++t)
+                {
+                  k += u;
+                  if (k >= r)
+                    k -= r;
+                  NumericT c  = roots[k].real();
+                  NumericT sn = conj_sign * roots[k].imag();
+                  NumericT sr = a[2*t]   + a[2*(r-t)];
+                  NumericT si = a[2*t+1] + a[2*(r-t)+1];
+                  NumericT dr = a[2*t]   - a[2*(r-t)];
+                  NumericT di = a[2*t+1] - a[2*(r-t)+1];
+                  br += sr * c - sn * di;
+                  bi += si * c + sn * dr;
+                }
+                b[2*u]   = br;
+                b[2*u+1] = bi;
+              }
+
+              NumericT * y_out = y + 2 * (q + s * r * p);
+              y_out[0] = b[0];
+              y_out[1] = b[1];
+              for (vcl_size_t u = 1; u < r; ++u)
+              {
+                NumericT wr = tw[p * (r-1) + u - 1].real();
+                NumericT wi = conj_sign * tw[p * (r-1) + u - 1].imag();
+                y_out[2 * s * u]     = b[2*u] * wr - b[2*u+1] * wi;
+                y_out[2 * s * u + 1] = b[2*u] * wi + b[2*u+1] * wr;
+              }
+            }
+          }
+          tw += m * (r - 1) + r;
+        }
+
+        std::swap(x, y);
+        n_cur = m;
+        s *= r;
+      }
+      return x;
+    }
+
+    /** @brief Precomputed data for Bluestein's algorithm: The chirp, the transformed convolution kernel, and the tables of the power-of-two transforms. */
+    template<typename NumericT>
+    struct bluestein_tables
+    {
+      bluestein_tables() : ext_size(0) {}
+
+      vcl_size_t                           ext_size;   // power of two >= 2 * size - 1
+      std::vector<std::complex<NumericT> > chirp;      // exp(sign * i * pi * k^2 / size)
+      std::vector<NumericT>                kernel;     // transformed conj(chirp), zero-padded and wrapped to ext_size, interleaved
+      std::vector<vcl_size_t>              radices;
+      std::vector<std::complex<NumericT> > twiddles;
+    };
+
+    /** @brief Sets up the tables for Bluestein's algorithm for the given size */
+    template<typename NumericT>
+    void setup_bluestein(bluestein_tables<NumericT> & tables, vcl_size_t size, NumericT sign)
+    {
+      double const NUM_PI = 3.14159265358979323846;
+
+      tables.ext_size = next_power_2(2 * size - 1);
+      tables.radices  = mixed_radix_factors(tables.ext_size);
+      stockham_twiddles(tables.twiddles, tables.radices, tables.ext_size, sign);
+
+      tables.chirp.resize(size);
+      for (vcl_size_t k = 0; k < size; ++k)
+      {
+        double arg = double(sign) * NUM_PI * double((k * k) % (2 * size)) / double(size);
+        tables.chirp[k] = std::complex<NumericT>(NumericT(std::cos(arg)), NumericT(std::sin(arg)));
+      }
+
+      std::vector<NumericT> kernel(2 * tables.ext_size), work(2 * tables.ext_size);
+      for (vcl_size_t k = 0; k < size; ++k)
+      {
+        kernel[2*k]   =  tables.chirp[k].real();
+        kernel[2*k+1] = -tables.chirp[k].imag();
+        if (k > 0)
+        {
+          kernel[2*(tables.ext_size - k)]   =  tables.chirp[k].real();
+          kernel[2*(tables.ext_size - k)+1] = -tables.chirp[k].imag();
+        }
+      }
+      NumericT * result = stockham_transform(&kernel[0], &work[0], tables.ext_size, tables.radices, &tables.twiddles[0], sign, false);
+      tables.kernel.assign(result, result + 2 * tables.ext_size);
+    }
+
+    /** @brief Bluestein's algorithm for a single contiguous sequence x of interleaved complex numbers. Work buffers w1 and w2 must hold 2*ext_size values. */
+    template<typename NumericT>
+    void bluestein_transform(NumericT * x, NumericT * w1, NumericT * w2, vcl_size_t size,
+                             bluestein_tables<NumericT> const & tables, NumericT sign, bool conjugate)
+    {
+      NumericT conj_sign = conjugate ? NumericT(-1) : NumericT(1);
+      vcl_size_t M = tables.ext_size;
+
+      for (vcl_size_t k = 0; k < size; ++k)
+      {
+        NumericT cr = tables.chirp[k].real();
+        NumericT ci = conj_sign * tables.chirp[k].imag();
+        w1[2*k]   = x[2*k] * cr - x[2*k+1] * ci;
+        w1[2*k+1] = x[2*k] * ci + x[2*k+1] * cr;
+      }
+      std::fill(w1 + 2 * size, w1 + 2 * M, NumericT(0));
+
+      NumericT * A = stockham_transform(w1, w2, M, tables.radices, &tables.twiddles[0], sign, false);
+      NumericT * other = (A == w1) ? w2 : w1;
+
+      // pointwise product with the kernel spectrum. The kernel for the opposite direction is conj(b), with spectrum conj(B[-k]).
+      for (vcl_size_t k = 0; k < M; ++k)
+      {
+        vcl_size_t kk = conjugate ? (M - k) % M : k;
+        NumericT br = tables.kernel[2*kk];
+        NumericT bi = conj_sign * tables.kernel[2*kk+1];
+        NumericT ar = A[2*k];
+        NumericT ai = A[2*k+1];
+        A[2*k]   = ar * br - ai * bi;
+        A[2*k+1] = ar * bi + ai * br;
+      }
+
+      NumericT * conv = stockham_transform(A, other, M, tables.radices, &tables.twiddles[0], sign, true);
+      NumericT scale = NumericT(1) / NumericT(M);
+      for (vcl_size_t k = 0; k < size; ++k)
+      {
+        NumericT cr = tables.chirp[k].real();
+        NumericT ci = conj_sign * tables.chirp[k].imag();
+        x[2*k]   = scale * (conv[2*k] * cr - conv[2*k+1] * ci);
+        x[2*k+1] = scale * (conv[2*k] * ci + conv[2*k+1] * cr);
+      }
+    }
+
+    /** @brief Minimum transform size for which the six-step algorithm is used for a single transform */
+    const vcl_size_t FOUR_STEP_MIN_SIZE = 65536;
+
+    /** @brief Block size (in complex numbers) of the cache-blocked transposes */
+    const vcl_size_t TRANSPOSE_BLOCK_SIZE = 32;
+
+    /** @brief Number of interleaved (column-major) transforms which are gathered and transformed together */
+    const vcl_size_t FFT_COLUMN_PANEL = 8;
+
+    /** @brief Precomputed data for the four-step/six-step (Bailey) algorithm with size = n1 * n2 */
+    template<typename NumericT>
+    struct four_step_tables
+    {
+      four_step_tables() : n1(0), n2(0) {}
+
+      vcl_size_t                           n1;
+      vcl_size_t                           n2;
+      std::vector<vcl_size_t>              radices1;
+      std::vector<std::complex<NumericT> > twiddles1;
+      std::vector<vcl_size_t>              radices2;
+      std::vector<std::complex<NumericT> > twiddles2;
+      std::vector<std::complex<NumericT> > omega_lo;   // exp(sign * 2 * i * pi * t / size) for t < n1
+      std::vector<std::complex<NumericT> > omega_hi;   // exp(sign * 2 * i * pi * t * n1 / size) for t < n2
+    };
+
+    /** @brief Sets up the six-step algorithm by splitting the radices into two groups of similar product. Returns false if no useful split exists. */
+    template<typename NumericT>
+    bool setup_four_step(four_step_tables<NumericT> & tables, vcl_size_t size, std::vector<vcl_size_t> const & radices, NumericT sign)
+    {
+      double const NUM_PI = 3.14159265358979323846;
+
+      vcl_size_t n1 = 1;
+      vcl_size_t i = 0;
+      while (i < radices.size() && n1 * radices[i] * n1 * radices[i] <= size)
+        n1 *= radices[i++];
+      if (n1 < 16 || size / n1 < 16)
+        return false;
+
+      tables.n1 = n1;
+      tables.n2 = size / n1;
+      tables.radices1.assign(radices.begin(), radices.begin() + long(i));
+      tables.radices2.assign(radices.begin() + long(i), radices.end());
+      stockham_twiddles(tables.twiddles1, tables.radices1, tables.n1, sign);
+      stockham_twiddles(tables.twiddles2, tables.radices2, tables.n2, sign);
+
+      tables.omega_lo.resize(tables.n1);
+      for (vcl_size_t t = 0; t < tables.n1; ++t)
+      {
+        double arg = double(sign) * 2.0 * NUM_PI * double(t) / double(size);
+        tables.omega_lo[t] = std::complex<NumericT>(NumericT(std::cos(arg)), NumericT(std::sin(arg)));
+      }
+      tables.omega_hi.resize(tables.n2);
+      for (vcl_size_t t = 0; t < tables.n2; ++t)
+      {
+        double arg = double(sign) * 2.0 * NUM_PI * double(t * tables.n1) / double(size);
+        tables.omega_hi[t] = std::complex<NumericT>(NumericT(std::cos(arg)), NumericT(std::sin(arg)));
+      }
+      return true;
+    }
+
+    /** @brief Cache-blocked out-of-place transpose of a rows-by-cols row-major matrix of interleaved complex numbers */
+    template<typename NumericT>
+    void blocked_transpose(NumericT const * in, NumericT * out, vcl_size_t rows, vcl_size_t cols)
+    {
+      vcl_size_t const B = TRANSPOSE_BLOCK_SIZE;
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (rows * cols > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+      for (long ib2 = 0; ib2 < long((rows + B - 1) / B); ++ib2)
+      {
+        vcl_size_t i_begin = vcl_size_t(ib2) * B;
+        vcl_size_t i_end   = std::min(i_begin + B, rows);
+        for (vcl_size_t j_begin = 0; j_begin < cols; j_begin += B)
+        {
+          vcl_size_t j_end = std::min(j_begin + B, cols);
+          for (vcl_size_t i = i_begin; i < i_end; ++i)
+            for (vcl_size_t j = j_begin; j < j_end; ++j)
+            {
+              out[2 * (j * rows + i)]     = in[2 * (i * cols + j)];
+              out[2 * (j * rows + i) + 1] = in[2 * (i * cols + j) + 1];
+            }
+        }
+      }
+    }
+
+    /** @brief Cache-blocked transpose of the n2-by-n1 intermediate result of the six-step algorithm, fused with the multiplication by the twiddle factors exp(sign * 2 * i * pi * j2 * k1 / size) */
+    template<typename NumericT>
+    void blocked_transpose_twiddle(NumericT const * in, NumericT * out, four_step_tables<NumericT> const & tables, bool conjugate)
+    {
+      vcl_size_t const B = TRANSPOSE_BLOCK_SIZE;
+      vcl_size_t rows = tables.n2;
+      vcl_size_t cols = tables.n1;
+      NumericT conj_sign = conjugate ? NumericT(-1) : NumericT(1);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (rows * cols > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+      for (long ib2 = 0; ib2 < long((rows + B - 1) / B); ++ib2)
+      {
+        vcl_size_t i_begin = vcl_size_t(ib2) * B;
+        vcl_size_t i_end   = std::min(i_begin + B, rows);
+        for (vcl_size_t j_begin = 0; j_begin < cols; j_begin += B)
+        {
+          vcl_size_t j_end = std::min(j_begin + B, cols);
+          for (vcl_size_t i = i_begin; i < i_end; ++i)   // i = j2
+            for (vcl_size_t j = j_begin; j < j_end; ++j) // j = k1
+            {
+              vcl_size_t t = i * j;   // < size
+              std::complex<NumericT> const & lo = tables.omega_lo[t % cols];
+              std::complex<NumericT> const & hi = tables.omega_hi[t / cols];
+              NumericT wr = lo.real() * hi.real() - lo.imag() * hi.imag();
+              NumericT wi = conj_sign * (lo.real() * hi.imag() + lo.imag() * hi.real());
+              NumericT xr = in[2 * (i * cols + j)];
+              NumericT xi = in[2 * (i * cols + j) + 1];
+              out[2 * (j * rows + i)]     = xr * wr - xi * wi;
+              out[2 * (j * rows + i) + 1] = xr * wi + xi * wr;
+            }
+        }
+      }
+    }
+
     template<typename NumericT>
     void zero2(NumericT *input1, NumericT *input2, vcl_size_t size)
     {
@@ -223,7 +693,7 @@ void fft_direct(std::complex<NumericT> * input_complex, std::complex<NumericT> *
           input = input_complex[batch_id * stride + n]; //input index here
         else
           input = input_complex[n * stride + batch_id];
-        NumericT arg = sign * 2 * NUM_PI * NumericT(k) / NumericT(size * n);
+        NumericT arg = sign * 2 * NUM_PI * NumericT((k * n) % size) / NumericT(size);
         NumericT sn  = std::sin(arg);
         NumericT cs  = std::cos(arg);
 
@@ -514,6 +984,441 @@ void fft_radix2_local(std::complex<NumericT> * input_complex,
 
 }
 
+/**
+ * @brief Radix-2 algorithm for computing Fourier transformation with precomputed twiddle factors and bit-reversal permutation.
+ *
+ * Operates in-place on interleaved complex data (real part at even, imaginary part at odd positions).
+ *
+ * @param data          Interleaved complex data
+ * @param size          Length of each transform (power of two)
+ * @param stride        Distance between consecutive transforms (ROW_MAJOR) or consecutive elements of a transform (COL_MAJOR) in complex numbers
+ * @param batch_num     Number of transforms
+ * @param twiddles      Twiddle factors as computed by detail::fft::radix2_twiddles()
+ * @param bit_reversal  Bit-reversal permutation as computed by detail::fft::bit_reversal_table()
+ * @param conjugate     If true, the complex conjugate twiddle factors are used, i.e. the transform in the opposite direction is computed
+ * @param scale         Factor applied to the result, e.g. 1/size for inverse transforms
+ * @param data_order    Layout of the batch
+ */
+template<typename NumericT>
+void fft_radix2_tables(NumericT * data, vcl_size_t size, vcl_size_t stride, vcl_size_t batch_num,
+                       std::complex<NumericT> const * twiddles, vcl_size_t const * bit_reversal,
+                       bool conjugate, NumericT scale,
+                       viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
+{
+  vcl_size_t elem_stride  = data_order ? 2 * stride : 2;
+  vcl_size_t batch_stride = data_order ? 2 : 2 * stride;
+  NumericT conj_sign = conjugate ? NumericT(-1) : NumericT(1);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (batch_num > 1 && size * batch_num > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long batch_id2 = 0; batch_id2 < long(batch_num); batch_id2++)
+  {
+    NumericT * x = data + vcl_size_t(batch_id2) * batch_stride;
+
+    for (vcl_size_t i = 0; i < size; ++i)
+    {
+      vcl_size_t j = bit_reversal[i];
+      if (i < j)
+      {
+        std::swap(x[i * elem_stride],     x[j * elem_stride]);
+        std::swap(x[i * elem_stride + 1], x[j * elem_stride + 1]);
+      }
+    }
+
+    for (vcl_size_t ss = 1; ss < size; ss <<= 1)
+    {
+      std::complex<NumericT> const * tw = twiddles + ss - 1;
+      for (vcl_size_t pos = 0; pos < size; pos += 2 * ss)
+      {
+        NumericT * x1 = x + pos * elem_stride;
+        NumericT * x2 = x + (pos + ss) * elem_stride;
+        for (vcl_size_t g = 0; g < ss; ++g)
+        {
+          NumericT wr = tw[g].real();
+          NumericT wi = conj_sign * tw[g].imag();
+          vcl_size_t k = g * elem_stride;
+          NumericT tr = x2[k] * wr - x2[k+1] * wi;
+          NumericT ti = x2[k] * wi + x2[k+1] * wr;
+          x2[k]   = x1[k]   - tr;
+          x2[k+1] = x1[k+1] - ti;
+          x1[k]   += tr;
+          x1[k+1] += ti;
+        }
+      }
+    }
+
+    if (scale < 1 || scale > 1)
+      for (vcl_size_t i = 0; i < size; ++i)
+      {
+        x[i * elem_stride]     *= scale;
+        x[i * elem_stride + 1] *= scale;
+      }
+  }
+}
+
+/**
+ * @brief Direct algorithm for computing Fourier transformation with precomputed roots of unity.
+ *
+ * Operates in-place on interleaved complex data. Works on any sizes of data with o(n^2) complexity, but avoids the evaluation of transcendental functions.
+ * Parameters are the same as for fft_radix2_tables(), with the roots of unity as computed by detail::fft::roots_of_unity() instead of the twiddle factors.
+ */
+template<typename NumericT>
+void fft_direct_tables(NumericT * data, vcl_size_t size, vcl_size_t stride, vcl_size_t batch_num,
+                       std::complex<NumericT> const * roots, bool conjugate, NumericT scale,
+                       viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
+{
+  vcl_size_t elem_stride  = data_order ? 2 * stride : 2;
+  vcl_size_t batch_stride = data_order ? 2 : 2 * stride;
+  NumericT conj_sign = conjugate ? NumericT(-1) : NumericT(1);
+
+  std::vector<std::complex<NumericT> > input(size);
+  for (vcl_size_t batch_id = 0; batch_id < batch_num; ++batch_id)
+  {
+    NumericT * x = data + batch_id * batch_stride;
+    for (vcl_size_t i = 0; i < size; ++i)
+      input[i] = std::complex<NumericT>(x[i * elem_stride], x[i * elem_stride + 1]);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (size > 64)
+#endif
+    for (long k2 = 0; k2 < long(size); k2++)
+    {
+      vcl_size_t k = vcl_size_t(k2);
+      NumericT fr = 0;
+      NumericT fi = 0;
+      vcl_size_t index = 0;   // (n * k) mod size
+      for (vcl_size_t n = 0; n < size; ++n)
+      {
+        NumericT wr = roots[index].real();
+        NumericT wi = conj_sign * roots[index].imag();
+        fr += input[n].real() * wr - input[n].imag() * wi;
+        fi += input[n].real() * wi + input[n].imag() * wr;
+        index += k;
+        if (index >= size)
+          index -= size;
+      }
+      x[k * elem_stride]     = scale * fr;
+      x[k * elem_stride + 1] = scale * fi;
+    }
+  }
+}
+
+/**
+ * @brief Mixed-radix Stockham algorithm for computing Fourier transformation with precomputed twiddle factors.
+ *
+ * Operates in-place on interleaved complex data of any size for which detail::fft::mixed_radix_factors() yields small radices.
+ * Parameters are the same as for fft_radix2_tables(), with the radices and the twiddle factors as computed by detail::fft::stockham_twiddles().
+ */
+template<typename NumericT>
+void fft_stockham_tables(NumericT * data, vcl_size_t size, vcl_size_t stride, vcl_size_t batch_num,
+                         std::vector<vcl_size_t> const & radices, std::complex<NumericT> const * twiddles,
+                         NumericT sign, bool conjugate, NumericT scale,
+                         viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
+{
+  vcl_size_t elem_stride  = data_order ? 2 * stride : 2;
+  vcl_size_t batch_stride = data_order ? 2 : 2 * stride;
+
+  if (data_order == viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::COL_MAJOR && batch_num > 1)
+  {
+    // interleaved transforms: gather panels of neighboring transforms row by row (blocked transpose), so that all loaded cache lines are used
+    vcl_size_t const P = viennacl::linalg::host_based::detail::fft::FFT_COLUMN_PANEL;
+    vcl_size_t num_panels = (batch_num + P - 1) / P;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if (size * batch_num > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    {
+      std::vector<NumericT> panel(2 * size * P), work1(2 * size);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long panel_id2 = 0; panel_id2 < long(num_panels); panel_id2++)
+      {
+        vcl_size_t first = vcl_size_t(panel_id2) * P;
+        vcl_size_t width = std::min(P, batch_num - first);
+        NumericT * x = data + first * batch_stride;
+
+        for (vcl_size_t i = 0; i < size; ++i)
+          for (vcl_size_t c = 0; c < width; ++c)
+          {
+            panel[2 * (c * size + i)]     = x[i * elem_stride + 2 * c];
+            panel[2 * (c * size + i) + 1] = x[i * elem_stride + 2 * c + 1];
+          }
+
+        for (vcl_size_t c = 0; c < width; ++c)
+        {
+          NumericT * column = &panel[2 * c * size];
+          NumericT * result = viennacl::linalg::host_based::detail::fft::stockham_transform(column, &work1[0], size, radices, twiddles, sign, conjugate);
+          if (result != column)
+            std::copy(result, result + 2 * size, column);
+        }
+
+        for (vcl_size_t i = 0; i < size; ++i)
+          for (vcl_size_t c = 0; c < width; ++c)
+          {
+            x[i * elem_stride + 2 * c]     = scale * panel[2 * (c * size + i)];
+            x[i * elem_stride + 2 * c + 1] = scale * panel[2 * (c * size + i) + 1];
+          }
+      }
+    }
+    return;
+  }
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if (batch_num > 1 && size * batch_num > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  {
+    std::vector<NumericT> work0(2 * size), work1(2 * size);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long batch_id2 = 0; batch_id2 < long(batch_num); batch_id2++)
+    {
+      NumericT * x = data + vcl_size_t(batch_id2) * batch_stride;
+      for (vcl_size_t i = 0; i < size; ++i)
+      {
+        work0[2*i]   = x[i * elem_stride];
+        work0[2*i+1] = x[i * elem_stride + 1];
+      }
+
+      NumericT * result = viennacl::linalg::host_based::detail::fft::stockham_transform(&work0[0], &work1[0], size, radices, twiddles, sign, conjugate);
+
+      for (vcl_size_t i = 0; i < size; ++i)
+      {
+        x[i * elem_stride]     = scale * result[2*i];
+        x[i * elem_stride + 1] = scale * result[2*i+1];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Bluestein's algorithm for computing Fourier transformation with precomputed tables.
+ *
+ * Operates in-place on interleaved complex data of any size. Used for sizes with large prime factors.
+ * Parameters are the same as for fft_radix2_tables(), with the tables as computed by detail::fft::setup_bluestein().
+ */
+template<typename NumericT>
+void fft_bluestein_tables(NumericT * data, vcl_size_t size, vcl_size_t stride, vcl_size_t batch_num,
+                          viennacl::linalg::host_based::detail::fft::bluestein_tables<NumericT> const & tables,
+                          NumericT sign, bool conjugate, NumericT scale,
+                          viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
+{
+  vcl_size_t elem_stride  = data_order ? 2 * stride : 2;
+  vcl_size_t batch_stride = data_order ? 2 : 2 * stride;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if (batch_num > 1)
+#endif
+  {
+    std::vector<NumericT> x_local(2 * size), work0(2 * tables.ext_size), work1(2 * tables.ext_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long batch_id2 = 0; batch_id2 < long(batch_num); batch_id2++)
+    {
+      NumericT * x = data + vcl_size_t(batch_id2) * batch_stride;
+      for (vcl_size_t i = 0; i < size; ++i)
+      {
+        x_local[2*i]   = x[i * elem_stride];
+        x_local[2*i+1] = x[i * elem_stride + 1];
+      }
+
+      viennacl::linalg::host_based::detail::fft::bluestein_transform(&x_local[0], &work0[0], &work1[0], size, tables, sign, conjugate);
+
+      for (vcl_size_t i = 0; i < size; ++i)
+      {
+        x[i * elem_stride]     = scale * x_local[2*i];
+        x[i * elem_stride + 1] = scale * x_local[2*i+1];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Six-step (Bailey) algorithm for computing large Fourier transformations with precomputed tables.
+ *
+ * A transform of size n1 * n2 is decomposed into n2 transforms of size n1 and n1 transforms of size n2, which are distributed over the threads,
+ * with cache-blocked transposes in between. Thus, also a single large transform uses all cores, and each sub-transform fits into cache.
+ * Operates in-place on interleaved complex data, parameters are the same as for fft_radix2_tables(), with the tables as computed by detail::fft::setup_four_step().
+ */
+template<typename NumericT>
+void fft_four_step_tables(NumericT * data, vcl_size_t size, vcl_size_t stride, vcl_size_t batch_num,
+                          viennacl::linalg::host_based::detail::fft::four_step_tables<NumericT> const & tables,
+                          NumericT sign, bool conjugate, NumericT scale,
+                          viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
+{
+  vcl_size_t elem_stride  = data_order ? 2 * stride : 2;
+  vcl_size_t batch_stride = data_order ? 2 : 2 * stride;
+  bool contiguous = (elem_stride == 2);
+
+  std::vector<NumericT> x_local(contiguous ? 0 : 2 * size);
+  std::vector<NumericT> work(2 * size);
+  for (vcl_size_t batch_id = 0; batch_id < batch_num; ++batch_id)
+  {
+    NumericT * x_global = data + batch_id * batch_stride;
+    NumericT * x = contiguous ? x_global : &x_local[0];
+    if (!contiguous)
+      for (vcl_size_t i = 0; i < size; ++i)
+      {
+        x[2*i]   = x_global[i * elem_stride];
+        x[2*i+1] = x_global[i * elem_stride + 1];
+      }
+
+    // x is viewed as n1-by-n2 row-major matrix
+    viennacl::linalg::host_based::detail::fft::blocked_transpose(x, &work[0], tables.n1, tables.n2);
+    fft_stockham_tables(&work[0], tables.n1, tables.n1, tables.n2, tables.radices1, &tables.twiddles1[0], sign, conjugate, NumericT(1));
+    viennacl::linalg::host_based::detail::fft::blocked_transpose_twiddle(&work[0], x, tables, conjugate);
+    fft_stockham_tables(x, tables.n2, tables.n2, tables.n1, tables.radices2, &tables.twiddles2[0], sign, conjugate, NumericT(1));
+    viennacl::linalg::host_based::detail::fft::blocked_transpose(x, &work[0], tables.n1, tables.n2);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+    for (long i2 = 0; i2 < long(size); ++i2)
+    {
+      vcl_size_t i = vcl_size_t(i2);
+      x_global[i * elem_stride]     = scale * work[2*i];
+      x_global[i * elem_stride + 1] = scale * work[2*i+1];
+    }
+  }
+}
+
+/**
+ * @brief Copies batch_num blocks of count values with the respective distances between consecutive blocks.
+ */
+template<typename NumericT>
+void fft_copy_batches(NumericT const * input, vcl_size_t input_stride,
+                      NumericT       * output, vcl_size_t output_stride,
+                      vcl_size_t count, vcl_size_t batch_num)
+{
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (count * batch_num > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long b2 = 0; b2 < long(batch_num); ++b2)
+  {
+    NumericT const * in  = input  + vcl_size_t(b2) * input_stride;
+    NumericT       * out = output + vcl_size_t(b2) * output_stride;
+    for (vcl_size_t i = 0; i < count; ++i)
+      out[i] = in[i];
+  }
+}
+
+/**
+ * @brief Recovers the spectrum of real data of even length from the complex transform of half length.
+ *
+ * On input, each transform in data holds Z = FFT(z) with z_j = x_{2j} + i x_{2j+1}, j < size/2.
+ * On output, each transform holds the non-redundant part X_0, ..., X_{size/2} of the Hermitian spectrum of x.
+ *
+ * @param data       Interleaved complex data, size/2 + 1 complex numbers per transform
+ * @param size       Length of the real transforms (even)
+ * @param stride     Distance between consecutive transforms in real numbers
+ * @param batch_num  Number of transforms
+ * @param omega      Twiddle factors exp(sign * 2 * i * pi * k / size) for k <= size/4
+ */
+template<typename NumericT>
+void fft_real_postprocess(NumericT * data, vcl_size_t size, vcl_size_t stride, vcl_size_t batch_num,
+                          std::complex<NumericT> const * omega)
+{
+  vcl_size_t m = size / 2;
+  vcl_size_t pairs = m / 2 + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (size * batch_num > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long idx2 = 0; idx2 < long(pairs * batch_num); ++idx2)
+  {
+    vcl_size_t b = vcl_size_t(idx2) / pairs;
+    vcl_size_t k = vcl_size_t(idx2) % pairs;
+    vcl_size_t j = m - k;
+    NumericT * Z = data + b * stride;
+
+    NumericT zk_r = Z[2*k],       zk_i = Z[2*k+1];
+    NumericT zj_r = Z[2*(j % m)], zj_i = Z[2*(j % m)+1];
+
+    // even part: (Z_k + conj(Z_j)) / 2, odd part: (Z_k - conj(Z_j)) / (2i)
+    NumericT fe_r = NumericT(0.5) * (zk_r + zj_r);
+    NumericT fe_i = NumericT(0.5) * (zk_i - zj_i);
+    NumericT fo_r = NumericT(0.5) * (zk_i + zj_i);
+    NumericT fo_i = NumericT(0.5) * (zj_r - zk_r);
+
+    NumericT w_r = omega[k].real(), w_i = omega[k].imag();
+    NumericT t_r = w_r * fo_r - w_i * fo_i;
+    NumericT t_i = w_r * fo_i + w_i * fo_r;
+
+    // X_k = Fe + w^k Fo,  X_{m-k} = conj(Fe - w^k Fo)
+    Z[2*k]   = fe_r + t_r;
+    Z[2*k+1] = fe_i + t_i;
+    if (j != k)
+    {
+      Z[2*j]   =   fe_r - t_r;
+      Z[2*j+1] = -(fe_i - t_i);
+    }
+  }
+}
+
+/**
+ * @brief Prepares the complex transform of half length for the inverse transform of a Hermitian spectrum to real data of even length.
+ *
+ * Inverse of fft_real_postprocess(): Reads X_0, ..., X_{size/2} from input and writes Z to output, such that
+ * the inverse transform of Z yields z_j = x_{2j} + i x_{2j+1}.
+ *
+ * @param input          Interleaved complex spectra, size/2 + 1 complex numbers per transform
+ * @param input_stride   Distance between consecutive spectra in real numbers
+ * @param output         Interleaved complex data, size/2 complex numbers per transform
+ * @param output_stride  Distance between consecutive transforms in the output in real numbers
+ * @param size           Length of the real transforms (even)
+ * @param batch_num      Number of transforms
+ * @param omega          Twiddle factors exp(sign * 2 * i * pi * k / size) for k <= size/4
+ */
+template<typename NumericT>
+void fft_real_preprocess(NumericT const * input, vcl_size_t input_stride,
+                         NumericT       * output, vcl_size_t output_stride,
+                         vcl_size_t size, vcl_size_t batch_num,
+                         std::complex<NumericT> const * omega)
+{
+  vcl_size_t m = size / 2;
+  vcl_size_t pairs = m / 2 + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (size * batch_num > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long idx2 = 0; idx2 < long(pairs * batch_num); ++idx2)
+  {
+    vcl_size_t b = vcl_size_t(idx2) / pairs;
+    vcl_size_t k = vcl_size_t(idx2) % pairs;
+    vcl_size_t j = m - k;
+    NumericT const * X = input  + b * input_stride;
+    NumericT       * Z = output + b * output_stride;
+
+    NumericT xk_r = X[2*k], xk_i = X[2*k+1];
+    NumericT xj_r = X[2*j], xj_i = X[2*j+1];
+
+    // Fe = (X_k + conj(X_j)) / 2,  Fo = (X_k - conj(X_j)) conj(w^k) / 2
+    NumericT fe_r = NumericT(0.5) * (xk_r + xj_r);
+    NumericT fe_i = NumericT(0.5) * (xk_i - xj_i);
+    NumericT d_r  = NumericT(0.5) * (xk_r - xj_r);
+    NumericT d_i  = NumericT(0.5) * (xk_i + xj_i);
+
+    NumericT w_r = omega[k].real(), w_i = omega[k].imag();
+    NumericT fo_r = d_r * w_r + d_i * w_i;
+    NumericT fo_i = d_i * w_r - d_r * w_i;
+
+    // Z_k = Fe + i Fo,  Z_{m-k} = conj(Fe) + i conj(Fo)
+    Z[2*k]   = fe_r - fo_i;
+    Z[2*k+1] = fe_i + fo_r;
+    if (j != k && j < m)
+    {
+      Z[2*j]   =  fe_r + fo_i;
+      Z[2*j+1] = -fe_i + fo_r;
+    }
+  }
+}
+
 /**
  * @brief Radix-2 1D algorithm for computing Fourier transformation.
  *
@@ -526,25 +1431,16 @@ void radix2(viennacl::vector<NumericT, AlignmentV>& in, vcl_size_t size, vcl_siz
             vcl_size_t batch_num, NumericT sign = NumericT(-1),
             viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
 {
+  if (size < 2)
+    return;
 
-  vcl_size_t bit_size = viennacl::linalg::host_based::detail::fft::num_bits(size);
-
-  std::vector<std::complex<NumericT> > input_complex(size * batch_num);
-  std::vector<std::complex<NumericT> > lcl_input(size * batch_num);
-  viennacl::linalg::host_based::detail::fft::copy_to_complex_array(&input_complex[0], in, size * batch_num);
-
-  if (size <= viennacl::linalg::host_based::detail::fft::MAX_LOCAL_POINTS_NUM)
-  {
-    viennacl::linalg::host_based::fft_radix2_local(&input_complex[0], &lcl_input[0], batch_num, bit_size, size, stride, sign, data_order);
-  }
-  else
-  {
-    viennacl::linalg::host_based::reorder<NumericT>(in, size, stride, bit_size, batch_num, data_order);
-    viennacl::linalg::host_based::detail::fft::copy_to_complex_array(&input_complex[0], in, size * batch_num);
-    viennacl::linalg::host_based::fft_radix2(&input_complex[0], batch_num, bit_size, size, stride, sign, data_order);
-  }
+  std::vector<std::complex<NumericT> > twiddles;
+  std::vector<vcl_size_t> bit_reversal;
+  viennacl::linalg::host_based::detail::fft::radix2_twiddles(twiddles, size, sign);
+  viennacl::linalg::host_based::detail::fft::bit_reversal_table(bit_reversal, size);
 
-  viennacl::linalg::host_based::detail::fft::copy_to_vector(&input_complex[0], in, size * batch_num);
+  NumericT * data = detail::extract_raw_pointer<NumericT>(in);
+  viennacl::linalg::host_based::fft_radix2_tables(data, size, stride, batch_num, &twiddles[0], &bit_reversal[0], false, NumericT(1), data_order);
 }
 
 /**
@@ -559,33 +1455,16 @@ void radix2(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>& in, vcl
             vcl_size_t stride, vcl_size_t batch_num, NumericT sign = NumericT(-1),
             viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
 {
+  if (size < 2)
+    return;
 
-  vcl_size_t bit_size = viennacl::linalg::host_based::detail::fft::num_bits(size);
+  std::vector<std::complex<NumericT> > twiddles;
+  std::vector<vcl_size_t> bit_reversal;
+  viennacl::linalg::host_based::detail::fft::radix2_twiddles(twiddles, size, sign);
+  viennacl::linalg::host_based::detail::fft::bit_reversal_table(bit_reversal, size);
 
   NumericT * data = detail::extract_raw_pointer<NumericT>(in);
-
-  vcl_size_t row_num = in.internal_size1();
-  vcl_size_t col_num = in.internal_size2() >> 1;
-  vcl_size_t size_mat = row_num * col_num;
-
-  std::vector<std::complex<NumericT> > input_complex(size_mat);
-
-  viennacl::linalg::host_based::detail::fft::copy_to_complex_array(&input_complex[0], data, size_mat);
-  if (size <= viennacl::linalg::host_based::detail::fft::MAX_LOCAL_POINTS_NUM)
-  {
-    //std::cout<<bit_size<<","<<size<<","<<stride<<","<<batch_num<<","<<size<<","<<sign<<","<<data_order<<std::endl;
-    std::vector<std::complex<NumericT> > lcl_input(size_mat);
-    viennacl::linalg::host_based::fft_radix2_local(&input_complex[0], &lcl_input[0], batch_num, bit_size, size, stride, sign, data_order);
-  }
-  else
-  {
-    viennacl::linalg::host_based::reorder<NumericT>(in, size, stride, bit_size, batch_num, data_order);
-    viennacl::linalg::host_based::detail::fft::copy_to_complex_array(&input_complex[0], data, size_mat);
-    viennacl::linalg::host_based::fft_radix2(&input_complex[0], batch_num, bit_size, size, stride, sign, data_order);
-  }
-
-  viennacl::linalg::host_based::detail::fft::copy_to_vector(&input_complex[0], data, size_mat);
-
+  viennacl::linalg::host_based::fft_radix2_tables(data, size, stride, batch_num, &twiddles[0], &bit_reversal[0], false, NumericT(1), data_order);
 }
 
 /**
@@ -834,18 +1713,21 @@ void complex_to_real(viennacl::vector_base<NumericT> const & in,
 template<typename NumericT>
 void reverse(viennacl::vector_base<NumericT> & in)
 {
-  vcl_size_t size = in.size();
+  vcl_size_t size   = in.size();
+  vcl_size_t stride = in.stride();
+  NumericT * data   = detail::extract_raw_pointer<NumericT>(in) + in.start();
 
+  // swap the first half with the second half (iterating over all entries would swap each pair twice)
 #ifdef VIENNACL_WITH_OPENMP
   #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
 #endif
-  for (long i2 = 0; i2 < long(size); i2++)
+  for (long i2 = 0; i2 < long(size / 2); i2++)
   {
     vcl_size_t i = vcl_size_t(i2);
-    NumericT val1 = in[i];
-    NumericT val2 = in[size - i - 1];
-    in[i] = val2;
-    in[size - i - 1] = val1;
+    NumericT val1 = data[i * stride];
+    NumericT val2 = data[(size - i - 1) * stride];
+    data[i * stride] = val2;
+    data[(size - i - 1) * stride] = val1;
   }
 }
 
@@ -664,6 +664,112 @@ void ilu_form_neumann_matrix(compressed_matrix<NumericT> & R,
   //std::cout << "diag_R: " << diag_R << std::endl;
 }
 
+
+/** @brief Approximate triangular solve (D - D R) x = vec with the matrix R = I - D^{-1}T obtained from ilu_form_neumann_matrix(), using a fixed number of fused (block-)Jacobi sweeps.
+  *
+  * Starting with x_1 = D^{-1} vec, each sweep computes x_{k+1} = R x_k + D^{-1} vec in a single pass over R.
+  * For block sizes larger than one, rows are grouped into blocks of consecutive rows. Within each block the triangular system is solved exactly by substitution,
+  * while entries outside the block are taken from the previous sweep (block-Jacobi). A single block spanning all rows yields the exact triangular solve.
+  * Block-Jacobi starts from x_0 = 0, so that the first sweep is the exact substitution with the diagonal blocks.
+  * The resulting operator is then the transpose of the one for the transposed triangular system, hence symmetric factorizations yield symmetric preconditioners.
+  *
+  * @param R           The (strictly lower or strictly upper triangular) iteration matrix I - D^{-1}T
+  * @param diag_R      The diagonal D of the triangular matrix T
+  * @param vec         On input the right hand side, on output the approximate solution. Ranges and slices are supported for vec and the work vectors.
+  * @param x_buffer    Work vector of the same size as vec
+  * @param b_buffer    Work vector of the same size as vec, holds D^{-1} vec on output
+  * @param num_sweeps  Number of sweeps after the initial guess (after the first block substitution for block-Jacobi)
+  * @param block_size  Number of consecutive rows per block. A value of one yields point-Jacobi sweeps.
+  * @param lower       True if R is lower triangular, false if R is upper triangular
+  */
+template<typename NumericT>
+void ilu_jacobi_solve(compressed_matrix<NumericT> const & R,
+                      vector<NumericT> const & diag_R,
+                      vector_base<NumericT> & vec,
+                      vector_base<NumericT> & x_buffer,
+                      vector_base<NumericT> & b_buffer,
+                      vcl_size_t num_sweeps,
+                      vcl_size_t block_size,
+                      bool lower)
+{
+  unsigned int const *R_row_buffer = detail::extract_raw_pointer<unsigned int>(R.handle1());
+  unsigned int const *R_col_buffer = detail::extract_raw_pointer<unsigned int>(R.handle2());
+  NumericT     const *R_elements   = detail::extract_raw_pointer<NumericT>(R.handle());
+
+  NumericT const *diag_ptr = detail::extract_raw_pointer<NumericT>(diag_R.handle());
+  NumericT       *vec_ptr  = detail::extract_raw_pointer<NumericT>(vec.handle())      + viennacl::traits::start(vec);
+  NumericT       *x_ptr    = detail::extract_raw_pointer<NumericT>(x_buffer.handle()) + viennacl::traits::start(x_buffer);
+  NumericT       *b_ptr    = detail::extract_raw_pointer<NumericT>(b_buffer.handle()) + viennacl::traits::start(b_buffer);
+
+  long vec_inc = static_cast<long>(viennacl::traits::stride(vec));
+  long x_inc   = static_cast<long>(viennacl::traits::stride(x_buffer));
+  long b_inc   = static_cast<long>(viennacl::traits::stride(b_buffer));
+
+  block_size = std::max<vcl_size_t>(block_size, 1);
+  long num_rows   = static_cast<long>(R.size1());
+  long num_blocks = (num_rows + long(block_size) - 1) / long(block_size);
+
+  // x_1 = D^{-1} vec
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (num_rows > VIENNACL_OPENMP_ILU_MIN_SIZE)
+#endif
+  for (long row = 0; row < num_rows; ++row)
+    b_ptr[row * b_inc] = vec_ptr[row * vec_inc] / diag_ptr[row];
+
+  // point-Jacobi starts from x_1 = D^{-1} vec, block-Jacobi from x_0 = 0 (with one additional sweep):
+  NumericT const *x_old = NULL;
+  long x_old_inc = 0;
+  if (block_size == 1)
+  {
+    if (num_sweeps == 0)
+    {
+      for (long row = 0; row < num_rows; ++row)
+        vec_ptr[row * vec_inc] = b_ptr[row * b_inc];
+      return;
+    }
+    x_old     = b_ptr;
+    x_old_inc = b_inc;
+  }
+  else
+    ++num_sweeps;
+
+  // the destinations alternate between x_buffer and vec such that the last sweep writes to vec:
+  for (vcl_size_t sweep = 0; sweep < num_sweeps; ++sweep)
+  {
+    bool to_vec = ((num_sweeps - sweep) % 2 == 1);
+    NumericT *x_new     = to_vec ? vec_ptr : x_ptr;
+    long      x_new_inc = to_vec ? vec_inc : x_inc;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (num_rows > VIENNACL_OPENMP_ILU_MIN_SIZE)
+#endif
+    for (long block = 0; block < num_blocks; ++block)
+    {
+      long block_begin = block * long(block_size);
+      long block_end   = std::min(num_rows, block_begin + long(block_size));
+      for (long i = 0; i < block_end - block_begin; ++i)
+      {
+        long row = lower ? block_begin + i : block_end - i - 1;
+        NumericT sum = 0;
+        for (unsigned int j = R_row_buffer[row]; j < R_row_buffer[row+1]; ++j)
+        {
+          long col = static_cast<long>(R_col_buffer[j]);
+          if (col == row)
+            continue;
+          if (col >= block_begin && col < block_end)
+            sum += R_elements[j] * x_new[col * x_new_inc];
+          else if (x_old)
+            sum += R_elements[j] * x_old[col * x_old_inc];
+        }
+        x_new[row * x_new_inc] = sum + b_ptr[row * b_inc];
+      }
+    }
+
+    x_old     = x_new;
+    x_old_inc = x_new_inc;
+  }
+}
+
 } //namespace host_based
 } //namespace linalg
 } //namespace viennacl
@@ -505,6 +505,438 @@ void pipelined_cg_prod(hyb_matrix<NumericT> const & A,
   viennacl::linalg::host_based::detail::pipelined_prod_impl(A, p, Ap, PtrType(NULL), inner_prod_buffer, inner_prod_buffer.size() / 3, 0);
 }
 
+//////////////////////////
+
+namespace detail
+{
+  /** @brief Updates the search direction p = z + beta * p of a classical CG algorithm in place.
+    *
+    * Must be called from within an OpenMP parallel region (if enabled), the work is shared among the threads of the region.
+    */
+  template<typename NumericT>
+  void fused_cg_direction_update(NumericT const * z_buf, NumericT beta, NumericT * p_buf, vcl_size_t size)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for
+#endif
+    for (long i2 = 0; i2 < static_cast<long>(size); ++i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      p_buf[i] = z_buf[i] + beta * p_buf[i];
+    }
+  }
+
+
+  /** @brief Implementation of the fused search direction update and matrix-vector product with a compressed_matrix for a classical CG algorithm on the host.
+    *
+    * This routines computes for a matrix A, vectors 'z', 'p', 'Ap' and a scalar beta:
+    *   p  = z + beta * p;
+    *   Ap = prod(A, p);
+    * and stores inner_prod(p, Ap) in the second entry of inner_prod_buffer.
+    * Both sweeps run within a single parallel region, so that each thread reads back the entries of p it has just written.
+    */
+  template<typename NumericT>
+  void fused_cg_prod_impl(compressed_matrix<NumericT> const & A,
+                          vector_base<NumericT> const & z,
+                          NumericT beta,
+                          vector_base<NumericT> & p,
+                          vector_base<NumericT> & Ap,
+                          vector_base<NumericT> & inner_prod_buffer)
+  {
+    typedef NumericT        value_type;
+
+    value_type   const *  z_buf      = detail::extract_raw_pointer<value_type>(z.handle()) + viennacl::traits::start(z);
+    value_type         *  p_buf      = detail::extract_raw_pointer<value_type>(p.handle()) + viennacl::traits::start(p);
+    value_type         * Ap_buf      = detail::extract_raw_pointer<value_type>(Ap.handle()) + viennacl::traits::start(Ap);
+    value_type   const * elements    = detail::extract_raw_pointer<value_type>(A.handle());
+    unsigned int const *  row_buffer = detail::extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const *  col_buffer = detail::extract_raw_pointer<unsigned int>(A.handle2());
+    value_type         * data_buffer = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
+
+    value_type inner_prod_pAp = 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      fused_cg_direction_update(z_buf, beta, p_buf, A.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for reduction(+: inner_prod_pAp)
+#endif
+      for (long row = 0; row < static_cast<long>(A.size1()); ++row)
+      {
+        value_type dot_prod = 0;
+
+        vcl_size_t row_end = row_buffer[row+1];
+        for (vcl_size_t i = row_buffer[row]; i < row_end; ++i)
+          dot_prod += elements[i] * p_buf[col_buffer[i]];
+
+        Ap_buf[static_cast<vcl_size_t>(row)] = dot_prod;
+        inner_prod_pAp += p_buf[static_cast<vcl_size_t>(row)] * dot_prod;
+      }
+    }
+
+    data_buffer[1] = inner_prod_pAp;
+  }
+
+
+  /** @brief Returns the first row owned by chunk 'chunk' out of 'num_chunks' of a coordinate_matrix with entries sorted by row.
+    *
+    * The nonzeros are split evenly, the split point is then moved forward to the start of the next row, so that no row is shared by two chunks.
+    */
+  inline vcl_size_t fused_cg_coo_chunk_row(unsigned int const * coord_buffer, vcl_size_t nnz, vcl_size_t rows, vcl_size_t chunk, vcl_size_t num_chunks, vcl_size_t & entry)
+  {
+    if (chunk == 0)
+    {
+      entry = 0;
+      return 0;
+    }
+    entry = (nnz * chunk) / num_chunks;
+    while (entry > 0 && entry < nnz && coord_buffer[2*entry] == coord_buffer[2*entry - 2])
+      ++entry;
+    return (chunk < num_chunks && entry < nnz) ? coord_buffer[2*entry] : rows;
+  }
+
+
+  /** @brief Implementation of the fused search direction update and matrix-vector product with a coordinate_matrix for a classical CG algorithm on the host.
+    *
+    * This routines computes for a matrix A, vectors 'z', 'p', 'Ap' and a scalar beta:
+    *   p  = z + beta * p;
+    *   Ap = prod(A, p);
+    * and stores inner_prod(p, Ap) in the second entry of inner_prod_buffer.
+    * The entries of A are required to be sorted by row as set up by viennacl::copy(). Each thread processes a contiguous range of rows,
+    * so that the products are accumulated without races and the inner product is computed in the same sweep.
+    */
+  template<typename NumericT, unsigned int AlignmentV>
+  void fused_cg_prod_impl(coordinate_matrix<NumericT, AlignmentV> const & A,
+                          vector_base<NumericT> const & z,
+                          NumericT beta,
+                          vector_base<NumericT> & p,
+                          vector_base<NumericT> & Ap,
+                          vector_base<NumericT> & inner_prod_buffer)
+  {
+    typedef NumericT        value_type;
+
+    value_type   const *  z_buf       = detail::extract_raw_pointer<value_type>(z.handle()) + viennacl::traits::start(z);
+    value_type         *  p_buf       = detail::extract_raw_pointer<value_type>(p.handle()) + viennacl::traits::start(p);
+    value_type         * Ap_buf       = detail::extract_raw_pointer<value_type>(Ap.handle()) + viennacl::traits::start(Ap);
+    value_type   const * elements     = detail::extract_raw_pointer<value_type>(A.handle());
+    unsigned int const * coord_buffer = detail::extract_raw_pointer<unsigned int>(A.handle12());
+    value_type         * data_buffer  = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
+
+    value_type inner_prod_pAp = 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      fused_cg_direction_update(z_buf, beta, p_buf, A.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+      long num_chunks = omp_get_num_threads();
+      #pragma omp for schedule(static, 1) reduction(+: inner_prod_pAp)
+#else
+      long num_chunks = 1;
+#endif
+      for (long chunk = 0; chunk < num_chunks; ++chunk)
+      {
+        vcl_size_t entry, entry_end;
+        vcl_size_t row     = fused_cg_coo_chunk_row(coord_buffer, A.nnz(), A.size1(), static_cast<vcl_size_t>(chunk),     static_cast<vcl_size_t>(num_chunks), entry);
+        vcl_size_t row_end = fused_cg_coo_chunk_row(coord_buffer, A.nnz(), A.size1(), static_cast<vcl_size_t>(chunk + 1), static_cast<vcl_size_t>(num_chunks), entry_end);
+
+        for (; row < row_end; ++row)
+        {
+          value_type dot_prod = 0;
+          for (; entry < entry_end && coord_buffer[2*entry] == row; ++entry)
+            dot_prod += elements[entry] * p_buf[coord_buffer[2*entry+1]];
+
+          Ap_buf[row] = dot_prod;
+          inner_prod_pAp += p_buf[row] * dot_prod;
+        }
+      }
+    }
+
+    data_buffer[1] = inner_prod_pAp;
+  }
+
+
+  /** @brief Implementation of the fused search direction update and matrix-vector product with an ell_matrix for a classical CG algorithm on the host.
+    *
+    * This routines computes for a matrix A, vectors 'z', 'p', 'Ap' and a scalar beta:
+    *   p  = z + beta * p;
+    *   Ap = prod(A, p);
+    * and stores inner_prod(p, Ap) in the second entry of inner_prod_buffer.
+    */
+  template<typename NumericT>
+  void fused_cg_prod_impl(ell_matrix<NumericT> const & A,
+                          vector_base<NumericT> const & z,
+                          NumericT beta,
+                          vector_base<NumericT> & p,
+                          vector_base<NumericT> & Ap,
+                          vector_base<NumericT> & inner_prod_buffer)
+  {
+    typedef NumericT     value_type;
+
+    value_type   const *  z_buf       = detail::extract_raw_pointer<value_type>(z.handle()) + viennacl::traits::start(z);
+    value_type         *  p_buf       = detail::extract_raw_pointer<value_type>(p.handle()) + viennacl::traits::start(p);
+    value_type         * Ap_buf       = detail::extract_raw_pointer<value_type>(Ap.handle()) + viennacl::traits::start(Ap);
+    value_type   const * elements     = detail::extract_raw_pointer<value_type>(A.handle());
+    unsigned int const * coords       = detail::extract_raw_pointer<unsigned int>(A.handle2());
+    value_type         * data_buffer  = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
+
+    value_type inner_prod_pAp = 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      fused_cg_direction_update(z_buf, beta, p_buf, A.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for reduction(+: inner_prod_pAp)
+#endif
+      for (long row2 = 0; row2 < static_cast<long>(A.size1()); ++row2)
+      {
+        vcl_size_t row = static_cast<vcl_size_t>(row2);
+        value_type sum = 0;
+
+        for (unsigned int item_id = 0; item_id < A.internal_maxnnz(); ++item_id)
+        {
+          vcl_size_t offset = row + item_id * A.internal_size1();
+          value_type val = elements[offset];
+
+          if (val)
+            sum += p_buf[coords[offset]] * val;
+        }
+
+        Ap_buf[row] = sum;
+        inner_prod_pAp += p_buf[row] * sum;
+      }
+    }
+
+    data_buffer[1] = inner_prod_pAp;
+  }
+
+
+  /** @brief Implementation of the fused search direction update and matrix-vector product with a sliced_ell_matrix for a classical CG algorithm on the host.
+    *
+    * This routines computes for a matrix A, vectors 'z', 'p', 'Ap' and a scalar beta:
+    *   p  = z + beta * p;
+    *   Ap = prod(A, p);
+    * and stores inner_prod(p, Ap) in the second entry of inner_prod_buffer.
+    */
+  template<typename NumericT, typename IndexT>
+  void fused_cg_prod_impl(sliced_ell_matrix<NumericT, IndexT> const & A,
+                          vector_base<NumericT> const & z,
+                          NumericT beta,
+                          vector_base<NumericT> & p,
+                          vector_base<NumericT> & Ap,
+                          vector_base<NumericT> & inner_prod_buffer)
+  {
+    typedef NumericT     value_type;
+
+    value_type const *  z_buf            = detail::extract_raw_pointer<value_type>(z.handle()) + viennacl::traits::start(z);
+    value_type       *  p_buf            = detail::extract_raw_pointer<value_type>(p.handle()) + viennacl::traits::start(p);
+    value_type       * Ap_buf            = detail::extract_raw_pointer<value_type>(Ap.handle()) + viennacl::traits::start(Ap);
+    value_type const * elements          = detail::extract_raw_pointer<value_type>(A.handle());
+    IndexT     const * columns_per_block = detail::extract_raw_pointer<IndexT>(A.handle1());
+    IndexT     const * column_indices    = detail::extract_raw_pointer<IndexT>(A.handle2());
+    IndexT     const * block_start       = detail::extract_raw_pointer<IndexT>(A.handle3());
+    value_type         * data_buffer     = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
+
+    vcl_size_t num_blocks = A.size1() / A.rows_per_block() + 1;
+
+    value_type inner_prod_pAp = 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      fused_cg_direction_update(z_buf, beta, p_buf, A.size1());
+
+      std::vector<value_type> result_values(A.rows_per_block()); // one buffer per thread
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for reduction(+: inner_prod_pAp)
+#endif
+      for (long block_idx2 = 0; block_idx2 < static_cast<long>(num_blocks); ++block_idx2)
+      {
+        vcl_size_t block_idx = static_cast<vcl_size_t>(block_idx2);
+        vcl_size_t current_columns_per_block = columns_per_block[block_idx];
+
+        std::fill(result_values.begin(), result_values.end(), value_type(0));
+
+        for (IndexT column_entry_index = 0;
+                    column_entry_index < current_columns_per_block;
+                  ++column_entry_index)
+        {
+          vcl_size_t stride_start = block_start[block_idx] + column_entry_index * A.rows_per_block();
+          for (IndexT row_in_block = 0; row_in_block < A.rows_per_block(); ++row_in_block)
+          {
+            value_type val = elements[stride_start + row_in_block];
+            if (val)
+              result_values[row_in_block] += p_buf[column_indices[stride_start + row_in_block]] * val;
+          }
+        }
+
+        vcl_size_t first_row_in_matrix = block_idx * A.rows_per_block();
+        for (IndexT row_in_block = 0; row_in_block < A.rows_per_block(); ++row_in_block)
+        {
+          vcl_size_t row = first_row_in_matrix + row_in_block;
+          if (row < Ap.size())
+          {
+            value_type row_result = result_values[row_in_block];
+
+            Ap_buf[row] = row_result;
+            inner_prod_pAp += p_buf[row] * row_result;
+          }
+        }
+      }
+    }
+
+    data_buffer[1] = inner_prod_pAp;
+  }
+
+
+  /** @brief Implementation of the fused search direction update and matrix-vector product with a hyb_matrix for a classical CG algorithm on the host.
+    *
+    * This routines computes for a matrix A, vectors 'z', 'p', 'Ap' and a scalar beta:
+    *   p  = z + beta * p;
+    *   Ap = prod(A, p);
+    * and stores inner_prod(p, Ap) in the second entry of inner_prod_buffer.
+    */
+  template<typename NumericT>
+  void fused_cg_prod_impl(hyb_matrix<NumericT> const & A,
+                          vector_base<NumericT> const & z,
+                          NumericT beta,
+                          vector_base<NumericT> & p,
+                          vector_base<NumericT> & Ap,
+                          vector_base<NumericT> & inner_prod_buffer)
+  {
+    typedef NumericT     value_type;
+    typedef unsigned int index_type;
+
+    value_type const *  z_buf            = detail::extract_raw_pointer<value_type>(z.handle()) + viennacl::traits::start(z);
+    value_type       *  p_buf            = detail::extract_raw_pointer<value_type>(p.handle()) + viennacl::traits::start(p);
+    value_type       * Ap_buf            = detail::extract_raw_pointer<value_type>(Ap.handle()) + viennacl::traits::start(Ap);
+    value_type const * elements          = detail::extract_raw_pointer<value_type>(A.handle());
+    index_type const * coords            = detail::extract_raw_pointer<index_type>(A.handle2());
+    value_type const * csr_elements      = detail::extract_raw_pointer<value_type>(A.handle5());
+    index_type const * csr_row_buffer    = detail::extract_raw_pointer<index_type>(A.handle3());
+    index_type const * csr_col_buffer    = detail::extract_raw_pointer<index_type>(A.handle4());
+    value_type         * data_buffer     = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
+
+    value_type inner_prod_pAp = 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      fused_cg_direction_update(z_buf, beta, p_buf, A.size1());
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for reduction(+: inner_prod_pAp)
+#endif
+      for (long row2 = 0; row2 < static_cast<long>(A.size1()); ++row2)
+      {
+        vcl_size_t row = static_cast<vcl_size_t>(row2);
+        value_type sum = 0;
+
+        //
+        // Part 1: Process ELL part
+        //
+        for (index_type item_id = 0; item_id < A.internal_ellnnz(); ++item_id)
+        {
+          vcl_size_t offset = row + item_id * A.internal_size1();
+          value_type val = elements[offset];
+
+          if (val)
+            sum += p_buf[coords[offset]] * val;
+        }
+
+        //
+        // Part 2: Process HYB part
+        //
+        vcl_size_t col_begin = csr_row_buffer[row];
+        vcl_size_t col_end   = csr_row_buffer[row + 1];
+
+        for (vcl_size_t item_id = col_begin; item_id < col_end; item_id++)
+          sum += p_buf[csr_col_buffer[item_id]] * csr_elements[item_id];
+
+        Ap_buf[row] = sum;
+        inner_prod_pAp += p_buf[row] * sum;
+      }
+    }
+
+    data_buffer[1] = inner_prod_pAp;
+  }
+
+} // namespace detail
+
+
+/** @brief Performs the fused search direction update and matrix-vector product of a classical (non-pipelined) CG algorithm on the host.
+  *
+  * This routines computes for a sparse matrix A, vectors 'z', 'p', 'Ap' and a scalar beta within a single parallel region:
+  *   p  = z + beta * p;
+  *   Ap = prod(A, p);
+  * and stores inner_prod(p, Ap) in the second entry of inner_prod_buffer.
+  * Supported matrix types are compressed_matrix, coordinate_matrix (with entries sorted by row), ell_matrix, sliced_ell_matrix, and hyb_matrix.
+  */
+template<typename MatrixT, typename NumericT>
+void fused_cg_prod(MatrixT const & A,
+                   vector_base<NumericT> const & z,
+                   NumericT beta,
+                   vector_base<NumericT> & p,
+                   vector_base<NumericT> & Ap,
+                   vector_base<NumericT> & inner_prod_buffer)
+{
+  viennacl::linalg::host_based::detail::fused_cg_prod_impl(A, z, beta, p, Ap, inner_prod_buffer);
+}
+
+/** @brief Performs the joint vector update of a classical (non-pipelined) CG algorithm on the host.
+  *
+  * This routines computes for vectors 'result', 'p', 'r', 'Ap' in a single sweep:
+  *   result += alpha * p;
+  *   r      -= alpha * Ap;
+  * and stores inner_prod(r, r) in the first entry of inner_prod_buffer.
+  */
+template<typename NumericT>
+void fused_cg_vector_update(vector_base<NumericT> & result,
+                            NumericT alpha,
+                            vector_base<NumericT> const & p,
+                            vector_base<NumericT> & r,
+                            vector_base<NumericT> const & Ap,
+                            vector_base<NumericT> & inner_prod_buffer)
+{
+  typedef NumericT       value_type;
+
+  value_type       * data_result = detail::extract_raw_pointer<value_type>(result);
+  value_type const * data_p      = detail::extract_raw_pointer<value_type>(p);
+  value_type       * data_r      = detail::extract_raw_pointer<value_type>(r);
+  value_type const * data_Ap     = detail::extract_raw_pointer<value_type>(Ap);
+  value_type       * data_buffer = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
+
+  // Note: Due to the special setting in CG, there is no need to check for sizes and strides
+  vcl_size_t size  = viennacl::traits::size(result);
+
+  value_type inner_prod_r = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: inner_prod_r)
+#endif
+  for (long i = 0; i < static_cast<long>(size); ++i)
+  {
+    value_type value_r = data_r[static_cast<vcl_size_t>(i)] - alpha * data_Ap[static_cast<vcl_size_t>(i)];
+
+    data_result[static_cast<vcl_size_t>(i)] += alpha * data_p[static_cast<vcl_size_t>(i)];
+    data_r[static_cast<vcl_size_t>(i)] = value_r;
+    inner_prod_r += value_r * value_r;
+  }
+
+  data_buffer[0] = inner_prod_r;
+}
+
+
 //////////////////////////
 
 
@@ -0,0 +1,76 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_VANDERMONDE_MATRIX_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_VANDERMONDE_MATRIX_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/vandermonde_matrix_operations.hpp
+    @brief Implementations of operations using vandermonde_matrix on the CPU using a single thread or OpenMP.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+
+/** @brief Carries out matrix-vector multiplication with a vandermonde_matrix
+*
+* Implementation of the convenience expression y = prod(A, x); Each row is evaluated with Horner's scheme.
+*
+* @param A    The Vandermonde matrix
+* @param x    The vector
+* @param y    The result vector
+*/
+template<typename NumericT, unsigned int AlignmentV>
+void prod_impl(viennacl::vandermonde_matrix<NumericT, AlignmentV> const & A,
+               viennacl::vector_base<NumericT> const & x,
+               viennacl::vector_base<NumericT>       & y)
+{
+  NumericT const * nodes = detail::extract_raw_pointer<NumericT>(A.elements());
+  NumericT const * x_buf = detail::extract_raw_pointer<NumericT>(x) + x.start();
+  NumericT       * y_buf = detail::extract_raw_pointer<NumericT>(y) + y.start();
+
+  vcl_size_t x_inc  = x.stride();
+  vcl_size_t y_inc  = y.stride();
+  vcl_size_t x_size = x.size();
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if (A.size1() * x_size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+  for (long i2 = 0; i2 < long(A.size1()); ++i2)
+  {
+    vcl_size_t i = vcl_size_t(i2);
+    NumericT node = nodes[i];
+    NumericT val = 0;
+    for (vcl_size_t j = x_size; j > 0; --j)
+      val = val * node + x_buf[(j - 1) * x_inc];
+    y_buf[i * y_inc] = val;
+  }
+}
+
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
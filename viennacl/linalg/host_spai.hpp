@@ -0,0 +1,144 @@
+#ifndef VIENNACL_LINALG_HOST_SPAI_HPP
+#define VIENNACL_LINALG_HOST_SPAI_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_spai.hpp
+    @brief SPAI and FSPAI preconditioners for compressed_matrix with the setup computed on the host using OpenMP. Requires neither OpenCL nor Boost.uBLAS. Experimental.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/detail/spai/spai_tag.hpp"
+#include "viennacl/linalg/detail/spai/host_spai.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+typedef viennacl::linalg::detail::spai::spai_tag         spai_tag;
+typedef viennacl::linalg::detail::spai::fspai_tag        fspai_tag;
+
+/** @brief SPAI preconditioner with host-based setup. Only available for compressed_matrix, see specialization below. */
+template<typename MatrixT>
+class host_spai_precond;
+
+/** @brief SPAI preconditioner for a compressed_matrix, where the setup is computed on the host.
+*
+* The least-squares problems for the columns are distributed over the OpenMP threads. The preconditioner is moved to the memory domain of the system matrix.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+class host_spai_precond< viennacl::compressed_matrix<NumericT, AlignmentV> >
+{
+  typedef viennacl::compressed_matrix<NumericT, AlignmentV>   MatrixType;
+
+public:
+  /** @brief Constructor
+   * @param A    matrix whose approximate inverse is calculated. Must be quadratic.
+   * @param tag  spai tag
+   */
+  host_spai_precond(MatrixType const & A, spai_tag const & tag)
+    : tag_(tag), M_(viennacl::context(viennacl::MAIN_MEMORY)), tmp_(A.size1(), viennacl::traits::context(A))
+  {
+    viennacl::context host_context(viennacl::MAIN_MEMORY);
+    viennacl::compressed_matrix<NumericT> host_A(host_context);
+    host_A = A;
+
+    viennacl::linalg::detail::spai::host_compute_spai(host_A, M_, tag_);
+    viennacl::switch_memory_context(M_, viennacl::traits::context(A));
+  }
+
+  /** @brief Application of current preconditioner, multiplication on the right-hand side vector
+   * @param vec rhs vector
+   */
+  template<typename VectorT>
+  void apply(VectorT & vec) const
+  {
+    tmp_ = viennacl::linalg::prod(M_, vec);
+    vec = tmp_;
+  }
+
+  /** @brief Returns the computed approximate inverse */
+  viennacl::compressed_matrix<NumericT> const & matrix() const { return M_; }
+
+private:
+  spai_tag tag_;
+  viennacl::compressed_matrix<NumericT> M_;
+  mutable viennacl::vector<NumericT> tmp_;
+};
+
+
+/** @brief FSPAI preconditioner with host-based setup. Only available for compressed_matrix, see specialization below. */
+template<typename MatrixT>
+class host_fspai_precond;
+
+/** @brief FSPAI preconditioner for a symmetric positive definite compressed_matrix, where the setup is computed on the host.
+*
+* The local Cholesky problems for the columns of the factor are distributed over the OpenMP threads. The factors are moved to the memory domain of the system matrix.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+class host_fspai_precond< viennacl::compressed_matrix<NumericT, AlignmentV> >
+{
+  typedef viennacl::compressed_matrix<NumericT, AlignmentV>   MatrixType;
+
+public:
+  /** @brief Constructor
+   * @param A    matrix whose approximate inverse is calculated. Must be symmetric positive definite.
+   * @param tag  fspai tag
+   */
+  host_fspai_precond(MatrixType const & A, fspai_tag const & tag)
+    : tag_(tag),
+      L_(viennacl::context(viennacl::MAIN_MEMORY)),
+      L_trans_(viennacl::context(viennacl::MAIN_MEMORY)),
+      tmp_(A.size1(), viennacl::traits::context(A))
+  {
+    viennacl::context host_context(viennacl::MAIN_MEMORY);
+    viennacl::compressed_matrix<NumericT> host_A(host_context);
+    host_A = A;
+
+    viennacl::linalg::detail::spai::host_compute_fspai(host_A, L_, L_trans_, tag_);
+    viennacl::switch_memory_context(L_,       viennacl::traits::context(A));
+    viennacl::switch_memory_context(L_trans_, viennacl::traits::context(A));
+  }
+
+  /** @brief Application of current preconditioner, multiplication on the right-hand side vector
+   * @param vec rhs vector
+   */
+  template<typename VectorT>
+  void apply(VectorT & vec) const
+  {
+    tmp_ = viennacl::linalg::prod(L_trans_, vec);
+    vec = viennacl::linalg::prod(L_, tmp_);
+  }
+
+  /** @brief Returns the factor L of the approximate inverse L L^T */
+  viennacl::compressed_matrix<NumericT> const & L() const { return L_; }
+
+private:
+  fspai_tag tag_;
+  viennacl::compressed_matrix<NumericT> L_;
+  viennacl::compressed_matrix<NumericT> L_trans_;
+  mutable viennacl::vector<NumericT> tmp_;
+};
+
+}
+}
+#endif
@@ -19,15 +19,19 @@
 ============================================================================= */
 
 /** @file viennacl/linalg/ichol.hpp
-  @brief Implementations of incomplete Cholesky factorization preconditioners with static nonzero pattern.
+  @brief Implementations of incomplete Cholesky factorization preconditioners with static nonzero pattern (IChol0), level of fill (IChol(k)), and threshold dropping (ICholT).
 */
 
 #include <vector>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
+#include <utility>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/compressed_matrix.hpp"
+#include "viennacl/meta/result_of.hpp"
+#include "viennacl/linalg/sparse_triangular_solver.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
 
@@ -174,7 +178,7 @@ class ichol0_precond< compressed_matrix<NumericT, AlignmentV> >
   typedef compressed_matrix<NumericT, AlignmentV>   MatrixType;
 
 public:
-  ichol0_precond(MatrixType const & mat, ichol0_tag const & tag) : tag_(tag), LLT(mat.size1(), mat.size2(), viennacl::traits::context(mat))
+  ichol0_precond(MatrixType const & mat, ichol0_tag const & tag) : tag_(tag)
   {
     //initialize preconditioner:
     //std::cout << "Start GPU precond" << std::endl;
@@ -190,32 +194,452 @@ public:
       viennacl::context old_ctx = viennacl::traits::context(vec);
 
       viennacl::switch_memory_context(vec, host_ctx);
-      viennacl::linalg::inplace_solve(trans(LLT), vec, lower_tag());
-      viennacl::linalg::inplace_solve(      LLT , vec, upper_tag());
+      R_solver_.apply_transposed(vec);
+      R_solver_.apply(vec);
       viennacl::switch_memory_context(vec, old_ctx);
     }
     else //apply ILU0 directly:
     {
       // Note: L is stored in a column-oriented fashion, i.e. transposed w.r.t. the row-oriented layout. Thus, the factorization A = L L^T holds L in the upper triangular part of A.
-      viennacl::linalg::inplace_solve(trans(LLT), vec, lower_tag());
-      viennacl::linalg::inplace_solve(      LLT , vec, upper_tag());
+      R_solver_.apply_transposed(vec);
+      R_solver_.apply(vec);
     }
   }
 
 private:
   void init(MatrixType const & mat)
   {
+    viennacl::compressed_matrix<NumericT> LLT(mat.size1(), mat.size2(), viennacl::traits::context(mat));
     viennacl::context host_ctx(viennacl::MAIN_MEMORY);
     viennacl::switch_memory_context(LLT, host_ctx);
     LLT = mat;
 
     viennacl::linalg::precondition(LLT, tag_);
+
+    // only the upper triangular part R = L^T is kept, the forward substitution with L runs over it transposed:
+    R_solver_.init(LLT, upper_tag());
+    R_solver_.release_value_map();
   }
 
   ichol0_tag const & tag_;
-  viennacl::compressed_matrix<NumericT> LLT;
+  viennacl::linalg::sparse_triangular_solver<NumericT> R_solver_;
+};
+
+/** @brief A tag for incomplete Cholesky factorization with level of fill (IChol(k))
+*
+* Fill-in entries are assigned the level lev(R(k,i)) + lev(R(k,j)) + 1, where entries of the system matrix have level zero.
+* Entries with a level higher than the prescribed level of fill are discarded. IChol(0) has the same pattern as IChol0.
+*/
+class icholk_tag
+{
+public:
+  /** @brief The constructor.
+  *
+  * @param level_of_fill   The maximum level of fill-in entries to be kept
+  */
+  icholk_tag(unsigned int level_of_fill = 1) : level_of_fill_(level_of_fill), nnz_A_(0), nnz_L_(0), diagonal_shift_(0) {}
+
+  unsigned int level_of_fill() const { return level_of_fill_; }
+  void level_of_fill(unsigned int k) { level_of_fill_ = k; }
+
+  /** @brief Returns the number of nonzeros of the factor L (including the diagonal) computed in the last factorization */
+  vcl_size_t nnz_L() const { return nnz_L_; }
+  /** @brief Returns the fill ratio nnz(L) / nnz(tril(A)) of the last factorization */
+  double fill_ratio() const { return (nnz_A_ > 0) ? static_cast<double>(nnz_L_) / static_cast<double>(nnz_A_) : 0; }
+  /** @brief Returns the relative diagonal shift alpha applied in the last factorization, i.e. A + alpha diag(A) was factored. Nonzero only if the factorization of A broke down. */
+  double diagonal_shift() const { return diagonal_shift_; }
+
+  /** @brief Sets the fill statistics. Called by the factorization routine. */
+  void fill_statistics(vcl_size_t nnz_A, vcl_size_t nnz_L, vcl_size_t /* dropped_entries */, double diagonal_shift) const
+  {
+    nnz_A_ = nnz_A;
+    nnz_L_ = nnz_L;
+    diagonal_shift_ = diagonal_shift;
+  }
+
+private:
+  unsigned int level_of_fill_;
+
+  //return values from factorization
+  mutable vcl_size_t nnz_A_;
+  mutable vcl_size_t nnz_L_;
+  mutable double     diagonal_shift_;
+};
+
+
+/** @brief A tag for incomplete Cholesky factorization with threshold (ICholT)
+*
+* Entries of a column of L are dropped if their magnitude is below the drop tolerance times the norm of the respective row of the system matrix.
+* Of the remaining entries, only the largest ones in magnitude are kept.
+*/
+class icholt_tag
+{
+public:
+  /** @brief The constructor.
+  *
+  * @param entries_per_column   Maximum number of off-diagonal entries per column of L
+  * @param drop_tolerance       The drop tolerance relative to the row norms of the system matrix
+  */
+  icholt_tag(unsigned int entries_per_column = 20, double drop_tolerance = 1e-4)
+    : entries_per_column_(entries_per_column), drop_tolerance_(drop_tolerance), nnz_A_(0), nnz_L_(0), dropped_entries_(0), diagonal_shift_(0) {}
+
+  void set_drop_tolerance(double tol)
+  {
+    if (tol > 0)
+      drop_tolerance_ = tol;
+  }
+  double get_drop_tolerance() const { return drop_tolerance_; }
+
+  void set_entries_per_column(unsigned int e)
+  {
+    if (e > 0)
+      entries_per_column_ = e;
+  }
+  unsigned int get_entries_per_column() const { return entries_per_column_; }
+
+  /** @brief Returns the number of nonzeros of the factor L (including the diagonal) computed in the last factorization */
+  vcl_size_t nnz_L() const { return nnz_L_; }
+  /** @brief Returns the number of entries dropped in the last factorization, either because of the drop tolerance or because of the limit on the number of entries per column */
+  vcl_size_t dropped_entries() const { return dropped_entries_; }
+  /** @brief Returns the fill ratio nnz(L) / nnz(tril(A)) of the last factorization */
+  double fill_ratio() const { return (nnz_A_ > 0) ? static_cast<double>(nnz_L_) / static_cast<double>(nnz_A_) : 0; }
+  /** @brief Returns the relative diagonal shift alpha applied in the last factorization, i.e. A + alpha diag(A) was factored. Nonzero only if the factorization of A broke down. */
+  double diagonal_shift() const { return diagonal_shift_; }
+
+  /** @brief Sets the fill statistics. Called by the factorization routine. */
+  void fill_statistics(vcl_size_t nnz_A, vcl_size_t nnz_L, vcl_size_t dropped_entries, double diagonal_shift) const
+  {
+    nnz_A_ = nnz_A;
+    nnz_L_ = nnz_L;
+    dropped_entries_ = dropped_entries;
+    diagonal_shift_ = diagonal_shift;
+  }
+
+private:
+  unsigned int entries_per_column_;
+  double       drop_tolerance_;
+
+  //return values from factorization
+  mutable vcl_size_t nnz_A_;
+  mutable vcl_size_t nnz_L_;
+  mutable vcl_size_t dropped_entries_;
+  mutable double     diagonal_shift_;
 };
 
+
+namespace detail
+{
+  /** @brief Computes the upper triangular factor R = L^T of an incomplete Cholesky factorization A + shift * diag(A) = R^T R row by row. For internal use only.
+    *
+    * Row i of R is obtained by eliminating the upper triangular part of row i of A with all previous rows k for which R(k,i) is nonzero.
+    * These rows are found through linked lists as in the column-oriented factorization of Lin and Moré: Each finished row is kept in the list of the column of its next entry.
+    *
+    * @param by_level          If true, fill-in is controlled by the level of fill (IChol(k)), otherwise by dropping small entries (ICholT)
+    * @param max_level         Maximum level of fill (IChol(k) only)
+    * @param drop_tolerance    Relative drop tolerance (ICholT only)
+    * @param max_entries       Maximum number of off-diagonal entries per row of R (ICholT only)
+    * @param shift             Relative diagonal shift
+    * @param R_rows            Row start indices of R
+    * @param R_cols            Column indices of R. The diagonal is the first entry in each row, followed by the off-diagonal entries in ascending order.
+    * @param R_values          Values of R
+    * @param dropped           Number of entries dropped by the threshold criterion
+    * @return False if a nonpositive pivot was encountered, in which case the factor is incomplete
+    */
+  template<typename NumericT>
+  bool ichol_factorize(unsigned int const * A_row_buffer, unsigned int const * A_col_buffer, NumericT const * A_elements, vcl_size_t n,
+                       bool by_level, unsigned int max_level, NumericT drop_tolerance, unsigned int max_entries, NumericT shift,
+                       std::vector<unsigned int> & R_rows, std::vector<unsigned int> & R_cols, std::vector<NumericT> & R_values, vcl_size_t & dropped)
+  {
+    std::vector<NumericT>     w(n);                                  // working row
+    std::vector<unsigned int> w_level(n);                            // level of fill of the entries in the working row
+    std::vector<unsigned int> marker(n, static_cast<unsigned int>(n)); // column is occupied in the working row i if marker equals i
+    std::vector<unsigned int> w_cols;
+    std::vector<std::pair<NumericT, unsigned int> > kept;
+
+    std::vector<long>         list_head(n, -1);   // first row in the list of each column
+    std::vector<long>         list_next(n, -1);   // next row in the same list
+    std::vector<unsigned int> next_entry(n);      // position of the entry of each row that determines its list
+    std::vector<unsigned int> R_levels;
+
+    R_rows.assign(1, 0);
+    R_cols.clear();
+    R_values.clear();
+    dropped = 0;
+
+    for (vcl_size_t i = 0; i < n; ++i)
+    {
+      unsigned int row = static_cast<unsigned int>(i);
+
+      // scatter upper triangular part of row i of A:
+      w_cols.clear();
+      NumericT row_norm = 0;
+      for (unsigned int j = A_row_buffer[i]; j < A_row_buffer[i+1]; ++j)
+      {
+        unsigned int col = A_col_buffer[j];
+        row_norm += A_elements[j] * A_elements[j];
+        if (col < row)
+          continue;
+        if (marker[col] != row)
+        {
+          marker[col] = row;
+          w[col] = 0;
+          w_level[col] = 0;
+          w_cols.push_back(col);
+        }
+        w[col] += (col == row) ? (1 + shift) * A_elements[j] : A_elements[j];
+      }
+      row_norm = std::sqrt(row_norm);
+      if (marker[i] != row)
+        return false;
+
+      // eliminate with all previous rows k with R(k,i) != 0:
+      long k = list_head[i];
+      list_head[i] = -1;
+      while (k >= 0)
+      {
+        long k_next = list_next[static_cast<vcl_size_t>(k)];
+        unsigned int pos = next_entry[static_cast<vcl_size_t>(k)];
+        unsigned int end = R_rows[static_cast<vcl_size_t>(k) + 1];
+        NumericT     r_ki = R_values[pos];
+        unsigned int level_ki = by_level ? R_levels[pos] : 0;
+
+        w[i] -= r_ki * r_ki;
+        for (unsigned int j = pos + 1; j < end; ++j)
+        {
+          unsigned int col = R_cols[j];
+          unsigned int level = by_level ? level_ki + R_levels[j] + 1 : 0;
+          if (marker[col] == row)
+          {
+            w[col] -= r_ki * R_values[j];
+            w_level[col] = std::min(w_level[col], level);
+          }
+          else if (!by_level || level <= max_level)
+          {
+            marker[col] = row;
+            w[col] = -r_ki * R_values[j];
+            w_level[col] = level;
+            w_cols.push_back(col);
+          }
+        }
+
+        // move row k to the list of its next entry:
+        if (pos + 1 < end)
+        {
+          next_entry[static_cast<vcl_size_t>(k)] = pos + 1;
+          list_next[static_cast<vcl_size_t>(k)] = list_head[R_cols[pos + 1]];
+          list_head[R_cols[pos + 1]] = k;
+        }
+        k = k_next;
+      }
+
+      if (w[i] <= 0)
+        return false;
+      NumericT r_ii = std::sqrt(w[i]);
+
+      // select the off-diagonal entries to keep:
+      kept.clear();
+      NumericT tau_i = drop_tolerance * row_norm;
+      for (vcl_size_t j = 0; j < w_cols.size(); ++j)
+      {
+        unsigned int col = w_cols[j];
+        if (col == row)
+          continue;
+        if (!by_level && std::fabs(w[col]) <= tau_i)
+          ++dropped;
+        else
+          kept.push_back(std::make_pair(std::fabs(w[col]), col));
+      }
+      if (!by_level && kept.size() > max_entries)
+      {
+        dropped += kept.size() - max_entries;
+        std::nth_element(kept.begin(), kept.begin() + max_entries, kept.end(), std::greater<std::pair<NumericT, unsigned int> >());
+        kept.resize(max_entries);
+      }
+
+      // store row i, diagonal first:
+      std::vector<unsigned int> cols_i(kept.size());
+      for (vcl_size_t j = 0; j < kept.size(); ++j)
+        cols_i[j] = kept[j].second;
+      std::sort(cols_i.begin(), cols_i.end());
+
+      R_cols.push_back(row);
+      R_values.push_back(r_ii);
+      if (by_level)
+        R_levels.push_back(0);
+      for (vcl_size_t j = 0; j < cols_i.size(); ++j)
+      {
+        R_cols.push_back(cols_i[j]);
+        R_values.push_back(w[cols_i[j]] / r_ii);
+        if (by_level)
+          R_levels.push_back(w_level[cols_i[j]]);
+      }
+      R_rows.push_back(static_cast<unsigned int>(R_cols.size()));
+
+      // insert row i into the list of its first off-diagonal entry:
+      if (cols_i.size() > 0)
+      {
+        next_entry[i] = R_rows[i] + 1;
+        list_next[i] = list_head[cols_i[0]];
+        list_head[cols_i[0]] = static_cast<long>(i);
+      }
+    }
+
+    return true;
+  }
+
+  /** @brief Computes the factor R = L^T of IChol(k) or ICholT on the host, shifting the diagonal if the factorization breaks down. For internal use only.
+    *
+    * On breakdown, the factorization is restarted with A + alpha diag(A), where alpha starts at 1e-3 and is doubled for each further breakdown (cf. Manteuffel).
+    */
+  template<typename NumericT, typename TagT>
+  void ichol_precondition(viennacl::compressed_matrix<NumericT> const & A, viennacl::compressed_matrix<NumericT> & R, TagT const & tag,
+                          bool by_level, unsigned int max_level, NumericT drop_tolerance, unsigned int max_entries)
+  {
+    assert( (viennacl::traits::context(A).memory_type() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for incomplete Cholesky factorization") );
+
+    unsigned int const * A_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * A_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+    NumericT     const * A_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+
+    std::vector<unsigned int> R_rows;
+    std::vector<unsigned int> R_cols;
+    std::vector<NumericT>     R_values;
+    vcl_size_t dropped = 0;
+
+    NumericT shift = 0;
+    for (unsigned int attempt = 0; ; ++attempt)
+    {
+      if (ichol_factorize(A_row_buffer, A_col_buffer, A_elements, A.size1(), by_level, max_level, drop_tolerance, max_entries, shift,
+                          R_rows, R_cols, R_values, dropped))
+        break;
+      if (attempt == 20)
+        throw zero_on_diagonal_exception("ViennaCL: Incomplete Cholesky factorization broke down even with diagonal shift. Matrix not positive definite?");
+      shift = (shift > 0) ? 2 * shift : NumericT(1e-3);
+    }
+
+    vcl_size_t nnz_lower_A = 0;
+    for (vcl_size_t i = 0; i < A.size1(); ++i)
+      for (unsigned int j = A_row_buffer[i]; j < A_row_buffer[i+1]; ++j)
+        if (A_col_buffer[j] <= i)
+          ++nnz_lower_A;
+    tag.fill_statistics(nnz_lower_A, R_cols.size(), dropped, static_cast<double>(shift));
+
+    R = viennacl::compressed_matrix<NumericT>(A.size1(), A.size2(), R_cols.size(), viennacl::traits::context(A));
+    unsigned int * R_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(R.handle1());
+    unsigned int * R_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(R.handle2());
+    NumericT     * R_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(R.handle());
+    std::copy(R_rows.begin(), R_rows.end(), R_row_buffer);
+    if (R_cols.size() > 0)
+    {
+      std::copy(R_cols.begin(), R_cols.end(), R_col_buffer);
+      std::copy(R_values.begin(), R_values.end(), R_elements);
+    }
+    R.generate_row_block_information();
+  }
+}
+
+/** @brief Computes the IChol(k) factorization A \\approx L L^T of a symmetric positive definite matrix in main memory.
+  *
+  *  @param A       The input matrix in CSR format. Only the upper triangular part is used.
+  *  @param R       The upper triangular factor R = L^T, i.e. the transpose of the lower triangular factor is stored in CSR format.
+  *  @param tag     The IChol(k) configuration. The fill statistics are written to the tag.
+  */
+template<typename NumericT>
+void precondition(viennacl::compressed_matrix<NumericT> const & A, viennacl::compressed_matrix<NumericT> & R, icholk_tag const & tag)
+{
+  detail::ichol_precondition(A, R, tag, true, tag.level_of_fill(), NumericT(0), 0);
+}
+
+/** @brief Computes the ICholT factorization A \\approx L L^T of a symmetric positive definite matrix in main memory.
+  *
+  *  @param A       The input matrix in CSR format. Only the upper triangular part is used for the factorization, the full rows for the drop tolerance.
+  *  @param R       The upper triangular factor R = L^T, i.e. the transpose of the lower triangular factor is stored in CSR format.
+  *  @param tag     The ICholT configuration. The fill statistics are written to the tag.
+  */
+template<typename NumericT>
+void precondition(viennacl::compressed_matrix<NumericT> const & A, viennacl::compressed_matrix<NumericT> & R, icholt_tag const & tag)
+{
+  detail::ichol_precondition(A, R, tag, false, 0, static_cast<NumericT>(tag.get_drop_tolerance()), tag.get_entries_per_column());
+}
+
+
+namespace detail
+{
+  /** @brief Copies a system matrix to a compressed_matrix in main memory */
+  template<typename NumericT, unsigned int AlignmentV>
+  void ichol_copy_to_host(viennacl::compressed_matrix<NumericT, AlignmentV> const & mat, viennacl::compressed_matrix<NumericT> & host_mat)
+  {
+    host_mat = mat;
+  }
+
+  template<typename MatrixT, typename NumericT>
+  void ichol_copy_to_host(MatrixT const & mat, viennacl::compressed_matrix<NumericT> & host_mat)
+  {
+    viennacl::copy(mat, host_mat);
+  }
+
+  /** @brief Incomplete Cholesky preconditioner storing a single triangular factor. Common implementation of icholk_precond and icholt_precond.
+    *
+    * Only the factor R = L^T is computed and kept in a single sparse_triangular_solver, which copies it to its level-scheduled layout.
+    * The backward substitution with R uses it directly, the forward substitution with L = R^T runs over the same copy transposed.
+    */
+  template<typename MatrixT, typename TagT>
+  class ichol_precond_base
+  {
+    typedef typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type   NumericType;
+
+  public:
+    ichol_precond_base(MatrixT const & mat, TagT const & tag) : tag_(tag)
+    {
+      viennacl::compressed_matrix<NumericType> host_A(mat.size1(), mat.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+      ichol_copy_to_host(mat, host_A);
+
+      viennacl::compressed_matrix<NumericType> R(host_A.size1(), host_A.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::linalg::precondition(host_A, R, tag_);
+
+      R_solver_.init(R, upper_tag());
+      R_solver_.release_value_map();
+    }
+
+    /** @brief Applies the preconditioner, i.e. solves R^T R x = vec in place. Vectors not residing in main memory are transferred to main memory and back. */
+    void apply(viennacl::vector_base<NumericType> & vec) const
+    {
+      R_solver_.apply_transposed(vec);
+      R_solver_.apply(vec);
+    }
+
+    /** @brief Returns the tag holding the fill statistics of the factorization */
+    TagT const & tag() const { return tag_; }
+
+  private:
+    TagT tag_;
+    viennacl::linalg::sparse_triangular_solver<NumericType> R_solver_;
+  };
+}
+
+/** @brief Incomplete Cholesky preconditioner with level of fill (IChol(k)), can be supplied to solve()-routines.
+*
+* The system matrix is copied to main memory for the factorization. Only one triangular factor is stored, the forward substitution uses its transpose.
+*/
+template<typename MatrixT>
+class icholk_precond : public detail::ichol_precond_base<MatrixT, icholk_tag>
+{
+public:
+  icholk_precond(MatrixT const & mat, icholk_tag const & tag) : detail::ichol_precond_base<MatrixT, icholk_tag>(mat, tag) {}
+};
+
+/** @brief Incomplete Cholesky preconditioner with threshold (ICholT), can be supplied to solve()-routines.
+*
+* The system matrix is copied to main memory for the factorization. Only one triangular factor is stored, the forward substitution uses its transpose.
+*/
+template<typename MatrixT>
+class icholt_precond : public detail::ichol_precond_base<MatrixT, icholt_tag>
+{
+public:
+  icholt_precond(MatrixT const & mat, icholt_tag const & tag) : detail::ichol_precond_base<MatrixT, icholt_tag>(mat, tag) {}
+};
+
+
 }
 }
 
@@ -121,6 +121,60 @@ void pipelined_cg_prod(MatrixT const & A,
   }
 }
 
+/** @brief Performs the fused search direction update and matrix-vector product of a classical (non-pipelined) CG algorithm.
+  *
+  * This routines computes for a sparse matrix A, vectors 'z', 'p', 'Ap' and a scalar beta:
+  *   p  = z + beta * p;
+  *   Ap = prod(A, p);
+  * and stores inner_prod(p, Ap) in the second entry of inner_prod_buffer. Currently only available for the host backend.
+  */
+template<typename MatrixT, typename NumericT>
+void fused_cg_prod(MatrixT const & A,
+                   vector_base<NumericT> const & z,
+                   NumericT beta,
+                   vector_base<NumericT> & p,
+                   vector_base<NumericT> & Ap,
+                   vector_base<NumericT> & inner_prod_buffer)
+{
+  switch (viennacl::traits::handle(p).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::fused_cg_prod(A, z, beta, p, Ap, inner_prod_buffer);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Performs the joint vector update of a classical (non-pipelined) CG algorithm.
+  *
+  * This routines computes for vectors 'result', 'p', 'r', 'Ap':
+  *   result += alpha * p;
+  *   r      -= alpha * Ap;
+  * and stores inner_prod(r, r) in the first entry of inner_prod_buffer. Currently only available for the host backend.
+  */
+template<typename NumericT>
+void fused_cg_vector_update(vector_base<NumericT> & result,
+                            NumericT alpha,
+                            vector_base<NumericT> const & p,
+                            vector_base<NumericT> & r,
+                            vector_base<NumericT> const & Ap,
+                            vector_base<NumericT> & inner_prod_buffer)
+{
+  switch (viennacl::traits::handle(result).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::fused_cg_vector_update(result, alpha, p, r, Ap, inner_prod_buffer);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
 ////////////////////////////////////////////
 
 /** @brief Performs a joint vector update operation needed for an efficient pipelined CG algorithm.
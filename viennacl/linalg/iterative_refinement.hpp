@@ -0,0 +1,249 @@
+#ifndef VIENNACL_LINALG_ITERATIVE_REFINEMENT_HPP_
+#define VIENNACL_LINALG_ITERATIVE_REFINEMENT_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/iterative_refinement.hpp
+    @brief Mixed-precision iterative refinement wrapping an arbitrary iterative solver and preconditioner. Experimental.
+*/
+
+#include <cmath>
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/context.hpp"
+#include "viennacl/backend/memory.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for mixed-precision iterative refinement. Used for supplying solver parameters and for dispatching the solve() function
+*
+* The residual r = b - Ax is computed with the high-precision system matrix, while the correction Ad = r is computed by the inner solver
+* specified by InnerTagT (e.g. cg_tag, bicgstab_tag, gmres_tag) using a low-precision copy of the system matrix and a preconditioner set up for the latter.
+*/
+template<typename InnerTagT>
+class iterative_refinement_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param inner_tag        The tag of the inner (low-precision) solver. Its tolerance is the relative tolerance for each correction step.
+  * @param tol              Relative tolerance for the high-precision residual (solver quits if ||r|| < tol * ||b||)
+  * @param max_refinements  The maximum number of refinement steps (i.e. inner solver runs)
+  */
+  iterative_refinement_tag(InnerTagT const & inner_tag = InnerTagT(), double tol = 1e-12, vcl_size_t max_refinements = 20)
+    : inner_tag_(inner_tag), tol_(tol), abs_tol_(0), refinements_(max_refinements), refinements_taken_(0), iters_taken_(0), last_error_(0) {}
+
+  /** @brief Returns the tag of the inner low-precision solver */
+  InnerTagT const & inner_tag() const { return inner_tag_; }
+
+  /** @brief Returns the relative tolerance */
+  double tolerance() const { return tol_; }
+
+  /** @brief Returns the absolute tolerance */
+  double abs_tolerance() const { return abs_tol_; }
+  /** @brief Sets the absolute tolerance */
+  void abs_tolerance(double new_tol) { if (new_tol >= 0) abs_tol_ = new_tol; }
+
+  /** @brief Returns the maximum number of refinement steps */
+  vcl_size_t max_refinements() const { return refinements_; }
+
+  /** @brief Returns the number of refinement steps (inner solver runs) taken */
+  vcl_size_t refinements() const { return refinements_taken_; }
+  void refinements(vcl_size_t i) const { refinements_taken_ = i; }
+
+  /** @brief Returns the total number of inner solver iterations accumulated over all refinement steps */
+  vcl_size_t iters() const { return iters_taken_; }
+  void iters(vcl_size_t i) const { iters_taken_ = i; }
+
+  /** @brief Returns the relative residual ||b - Ax|| / ||b|| computed in high precision at the end of the solver run */
+  double error() const { return last_error_; }
+  /** @brief Sets the relative residual at the end of the solver run */
+  void error(double e) const { last_error_ = e; }
+
+private:
+  InnerTagT inner_tag_;
+  double tol_;
+  double abs_tol_;
+  vcl_size_t refinements_;
+
+  //return values from solver
+  mutable vcl_size_t refinements_taken_;
+  mutable vcl_size_t iters_taken_;
+  mutable double last_error_;
+};
+
+
+/** @brief Copies a compressed_matrix to a compressed_matrix with lower precision entries (typically double to float).
+*
+* The sparsity pattern is copied as-is in the memory domain of the source matrix, only the nonzero entries are converted.
+*
+* @param A        The source matrix
+* @param A_low    The destination matrix. Is resized and reinitialized.
+*/
+template<typename HighNumericT, unsigned int AlignmentV, typename LowNumericT, unsigned int LowAlignmentV>
+void copy_to_lower_precision(viennacl::compressed_matrix<HighNumericT, AlignmentV> const & A,
+                             viennacl::compressed_matrix<LowNumericT, LowAlignmentV> & A_low)
+{
+  A_low = viennacl::compressed_matrix<LowNumericT, LowAlignmentV>(A.size1(), A.size2(), A.nnz(), viennacl::traits::context(A));
+  if (A.nnz() == 0)
+    return;
+
+  viennacl::backend::memory_copy(A.handle1(), A_low.handle1(), 0, 0, A_low.handle1().raw_size());
+  viennacl::backend::memory_copy(A.handle2(), A_low.handle2(), 0, 0, A_low.handle2().raw_size());
+
+  viennacl::vector_base<HighNumericT> elements_high(const_cast<viennacl::backend::mem_handle &>(A.handle()), A.nnz(), 0, 1);
+  viennacl::vector_base<LowNumericT>  elements_low(A_low.handle(), A.nnz(), 0, 1);
+  elements_low = elements_high;
+  A_low.generate_row_block_information();
+}
+
+
+namespace detail
+{
+  /** @brief Deduces the floating point type of the low-precision matrix copy created by the short forms of iterative refinement */
+  template<typename NumericT>
+  struct iterative_refinement_low_precision
+  {
+    typedef float   type;
+  };
+}
+
+
+/** @brief Mixed-precision iterative refinement with an arbitrary inner solver and preconditioner.
+*
+* Each refinement step computes the residual r = b - Ax with the high-precision matrix A, scales it to unit norm,
+* and solves A_low d = r / ||r|| with the inner solver in the precision of A_low. Since the sparse matrix-vector product
+* in the inner solver is bandwidth-limited, storing A_low in single precision roughly halves the memory traffic of each inner iteration.
+*
+* The refinement stops early if a step fails to reduce the high-precision residual (e.g. because the inner solver diverged or produced NaNs).
+* In that case the iterate with the smallest residual is returned and error() reports its relative residual.
+*
+* @param A          The system matrix in high precision (used for residual computations only)
+* @param rhs        The load vector in high precision
+* @param tag        Solver configuration tag, holding the inner solver tag
+* @param A_low      The system matrix in low precision. May be of a different sparse matrix type than A.
+* @param precond    A preconditioner set up for A_low. Precondition operation is done via member function apply()
+* @return The result vector in high precision
+*/
+template<typename MatrixT, typename NumericT, typename InnerTagT, typename LowMatrixT, typename PreconditionerT>
+viennacl::vector<NumericT> solve(MatrixT const & A,
+                                 viennacl::vector_base<NumericT> const & rhs,
+                                 iterative_refinement_tag<InnerTagT> const & tag,
+                                 LowMatrixT const & A_low,
+                                 PreconditionerT const & precond)
+{
+  typedef typename viennacl::result_of::cpu_value_type<typename LowMatrixT::value_type>::type    LowNumericT;
+
+  vcl_size_t problem_size = viennacl::traits::size(rhs);
+
+  viennacl::vector<NumericT> result = viennacl::zero_vector<NumericT>(problem_size, viennacl::traits::context(rhs));
+  viennacl::vector<NumericT> previous_result(problem_size, viennacl::traits::context(rhs));
+  viennacl::vector<NumericT> residual = rhs;
+  viennacl::vector<NumericT> correction(problem_size, viennacl::traits::context(rhs));
+  viennacl::vector<LowNumericT> residual_low(problem_size, viennacl::traits::context(rhs));
+
+  NumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+  NumericT norm_residual = norm_rhs;
+
+  tag.refinements(0);
+  tag.iters(0);
+  tag.error(0);
+
+  if (norm_rhs <= tag.abs_tolerance()) //solution is zero if RHS norm is zero
+    return result;
+
+  vcl_size_t inner_iters = 0;
+  for (vcl_size_t i = 0; i < tag.max_refinements(); ++i)
+  {
+    tag.refinements(i+1);
+
+    // scale residual to unit norm so that it is representable in low precision also when close to convergence:
+    residual /= norm_residual;
+    residual_low = residual;
+
+    viennacl::vector<LowNumericT> correction_low = solve(A_low, residual_low, tag.inner_tag(), precond);
+    inner_iters += static_cast<vcl_size_t>(tag.inner_tag().iters());
+
+    correction = correction_low;
+    previous_result = result;
+    result += norm_residual * correction;
+
+    // residual = b - Ax in high precision (without introducing a temporary)
+    residual = viennacl::linalg::prod(A, result);
+    residual = rhs - residual;
+    NumericT new_norm_residual = viennacl::linalg::norm_2(residual);
+
+    if (!(new_norm_residual < norm_residual)) // no progress, divergence, or NaN: keep the previous iterate
+    {
+      result = previous_result;
+      break;
+    }
+    norm_residual = new_norm_residual;
+
+    if (norm_residual < tag.tolerance() * norm_rhs || norm_residual < tag.abs_tolerance())
+      break;
+  }
+
+  tag.iters(inner_iters);
+  tag.error(norm_residual / norm_rhs);
+
+  return result;
+}
+
+/** @brief Convenience overload for mixed-precision iterative refinement of a compressed_matrix without preconditioner.
+*
+* A low-precision copy of the system matrix is created internally, its floating point type is given by detail::iterative_refinement_low_precision (single precision).
+* Use the overload taking the low-precision matrix explicitly in order to reuse the copy, to choose a different precision, or to use a preconditioner.
+*/
+template<typename NumericT, unsigned int AlignmentV, typename InnerTagT>
+viennacl::vector<NumericT> solve(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                                 viennacl::vector_base<NumericT> const & rhs,
+                                 iterative_refinement_tag<InnerTagT> const & tag,
+                                 viennacl::linalg::no_precond)
+{
+  viennacl::compressed_matrix<typename detail::iterative_refinement_low_precision<NumericT>::type> A_low;
+  viennacl::linalg::copy_to_lower_precision(A, A_low);
+  return viennacl::linalg::solve(A, rhs, tag, A_low, viennacl::linalg::no_precond());
+}
+
+/** @brief Entry point for mixed-precision iterative refinement without preconditioner.
+ *
+ *  @param A         The system matrix
+ *  @param rhs       Right hand side vector (load vector)
+ *  @param tag       An iterative_refinement_tag holding the inner solver tag, tolerances, etc.
+ */
+template<typename NumericT, unsigned int AlignmentV, typename InnerTagT>
+viennacl::vector<NumericT> solve(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                                 viennacl::vector_base<NumericT> const & rhs,
+                                 iterative_refinement_tag<InnerTagT> const & tag)
+{
+  return viennacl::linalg::solve(A, rhs, tag, viennacl::linalg::no_precond());
+}
+
+}
+}
+
+#endif
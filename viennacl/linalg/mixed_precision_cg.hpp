@@ -34,6 +34,7 @@
 #include "viennacl/traits/size.hpp"
 #include "viennacl/meta/result_of.hpp"
 #include "viennacl/backend/memory.hpp"
+#include "viennacl/linalg/solver_statistics.hpp"
 
 #include "viennacl/vector_proxy.hpp"
 
@@ -53,7 +54,7 @@ namespace viennacl
         * @param max_iterations   The maximum number of iterations
         * @param inner_tol        Inner tolerance for the low-precision iterations
         */
-        mixed_precision_cg_tag(double tol = 1e-8, unsigned int max_iterations = 300, float inner_tol = 1e-2f) : tol_(tol), iterations_(max_iterations), inner_tol_(inner_tol) {}
+        mixed_precision_cg_tag(double tol = 1e-8, unsigned int max_iterations = 300, float inner_tol = 1e-2f) : tol_(tol), iterations_(max_iterations), inner_tol_(inner_tol), stats_(NULL) {}
 
         /** @brief Returns the relative tolerance */
         double tolerance() const { return tol_; }
@@ -71,11 +72,16 @@ namespace viennacl
         /** @brief Sets the estimated relative error at the end of the solver run */
         void error(double e) const { last_error_ = e; }
 
+        /** @brief Attaches an instrumentation record which is filled by subsequent solver runs. Pass NULL (default) to disable instrumentation. */
+        void statistics(solver_statistics * stats) { stats_ = stats; }
+        /** @brief Returns the attached instrumentation record, or NULL if instrumentation is disabled */
+        solver_statistics * statistics() const { return stats_; }
 
       private:
         double tol_;
         unsigned int iterations_;
         float inner_tol_;
+        solver_statistics * stats_;
 
         //return values from solver
         mutable unsigned int iters_taken_;
@@ -100,6 +106,9 @@ namespace viennacl
 
       //std::cout << "Starting CG" << std::endl;
       vcl_size_t problem_size = viennacl::traits::size(rhs);
+      detail::solver_statistics_recorder rec(tag.statistics(), problem_size, sizeof(float));
+      double high_precision_vector = static_cast<double>(sizeof(CPU_ScalarType)) / static_cast<double>(sizeof(float)); // size of a high precision vector relative to a low precision vector
+
       VectorType result(rhs);
       viennacl::traits::clear(result);
 
@@ -136,23 +145,30 @@ namespace viennacl
       matrix_elements_low_precision = matrix_elements_high_precision;
       matrix_low_precision.generate_row_block_information();
 
+      rec.mark();
       for (unsigned int i = 0; i < tag.max_iterations(); ++i)
       {
         tag.iters(i+1);
 
         // lower precision 'inner iteration'
         tmp_low_precision = viennacl::linalg::prod(matrix_low_precision, p_low_precision);
+        rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix_low_precision));
 
         alpha = inner_ip_rr / viennacl::linalg::inner_prod(tmp_low_precision, p_low_precision);
+        rec.record(solver_statistics::REDUCTION, rec.vector_bytes(2));
         result_low_precision += alpha * p_low_precision;
         residual_low_precision -= alpha * tmp_low_precision;
+        rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(6));
 
         new_inner_ip_rr = viennacl::linalg::inner_prod(residual_low_precision, residual_low_precision);
+        rec.record(solver_statistics::REDUCTION, rec.vector_bytes(1));
 
         beta = new_inner_ip_rr / inner_ip_rr;
         inner_ip_rr = new_inner_ip_rr;
 
         p_low_precision = residual_low_precision + beta * p_low_precision;
+        rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(3));
+        rec.residual(std::sqrt(std::fabs(new_inner_ip_rr / norm_rhs_squared)));
 
         //
         // If enough progress has been achieved, update current residual with high precision evaluation
@@ -162,12 +178,16 @@ namespace viennacl
         {
           residual = result_low_precision; // reusing residual vector as temporary buffer for conversion. Overwritten below anyway
           result += residual;
+          rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(1 + 3 * high_precision_vector));
 
           // residual = b - Ax  (without introducing a temporary)
           residual = viennacl::linalg::prod(matrix, result);
+          rec.record(solver_statistics::SPMV, detail::spmv_bytes(matrix));
           residual = rhs - residual;
+          rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(3 * high_precision_vector));
 
           new_ip_rr = viennacl::linalg::inner_prod(residual, residual);
+          rec.record(solver_statistics::REDUCTION, rec.vector_bytes(high_precision_vector));
           if (new_ip_rr / norm_rhs_squared < tag.tolerance() *  tag.tolerance())//squared norms involved here
             break;
 
@@ -175,6 +195,7 @@ namespace viennacl
 
           result_low_precision.clear();
           residual_low_precision = p_low_precision;
+          rec.record(solver_statistics::VECTOR_UPDATE, rec.vector_bytes(4 + high_precision_vector));
           initial_inner_rhs_norm_squared = static_cast<float>(new_ip_rr);
           inner_ip_rr = static_cast<float>(new_ip_rr);
         }
@@ -182,6 +203,7 @@ namespace viennacl
 
       //store last error estimate:
       tag.error(std::sqrt(new_ip_rr / norm_rhs_squared));
+      rec.iterations(tag.iters());
 
       return result;
     }
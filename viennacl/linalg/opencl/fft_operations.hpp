@@ -339,7 +339,10 @@ void reverse(viennacl::vector_base<NumericT>& in)
   vcl_size_t size = in.size();
 
   viennacl::ocl::kernel& k = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<NumericT>::program_name(), "reverse_inplace");
-  viennacl::ocl::enqueue(k(in, static_cast<cl_uint>(size)));
+  viennacl::ocl::enqueue(k(in,
+                           static_cast<cl_uint>(viennacl::traits::start(in)),
+                           static_cast<cl_uint>(viennacl::traits::stride(in)),
+                           static_cast<cl_uint>(size)));
 }
 
 } //namespace opencl
@@ -161,13 +161,13 @@ void generate_fft_real_to_complex(StringT & source, std::string const & numeric_
 template<typename StringT>
 void generate_fft_reverse_inplace(StringT & source, std::string const & numeric_string)
 {
-  source.append("__kernel void reverse_inplace(__global "); source.append(numeric_string); source.append(" *vec, uint size) { \n");
+  source.append("__kernel void reverse_inplace(__global "); source.append(numeric_string); source.append(" *vec, uint start, uint inc, uint size) { \n");
   source.append("  for (uint i = get_global_id(0); i < (size >> 1); i+=get_global_size(0)) { \n");
-  source.append("    "); source.append(numeric_string); source.append(" val1 = vec[i]; \n");
-  source.append("    "); source.append(numeric_string); source.append(" val2 = vec[size - i - 1]; \n");
+  source.append("    "); source.append(numeric_string); source.append(" val1 = vec[start + i * inc]; \n");
+  source.append("    "); source.append(numeric_string); source.append(" val2 = vec[start + (size - i - 1) * inc]; \n");
 
-  source.append("    vec[i] = val2; \n");
-  source.append("    vec[size - i - 1] = val1; \n");
+  source.append("    vec[start + i * inc] = val2; \n");
+  source.append("    vec[start + (size - i - 1) * inc] = val1; \n");
   source.append("  } \n");
   source.append("} \n");
 }
@@ -221,7 +221,9 @@ void generate_fft_vandermonde_prod(StringT & source, std::string const & numeric
 {
   source.append("__kernel void vandermonde_prod(__global "); source.append(numeric_string); source.append(" *vander, \n");
   source.append("  __global "); source.append(numeric_string); source.append(" *vector, \n");
+  source.append("  uint vector_start, uint vector_inc, \n");
   source.append("  __global "); source.append(numeric_string); source.append(" *result, \n");
+  source.append("  uint result_start, uint result_inc, \n");
   source.append("  uint size) { \n");
   source.append("  for (uint i = get_global_id(0); i < size; i+= get_global_size(0)) { \n");
   source.append("    "); source.append(numeric_string); source.append(" mul = vander[i]; \n");
@@ -229,11 +231,11 @@ void generate_fft_vandermonde_prod(StringT & source, std::string const & numeric
   source.append("    "); source.append(numeric_string); source.append(" val = 0; \n");
 
   source.append("    for (uint j = 0; j < size; j++) { \n");
-  source.append("      val = val + pwr * vector[j]; \n");
+  source.append("      val = val + pwr * vector[vector_start + j * vector_inc]; \n");
   source.append("      pwr *= mul; \n");
   source.append("    } \n");
 
-  source.append("    result[i] = val; \n");
+  source.append("    result[result_start + i * result_inc] = val; \n");
   source.append("  } \n");
   source.append("} \n");
 }
@@ -56,7 +56,11 @@ void prod_impl(viennacl::vandermonde_matrix<NumericT, AlignmentV> const & A,
   viennacl::ocl::kernel & kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::fft<NumericT>::program_name(), "vandermonde_prod");
   viennacl::ocl::enqueue(kernel(viennacl::traits::opencl_handle(A),
                                 viennacl::traits::opencl_handle(x),
+                                static_cast<cl_uint>(viennacl::traits::start(x)),
+                                static_cast<cl_uint>(viennacl::traits::stride(x)),
                                 viennacl::traits::opencl_handle(y),
+                                static_cast<cl_uint>(viennacl::traits::start(y)),
+                                static_cast<cl_uint>(viennacl::traits::stride(y)),
                                 static_cast<cl_uint>(A.size1())));
 }
 
@@ -24,6 +24,7 @@
 #include "viennacl/linalg/qr-method-common.hpp"
 #include "viennacl/linalg/tql2.hpp"
 #include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/symmetric_eig.hpp"
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
@@ -744,6 +745,18 @@ void update_float_QR_column_gpu(matrix_base<SCALARTYPE> & A,
         D.resize(A.size1());
         E.resize(A.size1());
 
+        if (is_symmetric && viennacl::traits::active_handle_id(A) == viennacl::MAIN_MEMORY)
+        {
+          // blocked tridiagonalization and divide-and-conquer, see symmetric_eig.hpp
+          viennacl::linalg::symmetric_eig(A, D, Q);
+          std::fill(E.begin(), E.end(), SCALARTYPE(0));
+
+          viennacl::vector<SCALARTYPE> vcl_eigenvalues(mat_size, viennacl::traits::context(A));
+          viennacl::copy(D, vcl_eigenvalues);
+          viennacl::linalg::matrix_diag_from_vector(vcl_eigenvalues, 0, A);
+          return;
+        }
+
         viennacl::vector<SCALARTYPE> vcl_D(mat_size), vcl_E(mat_size);
         //std::vector<SCALARTYPE> std_D(mat_size), std_E(mat_size);
 
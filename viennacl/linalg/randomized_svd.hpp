@@ -0,0 +1,348 @@
+#ifndef VIENNACL_LINALG_RANDOMIZED_SVD_HPP_
+#define VIENNACL_LINALG_RANDOMIZED_SVD_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/randomized_svd.hpp
+*   @brief Randomized truncated singular value decomposition of large dense and sparse matrices.
+*
+*   Implements the randomized range finder with power iterations by Halko, Martinsson, and Tropp (SIAM Review 53(2), 2011).
+*   The products with A and A^T are computed by prod() in the memory domain of A, while the orthonormalization of the
+*   tall and skinny bases and the singular value decomposition of the small projected matrix are carried out in main memory.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/ilu_operations.hpp"
+#include "viennacl/linalg/svd_dc.hpp"
+#include "viennacl/tools/random.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the randomized truncated singular value decomposition.
+*
+* The range of A is sketched by rank + oversampling Gaussian random vectors. Each power iteration multiplies the sketch by A A^T,
+* which sharpens the decay of the singular values and hence improves the accuracy for slowly decaying spectra.
+*/
+class randomized_svd_tag
+{
+public:
+
+  /** @brief The constructor
+  *
+  * @param rank               Number of singular triplets to compute
+  * @param oversampling       Number of additional random vectors in the sketch
+  * @param power_iterations   Number of power iterations
+  */
+  randomized_svd_tag(vcl_size_t rank = 10, vcl_size_t oversampling = 10, vcl_size_t power_iterations = 2)
+    : rank_(rank), oversampling_(oversampling), power_iterations_(power_iterations) {}
+
+  /** @brief Sets the number of singular triplets */
+  void rank(vcl_size_t r) { rank_ = r; }
+
+  /** @brief Returns the number of singular triplets */
+  vcl_size_t rank() const { return rank_; }
+
+  /** @brief Sets the number of additional random vectors */
+  void oversampling(vcl_size_t p) { oversampling_ = p; }
+
+  /** @brief Returns the number of additional random vectors */
+  vcl_size_t oversampling() const { return oversampling_; }
+
+  /** @brief Sets the number of power iterations */
+  void power_iterations(vcl_size_t q) { power_iterations_ = q; }
+
+  /** @brief Returns the number of power iterations */
+  vcl_size_t power_iterations() const { return power_iterations_; }
+
+private:
+  vcl_size_t rank_;
+  vcl_size_t oversampling_;
+  vcl_size_t power_iterations_;
+};
+
+
+namespace detail
+{
+  /** @brief Number of columns per panel in the orthonormalization */
+  static const vcl_size_t RSVD_BLOCK_SIZE = 32;
+
+  /** @brief Overwrites the M-by-L host matrix Y with M >= L by an orthonormal basis of its range.
+  *
+  * The basis is obtained from a blocked Householder QR factorization (LAPACK's xGEQRF), the first L columns of Q are then formed explicitly (xORGQR).
+  * Rank-deficient inputs still yield orthonormal columns.
+  */
+  template<typename NumericT>
+  void rsvd_orthonormalize_host(typename symeig_workspace<NumericT>::type & Y)
+  {
+    typedef typename symeig_workspace<NumericT>::type   MatrixType;
+
+    vcl_size_t m = Y.size1();
+    vcl_size_t l = Y.size2();
+    vcl_size_t ldy = Y.internal_size1();
+    NumericT * y = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(Y);
+
+    std::vector<NumericT> tau(l);
+    MatrixType V(m, RSVD_BLOCK_SIZE, viennacl::context(viennacl::MAIN_MEMORY));
+    MatrixType X(RSVD_BLOCK_SIZE, l, viennacl::context(viennacl::MAIN_MEMORY));
+    vcl_size_t ldv = V.internal_size1();
+    NumericT * v = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(V);
+
+    // Householder vectors of panel k, stored explicitly in V:
+    vcl_size_t num_panels = (l + RSVD_BLOCK_SIZE - 1) / RSVD_BLOCK_SIZE;
+    for (vcl_size_t p = 0; p < num_panels; ++p)
+    {
+      vcl_size_t k = p * RSVD_BLOCK_SIZE;
+      vcl_size_t panel = std::min<vcl_size_t>(RSVD_BLOCK_SIZE, l - k);
+
+      for (vcl_size_t i = 0; i < panel; ++i)
+      {
+        vcl_size_t c = k + i;
+        NumericT * y_c = y + c * ldy;
+
+        // apply the previous reflections of this panel to column c:
+        for (vcl_size_t j = k; j < c; ++j)
+        {
+          NumericT const * y_j = y + j * ldy;
+          NumericT s = 0;
+          for (vcl_size_t r = j; r < m; ++r)
+            s += y_j[r] * y_c[r];
+          s *= tau[j];
+          for (vcl_size_t r = j; r < m; ++r)
+            y_c[r] -= s * y_j[r];
+        }
+
+        // Householder reflection annihilating Y(c+1:m, c). Only Q is needed, so the unit entry replaces R(c, c):
+        NumericT alpha = y_c[c];
+        NumericT xnorm = 0;
+        for (vcl_size_t r = c + 1; r < m; ++r)
+          xnorm += y_c[r] * y_c[r];
+        xnorm = std::sqrt(xnorm);
+        tau[c] = 0;
+        if (xnorm > 0)
+        {
+          NumericT beta = std::sqrt(alpha * alpha + xnorm * xnorm);
+          if (alpha > 0)
+            beta = -beta;
+          tau[c] = (beta - alpha) / beta;
+          NumericT scale = NumericT(1) / (alpha - beta);
+          for (vcl_size_t r = c + 1; r < m; ++r)
+            y_c[r] *= scale;
+        }
+        y_c[c] = 1;
+      }
+
+      for (vcl_size_t i = 0; i < panel; ++i)
+      {
+        NumericT * v_i = v + i * ldv;
+        NumericT const * y_i = y + (k + i) * ldy + k;
+        for (vcl_size_t r = 0; r < i; ++r)
+          v_i[r] = 0;
+        for (vcl_size_t r = i; r < m - k; ++r)
+          v_i[r] = y_i[r];
+      }
+
+      // Y(k:m, k+panel:l) = H_{panel-1} ... H_0 Y(k:m, k+panel:l):
+      if (k + panel < l)
+        symeig_apply_block_reflector<NumericT>(V, m - k, panel, &(tau[k]), X, Y, k, k + panel, true);
+    }
+
+    // Q = H_0 H_1 ... H_{l-1} [I; 0], accumulated backwards such that only the trailing columns are touched:
+    MatrixType Q(m, l, viennacl::context(viennacl::MAIN_MEMORY));
+    vcl_size_t ldq = Q.internal_size1();
+    NumericT * q = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(Q);
+    for (vcl_size_t j = 0; j < l; ++j)
+    {
+      std::fill(q + j * ldq, q + j * ldq + m, NumericT(0));
+      q[j + j * ldq] = 1;
+    }
+
+    for (vcl_size_t p = num_panels; p-- > 0;)
+    {
+      vcl_size_t k = p * RSVD_BLOCK_SIZE;
+      vcl_size_t panel = std::min<vcl_size_t>(RSVD_BLOCK_SIZE, l - k);
+
+      for (vcl_size_t i = 0; i < panel; ++i)
+      {
+        NumericT * v_i = v + i * ldv;
+        NumericT const * y_i = y + (k + i) * ldy + k;
+        for (vcl_size_t r = 0; r < i; ++r)
+          v_i[r] = 0;
+        for (vcl_size_t r = i; r < m - k; ++r)
+          v_i[r] = y_i[r];
+      }
+
+      symeig_apply_block_reflector<NumericT>(V, m - k, panel, &(tau[k]), X, Q, k, k);
+    }
+
+    for (vcl_size_t j = 0; j < l; ++j)
+      std::copy(q + j * ldq, q + j * ldq + m, y + j * ldy);
+  }
+
+  /** @brief Overwrites the tall and skinny matrix Y by an orthonormal basis of its range. Matrices outside of main memory are transferred to the host and back. */
+  template<typename NumericT>
+  void rsvd_orthonormalize(typename symeig_workspace<NumericT>::type & Y)
+  {
+    if (Y.memory_domain() == viennacl::MAIN_MEMORY)
+      rsvd_orthonormalize_host<NumericT>(Y);
+    else
+    {
+      viennacl::context ctx = viennacl::traits::context(Y);
+      Y.switch_memory_context(viennacl::context(viennacl::MAIN_MEMORY));
+      rsvd_orthonormalize_host<NumericT>(Y);
+      Y.switch_memory_context(ctx);
+    }
+  }
+
+  /** @brief Randomized truncated singular value decomposition of the M-by-N matrix A, where At represents A^T for the use in prod().
+  *
+  * If U and V are NULL, only the singular values are computed.
+  */
+  template<typename MatrixT, typename TransposedMatrixT, typename NumericT>
+  void randomized_svd(MatrixT const & A, TransposedMatrixT const & At, vcl_size_t m, vcl_size_t n,
+                      std::vector<NumericT> & S, viennacl::matrix_base<NumericT> * U, viennacl::matrix_base<NumericT> * V,
+                      randomized_svd_tag const & tag)
+  {
+    typedef typename symeig_workspace<NumericT>::type   MatrixType;
+
+    assert(m > 0 && n > 0 && bool("Empty matrix passed to randomized_svd()!"));
+
+    vcl_size_t k = std::min<vcl_size_t>(m, n);
+    vcl_size_t rank = std::max<vcl_size_t>(1, std::min<vcl_size_t>(tag.rank(), k));
+    vcl_size_t l = std::min<vcl_size_t>(rank + tag.oversampling(), k);
+    viennacl::context ctx = viennacl::traits::context(A);
+    viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+
+    // Gaussian test matrix:
+    MatrixType Omega(n, l, host_ctx);
+    viennacl::tools::normal_random_numbers<NumericT> get_N;
+    NumericT * omega = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(Omega);
+    for (vcl_size_t j = 0; j < l; ++j)
+      for (vcl_size_t i = 0; i < n; ++i)
+        omega[i + j * Omega.internal_size1()] = get_N();
+    Omega.switch_memory_context(ctx);
+
+    // range finder with power iterations, orthonormalizing after each product:
+    MatrixType Y(m, l, ctx), Z(n, l, ctx);
+    Y = viennacl::linalg::prod(A, Omega);
+    rsvd_orthonormalize<NumericT>(Y);
+    for (vcl_size_t iter = 0; iter < tag.power_iterations(); ++iter)
+    {
+      Z = viennacl::linalg::prod(At, Y);
+      rsvd_orthonormalize<NumericT>(Z);
+      Y = viennacl::linalg::prod(A, Z);
+      rsvd_orthonormalize<NumericT>(Y);
+    }
+
+    // B^T = A^T Q with B^T = U_B diag(S) V_B^T, hence A ~ Q B = (Q V_B) diag(S) U_B^T:
+    Z = viennacl::linalg::prod(At, Y);
+    svd_dc_tag small_tag(svd_dc_tag::truncated, rank);
+    if (!U || !V)
+    {
+      svd_dc(Z, S, static_cast<viennacl::matrix_base<NumericT> *>(NULL), static_cast<viennacl::matrix_base<NumericT> *>(NULL), small_tag);
+      return;
+    }
+
+    MatrixType U_B(n, rank, host_ctx), V_B(l, rank, host_ctx);
+    svd_dc(Z, S, &U_B, &V_B, small_tag);
+
+    V_B.switch_memory_context(ctx);
+    *U = viennacl::linalg::prod(Y, V_B);
+    svd_copy_result<NumericT>(U_B, *V);
+  }
+} //namespace detail
+
+
+/** @brief Computes the leading singular triplets of a dense matrix by a randomized range finder with power iterations.
+*
+* The products with A and A^T are computed in the memory domain of A. U and V are resized to M-by-rank and N-by-rank if necessary.
+* The Gaussian test matrix is drawn from viennacl::tools::normal_random_numbers, i.e. from rand(); seed with srand() for reproducible results.
+*
+* @param A    The dense input matrix
+* @param S    Vector receiving the approximate leading singular values in descending order
+* @param U    Matrix receiving the approximate left singular vectors column-wise
+* @param V    Matrix receiving the approximate right singular vectors column-wise
+* @param tag  Rank, oversampling, and number of power iterations
+*/
+template<typename NumericT, typename FU, typename FV>
+void randomized_svd(viennacl::matrix_base<NumericT> const & A, std::vector<NumericT> & S,
+                    viennacl::matrix<NumericT, FU> & U, viennacl::matrix<NumericT, FV> & V,
+                    randomized_svd_tag const & tag = randomized_svd_tag())
+{
+  vcl_size_t rank = std::max<vcl_size_t>(1, std::min<vcl_size_t>(tag.rank(), std::min<vcl_size_t>(A.size1(), A.size2())));
+  if (U.size1() != A.size1() || U.size2() != rank)
+    U.resize(A.size1(), rank, false);
+  if (V.size1() != A.size2() || V.size2() != rank)
+    V.resize(A.size2(), rank, false);
+
+  detail::randomized_svd(A, viennacl::trans(A), A.size1(), A.size2(), S, &U, &V, tag);
+}
+
+/** @brief Computes the leading singular triplets of a sparse matrix by a randomized range finder with power iterations, see above for details.
+*
+* The transpose of A is set up once, so that all products are sparse matrix-dense matrix products.
+*/
+template<typename NumericT, typename FU, typename FV>
+void randomized_svd(viennacl::compressed_matrix<NumericT> const & A, std::vector<NumericT> & S,
+                    viennacl::matrix<NumericT, FU> & U, viennacl::matrix<NumericT, FV> & V,
+                    randomized_svd_tag const & tag = randomized_svd_tag())
+{
+  vcl_size_t rank = std::max<vcl_size_t>(1, std::min<vcl_size_t>(tag.rank(), std::min<vcl_size_t>(A.size1(), A.size2())));
+  if (U.size1() != A.size1() || U.size2() != rank)
+    U.resize(A.size1(), rank, false);
+  if (V.size1() != A.size2() || V.size2() != rank)
+    V.resize(A.size2(), rank, false);
+
+  viennacl::compressed_matrix<NumericT> At(A.size2(), A.size1(), 1, viennacl::traits::context(A));
+  viennacl::linalg::ilu_transpose(A, At);
+  detail::randomized_svd(A, At, A.size1(), A.size2(), S, &U, &V, tag);
+}
+
+/** @brief Computes the leading singular values (descending) of a dense matrix by a randomized range finder with power iterations. */
+template<typename NumericT>
+void randomized_svd(viennacl::matrix_base<NumericT> const & A, std::vector<NumericT> & S,
+                    randomized_svd_tag const & tag = randomized_svd_tag())
+{
+  detail::randomized_svd(A, viennacl::trans(A), A.size1(), A.size2(), S,
+                         static_cast<viennacl::matrix_base<NumericT> *>(NULL), static_cast<viennacl::matrix_base<NumericT> *>(NULL), tag);
+}
+
+/** @brief Computes the leading singular values (descending) of a sparse matrix by a randomized range finder with power iterations. */
+template<typename NumericT>
+void randomized_svd(viennacl::compressed_matrix<NumericT> const & A, std::vector<NumericT> & S,
+                    randomized_svd_tag const & tag = randomized_svd_tag())
+{
+  viennacl::compressed_matrix<NumericT> At(A.size2(), A.size1(), 1, viennacl::traits::context(A));
+  viennacl::linalg::ilu_transpose(A, At);
+  detail::randomized_svd(A, At, A.size1(), A.size2(), S,
+                         static_cast<viennacl::matrix_base<NumericT> *>(NULL), static_cast<viennacl::matrix_base<NumericT> *>(NULL), tag);
+}
+
+} //namespace linalg
+} //namespace viennacl
+
+#endif
@@ -0,0 +1,480 @@
+#ifndef VIENNACL_LINALG_SCHWARZ_HPP_
+#define VIENNACL_LINALG_SCHWARZ_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/schwarz.hpp
+    @brief Implementation of additive Schwarz and restricted additive Schwarz domain decomposition preconditioners with overlapping subdomains. Experimental.
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/misc/graph_partitioning.hpp"
+#include "viennacl/linalg/detail/ilu/ilu0.hpp"
+#include "viennacl/linalg/detail/ilu/ilut.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for an additive Schwarz preconditioner
+*/
+class schwarz_tag
+{
+public:
+  /** @brief The constructor.
+  *
+  * @param num_subdomains   Number of subdomains the graph of the system matrix is partitioned into
+  * @param overlap          Number of layers of neighboring unknowns added to each subdomain
+  * @param restricted       If true, restricted additive Schwarz (RAS) is used, i.e. each unknown is updated only by the subdomain owning it. Otherwise, the local solutions are summed up (standard additive Schwarz).
+  */
+  schwarz_tag(vcl_size_t num_subdomains = 8, unsigned int overlap = 1, bool restricted = true)
+    : num_subdomains_(num_subdomains), overlap_(overlap), restricted_(restricted) {}
+
+  vcl_size_t num_subdomains() const { return num_subdomains_; }
+  void num_subdomains(vcl_size_t num) { if (num > 0) num_subdomains_ = num; }
+
+  unsigned int overlap() const { return overlap_; }
+  void overlap(unsigned int levels) { overlap_ = levels; }
+
+  bool restricted() const { return restricted_; }
+  void restricted(bool b) { restricted_ = b; }
+
+private:
+  vcl_size_t   num_subdomains_;
+  unsigned int overlap_;
+  bool         restricted_;
+};
+
+
+/** @brief A tag selecting a dense LU factorization with partial pivoting as local solver. Only suitable for small subdomains.
+*/
+class dense_lu_tag {};
+
+
+namespace detail
+{
+  /** @brief Extracts the submatrix A(indices, indices) for a sorted index set. Column indices within a row remain sorted if they are sorted in A.
+    *
+    * @param local_index   Work array of size A.size1() initialized with -1. Restored on exit.
+    */
+  template<typename NumericT>
+  void schwarz_extract_submatrix(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements,
+                                 std::vector<unsigned int> const & indices, std::vector<long> & local_index,
+                                 viennacl::compressed_matrix<NumericT> & local_A)
+  {
+    for (vcl_size_t i = 0; i < indices.size(); ++i)
+      local_index[indices[i]] = static_cast<long>(i);
+
+    std::vector<unsigned int> local_rows(1, 0);
+    std::vector<unsigned int> local_cols;
+    std::vector<NumericT>     local_values;
+    for (vcl_size_t i = 0; i < indices.size(); ++i)
+    {
+      unsigned int row = indices[i];
+      for (unsigned int j = row_buffer[row]; j < row_buffer[row+1]; ++j)
+      {
+        long col = local_index[col_buffer[j]];
+        if (col >= 0)
+        {
+          local_cols.push_back(static_cast<unsigned int>(col));
+          local_values.push_back(elements[j]);
+        }
+      }
+      local_rows.push_back(static_cast<unsigned int>(local_cols.size()));
+    }
+
+    for (vcl_size_t i = 0; i < indices.size(); ++i)
+      local_index[indices[i]] = -1;
+
+    viennacl::context host_context(viennacl::MAIN_MEMORY);
+    local_A = viennacl::compressed_matrix<NumericT>(indices.size(), indices.size(), local_cols.size(), host_context);
+    if (local_cols.size() > 0)
+      local_A.set(&(local_rows[0]), &(local_cols[0]), &(local_values[0]), indices.size(), indices.size(), local_cols.size());
+  }
+
+  /** @brief A triangular factor of a local solver, stored in plain CSR arrays such that local solvers can be kept in a std::vector */
+  template<typename NumericT>
+  struct schwarz_csr_factor
+  {
+    void assign(viennacl::compressed_matrix<NumericT> const & A)
+    {
+      unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+      unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+      NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+
+      size = A.size1();
+      rows.assign(row_buffer, row_buffer + size + 1);
+      cols.assign(col_buffer, col_buffer + rows[size]);
+      values.assign(elements, elements + rows[size]);
+    }
+
+    template<typename TagT>
+    void inplace_solve(std::vector<NumericT> & x, TagT tag) const
+    {
+      if (size > 0)
+        viennacl::linalg::host_based::detail::csr_inplace_solve<NumericT>(&(rows[0]), cols.size() > 0 ? &(cols[0]) : NULL, values.size() > 0 ? &(values[0]) : NULL, x, size, tag);
+    }
+
+    vcl_size_t                size;
+    std::vector<unsigned int> rows;
+    std::vector<unsigned int> cols;
+    std::vector<NumericT>     values;
+  };
+
+  /** @brief Local solver for a subdomain of an additive Schwarz preconditioner. Specialized for the respective tags. */
+  template<typename NumericT, typename LocalTagT>
+  class schwarz_local_solver;
+
+  /** @brief ILU0 as local solver */
+  template<typename NumericT>
+  class schwarz_local_solver<NumericT, viennacl::linalg::ilu0_tag>
+  {
+  public:
+    void init(viennacl::compressed_matrix<NumericT> const & local_A, viennacl::linalg::ilu0_tag const & tag)
+    {
+      viennacl::compressed_matrix<NumericT> LU(viennacl::context(viennacl::MAIN_MEMORY));
+      LU = local_A;
+      viennacl::linalg::precondition(LU, tag);
+      LU_.assign(LU);
+    }
+
+    void apply(std::vector<NumericT> & x) const
+    {
+      LU_.inplace_solve(x, unit_lower_tag());
+      LU_.inplace_solve(x, upper_tag());
+    }
+
+  private:
+    schwarz_csr_factor<NumericT> LU_;
+  };
+
+  /** @brief ILUT as local solver */
+  template<typename NumericT>
+  class schwarz_local_solver<NumericT, viennacl::linalg::ilut_tag>
+  {
+  public:
+    void init(viennacl::compressed_matrix<NumericT> const & local_A, viennacl::linalg::ilut_tag const & tag)
+    {
+      viennacl::context host_context(viennacl::MAIN_MEMORY);
+      viennacl::compressed_matrix<NumericT> L(local_A.size1(), local_A.size2(), host_context);
+      viennacl::compressed_matrix<NumericT> U(local_A.size1(), local_A.size2(), host_context);
+      viennacl::linalg::ilut_tag local_tag(tag); // subdomains are factored concurrently, fill statistics must not be written to a shared tag
+      viennacl::linalg::precondition(local_A, L, U, local_tag);
+      L_.assign(L);
+      U_.assign(U);
+    }
+
+    void apply(std::vector<NumericT> & x) const
+    {
+      L_.inplace_solve(x, unit_lower_tag());
+      U_.inplace_solve(x, upper_tag());
+    }
+
+  private:
+    schwarz_csr_factor<NumericT> L_;
+    schwarz_csr_factor<NumericT> U_;
+  };
+
+  /** @brief Dense LU factorization with partial pivoting as local solver */
+  template<typename NumericT>
+  class schwarz_local_solver<NumericT, viennacl::linalg::dense_lu_tag>
+  {
+  public:
+    void init(viennacl::compressed_matrix<NumericT> const & local_A, viennacl::linalg::dense_lu_tag const &)
+    {
+      unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(local_A.handle1());
+      unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(local_A.handle2());
+      NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(local_A.handle());
+
+      n_ = local_A.size1();
+      LU_.assign(n_ * n_, NumericT(0));
+      pivots_.resize(n_);
+      for (vcl_size_t i = 0; i < n_; ++i)
+        for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+          LU_[i * n_ + col_buffer[j]] = elements[j];
+
+      // row-major LU factorization with partial pivoting:
+      for (vcl_size_t k = 0; k < n_; ++k)
+      {
+        vcl_size_t pivot_row = k;
+        for (vcl_size_t i = k + 1; i < n_; ++i)
+          if (std::fabs(LU_[i * n_ + k]) > std::fabs(LU_[pivot_row * n_ + k]))
+            pivot_row = i;
+        pivots_[k] = pivot_row;
+        if (pivot_row != k)
+          std::swap_ranges(LU_.begin() + static_cast<long>(k * n_), LU_.begin() + static_cast<long>((k + 1) * n_), LU_.begin() + static_cast<long>(pivot_row * n_));
+
+        NumericT a_kk = LU_[k * n_ + k];
+        if (a_kk <= 0 && a_kk >= 0)
+          throw zero_on_diagonal_exception("ViennaCL: Singular subdomain matrix in dense LU factorization of additive Schwarz preconditioner.");
+
+        for (vcl_size_t i = k + 1; i < n_; ++i)
+        {
+          NumericT l_ik = LU_[i * n_ + k] / a_kk;
+          LU_[i * n_ + k] = l_ik;
+          if (l_ik <= 0 && l_ik >= 0)
+            continue;
+          for (vcl_size_t j = k + 1; j < n_; ++j)
+            LU_[i * n_ + j] -= l_ik * LU_[k * n_ + j];
+        }
+      }
+    }
+
+    void apply(std::vector<NumericT> & x) const
+    {
+      for (vcl_size_t k = 0; k < n_; ++k)
+        std::swap(x[k], x[pivots_[k]]);
+
+      for (vcl_size_t i = 0; i < n_; ++i)
+      {
+        NumericT sum = x[i];
+        for (vcl_size_t j = 0; j < i; ++j)
+          sum -= LU_[i * n_ + j] * x[j];
+        x[i] = sum;
+      }
+
+      for (vcl_size_t i2 = 0; i2 < n_; ++i2)
+      {
+        vcl_size_t i = n_ - i2 - 1;
+        NumericT sum = x[i];
+        for (vcl_size_t j = i + 1; j < n_; ++j)
+          sum -= LU_[i * n_ + j] * x[j];
+        x[i] = sum / LU_[i * n_ + i];
+      }
+    }
+
+  private:
+    vcl_size_t              n_;
+    std::vector<NumericT>   LU_;
+    std::vector<vcl_size_t> pivots_;
+  };
+
+} // namespace detail
+
+
+/** @brief Additive Schwarz preconditioner. Only available for compressed_matrix, see specialization below. */
+template<typename MatrixT, typename LocalTagT>
+class schwarz_precond;
+
+/** @brief Additive Schwarz and restricted additive Schwarz preconditioner for a compressed_matrix, can be supplied to solve()-routines.
+*
+* The graph of the system matrix is partitioned into subdomains by the multilevel k-way partitioner (see viennacl/misc/graph_partitioning.hpp), which are extended by the prescribed number of layers of neighboring unknowns.
+* Each extended subdomain is factored by the local solver selected through LocalTagT (ilu0_tag, ilut_tag, or dense_lu_tag).
+* Setup and application are carried out on the host, with the subdomains distributed over the OpenMP threads.
+* Compared to block_ilu_precond, the overlap considerably reduces the number of iterations at the same degree of parallelism.
+*
+* @tparam MatrixT     Type of the system matrix
+* @tparam LocalTagT   Tag selecting the local solver for each subdomain
+*/
+template<typename NumericT, unsigned int AlignmentV, typename LocalTagT>
+class schwarz_precond< viennacl::compressed_matrix<NumericT, AlignmentV>, LocalTagT >
+{
+  typedef viennacl::compressed_matrix<NumericT, AlignmentV>   MatrixType;
+
+public:
+  /** @brief Sets up the preconditioner using the built-in graph partitioning
+  *
+  * @param A           The system matrix
+  * @param tag         The Schwarz configuration
+  * @param local_tag   The configuration of the local solver
+  */
+  schwarz_precond(MatrixType const & A, schwarz_tag const & tag, LocalTagT const & local_tag = LocalTagT())
+    : tag_(tag), local_tag_(local_tag)
+  {
+    viennacl::compressed_matrix<NumericT> host_A(viennacl::context(viennacl::MAIN_MEMORY));
+    host_A = A;
+
+    viennacl::multilevel_kway_tag partitioning_tag(std::min<vcl_size_t>(tag.num_subdomains(), std::max<vcl_size_t>(host_A.size1(), 1)));
+    init(host_A, viennacl::partition(host_A, partitioning_tag));
+  }
+
+  /** @brief Sets up the preconditioner for a user-supplied partitioning
+  *
+  * @param A           The system matrix
+  * @param tag         The Schwarz configuration. The number of subdomains is taken from the partition.
+  * @param partition   Subdomain of each unknown, with subdomains numbered consecutively starting at zero
+  * @param local_tag   The configuration of the local solver
+  */
+  schwarz_precond(MatrixType const & A, schwarz_tag const & tag, std::vector<unsigned int> const & partition, LocalTagT const & local_tag = LocalTagT())
+    : tag_(tag), local_tag_(local_tag)
+  {
+    assert(partition.size() == A.size1() && bool("Size of partition does not match system matrix"));
+
+    viennacl::compressed_matrix<NumericT> host_A(viennacl::context(viennacl::MAIN_MEMORY));
+    host_A = A;
+    init(host_A, partition);
+  }
+
+  /** @brief Applies the preconditioner. Vectors not residing in main memory are transferred to main memory and back. */
+  void apply(viennacl::vector_base<NumericT> & vec) const
+  {
+    if (viennacl::traits::active_handle_id(vec) == viennacl::MAIN_MEMORY)
+    {
+      NumericT * vec_buf = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec);
+      apply(vec_buf + viennacl::traits::start(vec), viennacl::traits::stride(vec));
+    }
+    else
+    {
+      std::vector<NumericT> host_vec(vec.size());
+      viennacl::copy(vec, host_vec);
+      if (host_vec.size() > 0)
+        apply(&(host_vec[0]), 1);
+      viennacl::copy(host_vec, vec);
+    }
+  }
+
+  /** @brief Returns the number of subdomains */
+  vcl_size_t num_subdomains() const { return subdomains_.size(); }
+
+  /** @brief Returns the unknowns of the i-th subdomain including the overlap, sorted in ascending order */
+  std::vector<unsigned int> const & subdomain(vcl_size_t i) const { return subdomains_[i]; }
+
+private:
+  void init(viennacl::compressed_matrix<NumericT> const & host_A, std::vector<unsigned int> const & partition)
+  {
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(host_A.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(host_A.handle2());
+    NumericT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(host_A.handle());
+
+    vcl_size_t n = host_A.size1();
+    vcl_size_t num_parts = 0;
+    for (vcl_size_t i = 0; i < n; ++i)
+      num_parts = std::max<vcl_size_t>(num_parts, partition[i] + 1);
+
+    subdomains_.resize(num_parts);
+    owned_.resize(num_parts);
+    local_solvers_.resize(num_parts);
+    local_vectors_.resize(num_parts);
+
+    for (vcl_size_t i = 0; i < n; ++i)
+      subdomains_[partition[i]].push_back(static_cast<unsigned int>(i));
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      std::vector<long> local_index(n, -1);
+      std::vector<bool> in_subdomain(n, false);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for schedule(dynamic, 1)
+#endif
+      for (long s2 = 0; s2 < static_cast<long>(num_parts); ++s2)
+      {
+        vcl_size_t s = static_cast<vcl_size_t>(s2);
+        std::vector<unsigned int> & indices = subdomains_[s];
+
+        // Step 1: Add overlap layer by layer:
+        for (vcl_size_t i = 0; i < indices.size(); ++i)
+          in_subdomain[indices[i]] = true;
+        vcl_size_t layer_begin = 0;
+        for (unsigned int level = 0; level < tag_.overlap(); ++level)
+        {
+          vcl_size_t layer_end = indices.size();
+          for (vcl_size_t i = layer_begin; i < layer_end; ++i)
+            for (unsigned int j = row_buffer[indices[i]]; j < row_buffer[indices[i]+1]; ++j)
+              if (!in_subdomain[col_buffer[j]])
+              {
+                in_subdomain[col_buffer[j]] = true;
+                indices.push_back(col_buffer[j]);
+              }
+          layer_begin = layer_end;
+        }
+        for (vcl_size_t i = 0; i < indices.size(); ++i)
+          in_subdomain[indices[i]] = false;
+        std::sort(indices.begin(), indices.end());
+
+        // Step 2: Mark the unknowns updated by this subdomain (all for standard additive Schwarz, only the owned ones for RAS):
+        owned_[s].resize(indices.size());
+        for (vcl_size_t i = 0; i < indices.size(); ++i)
+          owned_[s][i] = !tag_.restricted() || partition[indices[i]] == s;
+
+        // Step 3: Factor subdomain matrix:
+        viennacl::compressed_matrix<NumericT> local_A;
+        detail::schwarz_extract_submatrix(row_buffer, col_buffer, elements, indices, local_index, local_A);
+        local_solvers_[s].init(local_A, local_tag_);
+        local_vectors_[s].resize(indices.size());
+      }
+    }
+  }
+
+  void apply(NumericT * x, vcl_size_t stride) const
+  {
+    long num_parts = static_cast<long>(subdomains_.size());
+
+    // Solve all subdomain problems with the restricted residual:
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (long s2 = 0; s2 < num_parts; ++s2)
+    {
+      vcl_size_t s = static_cast<vcl_size_t>(s2);
+      std::vector<unsigned int> const & indices = subdomains_[s];
+      std::vector<NumericT> & local_x = local_vectors_[s];
+      for (vcl_size_t i = 0; i < indices.size(); ++i)
+        local_x[i] = x[indices[i] * stride];
+      local_solvers_[s].apply(local_x);
+    }
+
+    // Prolongate local solutions. For RAS, each unknown is owned by exactly one subdomain, so the updates are free of conflicts:
+    if (tag_.restricted())
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long s2 = 0; s2 < num_parts; ++s2)
+      {
+        vcl_size_t s = static_cast<vcl_size_t>(s2);
+        std::vector<unsigned int> const & indices = subdomains_[s];
+        for (vcl_size_t i = 0; i < indices.size(); ++i)
+          if (owned_[s][i])
+            x[indices[i] * stride] = local_vectors_[s][i];
+      }
+    }
+    else
+    {
+      for (vcl_size_t s = 0; s < subdomains_.size(); ++s)
+        for (vcl_size_t i = 0; i < subdomains_[s].size(); ++i)
+          x[subdomains_[s][i] * stride] = 0;
+      for (vcl_size_t s = 0; s < subdomains_.size(); ++s)
+        for (vcl_size_t i = 0; i < subdomains_[s].size(); ++i)
+          x[subdomains_[s][i] * stride] += local_vectors_[s][i];
+    }
+  }
+
+  schwarz_tag tag_;
+  LocalTagT   local_tag_;
+  std::vector< std::vector<unsigned int> > subdomains_;
+  std::vector< std::vector<bool> >         owned_;
+  std::vector< detail::schwarz_local_solver<NumericT, LocalTagT> > local_solvers_;
+  mutable std::vector< std::vector<NumericT> > local_vectors_;
+};
+
+}
+}
+
+#endif
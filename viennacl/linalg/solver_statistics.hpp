@@ -0,0 +1,279 @@
+#ifndef VIENNACL_LINALG_SOLVER_STATISTICS_HPP_
+#define VIENNACL_LINALG_SOLVER_STATISTICS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/solver_statistics.hpp
+    @brief Opt-in instrumentation of the iterative solvers: Residual history, time and estimated memory traffic per phase.
+*/
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cmath>
+
+#include "viennacl/forwards.h"
+#include "viennacl/tools/timer.hpp"
+#include "viennacl/backend/memory.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief Accumulated time, estimated memory traffic and number of calls of one phase of an iterative solver. */
+struct solver_phase_statistics
+{
+  solver_phase_statistics() : time(0), bytes(0), calls(0) {}
+
+  double     time;    ///< Accumulated execution time in seconds
+  double     bytes;   ///< Estimated number of bytes read and written by the kernels (lower bound, assumes perfect caching)
+  vcl_size_t calls;   ///< Number of times the phase was entered
+
+  /** @brief Returns the effective bandwidth in bytes per second, or zero if no time was recorded */
+  double bandwidth() const { return (time > 0) ? bytes / time : 0; }
+};
+
+/** @brief Instrumentation record of an iterative solver run.
+*
+* Pass a pointer to an object of this type to the solver tag via statistics() in order to enable the instrumentation.
+* Each phase is followed by a synchronization with the compute device when instrumentation is enabled, so that the timings are attributed correctly,
+* but the solver runs slightly slower than without instrumentation. The record is cleared at the beginning of each solver run.
+*
+* Note that the fused and pipelined solver variants compute inner products as part of the matrix-vector products and vector updates.
+* In that case only the final summation of the partial results on the host is accounted as reduction.
+*/
+struct solver_statistics
+{
+  /** @brief The phases of an iterative solver for which time and memory traffic are recorded */
+  enum phase_type
+  {
+    SPMV = 0,          ///< Sparse matrix-vector products
+    PRECONDITIONER,    ///< Applications of the preconditioner
+    REDUCTION,         ///< Inner products and norms
+    VECTOR_UPDATE      ///< Vector updates (including orthogonalization in GMRES)
+  };
+
+  solver_statistics() : total_time(0), iterations(0) {}
+
+  /** @brief Returns the record of the given phase */
+  solver_phase_statistics       & phase(phase_type p)
+  {
+    switch (p)
+    {
+    case SPMV:           return spmv;
+    case PRECONDITIONER: return preconditioner;
+    case REDUCTION:      return reduction;
+    default:             return vector_update;
+    }
+  }
+
+  /** @brief Returns the record of the given phase */
+  solver_phase_statistics const & phase(phase_type p) const { return const_cast<solver_statistics &>(*this).phase(p); }
+
+  /** @brief Resets all records */
+  void clear() { *this = solver_statistics(); }
+
+  /** @brief Returns the total estimated memory traffic of all phases in bytes */
+  double total_bytes() const { return spmv.bytes + preconditioner.bytes + reduction.bytes + vector_update.bytes; }
+
+  /** @brief Returns the record as JSON object, for example for writing to log files. */
+  std::string to_json() const
+  {
+    std::ostringstream oss;
+    oss.precision(10);
+    oss << "{\"iterations\": " << iterations
+        << ", \"total_time\": " << json_number(total_time)
+        << ", \"total_bytes\": " << json_number(total_bytes())
+        << ", \"phases\": {"
+        <<   "\"spmv\": "           << json_phase(spmv)
+        << ", \"preconditioner\": " << json_phase(preconditioner)
+        << ", \"reduction\": "      << json_phase(reduction)
+        << ", \"vector_update\": "  << json_phase(vector_update)
+        << "}, \"residual_history\": [";
+    for (vcl_size_t i=0; i<residual_history.size(); ++i)
+      oss << (i > 0 ? ", " : "") << json_number(residual_history[i]);
+    oss << "]}";
+    return oss.str();
+  }
+
+  solver_phase_statistics spmv;
+  solver_phase_statistics preconditioner;
+  solver_phase_statistics reduction;
+  solver_phase_statistics vector_update;
+
+  std::vector<double> residual_history;   ///< Relative residual (estimate) after each iteration as computed by the solver
+  double              total_time;         ///< Total time spent in the solver in seconds (including time not attributed to any of the phases, e.g. monitor callbacks)
+  vcl_size_t          iterations;         ///< Number of iterations taken
+
+private:
+  static std::string json_number(double value)
+  {
+    if (value != value || std::fabs(value) > 1e300) // NaN and Inf are not valid JSON
+      return "null";
+    std::ostringstream oss;
+    oss.precision(10);
+    oss << value;
+    return oss.str();
+  }
+
+  static std::string json_phase(solver_phase_statistics const & p)
+  {
+    std::ostringstream oss;
+    oss << "{\"time\": " << json_number(p.time) << ", \"bytes\": " << json_number(p.bytes) << ", \"calls\": " << p.calls << "}";
+    return oss.str();
+  }
+};
+
+
+namespace detail
+{
+  /** @brief Records the phases of an iterative solver run in a solver_statistics object. All member functions are no-ops if no record is attached.
+  *
+  * Time is attributed to a phase from the previous call of record() or mark() up to the current call of record().
+  */
+  class solver_statistics_recorder
+  {
+  public:
+    /** @brief Starts the recording.
+    *
+    * @param stats          The record to fill. May be NULL, in which case nothing is recorded.
+    * @param vector_size    The number of entries in the vectors the solver operates on
+    * @param element_size   The size of a vector entry in bytes
+    */
+    solver_statistics_recorder(solver_statistics * stats, vcl_size_t vector_size, vcl_size_t element_size)
+      : stats_(stats), vector_bytes_(static_cast<double>(vector_size) * static_cast<double>(element_size))
+    {
+      if (stats_)
+      {
+        stats_->clear();
+        viennacl::backend::finish();
+        total_timer_.start();
+        phase_timer_.start();
+      }
+    }
+
+    ~solver_statistics_recorder()
+    {
+      if (stats_)
+      {
+        viennacl::backend::finish();
+        stats_->total_time = total_timer_.get();
+      }
+    }
+
+    /** @brief Returns true if a record is attached */
+    bool active() const { return stats_ != NULL; }
+
+    /** @brief Attributes the time since the last mark to the given phase and adds the estimated memory traffic. */
+    void record(solver_statistics::phase_type phase, double bytes)
+    {
+      if (!stats_)
+        return;
+
+      viennacl::backend::finish();
+      solver_phase_statistics & p = stats_->phase(phase);
+      p.time  += phase_timer_.get();
+      p.bytes += bytes;
+      p.calls += 1;
+      phase_timer_.start();
+    }
+
+    /** @brief Starts a new time interval without attributing the elapsed time to any phase (e.g. after calling the monitor) */
+    void mark() { if (stats_) phase_timer_.start(); }
+
+    /** @brief Appends a relative residual to the residual history */
+    void residual(double relative_residual) { if (stats_) stats_->residual_history.push_back(relative_residual); }
+
+    /** @brief Sets the number of iterations taken */
+    void iterations(vcl_size_t num_iterations) { if (stats_) stats_->iterations = num_iterations; }
+
+    /** @brief Returns the number of bytes of 'num_vectors' vectors */
+    double vector_bytes(double num_vectors) const { return num_vectors * vector_bytes_; }
+
+  private:
+    solver_statistics * stats_;
+    double vector_bytes_;
+    viennacl::tools::timer total_timer_;
+    viennacl::tools::timer phase_timer_;
+  };
+
+  /** @brief Returns the number of bytes the preconditioner reads and writes. Unknown for general preconditioners, hence only the vector is accounted. */
+  template<typename PreconditionerT>
+  double preconditioner_bytes(PreconditionerT const &, solver_statistics_recorder const & rec) { return rec.vector_bytes(2); }
+
+  /** @brief No memory traffic without preconditioner */
+  inline double preconditioner_bytes(viennacl::linalg::no_precond const &, solver_statistics_recorder const &) { return 0; }
+
+  /** @brief Returns true if a preconditioner is applied, false for no_precond */
+  template<typename PreconditionerT>
+  bool has_preconditioner(PreconditionerT const &) { return true; }
+
+  inline bool has_preconditioner(viennacl::linalg::no_precond const &) { return false; }
+
+
+  //
+  // Estimated memory traffic of y = A * x: All matrix buffers are read once, x is read once, y is written once.
+  //
+
+  /** @brief Fallback for matrix types for which the memory traffic is unknown (e.g. matrix-free operators or third-party types) */
+  template<typename MatrixT>
+  double spmv_bytes(MatrixT const &) { return 0; }
+
+  template<typename NumericT, unsigned int AlignmentV>
+  double spmv_bytes(viennacl::compressed_matrix<NumericT, AlignmentV> const & A)
+  {
+    return static_cast<double>(A.handle1().raw_size() + A.handle2().raw_size() + A.handle().raw_size() + sizeof(NumericT) * (A.size1() + A.size2()));
+  }
+
+  template<typename NumericT, unsigned int AlignmentV>
+  double spmv_bytes(viennacl::coordinate_matrix<NumericT, AlignmentV> const & A)
+  {
+    return static_cast<double>(A.handle12().raw_size() + A.handle().raw_size() + sizeof(NumericT) * (A.size1() + A.size2()));
+  }
+
+  template<typename NumericT, unsigned int AlignmentV>
+  double spmv_bytes(viennacl::ell_matrix<NumericT, AlignmentV> const & A)
+  {
+    return static_cast<double>(A.handle2().raw_size() + A.handle().raw_size() + sizeof(NumericT) * (A.size1() + A.size2()));
+  }
+
+  template<typename NumericT, typename IndexT>
+  double spmv_bytes(viennacl::sliced_ell_matrix<NumericT, IndexT> const & A)
+  {
+    return static_cast<double>(A.handle1().raw_size() + A.handle2().raw_size() + A.handle3().raw_size() + A.handle().raw_size() + sizeof(NumericT) * (A.size1() + A.size2()));
+  }
+
+  template<typename NumericT, unsigned int AlignmentV>
+  double spmv_bytes(viennacl::hyb_matrix<NumericT, AlignmentV> const & A)
+  {
+    return static_cast<double>(A.handle().raw_size() + A.handle2().raw_size() + A.handle3().raw_size() + A.handle4().raw_size() + A.handle5().raw_size() + sizeof(NumericT) * (A.size1() + A.size2()));
+  }
+
+  template<typename NumericT, typename F, unsigned int AlignmentV>
+  double spmv_bytes(viennacl::matrix<NumericT, F, AlignmentV> const & A)
+  {
+    return static_cast<double>(sizeof(NumericT) * (A.size1() * A.size2() + A.size1() + A.size2()));
+  }
+
+} //namespace detail
+
+}
+}
+
+#endif
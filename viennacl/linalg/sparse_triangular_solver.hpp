@@ -0,0 +1,667 @@
+#ifndef VIENNACL_LINALG_SPARSE_TRIANGULAR_SOLVER_HPP_
+#define VIENNACL_LINALG_SPARSE_TRIANGULAR_SOLVER_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/sparse_triangular_solver.hpp
+    @brief Parallel solution of sparse triangular systems on the host with a dependency analysis computed once and reused for each solve.
+*/
+
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+/** @brief Minimum number of rows for which the automatic strategy selection of sparse_triangular_solver considers parallel execution */
+#ifndef VIENNACL_SPTRSV_MIN_SIZE
+  #define VIENNACL_SPTRSV_MIN_SIZE  5000
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief The execution strategies of sparse_triangular_solver */
+enum sparse_triangular_solver_strategy
+{
+  SPTRSV_AUTO = 0,      ///< Selected from the dependency analysis and the number of threads
+  SPTRSV_SEQUENTIAL,    ///< Plain forward or backward substitution by a single thread
+  SPTRSV_LEVEL_SET,     ///< Rows without mutual dependencies are grouped into levels, which are processed one after another with a barrier in between
+  SPTRSV_SYNC_FREE,     ///< Rows are processed in parallel in topological order, where each row waits only for the rows it depends on. No barriers.
+  SPTRSV_BLOCKED        ///< Level scheduling of contiguous blocks of rows, where each block is substituted by a single thread. Few barriers, but coarse-grained parallelism only.
+};
+
+namespace detail
+{
+  inline bool sptrsv_is_lower(viennacl::linalg::lower_tag)      { return true; }
+  inline bool sptrsv_is_lower(viennacl::linalg::unit_lower_tag) { return true; }
+  inline bool sptrsv_is_lower(viennacl::linalg::upper_tag)      { return false; }
+  inline bool sptrsv_is_lower(viennacl::linalg::unit_upper_tag) { return false; }
+
+  inline bool sptrsv_is_unit(viennacl::linalg::lower_tag)      { return false; }
+  inline bool sptrsv_is_unit(viennacl::linalg::unit_lower_tag) { return true; }
+  inline bool sptrsv_is_unit(viennacl::linalg::upper_tag)      { return false; }
+  inline bool sptrsv_is_unit(viennacl::linalg::unit_upper_tag) { return true; }
+
+  /** @brief Returns the number of threads available for the triangular solve */
+  inline vcl_size_t sptrsv_num_threads()
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    return static_cast<vcl_size_t>(omp_get_max_threads());
+#else
+    return 1;
+#endif
+  }
+
+  /** @brief Computes the levels of blocks of block_size consecutive rows in execution order. A block depends on another block if any of its rows depends on a row of the other block.
+    *
+    * @param rows             Row pointers of the strict triangle (indexed by row)
+    * @param cols             Column indices of the strict triangle
+    * @param order            The row at each position of the execution order
+    * @param block_size       Number of consecutive positions per block
+    * @param block_level      Output: The level of each block
+    * @return The number of block levels
+    */
+  inline vcl_size_t sptrsv_block_levels(std::vector<unsigned int> const & rows, std::vector<unsigned int> const & cols,
+                                        std::vector<unsigned int> const & order,
+                                        vcl_size_t block_size, std::vector<unsigned int> & block_level)
+  {
+    vcl_size_t num_rows   = order.size();
+    vcl_size_t num_blocks = (num_rows + block_size - 1) / block_size;
+    block_level.assign(num_blocks, 0);
+
+    std::vector<unsigned int> block_of_row(num_rows);
+    for (vcl_size_t p = 0; p < num_rows; ++p)
+      block_of_row[order[p]] = static_cast<unsigned int>(p / block_size);
+
+    vcl_size_t num_levels = 0;
+    for (vcl_size_t b = 0; b < num_blocks; ++b)
+    {
+      vcl_size_t block_begin = b * block_size;
+      vcl_size_t block_end   = std::min(num_rows, block_begin + block_size);
+      unsigned int level = 0;
+      for (vcl_size_t p = block_begin; p < block_end; ++p)
+        for (unsigned int j = rows[order[p]]; j < rows[order[p] + 1]; ++j)
+        {
+          unsigned int dep_block = block_of_row[cols[j]];
+          if (dep_block != b)
+            level = std::max<unsigned int>(level, block_level[dep_block] + 1);
+        }
+      block_level[b] = level;
+      num_levels = std::max<vcl_size_t>(num_levels, level + 1);
+    }
+    return num_levels;
+  }
+}
+
+
+/** @brief Solver for sparse triangular systems on the host, which analyzes the dependencies among the rows once and reuses the analysis for each solve.
+*
+* Depending on the available parallelism found in the analysis and the number of OpenMP threads, the rows are substituted sequentially,
+* by level scheduling, in a synchronization-free fashion where each row waits for the rows it depends on, or by level scheduling of contiguous row blocks.
+* The result of each row is identical for all strategies, as the summation order within each row is the same.
+*
+* The triangular part of the matrix is copied to an internal representation in the order of execution, hence the matrix can be modified or destroyed afterwards.
+* If only the values change while the sparsity pattern remains the same, update_values() refreshes the values without repeating the analysis.
+* apply_transposed() solves with the transposed matrix using the same internal representation, so that e.g. both substitutions of an incomplete Cholesky preconditioner need only one copy of the factor.
+* Entries of the matrix outside the respective triangle are ignored. A solver object must not be applied concurrently by several threads.
+*
+* @tparam NumericT   The floating point type
+*/
+template<typename NumericT>
+class sparse_triangular_solver
+{
+public:
+  sparse_triangular_solver() : size_(0), lower_(true), unit_diagonal_(false), transposed_(false), strategy_(SPTRSV_SEQUENTIAL), num_levels_(0), block_size_(0), epoch_(0) {}
+
+  /** @brief Analyzes the triangular system given by a compressed_matrix.
+  *
+  * @param T          The matrix. Only the entries of the triangle identified by the tag and the diagonal are used.
+  * @param tag        One of lower_tag, unit_lower_tag, upper_tag, unit_upper_tag
+  * @param strategy   The execution strategy. SPTRSV_AUTO selects the strategy from the analysis.
+  */
+  template<unsigned int AlignmentV, typename TagT>
+  sparse_triangular_solver(viennacl::compressed_matrix<NumericT, AlignmentV> const & T, TagT tag, sparse_triangular_solver_strategy strategy = SPTRSV_AUTO)
+    : size_(0), lower_(true), unit_diagonal_(false), transposed_(false), strategy_(SPTRSV_SEQUENTIAL), num_levels_(0), block_size_(0), epoch_(0)
+  {
+    init(T, tag, strategy);
+  }
+
+  /** @brief Analyzes the triangular system given by the transpose of a compressed_matrix, e.g. trans(U) for the factor of an incomplete Cholesky factorization.
+  *
+  * @param proxy      The transposed matrix, i.e. trans(T)
+  * @param tag        One of lower_tag, unit_lower_tag, upper_tag, unit_upper_tag, referring to the transposed matrix
+  * @param strategy   The execution strategy. SPTRSV_AUTO selects the strategy from the analysis.
+  */
+  template<unsigned int AlignmentV, typename TagT>
+  sparse_triangular_solver(viennacl::matrix_expression<const viennacl::compressed_matrix<NumericT, AlignmentV>,
+                                                       const viennacl::compressed_matrix<NumericT, AlignmentV>,
+                                                       viennacl::op_trans> const & proxy,
+                           TagT tag, sparse_triangular_solver_strategy strategy = SPTRSV_AUTO)
+    : size_(0), lower_(true), unit_diagonal_(false), transposed_(false), strategy_(SPTRSV_SEQUENTIAL), num_levels_(0), block_size_(0), epoch_(0)
+  {
+    init(proxy, tag, strategy);
+  }
+
+  /** @brief (Re-)analyzes the triangular system given by a compressed_matrix. See the respective constructor for the parameters. */
+  template<unsigned int AlignmentV, typename TagT>
+  void init(viennacl::compressed_matrix<NumericT, AlignmentV> const & T, TagT tag, sparse_triangular_solver_strategy strategy = SPTRSV_AUTO)
+  {
+    assert(T.size1() == T.size2() && bool("Triangular matrix must be square!"));
+    lower_         = detail::sptrsv_is_lower(tag);
+    unit_diagonal_ = detail::sptrsv_is_unit(tag);
+    transposed_    = false;
+    with_host_buffers(T, strategy, &sparse_triangular_solver::analyze);
+  }
+
+  /** @brief (Re-)analyzes the triangular system given by the transpose of a compressed_matrix. See the respective constructor for the parameters. */
+  template<unsigned int AlignmentV, typename TagT>
+  void init(viennacl::matrix_expression<const viennacl::compressed_matrix<NumericT, AlignmentV>,
+                                        const viennacl::compressed_matrix<NumericT, AlignmentV>,
+                                        viennacl::op_trans> const & proxy,
+            TagT tag, sparse_triangular_solver_strategy strategy = SPTRSV_AUTO)
+  {
+    assert(proxy.lhs().size1() == proxy.lhs().size2() && bool("Triangular matrix must be square!"));
+    lower_         = detail::sptrsv_is_lower(tag);
+    unit_diagonal_ = detail::sptrsv_is_unit(tag);
+    transposed_    = true;
+    with_host_buffers(proxy.lhs(), strategy, &sparse_triangular_solver::analyze);
+  }
+
+  /** @brief Replaces the values of the triangular system by the values of T, which must have the same sparsity pattern as the matrix used for the analysis (transposed, if the analysis was for a transposed matrix). */
+  template<unsigned int AlignmentV>
+  void update_values(viennacl::compressed_matrix<NumericT, AlignmentV> const & T)
+  {
+    assert((src_.size() == values_.size() && diag_src_.size() == size_) && bool("Values of sparse triangular solver cannot be updated after release_value_map()"));
+    with_host_buffers(T, strategy_, &sparse_triangular_solver::gather_values);
+  }
+
+  /** @brief Releases the map from the stored entries to the entries of the analyzed matrix, which is only needed by update_values(). Saves memory if the values never change. */
+  void release_value_map()
+  {
+    std::vector<unsigned int>().swap(src_);
+    std::vector<long>().swap(diag_src_);
+  }
+
+  /** @brief Solves the triangular system in place. Vectors not residing in main memory are transferred to main memory and back. */
+  void apply(viennacl::vector_base<NumericT> & vec) const
+  {
+    apply_on_host(vec, &sparse_triangular_solver::apply);
+  }
+
+  /** @brief Solves the transposed triangular system in place, e.g. L^T x = b for a solver set up for L. Vectors not residing in main memory are transferred to main memory and back. */
+  void apply_transposed(viennacl::vector_base<NumericT> & vec) const
+  {
+    apply_on_host(vec, &sparse_triangular_solver::apply_transposed);
+  }
+
+  /** @brief Solves the triangular system in place for a vector in main memory given by a pointer to the first entry and the stride between consecutive entries. */
+  void apply(NumericT * x, vcl_size_t stride = 1) const
+  {
+    switch (strategy_)
+    {
+    case SPTRSV_LEVEL_SET: apply_level_set(x, stride); break;
+    case SPTRSV_SYNC_FREE: apply_sync_free(x, stride); break;
+    case SPTRSV_BLOCKED:   apply_blocked(x, stride);   break;
+    default:
+      for (vcl_size_t p = 0; p < size_; ++p)
+        substitute_row(p, x, stride);
+    }
+  }
+
+  /** @brief Solves the transposed triangular system in place for a vector in main memory given by a pointer to the first entry and the stride between consecutive entries.
+  *
+  * The stored rows are processed in reverse execution order, where each row scatters its contribution to the entries it depends on.
+  * For the parallel strategies, levels (or levels of blocks) are processed in reverse order with atomic updates.
+  * The result is therefore identical to the one of the sequential strategy only up to round-off.
+  */
+  void apply_transposed(NumericT * x, vcl_size_t stride = 1) const
+  {
+    switch (strategy_)
+    {
+    case SPTRSV_LEVEL_SET:
+    case SPTRSV_SYNC_FREE: apply_transposed_level_set(x, stride); break; // the levels are also available for the synchronization-free strategy
+    case SPTRSV_BLOCKED:   apply_transposed_blocked(x, stride);   break;
+    default:
+      for (vcl_size_t p = size_; p > 0; --p)
+        scatter_row<false>(p - 1, x, stride);
+    }
+  }
+
+  /** @brief Returns the number of rows of the triangular system */
+  vcl_size_t size() const { return size_; }
+  /** @brief Returns the strategy used for the solves. Never returns SPTRSV_AUTO. */
+  sparse_triangular_solver_strategy strategy() const { return strategy_; }
+  /** @brief Returns the number of levels (length of the critical path) found in the analysis */
+  vcl_size_t num_levels() const { return num_levels_; }
+  /** @brief Returns the number of rows per block if the blocked strategy is used, zero otherwise */
+  vcl_size_t block_size() const { return block_size_; }
+
+private:
+  void apply_on_host(viennacl::vector_base<NumericT> & vec, void (sparse_triangular_solver::*func)(NumericT *, vcl_size_t) const) const
+  {
+    assert(vec.size() == size_ && bool("Size mismatch in sparse triangular solve"));
+
+    if (viennacl::traits::active_handle_id(vec) == viennacl::MAIN_MEMORY)
+    {
+      NumericT * vec_buf = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec);
+      (this->*func)(vec_buf + viennacl::traits::start(vec), viennacl::traits::stride(vec));
+    }
+    else
+    {
+      std::vector<NumericT> host_vec(vec.size());
+      viennacl::copy(vec, host_vec);
+      if (size_ > 0)
+        (this->*func)(&(host_vec[0]), 1);
+      viennacl::copy(host_vec, vec);
+    }
+  }
+
+  template<unsigned int AlignmentV>
+  void with_host_buffers(viennacl::compressed_matrix<NumericT, AlignmentV> const & T, sparse_triangular_solver_strategy strategy,
+                         void (sparse_triangular_solver::*func)(unsigned int const *, unsigned int const *, NumericT const *, vcl_size_t, sparse_triangular_solver_strategy))
+  {
+    if (viennacl::traits::context(T).memory_type() == viennacl::MAIN_MEMORY)
+      (this->*func)(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(T.handle1()),
+                    viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(T.handle2()),
+                    viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(T.handle()),
+                    T.size1(), strategy);
+    else
+    {
+      viennacl::context host_context(viennacl::MAIN_MEMORY);
+      viennacl::compressed_matrix<NumericT> host_T(T.size1(), T.size2(), viennacl::traits::context(T));
+      viennacl::switch_memory_context(host_T, host_context);
+      host_T = T;
+      (this->*func)(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(host_T.handle1()),
+                    viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(host_T.handle2()),
+                    viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(host_T.handle()),
+                    host_T.size1(), strategy);
+    }
+  }
+
+  /** @brief Returns true if column 'col' of row 'row' is part of the strict triangle */
+  bool in_triangle(vcl_size_t row, vcl_size_t col) const { return lower_ ? (col < row) : (col > row); }
+
+  /** @brief Returns the row substituted in the k-th step of plain forward or backward substitution */
+  vcl_size_t natural_row(vcl_size_t k) const { return lower_ ? k : (size_ - k) - 1; }
+
+  void analyze(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements, vcl_size_t num_rows, sparse_triangular_solver_strategy strategy)
+  {
+    size_ = num_rows;
+
+    //
+    // Step 1: Row-wise view of the system (transpose if necessary), keeping only the strict triangle. src_ holds the index of each entry in the input buffers.
+    //
+    std::vector<unsigned int> rows(num_rows + 1, 0);
+    std::vector<unsigned int> cols;
+    std::vector<unsigned int> src;
+    std::vector<long>         diag_src(num_rows, -1);
+
+    if (!transposed_)
+    {
+      for (vcl_size_t row = 0; row < num_rows; ++row)
+      {
+        for (unsigned int j = row_buffer[row]; j < row_buffer[row+1]; ++j)
+        {
+          if (in_triangle(row, col_buffer[j]))
+          {
+            cols.push_back(col_buffer[j]);
+            src.push_back(j);
+          }
+          else if (col_buffer[j] == row)
+            diag_src[row] = static_cast<long>(j);
+        }
+        rows[row+1] = static_cast<unsigned int>(cols.size());
+      }
+    }
+    else
+    {
+      for (vcl_size_t i = 0; i < num_rows; ++i)
+        for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+        {
+          if (in_triangle(col_buffer[j], i))
+            rows[col_buffer[j] + 1] += 1;
+          else if (col_buffer[j] == i)
+            diag_src[i] = static_cast<long>(j);
+        }
+      for (vcl_size_t row = 0; row < num_rows; ++row)
+        rows[row+1] += rows[row];
+      cols.resize(rows[num_rows]);
+      src.resize(rows[num_rows]);
+      std::vector<unsigned int> offset(rows.begin(), rows.end() - 1);
+      for (vcl_size_t i = 0; i < num_rows; ++i)
+        for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+          if (in_triangle(col_buffer[j], i))
+          {
+            unsigned int k = offset[col_buffer[j]]++;
+            cols[k] = static_cast<unsigned int>(i);
+            src[k]  = j;
+          }
+    }
+
+    //
+    // Step 2: Levels. A row without dependencies is on level 0, otherwise on the level following the highest level of its dependencies.
+    //
+    std::vector<unsigned int> level(num_rows, 0);
+    num_levels_ = (num_rows > 0) ? 1 : 0;
+    for (vcl_size_t k = 0; k < num_rows; ++k)
+    {
+      vcl_size_t row = natural_row(k);
+      unsigned int row_level = 0;
+      for (unsigned int j = rows[row]; j < rows[row+1]; ++j)
+        row_level = std::max<unsigned int>(row_level, level[cols[j]] + 1);
+      level[row] = row_level;
+      num_levels_ = std::max<vcl_size_t>(num_levels_, row_level + 1);
+    }
+
+    //
+    // Step 3: Select strategy and execution order. Blocks always consist of consecutive rows in solve order.
+    //
+    vcl_size_t num_threads = detail::sptrsv_num_threads();
+    double parallelism = (num_levels_ > 0) ? double(num_rows) / double(num_levels_) : 0;
+
+    std::vector<unsigned int> natural_order(num_rows);
+    for (vcl_size_t k = 0; k < num_rows; ++k)
+      natural_order[k] = static_cast<unsigned int>(natural_row(k));
+
+    // blocks of contiguous rows (about eight blocks per thread):
+    vcl_size_t block_size = std::max<vcl_size_t>(1, (num_rows + 8 * num_threads - 1) / (8 * num_threads));
+    std::vector<unsigned int> block_level;
+    vcl_size_t num_block_levels = 0;
+    if (strategy == SPTRSV_AUTO || strategy == SPTRSV_BLOCKED)
+      num_block_levels = detail::sptrsv_block_levels(rows, cols, natural_order, block_size, block_level);
+
+    if (strategy == SPTRSV_AUTO)
+    {
+      if (num_threads < 2 || num_rows < VIENNACL_SPTRSV_MIN_SIZE || parallelism < 2)
+        strategy = SPTRSV_SEQUENTIAL;
+      else if (parallelism >= 32.0 * double(num_threads)) // enough work per level to amortize the barriers
+        strategy = SPTRSV_LEVEL_SET;
+      else if (block_level.size() >= num_threads * num_block_levels) // e.g. block-diagonal dominated systems: few barriers, all threads busy
+        strategy = SPTRSV_BLOCKED;
+      else
+        strategy = SPTRSV_SYNC_FREE;
+    }
+
+    if (strategy == SPTRSV_LEVEL_SET || strategy == SPTRSV_SYNC_FREE) // counting sort by level, stable w.r.t. solve order
+    {
+      level_ptr_.assign(num_levels_ + 1, 0);
+      for (vcl_size_t row = 0; row < num_rows; ++row)
+        level_ptr_[level[row] + 1] += 1;
+      for (vcl_size_t l = 0; l < num_levels_; ++l)
+        level_ptr_[l+1] += level_ptr_[l];
+      order_.resize(num_rows);
+      std::vector<unsigned int> offset(level_ptr_.begin(), level_ptr_.end() - 1);
+      for (vcl_size_t k = 0; k < num_rows; ++k)
+        order_[offset[level[natural_order[k]]]++] = natural_order[k];
+    }
+    else
+    {
+      level_ptr_.clear();
+      order_.swap(natural_order);
+    }
+
+    block_size_ = 0;
+    block_order_.clear();
+    block_level_ptr_.clear();
+    if (strategy == SPTRSV_BLOCKED) // sort blocks by level
+    {
+      block_size_ = block_size;
+      block_level_ptr_.assign(num_block_levels + 1, 0);
+      for (vcl_size_t b = 0; b < block_level.size(); ++b)
+        block_level_ptr_[block_level[b] + 1] += 1;
+      for (vcl_size_t l = 0; l < num_block_levels; ++l)
+        block_level_ptr_[l+1] += block_level_ptr_[l];
+      block_order_.resize(block_level.size());
+      std::vector<unsigned int> offset(block_level_ptr_.begin(), block_level_ptr_.end() - 1);
+      for (vcl_size_t b = 0; b < block_level.size(); ++b)
+        block_order_[offset[block_level[b]]++] = static_cast<unsigned int>(b);
+    }
+
+    //
+    // Step 4: Store the rows in execution order
+    //
+    row_ptr_.resize(num_rows + 1);
+    row_ptr_[0] = 0;
+    cols_.resize(cols.size());
+    src_.resize(cols.size());
+    diag_src_.resize(num_rows);
+    for (vcl_size_t p = 0; p < num_rows; ++p)
+    {
+      unsigned int row = order_[p];
+      unsigned int offset = row_ptr_[p];
+      for (unsigned int j = rows[row]; j < rows[row+1]; ++j, ++offset)
+      {
+        cols_[offset] = cols[j];
+        src_[offset]  = src[j];
+      }
+      row_ptr_[p+1] = offset;
+      diag_src_[p] = diag_src[row];
+    }
+
+    strategy_ = strategy;
+    done_.assign(num_rows, 0);
+    epoch_ = 0;
+
+    gather_values(row_buffer, col_buffer, elements, num_rows, strategy);
+  }
+
+  void gather_values(unsigned int const *, unsigned int const *, NumericT const * elements, vcl_size_t num_rows, sparse_triangular_solver_strategy)
+  {
+    assert(num_rows == size_ && bool("Size mismatch when updating values of sparse triangular solver"));
+    (void)num_rows;
+
+    values_.resize(src_.size());
+    for (vcl_size_t j = 0; j < src_.size(); ++j)
+      values_[j] = elements[src_[j]];
+
+    diagonal_.resize(diag_src_.size());
+    for (vcl_size_t p = 0; p < diag_src_.size(); ++p)
+      diagonal_[p] = (diag_src_[p] >= 0) ? elements[diag_src_[p]] : NumericT(0);
+  }
+
+  /** @brief Substitutes the row at position p of the execution order */
+  void substitute_row(vcl_size_t p, NumericT * x, vcl_size_t stride) const
+  {
+    vcl_size_t row = order_[p];
+    NumericT vec_entry = x[row * stride];
+    for (unsigned int j = row_ptr_[p]; j < row_ptr_[p+1]; ++j)
+      vec_entry -= x[cols_[j] * stride] * values_[j];
+    x[row * stride] = unit_diagonal_ ? vec_entry : vec_entry / diagonal_[p];
+  }
+
+  /** @brief Computes the entry of the transposed solve for the row at position p of the execution order and subtracts its contributions from the entries the row depends on */
+  template<bool AtomicV>
+  void scatter_row(vcl_size_t p, NumericT * x, vcl_size_t stride) const
+  {
+    vcl_size_t row = order_[p];
+    NumericT row_entry = unit_diagonal_ ? x[row * stride] : x[row * stride] / diagonal_[p];
+    x[row * stride] = row_entry;
+    for (unsigned int j = row_ptr_[p]; j < row_ptr_[p+1]; ++j)
+    {
+      if (AtomicV)
+      {
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp atomic
+#endif
+        x[cols_[j] * stride] -= values_[j] * row_entry;
+      }
+      else
+        x[cols_[j] * stride] -= values_[j] * row_entry;
+    }
+  }
+
+  void apply_level_set(NumericT * x, vcl_size_t stride) const
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    for (vcl_size_t l = 0; l < num_levels_; ++l)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long p = static_cast<long>(level_ptr_[l]); p < static_cast<long>(level_ptr_[l+1]); ++p)
+        substitute_row(static_cast<vcl_size_t>(p), x, stride);
+    }
+  }
+
+  void apply_sync_free(NumericT * x, vcl_size_t stride) const
+  {
+    // Rows are marked as done with the number of the current solve, hence the flags never need to be reset:
+    unsigned int epoch = ++epoch_;
+    if (epoch == 0) // wrap-around
+    {
+      std::fill(done_.begin(), done_.end(), 0);
+      epoch = epoch_ = 1;
+    }
+    unsigned int * done = done_.size() > 0 ? &(done_[0]) : NULL;
+
+#ifdef VIENNACL_WITH_OPENMP
+    // threads busy-wait for the rows they depend on, hence the processors must not be oversubscribed:
+    int num_threads = std::max(1, std::min(omp_get_max_threads(), omp_get_num_procs()));
+    // Static cyclic distribution in topological order: Each thread processes its rows in ascending order, hence the lowest unfinished row can always proceed.
+    #pragma omp parallel for schedule(static, 1) num_threads(num_threads)
+#endif
+    for (long p2 = 0; p2 < static_cast<long>(size_); ++p2)
+    {
+      vcl_size_t p = static_cast<vcl_size_t>(p2);
+      vcl_size_t row = order_[p];
+      NumericT vec_entry = x[row * stride];
+      for (unsigned int j = row_ptr_[p]; j < row_ptr_[p+1]; ++j)
+      {
+        unsigned int col = cols_[j];
+#ifdef VIENNACL_WITH_OPENMP
+        for (;;)
+        {
+          #pragma omp flush
+          if (*static_cast<unsigned int const volatile *>(done + col) == epoch)
+            break;
+        }
+#endif
+        vec_entry -= x[col * stride] * values_[j];
+      }
+      x[row * stride] = unit_diagonal_ ? vec_entry : vec_entry / diagonal_[p];
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp flush
+#endif
+      *static_cast<unsigned int volatile *>(done + row) = epoch;
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp flush
+#endif
+    }
+  }
+
+  void apply_blocked(NumericT * x, vcl_size_t stride) const
+  {
+    vcl_size_t num_block_levels = block_level_ptr_.size() > 0 ? block_level_ptr_.size() - 1 : 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    for (vcl_size_t l = 0; l < num_block_levels; ++l)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for schedule(dynamic)
+#endif
+      for (long b = static_cast<long>(block_level_ptr_[l]); b < static_cast<long>(block_level_ptr_[l+1]); ++b)
+      {
+        vcl_size_t block_begin = block_order_[static_cast<vcl_size_t>(b)] * block_size_;
+        vcl_size_t block_end   = std::min(size_, block_begin + block_size_);
+        for (vcl_size_t p = block_begin; p < block_end; ++p)
+          substitute_row(p, x, stride);
+      }
+    }
+  }
+
+  /** @brief Transposed solve: rows of one level do not depend on each other, hence they are finalized concurrently once all levels above have scattered their contributions. */
+  void apply_transposed_level_set(NumericT * x, vcl_size_t stride) const
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    for (vcl_size_t l = num_levels_; l > 0; --l)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long p = static_cast<long>(level_ptr_[l-1]); p < static_cast<long>(level_ptr_[l]); ++p)
+        scatter_row<true>(static_cast<vcl_size_t>(p), x, stride);
+    }
+  }
+
+  void apply_transposed_blocked(NumericT * x, vcl_size_t stride) const
+  {
+    vcl_size_t num_block_levels = block_level_ptr_.size() > 0 ? block_level_ptr_.size() - 1 : 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    for (vcl_size_t l = num_block_levels; l > 0; --l)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for schedule(dynamic)
+#endif
+      for (long b = static_cast<long>(block_level_ptr_[l-1]); b < static_cast<long>(block_level_ptr_[l]); ++b)
+      {
+        vcl_size_t block_begin = block_order_[static_cast<vcl_size_t>(b)] * block_size_;
+        vcl_size_t block_end   = std::min(size_, block_begin + block_size_);
+        for (vcl_size_t p = block_end; p > block_begin; --p)
+          scatter_row<true>(p - 1, x, stride);
+      }
+    }
+  }
+
+  vcl_size_t size_;
+  bool       lower_;
+  bool       unit_diagonal_;
+  bool       transposed_;
+  sparse_triangular_solver_strategy strategy_;
+  vcl_size_t num_levels_;
+  vcl_size_t block_size_;
+
+  // rows in execution order:
+  std::vector<unsigned int> order_;       // row substituted at each position
+  std::vector<unsigned int> row_ptr_;
+  std::vector<unsigned int> cols_;
+  std::vector<NumericT>     values_;
+  std::vector<NumericT>     diagonal_;
+  std::vector<unsigned int> src_;         // index of each entry in the buffers of the input matrix (empty after release_value_map())
+  std::vector<long>         diag_src_;    // index of each diagonal entry in the buffers of the input matrix, -1 if not present (empty after release_value_map())
+
+  std::vector<unsigned int> level_ptr_;        // level l consists of the positions [level_ptr_[l], level_ptr_[l+1])
+  std::vector<unsigned int> block_order_;      // blocks sorted by level
+  std::vector<unsigned int> block_level_ptr_;  // block level l consists of the blocks block_order_[block_level_ptr_[l]], ..., block_order_[block_level_ptr_[l+1]-1]
+
+  mutable std::vector<unsigned int> done_;   // synchronization-free strategy: number of the solve in which the row was completed
+  mutable unsigned int              epoch_;
+};
+
+} // namespace linalg
+} // namespace viennacl
+
+#endif
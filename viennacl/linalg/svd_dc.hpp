@@ -0,0 +1,1147 @@
+#ifndef VIENNACL_LINALG_SVD_DC_HPP_
+#define VIENNACL_LINALG_SVD_DC_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/svd_dc.hpp
+*   @brief Singular value decomposition of dense matrices in main memory.
+*
+*   The matrix is reduced to upper bidiagonal form by blocked Householder transformations (LAPACK's xGEBRD/xLABRD),
+*   where the trailing matrix is updated by matrix-matrix products. The singular value decomposition of the bidiagonal matrix
+*   is computed by the divide-and-conquer method of Gu and Eisenstat (LAPACK's xBDSDC), with small subproblems solved by one-sided Jacobi rotations.
+*   In contrast to viennacl/linalg/svd.hpp, neither OpenCL nor Boost.uBLAS is required.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <functional>
+#include <cmath>
+#include <limits>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/symmetric_eig.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the divide-and-conquer singular value decomposition.
+*
+* For an M-by-N matrix A with K = min(M, N), the following modes are available:
+*  - full:      U is M-by-M and V is N-by-N,
+*  - economy:   U is M-by-K and V is N-by-K,
+*  - truncated: only the leading 'rank' singular triplets are returned, U is M-by-rank and V is N-by-rank.
+*/
+class svd_dc_tag
+{
+public:
+
+  enum
+  {
+    full = 0,
+    economy,
+    truncated
+  };
+
+  /** @brief The constructor
+  *
+  * @param mode    One of full, economy, or truncated
+  * @param rank    Number of singular triplets to compute in truncated mode
+  */
+  svd_dc_tag(int mode = economy, vcl_size_t rank = 1) : mode_(mode), rank_(rank) {}
+
+  /** @brief Sets the mode */
+  void mode(int m) { mode_ = m; }
+
+  /** @brief Returns the mode */
+  int mode() const { return mode_; }
+
+  /** @brief Sets the number of singular triplets computed in truncated mode */
+  void rank(vcl_size_t r) { rank_ = r; }
+
+  /** @brief Returns the number of singular triplets computed in truncated mode */
+  vcl_size_t rank() const { return rank_; }
+
+private:
+  int mode_;
+  vcl_size_t rank_;
+};
+
+
+namespace detail
+{
+  /** @brief Number of columns reduced per panel in the bidiagonalization */
+  static const vcl_size_t SVD_BLOCK_SIZE = 32;
+
+  /** @brief Bidiagonal subproblems up to this size are solved by one-sided Jacobi rotations in the divide-and-conquer scheme */
+  static const vcl_size_t SVD_LEAF_SIZE = 25;
+
+  /** @brief Reduces the M-by-N matrix A with M >= N to upper bidiagonal form Q^T A P = B by blocked Householder transformations.
+  *
+  * On exit, d and e hold the diagonal and the superdiagonal of B. The Householder vectors of Q are stored below the diagonal of A,
+  * the ones of P to the right of the superdiagonal, their scaling factors in tauq and taup.
+  * Each panel is reduced as in LAPACK's xLABRD, the trailing matrix is then updated by A -= U Y^T + X W^T using matrix-matrix products.
+  */
+  template<typename NumericT>
+  void svd_bidiagonalize(typename symeig_workspace<NumericT>::type & A, std::vector<NumericT> & d, std::vector<NumericT> & e,
+                         std::vector<NumericT> & tauq, std::vector<NumericT> & taup)
+  {
+    typedef typename symeig_workspace<NumericT>::type   MatrixType;
+
+    vcl_size_t m = A.size1();
+    vcl_size_t n = A.size2();
+    vcl_size_t lda = A.internal_size1();
+    NumericT * a = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A);
+
+    d.resize(n);
+    e.resize(n);
+    tauq.resize(n);
+    taup.resize(n);
+    std::fill(e.begin(), e.end(), NumericT(0));
+    std::fill(tauq.begin(), tauq.end(), NumericT(0));
+    std::fill(taup.begin(), taup.end(), NumericT(0));
+
+    MatrixType X(m, SVD_BLOCK_SIZE, viennacl::context(viennacl::MAIN_MEMORY));
+    MatrixType Y(n, SVD_BLOCK_SIZE, viennacl::context(viennacl::MAIN_MEMORY));
+    vcl_size_t ldx = X.internal_size1();
+    vcl_size_t ldy = Y.internal_size1();
+    NumericT * x = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(X);
+    NumericT * y = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(Y);
+
+    std::vector<NumericT> t(SVD_BLOCK_SIZE + 1);
+    std::vector<NumericT> v(n);
+
+    for (vcl_size_t k = 0; k < n; k += SVD_BLOCK_SIZE)
+    {
+      vcl_size_t panel = std::min<vcl_size_t>(SVD_BLOCK_SIZE, n - k);
+
+      for (vcl_size_t i = 0; i < panel; ++i)
+      {
+        vcl_size_t c = k + i;
+        NumericT * a_c = a + c * lda;
+
+        // apply the previous transformations of this panel to column c:
+        for (vcl_size_t l = 0; l < i; ++l)
+        {
+          NumericT const * u_l = a + (k + l) * lda;
+          NumericT const * x_l = x + l * ldx;
+          NumericT f1 = y[c + l * ldy];
+          NumericT f2 = a_c[k + l];
+          for (vcl_size_t r = c; r < m; ++r)
+            a_c[r] -= u_l[r] * f1 + x_l[r] * f2;
+        }
+
+        // Householder reflection annihilating A(c+1:m, c):
+        NumericT alpha = a_c[c];
+        NumericT xnorm = 0;
+        for (vcl_size_t r = c + 1; r < m; ++r)
+          xnorm += a_c[r] * a_c[r];
+        xnorm = std::sqrt(xnorm);
+        d[c] = alpha;
+        if (xnorm > 0)
+        {
+          NumericT beta = std::sqrt(alpha * alpha + xnorm * xnorm);
+          if (alpha > 0)
+            beta = -beta;
+          tauq[c] = (beta - alpha) / beta;
+          NumericT scale = NumericT(1) / (alpha - beta);
+          for (vcl_size_t r = c + 1; r < m; ++r)
+            a_c[r] *= scale;
+          d[c] = beta;
+        }
+
+        if (c + 1 >= n)
+          break;
+
+        a_c[c] = 1;
+
+        // Y(c+1:n, i) = tauq * (A(c:m, c+1:n)^T u - Y U^T u - W^T X^T u):
+        NumericT * y_i = y + i * ldy;
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if ((m - c) * (n - c) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+        for (long j2 = static_cast<long>(c + 1); j2 < static_cast<long>(n); ++j2)
+        {
+          NumericT const * a_j = a + static_cast<vcl_size_t>(j2) * lda;
+          NumericT s = 0;
+          for (vcl_size_t r = c; r < m; ++r)
+            s += a_j[r] * a_c[r];
+          y_i[j2] = s;
+        }
+        for (vcl_size_t l = 0; l < i; ++l)
+        {
+          NumericT const * u_l = a + (k + l) * lda;
+          NumericT s = 0;
+          for (vcl_size_t r = c; r < m; ++r)
+            s += u_l[r] * a_c[r];
+          t[l] = s;
+        }
+        for (vcl_size_t j = c + 1; j < n; ++j)
+        {
+          NumericT s = 0;
+          for (vcl_size_t l = 0; l < i; ++l)
+            s += y[j + l * ldy] * t[l];
+          y_i[j] -= s;
+        }
+        for (vcl_size_t l = 0; l < i; ++l)
+        {
+          NumericT const * x_l = x + l * ldx;
+          NumericT s = 0;
+          for (vcl_size_t r = c; r < m; ++r)
+            s += x_l[r] * a_c[r];
+          t[l] = s;
+        }
+        for (vcl_size_t j = c + 1; j < n; ++j)
+        {
+          NumericT const * a_j = a + j * lda + k;
+          NumericT s = 0;
+          for (vcl_size_t l = 0; l < i; ++l)
+            s += a_j[l] * t[l];
+          y_i[j] = tauq[c] * (y_i[j] - s);
+        }
+
+        // update row c: A(c, c+1:n) -= Y(c+1:n, 0:i+1) U(c, 0:i+1)^T + W(0:i, c+1:n)^T X(c, 0:i)^T
+        for (vcl_size_t j = c + 1; j < n; ++j)
+        {
+          NumericT const * a_j = a + j * lda + k;
+          NumericT s = 0;
+          for (vcl_size_t l = 0; l <= i; ++l)
+            s += y[j + l * ldy] * a[c + (k + l) * lda];
+          for (vcl_size_t l = 0; l < i; ++l)
+            s += a_j[l] * x[c + l * ldx];
+          a[c + j * lda] -= s;
+        }
+
+        // Householder reflection annihilating A(c, c+2:n):
+        alpha = a[c + (c + 1) * lda];
+        xnorm = 0;
+        for (vcl_size_t j = c + 2; j < n; ++j)
+          xnorm += a[c + j * lda] * a[c + j * lda];
+        xnorm = std::sqrt(xnorm);
+        e[c] = alpha;
+        if (xnorm > 0)
+        {
+          NumericT beta = std::sqrt(alpha * alpha + xnorm * xnorm);
+          if (alpha > 0)
+            beta = -beta;
+          taup[c] = (beta - alpha) / beta;
+          NumericT scale = NumericT(1) / (alpha - beta);
+          for (vcl_size_t j = c + 2; j < n; ++j)
+            a[c + j * lda] *= scale;
+          e[c] = beta;
+        }
+        a[c + (c + 1) * lda] = 1;
+        for (vcl_size_t j = c + 1; j < n; ++j)
+          v[j] = a[c + j * lda];
+
+        // X(c+1:m, i) = taup * (A(c+1:m, c+1:n) w - U Y^T w - X W w):
+        NumericT * x_i = x + i * ldx;
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if ((m - c) * (n - c) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+        for (long r2 = static_cast<long>(c + 1); r2 < static_cast<long>(m); r2 += 64)
+        {
+          vcl_size_t r_begin = static_cast<vcl_size_t>(r2);
+          vcl_size_t r_end = std::min<vcl_size_t>(r_begin + 64, m);
+          for (vcl_size_t r = r_begin; r < r_end; ++r)
+            x_i[r] = 0;
+          for (vcl_size_t j = c + 1; j < n; ++j)
+          {
+            NumericT const * a_j = a + j * lda;
+            NumericT v_j = v[j];
+            for (vcl_size_t r = r_begin; r < r_end; ++r)
+              x_i[r] += a_j[r] * v_j;
+          }
+        }
+        for (vcl_size_t l = 0; l <= i; ++l)
+        {
+          NumericT const * y_l = y + l * ldy;
+          NumericT s = 0;
+          for (vcl_size_t j = c + 1; j < n; ++j)
+            s += y_l[j] * v[j];
+          t[l] = s;
+        }
+        for (vcl_size_t l = 0; l <= i; ++l)
+        {
+          NumericT const * u_l = a + (k + l) * lda;
+          for (vcl_size_t r = c + 1; r < m; ++r)
+            x_i[r] -= u_l[r] * t[l];
+        }
+        for (vcl_size_t l = 0; l < i; ++l)
+        {
+          NumericT s = 0;
+          for (vcl_size_t j = c + 1; j < n; ++j)
+            s += a[k + l + j * lda] * v[j];
+          t[l] = s;
+        }
+        for (vcl_size_t l = 0; l < i; ++l)
+        {
+          NumericT const * x_l = x + l * ldx;
+          for (vcl_size_t r = c + 1; r < m; ++r)
+            x_i[r] -= x_l[r] * t[l];
+        }
+        for (vcl_size_t r = c + 1; r < m; ++r)
+          x_i[r] *= taup[c];
+      }
+
+      // update of the trailing matrix, one block column at a time:
+      vcl_size_t trailing = k + panel;
+      for (vcl_size_t j = trailing; j < n; j += 4 * SVD_BLOCK_SIZE)
+      {
+        vcl_size_t cols = std::min<vcl_size_t>(4 * SVD_BLOCK_SIZE, n - j);
+        symeig_gemm<NumericT>(NumericT(-1), A, trailing, k, false, Y, j, 0, true, NumericT(1), A, trailing, j, m - trailing, cols, panel);
+        symeig_gemm<NumericT>(NumericT(-1), X, trailing, 0, false, A, k, j, false, NumericT(1), A, trailing, j, m - trailing, cols, panel);
+      }
+    }
+  }
+
+  /** @brief Overwrites Z by Q Z, where Q is the orthogonal matrix of the left transformations computed by svd_bidiagonalize(). */
+  template<typename NumericT>
+  void svd_apply_q(typename symeig_workspace<NumericT>::type & A, std::vector<NumericT> const & tauq,
+                   typename symeig_workspace<NumericT>::type & Z)
+  {
+    vcl_size_t m = A.size1();
+    vcl_size_t n = A.size2();
+    vcl_size_t lda = A.internal_size1();
+    NumericT const * a = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A);
+
+    typename symeig_workspace<NumericT>::type V(m, SVD_BLOCK_SIZE, viennacl::context(viennacl::MAIN_MEMORY));
+    typename symeig_workspace<NumericT>::type X(SVD_BLOCK_SIZE, Z.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+    vcl_size_t ldv = V.internal_size1();
+    NumericT * v = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(V);
+
+    vcl_size_t num_panels = (n + SVD_BLOCK_SIZE - 1) / SVD_BLOCK_SIZE;
+    for (vcl_size_t p = num_panels; p-- > 0;)
+    {
+      vcl_size_t k = p * SVD_BLOCK_SIZE;
+      vcl_size_t panel = std::min<vcl_size_t>(SVD_BLOCK_SIZE, n - k);
+      vcl_size_t rows = m - k;
+
+      for (vcl_size_t i = 0; i < panel; ++i)
+      {
+        NumericT * v_i = v + i * ldv;
+        NumericT const * a_i = a + (k + i) * lda + k;
+        for (vcl_size_t r = 0; r < i; ++r)
+          v_i[r] = 0;
+        v_i[i] = 1;
+        for (vcl_size_t r = i + 1; r < rows; ++r)
+          v_i[r] = a_i[r];
+      }
+
+      symeig_apply_block_reflector<NumericT>(V, rows, panel, &(tauq[k]), X, Z, k);
+    }
+  }
+
+  /** @brief Overwrites Z by P Z, where P is the orthogonal matrix of the right transformations computed by svd_bidiagonalize(). */
+  template<typename NumericT>
+  void svd_apply_p(typename symeig_workspace<NumericT>::type & A, std::vector<NumericT> const & taup,
+                   typename symeig_workspace<NumericT>::type & Z)
+  {
+    vcl_size_t n = A.size2();
+    if (n < 3)
+      return;
+
+    vcl_size_t lda = A.internal_size1();
+    NumericT const * a = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A);
+
+    typename symeig_workspace<NumericT>::type V(n, SVD_BLOCK_SIZE, viennacl::context(viennacl::MAIN_MEMORY));
+    typename symeig_workspace<NumericT>::type X(SVD_BLOCK_SIZE, Z.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+    vcl_size_t ldv = V.internal_size1();
+    NumericT * v = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(V);
+
+    vcl_size_t num_panels = (n - 2 + SVD_BLOCK_SIZE - 1) / SVD_BLOCK_SIZE;
+    for (vcl_size_t p = num_panels; p-- > 0;)
+    {
+      vcl_size_t k = p * SVD_BLOCK_SIZE;
+      vcl_size_t panel = std::min<vcl_size_t>(SVD_BLOCK_SIZE, n - 1 - k);
+      vcl_size_t rows = n - k - 1;
+
+      // the vectors are stored in the rows of A, acting on rows k+1:n of Z:
+      for (vcl_size_t i = 0; i < panel; ++i)
+      {
+        NumericT * v_i = v + i * ldv;
+        for (vcl_size_t r = 0; r < i; ++r)
+          v_i[r] = 0;
+        v_i[i] = 1;
+        for (vcl_size_t r = i + 1; r < rows; ++r)
+          v_i[r] = a[(k + i) + (k + 1 + r) * lda];
+      }
+
+      symeig_apply_block_reflector<NumericT>(V, rows, panel, &(taup[k]), X, Z, k + 1);
+    }
+  }
+
+  /** @brief Workspace and data shared by the recursion levels of the bidiagonal divide-and-conquer method */
+  template<typename NumericT>
+  struct svd_dc_data
+  {
+    typedef typename symeig_workspace<NumericT>::type   MatrixType;
+
+    svd_dc_data(vcl_size_t n, NumericT * d_in, NumericT * e_in, MatrixType & U_in, MatrixType & V_in)
+      : d(d_in), e(e_in), U(U_in), V(V_in),
+        G(n, n, viennacl::context(viennacl::MAIN_MEMORY)),
+        W(n, n, viennacl::context(viennacl::MAIN_MEMORY)) {}
+
+    NumericT * d;
+    NumericT * e;
+    MatrixType & U;   // left singular vectors
+    MatrixType & V;   // right singular vectors
+    MatrixType G;     // gathered singular vectors of the two subproblems
+    MatrixType W;     // singular vectors of the merged arrow matrix
+  };
+
+  /** @brief Differences d_j^2 - d_l^2 of the poles of the secular equation for the singular values, computed without cancellation */
+  template<typename NumericT>
+  struct svd_pole_difference
+  {
+    svd_pole_difference(NumericT const * d) : d_(d) {}
+
+    NumericT operator()(vcl_size_t j, vcl_size_t l) const { return (d_[j] - d_[l]) * (d_[j] + d_[l]); }
+
+    NumericT const * d_;
+  };
+
+  /** @brief Orthonormalizes the M-vector v (column-major array with leading dimension ldq) against the first 'count' columns of Q.
+  *
+  * If v is (numerically) contained in their span, it is replaced by the unit vector with the largest component orthogonal to them.
+  */
+  template<typename NumericT>
+  void svd_complete_basis(NumericT const * Q, vcl_size_t ldq, vcl_size_t M, vcl_size_t count, NumericT * v)
+  {
+    for (vcl_size_t attempt = 0; attempt < 2; ++attempt)
+    {
+      for (vcl_size_t pass = 0; pass < 2; ++pass)
+        for (vcl_size_t l = 0; l < count; ++l)
+        {
+          NumericT s = 0;
+          for (vcl_size_t r = 0; r < M; ++r)
+            s += Q[r + l * ldq] * v[r];
+          for (vcl_size_t r = 0; r < M; ++r)
+            v[r] -= s * Q[r + l * ldq];
+        }
+
+      NumericT norm = 0;
+      for (vcl_size_t r = 0; r < M; ++r)
+        norm += v[r] * v[r];
+      norm = std::sqrt(norm);
+      if (norm > NumericT(0.5) || attempt > 0)
+      {
+        for (vcl_size_t r = 0; r < M; ++r)
+          v[r] /= norm;
+        return;
+      }
+
+      // restart from the unit vector least represented in the span of Q:
+      vcl_size_t best = 0;
+      NumericT best_norm = -1;
+      for (vcl_size_t r = 0; r < M; ++r)
+      {
+        NumericT s = 1;
+        for (vcl_size_t l = 0; l < count; ++l)
+          s -= Q[r + l * ldq] * Q[r + l * ldq];
+        if (s > best_norm)
+        {
+          best_norm = s;
+          best = r;
+        }
+      }
+      std::fill(v, v + M, NumericT(0));
+      v[best] = 1;
+    }
+  }
+
+  /** @brief Computes the singular value decomposition of the N-by-(N + sqre) upper bidiagonal block starting at index 'first' by one-sided Jacobi rotations.
+  *
+  * The rotations orthogonalize the columns of B^T, so that B^T J = V diag(sigma) with J accumulating the rotations, hence B = J diag(sigma) V^T.
+  */
+  template<typename NumericT>
+  void svd_dc_leaf(svd_dc_data<NumericT> & data, vcl_size_t first, vcl_size_t N, vcl_size_t sqre)
+  {
+    vcl_size_t M = N + sqre;
+    vcl_size_t ldu = data.U.internal_size1();
+    vcl_size_t ldv = data.V.internal_size1();
+    NumericT * u_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.U) + first + first * ldu;
+    NumericT * v_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.V) + first + first * ldv;
+    NumericT const * d = data.d + first;
+    NumericT const * e = data.e + first;
+
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+
+    std::vector<NumericT> X(M * N), J(N * N);
+    for (vcl_size_t i = 0; i < N; ++i)
+    {
+      X[i + i * M] = d[i];
+      if (i + 1 < M)
+        X[i + 1 + i * M] = e[i];
+      J[i + i * N] = 1;
+    }
+
+    for (vcl_size_t sweep = 0; sweep < 60; ++sweep)
+    {
+      bool rotated = false;
+      for (vcl_size_t p = 0; p < N; ++p)
+        for (vcl_size_t q = p + 1; q < N; ++q)
+        {
+          NumericT * x_p = &(X[p * M]);
+          NumericT * x_q = &(X[q * M]);
+          NumericT alpha = 0, beta = 0, gamma = 0;
+          for (vcl_size_t r = 0; r < M; ++r)
+          {
+            alpha += x_p[r] * x_p[r];
+            beta  += x_q[r] * x_q[r];
+            gamma += x_p[r] * x_q[r];
+          }
+          if (std::fabs(gamma) <= eps * std::sqrt(alpha * beta))
+            continue;
+          rotated = true;
+
+          NumericT zeta = (beta - alpha) / (2 * gamma);
+          NumericT t = NumericT(1) / (std::fabs(zeta) + std::sqrt(1 + zeta * zeta));
+          if (zeta < 0)
+            t = -t;
+          NumericT cs = NumericT(1) / std::sqrt(1 + t * t);
+          NumericT sn = cs * t;
+          for (vcl_size_t r = 0; r < M; ++r)
+          {
+            NumericT xp = x_p[r];
+            x_p[r] = cs * xp - sn * x_q[r];
+            x_q[r] = sn * xp + cs * x_q[r];
+          }
+          NumericT * j_p = &(J[p * N]);
+          NumericT * j_q = &(J[q * N]);
+          for (vcl_size_t r = 0; r < N; ++r)
+          {
+            NumericT jp = j_p[r];
+            j_p[r] = cs * jp - sn * j_q[r];
+            j_q[r] = sn * jp + cs * j_q[r];
+          }
+        }
+      if (!rotated)
+        break;
+    }
+
+    // singular values are the column norms, the right singular vectors the normalized columns (completed to an orthonormal basis):
+    std::vector<std::pair<NumericT, vcl_size_t> > order(N);
+    for (vcl_size_t i = 0; i < N; ++i)
+    {
+      NumericT norm = 0;
+      for (vcl_size_t r = 0; r < M; ++r)
+        norm += X[r + i * M] * X[r + i * M];
+      order[i] = std::make_pair(-std::sqrt(norm), i);
+    }
+    std::sort(order.begin(), order.end());
+
+    for (vcl_size_t ii = 0; ii < N; ++ii)
+    {
+      vcl_size_t i = order[ii].second;
+      NumericT sigma = -order[ii].first;
+      NumericT * v_i = v_mat + ii * ldv;
+      for (vcl_size_t r = 0; r < M; ++r)
+        v_i[r] = (sigma > 0) ? X[r + i * M] / sigma : NumericT(0);
+      svd_complete_basis(v_mat, ldv, M, ii, v_i);
+
+      data.d[first + ii] = sigma;
+      std::copy(J.begin() + static_cast<long>(i * N), J.begin() + static_cast<long>((i + 1) * N), u_mat + ii * ldu);
+    }
+    if (sqre)
+    {
+      NumericT * v_null = v_mat + N * ldv;
+      std::fill(v_null, v_null + M, NumericT(0));
+      svd_complete_basis(v_mat, ldv, M, N, v_null);
+    }
+  }
+
+  /** @brief Merges the singular value decompositions of the blocks [first, first + N/2) and [first + N/2 + 1, first + N) of the N-by-(N + sqre) bidiagonal block,
+  *          which are coupled by the row first + N/2 with diagonal entry alpha and superdiagonal entry beta (LAPACK's xLASD1).
+  */
+  template<typename NumericT>
+  void svd_dc_merge(svd_dc_data<NumericT> & data, vcl_size_t first, vcl_size_t N, vcl_size_t sqre, NumericT alpha, NumericT beta)
+  {
+    vcl_size_t nl = N / 2;
+    vcl_size_t nr = N - nl - 1;
+    vcl_size_t M = N + sqre;
+    vcl_size_t ldu = data.U.internal_size1();
+    vcl_size_t ldv = data.V.internal_size1();
+    vcl_size_t ldg = data.G.internal_size1();
+    vcl_size_t ldw = data.W.internal_size1();
+    NumericT * u_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.U) + first + first * ldu;
+    NumericT * v_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.V) + first + first * ldv;
+    NumericT * g_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.G);
+    NumericT * w_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.W);
+
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+
+    // B = diag(U1, 1, U2) M' diag(V1, V2)^T, where the first row of M' is z and the others are diag(d).
+    // Index j = 0 refers to the middle row and the null vectors of the subproblems, j = 1..nl to the upper and j > nl to the lower subproblem:
+    std::vector<vcl_size_t> column(N);   // column of the singular vectors of index j within the block
+    std::vector<NumericT> d(N), z(N);
+    column[0] = nl;
+    for (vcl_size_t j = 1; j <= nl; ++j)
+    {
+      column[j] = j - 1;
+      d[j] = data.d[first + j - 1];
+      z[j] = alpha * v_mat[nl + (j - 1) * ldv];
+    }
+    for (vcl_size_t j = nl + 1; j < N; ++j)
+    {
+      column[j] = j;
+      d[j] = data.d[first + j];
+      z[j] = beta * v_mat[nl + 1 + j * ldv];
+    }
+
+    // combine the null vectors of the subproblems such that only one of them couples to the middle row:
+    NumericT z_upper = alpha * v_mat[nl + nl * ldv];
+    NumericT z_lower = sqre ? beta * v_mat[nl + 1 + (M - 1) * ldv] : NumericT(0);
+    z[0] = std::sqrt(z_upper * z_upper + z_lower * z_lower);
+    if (sqre)
+    {
+      NumericT c = (z[0] > 0) ? z_upper / z[0] : NumericT(1);
+      NumericT s = (z[0] > 0) ? z_lower / z[0] : NumericT(0);
+      for (vcl_size_t r = 0; r <= nl; ++r)
+      {
+        v_mat[r + (M - 1) * ldv] = -s * v_mat[r + nl * ldv];
+        v_mat[r + nl * ldv] *= c;
+      }
+      for (vcl_size_t r = nl + 1; r < M; ++r)
+      {
+        v_mat[r + nl * ldv] = s * v_mat[r + (M - 1) * ldv];
+        v_mat[r + (M - 1) * ldv] *= c;
+      }
+    }
+    else if (z_upper < 0)
+      for (vcl_size_t r = 0; r <= nl; ++r)
+        v_mat[r + nl * ldv] = -v_mat[r + nl * ldv];
+
+    // scale to unit max-norm as in xLASD1, since the squares in the secular equation underflow for tiny blocks otherwise:
+    NumericT scale = std::max<NumericT>(std::fabs(alpha), std::fabs(beta));
+    for (vcl_size_t j = 1; j < N; ++j)
+      scale = std::max<NumericT>(scale, d[j]);
+    if (scale <= 0)
+      scale = 1;
+    for (vcl_size_t j = 0; j < N; ++j)
+    {
+      d[j] /= scale;
+      z[j] /= scale;
+    }
+
+    // sort the singular values of both subproblems:
+    std::vector<std::pair<NumericT, vcl_size_t> > order(N - 1);
+    for (vcl_size_t j = 1; j < N; ++j)
+      order[j - 1] = std::make_pair(d[j], j);
+    std::sort(order.begin(), order.end());
+
+    // relative to the unit max-norm, also for a vanishing block, whose z[0] is then kept away from zero:
+    NumericT tol = 8 * eps;
+    if (z[0] <= tol)
+      z[0] = tol;
+
+    // deflation: columns are of type 1 (nonzero in the upper block only), 2 (both), or 3 (lower block only)
+    std::vector<int> type(N);
+    for (vcl_size_t j = 1; j < N; ++j)
+      type[j] = (j <= nl) ? 1 : 3;
+
+    std::vector<vcl_size_t> kept, deflated;
+    kept.reserve(N);
+    deflated.reserve(N);
+    vcl_size_t pending = 0;
+    for (vcl_size_t jj = 0; jj + 1 < N; ++jj)
+    {
+      vcl_size_t j = order[jj].second;
+      if (std::fabs(z[j]) <= tol)
+      {
+        deflated.push_back(j);
+        continue;
+      }
+
+      if (d[j] <= tol)
+      {
+        // singular value numerically zero: rotate z[j] into z[0] from the right
+        NumericT r = std::sqrt(z[0] * z[0] + z[j] * z[j]);
+        NumericT c = z[0] / r;
+        NumericT s = z[j] / r;
+        NumericT * col_0 = v_mat + column[0] * ldv;
+        NumericT * col_j = v_mat + column[j] * ldv;
+        for (vcl_size_t row = 0; row < M; ++row)
+        {
+          NumericT x = col_0[row];
+          NumericT y = col_j[row];
+          col_0[row] = c * x + s * y;
+          col_j[row] = c * y - s * x;
+        }
+        z[0] = r;
+        z[j] = 0;
+        deflated.push_back(j);
+        continue;
+      }
+
+      if (pending > 0)
+      {
+        NumericT c = z[j];
+        NumericT s = z[pending];
+        NumericT r = std::sqrt(c * c + s * s);
+        c /= r;
+        s = -s / r;
+        if (std::fabs((d[j] - d[pending]) * c * s) <= tol)
+        {
+          // rotate the two (numerically) equal singular values from both sides such that z[pending] vanishes:
+          z[j] = r;
+          z[pending] = 0;
+          NumericT * u_p = u_mat + column[pending] * ldu;
+          NumericT * u_j = u_mat + column[j] * ldu;
+          for (vcl_size_t row = 0; row < N; ++row)
+          {
+            NumericT x = u_p[row];
+            NumericT y = u_j[row];
+            u_p[row] = c * x + s * y;
+            u_j[row] = c * y - s * x;
+          }
+          NumericT * v_p = v_mat + column[pending] * ldv;
+          NumericT * v_j = v_mat + column[j] * ldv;
+          for (vcl_size_t row = 0; row < M; ++row)
+          {
+            NumericT x = v_p[row];
+            NumericT y = v_j[row];
+            v_p[row] = c * x + s * y;
+            v_j[row] = c * y - s * x;
+          }
+          NumericT t = d[pending] * c * c + d[j] * s * s;
+          d[j] = d[pending] * s * s + d[j] * c * c;
+          d[pending] = t;
+          if (type[pending] != type[j])
+            type[pending] = type[j] = 2;
+          deflated.push_back(pending);
+          pending = j;
+          continue;
+        }
+      }
+      kept.push_back(pending);
+      pending = j;
+    }
+    kept.push_back(pending);
+
+    vcl_size_t k = kept.size();
+
+    // positions of the non-deflated columns: j = 0 first, then grouped by type
+    std::vector<vcl_size_t> position(k);
+    vcl_size_t count[4] = {0, 0, 0, 0};
+    for (vcl_size_t j = 1; j < k; ++j)
+      ++count[type[kept[j]]];
+    vcl_size_t offset[4] = {0, 1, 1 + count[1], 1 + count[1] + count[2]};
+    position[0] = 0;
+    for (vcl_size_t j = 1; j < k; ++j)
+      position[j] = offset[type[kept[j]]]++;
+
+    // solve the secular equation 1 + sum_j z_j^2 / (d_j^2 - sigma^2) = 0:
+    std::vector<NumericT> dk(k), zk(k), tau(k), sigma(k);
+    std::vector<vcl_size_t> origin(k);
+    NumericT znorm2 = 0;
+    for (vcl_size_t j = 0; j < k; ++j)
+    {
+      dk[j] = d[kept[j]];
+      zk[j] = z[kept[j]];
+      znorm2 += zk[j] * zk[j];
+    }
+    svd_pole_difference<NumericT> diff(&(dk[0]));
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic, 8) if (k > 64)
+#endif
+    for (long i2 = 0; i2 < static_cast<long>(k); ++i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      symeig_secular_root(i, k, diff, &(zk[0]), NumericT(1), znorm2, origin[i], tau[i]);
+      NumericT d_o = dk[origin[i]];
+      sigma[i] = d_o + tau[i] / (d_o + std::sqrt(d_o * d_o + tau[i]));
+    }
+
+    // z recomputed from the computed singular values (Gu and Eisenstat), so that the singular vectors are numerically orthogonal:
+    std::vector<NumericT> zhat(k);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (k > 64)
+#endif
+    for (long j2 = 0; j2 < static_cast<long>(k); ++j2)
+    {
+      vcl_size_t j = static_cast<vcl_size_t>(j2);
+      NumericT prod = -(diff(j, origin[k-1]) - tau[k-1]);
+      for (vcl_size_t i = 0; i + 1 < k; ++i)
+        prod *= -(diff(j, origin[i]) - tau[i]) / diff((i < j) ? i : i + 1, j);
+      zhat[j] = (zk[j] < 0) ? -std::sqrt(std::fabs(prod)) : std::sqrt(std::fabs(prod));
+    }
+
+    // left singular vectors of M', gathered left singular vectors of the subproblems, and their products:
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (k > 64)
+#endif
+    for (long i2 = 0; i2 < static_cast<long>(k); ++i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      NumericT * w_i = w_mat + i * ldw;
+      NumericT norm = 1;
+      w_i[0] = -1;
+      for (vcl_size_t j = 1; j < k; ++j)
+      {
+        NumericT w = dk[j] * zhat[j] / (diff(j, origin[i]) - tau[i]);
+        w_i[position[j]] = w;
+        norm += w * w;
+      }
+      norm = NumericT(1) / std::sqrt(norm);
+      for (vcl_size_t j = 0; j < k; ++j)
+        w_i[j] *= norm;
+    }
+
+    std::fill(g_mat, g_mat + N, NumericT(0));
+    g_mat[nl] = 1;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (N * N > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+    for (long j2 = 1; j2 < static_cast<long>(N); ++j2)
+    {
+      vcl_size_t j = static_cast<vcl_size_t>(j2);
+      vcl_size_t src = (j < k) ? kept[j] : deflated[j - k];
+      vcl_size_t dst = (j < k) ? position[j] : j;
+      std::copy(u_mat + column[src] * ldu, u_mat + column[src] * ldu + N, g_mat + dst * ldg);
+    }
+
+    // upper rows from the type 1 and 2 columns, the middle row directly from M', lower rows from the type 2 and 3 columns:
+    symeig_gemm<NumericT>(NumericT(1), data.G, 0, 1, false, data.W, 1, 0, false,
+                          NumericT(0), data.U, first, first, nl, k, count[1] + count[2]);
+    for (vcl_size_t i = 0; i < k; ++i)
+      u_mat[nl + i * ldu] = w_mat[i * ldw];
+    symeig_gemm<NumericT>(NumericT(1), data.G, nl + 1, 1 + count[1], false, data.W, 1 + count[1], 0, false,
+                          NumericT(0), data.U, first + nl + 1, first, nr, k, count[2] + count[3]);
+    for (vcl_size_t j = k; j < N; ++j)
+      std::copy(g_mat + j * ldg, g_mat + j * ldg + N, u_mat + j * ldu);
+
+    // right singular vectors of M', gathered right singular vectors of the subproblems, and their products:
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (k > 64)
+#endif
+    for (long i2 = 0; i2 < static_cast<long>(k); ++i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      NumericT * w_i = w_mat + i * ldw;
+      NumericT norm = 0;
+      for (vcl_size_t j = 0; j < k; ++j)
+      {
+        NumericT w = zhat[j] / (diff(j, origin[i]) - tau[i]);
+        w_i[position[j]] = w;
+        norm += w * w;
+      }
+      norm = NumericT(1) / std::sqrt(norm);
+      for (vcl_size_t j = 0; j < k; ++j)
+        w_i[j] *= norm;
+    }
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (N * M > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+    for (long j2 = 0; j2 < static_cast<long>(N); ++j2)
+    {
+      vcl_size_t j = static_cast<vcl_size_t>(j2);
+      vcl_size_t src = (j < k) ? kept[j] : deflated[j - k];
+      vcl_size_t dst = (j < k) ? position[j] : j;
+      std::copy(v_mat + column[src] * ldv, v_mat + column[src] * ldv + M, g_mat + dst * ldg);
+    }
+
+    // the vector of j = 0 is nonzero in all rows, the others are of the types above:
+    symeig_gemm<NumericT>(NumericT(1), data.G, 0, 0, false, data.W, 0, 0, false,
+                          NumericT(0), data.V, first, first, nl + 1, k, 1 + count[1] + count[2]);
+    symeig_gemm<NumericT>(NumericT(1), data.G, nl + 1, 1 + count[1], false, data.W, 1 + count[1], 0, false,
+                          NumericT(0), data.V, first + nl + 1, first, M - nl - 1, k, count[2] + count[3]);
+    symeig_gemm<NumericT>(NumericT(1), data.G, nl + 1, 0, false, data.W, 0, 0, false,
+                          NumericT(1), data.V, first + nl + 1, first, M - nl - 1, k, 1);
+    for (vcl_size_t j = k; j < N; ++j)
+      std::copy(g_mat + j * ldg, g_mat + j * ldg + M, v_mat + j * ldv);
+
+    for (vcl_size_t i = 0; i < k; ++i)
+      data.d[first + i] = sigma[i] * scale;
+    for (vcl_size_t j = k; j < N; ++j)
+      data.d[first + j] = d[deflated[j - k]] * scale;
+  }
+
+  /** @brief Computes the singular value decomposition of the N-by-(N + sqre) upper bidiagonal block starting at index 'first' by divide-and-conquer.
+  *
+  * The singular values are returned in no particular order. For sqre = 1, the last right singular vector spans the null space.
+  */
+  template<typename NumericT>
+  void svd_dc_recursive(svd_dc_data<NumericT> & data, vcl_size_t first, vcl_size_t N, vcl_size_t sqre)
+  {
+    if (N <= SVD_LEAF_SIZE)
+    {
+      svd_dc_leaf(data, first, N, sqre);
+      return;
+    }
+
+    vcl_size_t nl = N / 2;
+    NumericT alpha = data.d[first + nl];
+    NumericT beta  = data.e[first + nl];
+
+    svd_dc_recursive(data, first, nl, 1);
+    svd_dc_recursive(data, first + nl + 1, N - nl - 1, sqre);
+
+    svd_dc_merge(data, first, N, sqre, alpha, beta);
+  }
+
+  /** @brief Computes the singular values (descending) and, if U and V are not NULL, the singular vectors of the upper bidiagonal matrix with diagonal d and superdiagonal e */
+  template<typename NumericT>
+  void svd_bidiagonal(std::vector<NumericT> & d, std::vector<NumericT> & e,
+                      typename symeig_workspace<NumericT>::type * U, typename symeig_workspace<NumericT>::type * V)
+  {
+    vcl_size_t n = d.size();
+    if (n == 0)
+      return;
+
+    // scale to unit max-norm to avoid over- and underflow in the secular equation:
+    NumericT scale = 0;
+    for (vcl_size_t i = 0; i < n; ++i)
+      scale = std::max<NumericT>(scale, std::max<NumericT>(std::fabs(d[i]), std::fabs(e[i])));
+    if (scale <= 0)
+      scale = 1;
+    for (vcl_size_t i = 0; i < n; ++i)
+    {
+      d[i] /= scale;
+      e[i] /= scale;
+    }
+
+    if (U && V)
+    {
+      vcl_size_t ldu = U->internal_size1();
+      vcl_size_t ldv = V->internal_size1();
+      NumericT * u_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(*U);
+      NumericT * v_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(*V);
+      std::fill(u_mat, u_mat + ldu * n, NumericT(0));
+      std::fill(v_mat, v_mat + ldv * n, NumericT(0));
+
+      svd_dc_data<NumericT> data(n, &(d[0]), &(e[0]), *U, *V);
+      svd_dc_recursive(data, 0, n, 0);
+
+      // sort singular values and vectors in descending order:
+      std::vector<std::pair<NumericT, vcl_size_t> > order(n);
+      for (vcl_size_t i = 0; i < n; ++i)
+        order[i] = std::make_pair(-d[i], i);
+      std::sort(order.begin(), order.end());
+
+      vcl_size_t ldg = data.G.internal_size1();
+      vcl_size_t ldw = data.W.internal_size1();
+      NumericT * g_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.G);
+      NumericT * w_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.W);
+      for (vcl_size_t i = 0; i < n; ++i)
+      {
+        d[i] = -order[i].first;
+        std::copy(u_mat + order[i].second * ldu, u_mat + order[i].second * ldu + n, g_mat + i * ldg);
+        std::copy(v_mat + order[i].second * ldv, v_mat + order[i].second * ldv + n, w_mat + i * ldw);
+      }
+      for (vcl_size_t i = 0; i < n; ++i)
+      {
+        std::copy(g_mat + i * ldg, g_mat + i * ldg + n, u_mat + i * ldu);
+        std::copy(w_mat + i * ldw, w_mat + i * ldw + n, v_mat + i * ldv);
+      }
+    }
+    else
+    {
+      // the singular values are the nonnegative eigenvalues of the Golub-Kahan matrix [0 B; B^T 0], which is permuted to tridiagonal form:
+      std::vector<NumericT> t_d(2 * n), t_e(2 * n);
+      for (vcl_size_t i = 0; i < n; ++i)
+      {
+        t_e[2 * i] = d[i];
+        if (i + 1 < n)
+          t_e[2 * i + 1] = e[i];
+      }
+      symeig_tridiagonal_ql(2 * n, &(t_d[0]), &(t_e[0]), static_cast<NumericT *>(NULL), 0);
+      std::sort(t_d.begin(), t_d.end());
+      for (vcl_size_t i = 0; i < n; ++i)
+        d[i] = std::fabs(t_d[2 * n - 1 - i]);
+      std::sort(d.begin(), d.end(), std::greater<NumericT>());
+    }
+
+    for (vcl_size_t i = 0; i < n; ++i)
+      d[i] *= scale;
+  }
+
+  /** @brief Returns the number of left and right singular vectors computed for an M-by-N matrix */
+  inline void svd_dc_vector_count(vcl_size_t m, vcl_size_t n, svd_dc_tag const & tag, vcl_size_t & left, vcl_size_t & right)
+  {
+    vcl_size_t k = std::min<vcl_size_t>(m, n);
+    if (tag.mode() == svd_dc_tag::full)
+    {
+      left  = m;
+      right = n;
+    }
+    else
+      left = right = (tag.mode() == svd_dc_tag::truncated) ? std::max<vcl_size_t>(1, std::min<vcl_size_t>(tag.rank(), k)) : k;
+  }
+
+  /** @brief Copies the host matrix Z to the matrix 'result' of the same size in any memory domain */
+  template<typename NumericT>
+  void svd_copy_result(typename symeig_workspace<NumericT>::type & Z, viennacl::matrix_base<NumericT> & result)
+  {
+    assert(result.size1() == Z.size1() && result.size2() == Z.size2() && bool("Size mismatch of singular vector matrix in svd_dc()!"));
+
+    if (result.memory_domain() == viennacl::MAIN_MEMORY)
+      symeig_copy_host(Z, result);
+    else
+    {
+      viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+      viennacl::matrix_base<NumericT> staging(Z.size1(), Z.size2(), result.row_major(), host_ctx);
+      symeig_copy_host(Z, staging);
+      staging.switch_memory_context(viennacl::traits::context(result));
+      result = staging;
+    }
+  }
+
+  /** @brief Computes the singular values (descending) and optionally the singular vectors of A on the host */
+  template<typename NumericT>
+  void svd_dc(viennacl::matrix_base<NumericT> const & A, std::vector<NumericT> & S,
+              viennacl::matrix_base<NumericT> * U, viennacl::matrix_base<NumericT> * V, svd_dc_tag const & tag)
+  {
+    typedef typename symeig_workspace<NumericT>::type   MatrixType;
+
+    vcl_size_t m = A.size1();
+    vcl_size_t n = A.size2();
+    bool transposed = (m < n);
+    vcl_size_t rows = transposed ? n : m;
+    vcl_size_t cols = transposed ? m : n;
+    vcl_size_t rank = (tag.mode() == svd_dc_tag::truncated) ? std::max<vcl_size_t>(1, std::min<vcl_size_t>(tag.rank(), cols)) : cols;
+    assert(m > 0 && n > 0 && bool("Empty matrix passed to svd_dc()!"));
+    viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+
+    // the reduction works on A or A^T, whichever has at least as many rows as columns:
+    MatrixType work(rows, cols, host_ctx);
+    viennacl::matrix_base<NumericT> work_view(work.handle(), m, 0, 1, transposed ? work.internal_size2() : work.internal_size1(),
+                                                             n, 0, 1, transposed ? work.internal_size1() : work.internal_size2(), transposed);
+    if (A.memory_domain() == viennacl::MAIN_MEMORY)
+      symeig_copy_host(A, work_view);
+    else
+    {
+      viennacl::matrix_base<NumericT> staging(m, n, A.row_major(), viennacl::traits::context(A));
+      staging = A;
+      staging.switch_memory_context(host_ctx);
+      symeig_copy_host(staging, work_view);
+    }
+
+    std::vector<NumericT> d, e, tauq, taup;
+    svd_bidiagonalize<NumericT>(work, d, e, tauq, taup);
+
+    if (!U || !V)
+    {
+      svd_bidiagonal<NumericT>(d, e, static_cast<MatrixType *>(NULL), static_cast<MatrixType *>(NULL));
+      S.assign(d.begin(), d.begin() + static_cast<long>(rank));
+      return;
+    }
+
+    MatrixType UB(cols, cols, host_ctx), VB(cols, cols, host_ctx);
+    svd_bidiagonal<NumericT>(d, e, &UB, &VB);
+    S.assign(d.begin(), d.begin() + static_cast<long>(rank));
+
+    // back-transformation, restricted to the requested singular vectors:
+    vcl_size_t left_cols, right_cols;
+    svd_dc_vector_count(rows, cols, tag, left_cols, right_cols);
+    MatrixType ZU(rows, left_cols, host_ctx), ZV(cols, right_cols, host_ctx);
+    vcl_size_t ldub = UB.internal_size1();
+    vcl_size_t ldvb = VB.internal_size1();
+    vcl_size_t ldzu = ZU.internal_size1();
+    vcl_size_t ldzv = ZV.internal_size1();
+    NumericT const * ub = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(UB);
+    NumericT const * vb = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(VB);
+    NumericT * zu = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(ZU);
+    NumericT * zv = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(ZV);
+    for (vcl_size_t j = 0; j < left_cols; ++j)
+    {
+      std::fill(zu + j * ldzu, zu + j * ldzu + rows, NumericT(0));
+      if (j < cols)
+        std::copy(ub + j * ldub, ub + j * ldub + cols, zu + j * ldzu);
+      else
+        zu[j + j * ldzu] = 1;
+    }
+    for (vcl_size_t j = 0; j < right_cols; ++j)
+      std::copy(vb + j * ldvb, vb + j * ldvb + cols, zv + j * ldzv);
+
+    svd_apply_q<NumericT>(work, tauq, ZU);
+    svd_apply_p<NumericT>(work, taup, ZV);
+
+    // A^T = Z_U S Z_V^T for m < n:
+    svd_copy_result<NumericT>(transposed ? ZV : ZU, *U);
+    svd_copy_result<NumericT>(transposed ? ZU : ZV, *V);
+  }
+} //namespace detail
+
+
+/** @brief Computes the singular value decomposition A = U diag(S) V^T of a dense matrix by bidiagonalization and divide-and-conquer.
+*
+* The computation is carried out in main memory (with OpenMP, if enabled), matrices in other memory domains are transferred.
+* U and V are resized according to the mode of the tag if necessary.
+*
+* @param A    The input matrix, which is not modified
+* @param S    Vector receiving the singular values in descending order
+* @param U    Matrix receiving the left singular vectors column-wise
+* @param V    Matrix receiving the right singular vectors column-wise
+* @param tag  Selects full, economy, or truncated decompositions
+*/
+template<typename NumericT, typename FU, typename FV>
+void svd_dc(viennacl::matrix_base<NumericT> const & A, std::vector<NumericT> & S,
+            viennacl::matrix<NumericT, FU> & U, viennacl::matrix<NumericT, FV> & V, svd_dc_tag const & tag = svd_dc_tag())
+{
+  vcl_size_t left, right;
+  detail::svd_dc_vector_count(A.size1(), A.size2(), tag, left, right);
+  if (U.size1() != A.size1() || U.size2() != left)
+    U.resize(A.size1(), left, false);
+  if (V.size1() != A.size2() || V.size2() != right)
+    V.resize(A.size2(), right, false);
+
+  detail::svd_dc(A, S, &U, &V, tag);
+}
+
+/** @brief Computes the singular value decomposition of a dense matrix. Singular values are written to a ViennaCL vector of matching size, see above for details. */
+template<typename NumericT, typename FU, typename FV>
+void svd_dc(viennacl::matrix_base<NumericT> const & A, viennacl::vector_base<NumericT> & S,
+            viennacl::matrix<NumericT, FU> & U, viennacl::matrix<NumericT, FV> & V, svd_dc_tag const & tag = svd_dc_tag())
+{
+  std::vector<NumericT> std_S;
+  svd_dc(A, std_S, U, V, tag);
+  viennacl::copy(std_S, S);
+}
+
+/** @brief Computes the singular values (descending) of a dense matrix. In truncated mode, only the leading tag.rank() values are returned. */
+template<typename NumericT>
+void svd_dc(viennacl::matrix_base<NumericT> const & A, std::vector<NumericT> & S, svd_dc_tag const & tag = svd_dc_tag())
+{
+  detail::svd_dc(A, S, static_cast<viennacl::matrix_base<NumericT> *>(NULL), static_cast<viennacl::matrix_base<NumericT> *>(NULL), tag);
+}
+
+/** @brief Computes the singular values (descending) of a dense matrix and writes them to a ViennaCL vector of matching size. */
+template<typename NumericT>
+void svd_dc(viennacl::matrix_base<NumericT> const & A, viennacl::vector_base<NumericT> & S, svd_dc_tag const & tag = svd_dc_tag())
+{
+  std::vector<NumericT> std_S;
+  detail::svd_dc(A, std_S, static_cast<viennacl::matrix_base<NumericT> *>(NULL), static_cast<viennacl::matrix_base<NumericT> *>(NULL), tag);
+  viennacl::copy(std_S, S);
+}
+
+} //namespace linalg
+} //namespace viennacl
+
+#endif
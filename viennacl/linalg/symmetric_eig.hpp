@@ -0,0 +1,987 @@
+#ifndef VIENNACL_LINALG_SYMMETRIC_EIG_HPP_
+#define VIENNACL_LINALG_SYMMETRIC_EIG_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/symmetric_eig.hpp
+*   @brief Eigendecomposition of dense symmetric matrices in main memory.
+*
+*   The matrix is reduced to tridiagonal form by blocked Householder transformations (LAPACK's xSYTRD/xLATRD),
+*   where the rank-2k update of the trailing matrix is carried out by matrix-matrix products.
+*   The eigenpairs of the tridiagonal matrix are obtained by Cuppen's divide-and-conquer method with the deflation
+*   strategy of xLAED2 and the eigenvector computation of Gu and Eisenstat, again using matrix-matrix products for the merges.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include <limits>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+  /** @brief Number of columns reduced per panel in the tridiagonalization */
+  static const vcl_size_t SYMEIG_BLOCK_SIZE = 64;
+
+  /** @brief Tridiagonal subproblems up to this size are solved by the implicit QL method in the divide-and-conquer scheme */
+  static const vcl_size_t SYMEIG_LEAF_SIZE = 32;
+
+  /** @brief Column-major workspace matrix in main memory */
+  template<typename NumericT>
+  struct symeig_workspace
+  {
+    typedef viennacl::matrix<NumericT, viennacl::column_major>   type;
+  };
+
+  /** @brief Computes C = alpha * op(A) * op(B) + beta * C for blocks of column-major host matrices.
+  *
+  * op(A) is m-by-k, op(B) is k-by-n, and each block is given by the row and column of its first entry.
+  */
+  template<typename NumericT>
+  void symeig_gemm(NumericT alpha,
+                   typename symeig_workspace<NumericT>::type & A, vcl_size_t A_row, vcl_size_t A_col, bool trans_A,
+                   typename symeig_workspace<NumericT>::type & B, vcl_size_t B_row, vcl_size_t B_col, bool trans_B,
+                   NumericT beta,
+                   typename symeig_workspace<NumericT>::type & C, vcl_size_t C_row, vcl_size_t C_col,
+                   vcl_size_t m, vcl_size_t n, vcl_size_t k)
+  {
+    if (m == 0 || n == 0)
+      return;
+
+    if (k == 0) // the host kernel leaves C untouched for an empty inner dimension
+    {
+      NumericT * data_C = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(C);
+      vcl_size_t ldc = C.internal_size1();
+      for (vcl_size_t j = 0; j < n; ++j)
+        for (vcl_size_t i = 0; i < m; ++i)
+          data_C[C_row + i + (C_col + j) * ldc] = (beta > 0 || beta < 0) ? beta * data_C[C_row + i + (C_col + j) * ldc] : NumericT(0);
+      return;
+    }
+
+    viennacl::matrix_base<NumericT> A_view(A.handle(), trans_A ? k : m, A_row, 1, A.internal_size1(),
+                                                       trans_A ? m : k, A_col, 1, A.internal_size2(), false);
+    viennacl::matrix_base<NumericT> B_view(B.handle(), trans_B ? n : k, B_row, 1, B.internal_size1(),
+                                                       trans_B ? k : n, B_col, 1, B.internal_size2(), false);
+    viennacl::matrix_base<NumericT> C_view(C.handle(), m, C_row, 1, C.internal_size1(),
+                                                       n, C_col, 1, C.internal_size2(), false);
+
+    viennacl::linalg::host_based::prod_impl(A_view, trans_A, B_view, trans_B, C_view, alpha, beta);
+  }
+
+  /** @brief Computes y = A v for the symmetric matrix A(first:size, first:size), of which only the lower triangle of the column-major array A is referenced. */
+  template<typename NumericT>
+  void symeig_symv(NumericT const * A, vcl_size_t lda, vcl_size_t first, vcl_size_t size,
+                   NumericT const * v, NumericT * y)
+  {
+    vcl_size_t len = size - first;
+    std::fill(y, y + len, NumericT(0));
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if (len * len > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+    {
+      // each thread accumulates the contributions of its columns separately:
+      std::vector<NumericT> y_thread(len);
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for schedule(dynamic, 16) nowait
+#endif
+      for (long j2 = 0; j2 < static_cast<long>(len); ++j2)
+      {
+        vcl_size_t j = static_cast<vcl_size_t>(j2);
+        NumericT const * A_col = A + (first + j) * lda + first;
+        NumericT v_j = v[j];
+        NumericT dot = A_col[j] * v_j;
+        for (vcl_size_t i = j + 1; i < len; ++i)
+        {
+          y_thread[i] += A_col[i] * v_j;
+          dot         += A_col[i] * v[i];
+        }
+        y_thread[j] += dot;
+      }
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp critical
+#endif
+      for (vcl_size_t i = 0; i < len; ++i)
+        y[i] += y_thread[i];
+    }
+  }
+
+  /** @brief Reduces the symmetric matrix A (lower triangle referenced) to tridiagonal form Q^T A Q = T by blocked Householder transformations.
+  *
+  * On exit, d and e hold the diagonal and the off-diagonal of T. The Householder vectors are stored below the first subdiagonal of A
+  * (with an explicit one on the subdiagonal), their scaling factors in tau.
+  * Each panel of columns is reduced as in LAPACK's xLATRD, the trailing matrix is then updated by A -= V W^T + W V^T using matrix-matrix products.
+  */
+  template<typename NumericT>
+  void symeig_tridiagonalize(typename symeig_workspace<NumericT>::type & A,
+                             std::vector<NumericT> & d, std::vector<NumericT> & e, std::vector<NumericT> & tau)
+  {
+    vcl_size_t n = A.size1();
+    vcl_size_t lda = A.internal_size1();
+    NumericT * a = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A);
+
+    d.resize(n);
+    e.resize(n);
+    tau.resize(n);
+    std::fill(e.begin(), e.end(), NumericT(0));
+    std::fill(tau.begin(), tau.end(), NumericT(0));
+
+    typename symeig_workspace<NumericT>::type W(n, SYMEIG_BLOCK_SIZE, viennacl::context(viennacl::MAIN_MEMORY));
+    vcl_size_t ldw = W.internal_size1();
+    NumericT * w = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(W);
+
+    std::vector<NumericT> t1(SYMEIG_BLOCK_SIZE), t2(SYMEIG_BLOCK_SIZE);
+
+    for (vcl_size_t k = 0; k + 1 < n; k += SYMEIG_BLOCK_SIZE)
+    {
+      vcl_size_t panel = std::min<vcl_size_t>(SYMEIG_BLOCK_SIZE, n - 1 - k);
+
+      for (vcl_size_t i = 0; i < panel; ++i)
+      {
+        vcl_size_t c = k + i;
+        NumericT * a_c = a + c * lda;
+
+        // apply the previous reflections of this panel to column c:
+        for (vcl_size_t l = 0; l < i; ++l)
+        {
+          NumericT const * v_l = a + (k + l) * lda;
+          NumericT const * w_l = w + l * ldw;
+          NumericT f1 = w_l[c];
+          NumericT f2 = v_l[c];
+          for (vcl_size_t r = c; r < n; ++r)
+            a_c[r] -= v_l[r] * f1 + w_l[r] * f2;
+        }
+        d[c] = a_c[c];
+
+        // Householder reflection annihilating A(c+2:n, c):
+        NumericT alpha = a_c[c+1];
+        NumericT xnorm = 0;
+        for (vcl_size_t r = c + 2; r < n; ++r)
+          xnorm += a_c[r] * a_c[r];
+        xnorm = std::sqrt(xnorm);
+
+        if (xnorm > 0)
+        {
+          NumericT beta = std::sqrt(alpha * alpha + xnorm * xnorm);
+          if (alpha > 0)
+            beta = -beta;
+          tau[c] = (beta - alpha) / beta;
+          NumericT scale = NumericT(1) / (alpha - beta);
+          for (vcl_size_t r = c + 2; r < n; ++r)
+            a_c[r] *= scale;
+          e[c] = beta;
+        }
+        else
+          e[c] = alpha;
+        a_c[c+1] = 1;
+
+        // W(c+1:n, i) = tau * (A v - V W^T v - W V^T v), then W(:, i) += alpha * v with alpha = -tau/2 * (W(:, i)^T v):
+        NumericT const * v = a_c + c + 1;
+        NumericT * w_i = w + i * ldw;
+        symeig_symv(a, lda, c + 1, n, v, w_i + c + 1);
+
+        for (vcl_size_t l = 0; l < i; ++l)
+        {
+          NumericT const * v_l = a + (k + l) * lda;
+          NumericT const * w_l = w + l * ldw;
+          NumericT s1 = 0, s2 = 0;
+          for (vcl_size_t r = c + 1; r < n; ++r)
+          {
+            s1 += w_l[r] * a_c[r];
+            s2 += v_l[r] * a_c[r];
+          }
+          t1[l] = s1;
+          t2[l] = s2;
+        }
+        for (vcl_size_t l = 0; l < i; ++l)
+        {
+          NumericT const * v_l = a + (k + l) * lda;
+          NumericT const * w_l = w + l * ldw;
+          for (vcl_size_t r = c + 1; r < n; ++r)
+            w_i[r] -= v_l[r] * t1[l] + w_l[r] * t2[l];
+        }
+
+        NumericT dot = 0;
+        for (vcl_size_t r = c + 1; r < n; ++r)
+        {
+          w_i[r] *= tau[c];
+          dot += w_i[r] * a_c[r];
+        }
+        NumericT correction = NumericT(-0.5) * tau[c] * dot;
+        for (vcl_size_t r = c + 1; r < n; ++r)
+          w_i[r] += correction * a_c[r];
+      }
+
+      // rank-2k update of the lower triangle of the trailing matrix, one block column at a time:
+      vcl_size_t trailing = k + panel;
+      for (vcl_size_t j = trailing; j < n; j += 4 * SYMEIG_BLOCK_SIZE)
+      {
+        vcl_size_t cols = std::min<vcl_size_t>(4 * SYMEIG_BLOCK_SIZE, n - j);
+        symeig_gemm<NumericT>(NumericT(-1), A, j, k, false, W, j, 0, true, NumericT(1), A, j, j, n - j, cols, panel);
+        symeig_gemm<NumericT>(NumericT(-1), W, j, 0, false, A, j, k, true, NumericT(1), A, j, j, n - j, cols, panel);
+      }
+    }
+
+    if (n > 0)
+      d[n-1] = a[(n - 1) * lda + n - 1];
+  }
+
+  /** @brief Overwrites Z(first_row:first_row+rows, first_col:) by H_0 H_1 ... H_{panel-1} Z(first_row:first_row+rows, first_col:) for the Householder reflections H_i = I - tau_i v_i v_i^T,
+  *          or by the transposed product H_{panel-1} ... H_1 H_0 Z(first_row:first_row+rows, first_col:) if 'transposed' is set.
+  *
+  * The unit lower trapezoidal vectors v_i are the columns of V. The reflections are applied at once in the compact WY representation I - V T V^T (LAPACK's xLARFT/xLARFB),
+  * X is a workspace of at least panel rows and Z.size2() - first_col columns.
+  */
+  template<typename NumericT>
+  void symeig_apply_block_reflector(typename symeig_workspace<NumericT>::type & V, vcl_size_t rows, vcl_size_t panel, NumericT const * tau,
+                                    typename symeig_workspace<NumericT>::type & X,
+                                    typename symeig_workspace<NumericT>::type & Z, vcl_size_t first_row,
+                                    vcl_size_t first_col = 0, bool transposed = false)
+  {
+    vcl_size_t cols = Z.size2() - first_col;
+    vcl_size_t ldv = V.internal_size1();
+    vcl_size_t ldx = X.internal_size1();
+    NumericT const * v = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(V);
+    NumericT * x = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(X);
+
+    // upper triangular factor T of the block reflector:
+    std::vector<NumericT> T(panel * panel);
+    for (vcl_size_t i = 0; i < panel; ++i)
+    {
+      NumericT const * v_i = v + i * ldv;
+      for (vcl_size_t l = 0; l < i; ++l)
+      {
+        NumericT const * v_l = v + l * ldv;
+        NumericT s = 0;
+        for (vcl_size_t r = i; r < rows; ++r)
+          s += v_l[r] * v_i[r];
+        T[l + i * panel] = -tau[i] * s;
+      }
+      for (vcl_size_t l = 0; l < i; ++l) // T(0:i, i) = T(0:i, 0:i) * T(0:i, i)
+      {
+        NumericT s = 0;
+        for (vcl_size_t m = l; m < i; ++m)
+          s += T[l + m * panel] * T[m + i * panel];
+        T[l + i * panel] = s;
+      }
+      T[i + i * panel] = tau[i];
+    }
+
+    // Z -= V T (V^T Z), or Z -= V T^T (V^T Z)
+    symeig_gemm<NumericT>(NumericT(1), V, 0, 0, true, Z, first_row, first_col, false, NumericT(0), X, 0, 0, panel, cols, rows);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (cols * panel > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+    for (long j2 = 0; j2 < static_cast<long>(cols); ++j2)
+    {
+      NumericT * x_j = x + static_cast<vcl_size_t>(j2) * ldx;
+      if (transposed)
+      {
+        for (vcl_size_t l = panel; l-- > 0;)
+        {
+          NumericT s = 0;
+          for (vcl_size_t m = 0; m <= l; ++m)
+            s += T[m + l * panel] * x_j[m];
+          x_j[l] = s;
+        }
+      }
+      else
+      {
+        for (vcl_size_t l = 0; l < panel; ++l)
+        {
+          NumericT s = 0;
+          for (vcl_size_t m = l; m < panel; ++m)
+            s += T[l + m * panel] * x_j[m];
+          x_j[l] = s;
+        }
+      }
+    }
+
+    symeig_gemm<NumericT>(NumericT(-1), V, 0, 0, false, X, 0, 0, false, NumericT(1), Z, first_row, first_col, rows, cols, panel);
+  }
+
+  /** @brief Overwrites Z by Q Z, where Q is the orthogonal matrix of the tridiagonalization computed by symeig_tridiagonalize(). */
+  template<typename NumericT>
+  void symeig_apply_q(typename symeig_workspace<NumericT>::type & A, std::vector<NumericT> const & tau,
+                      typename symeig_workspace<NumericT>::type & Z)
+  {
+    vcl_size_t n = A.size1();
+    if (n < 3)
+      return;
+
+    vcl_size_t lda = A.internal_size1();
+    NumericT const * a = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A);
+
+    typename symeig_workspace<NumericT>::type V(n, SYMEIG_BLOCK_SIZE, viennacl::context(viennacl::MAIN_MEMORY));
+    typename symeig_workspace<NumericT>::type X(SYMEIG_BLOCK_SIZE, Z.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+    vcl_size_t ldv = V.internal_size1();
+    NumericT * v = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(V);
+
+    vcl_size_t num_panels = (n - 2 + SYMEIG_BLOCK_SIZE - 1) / SYMEIG_BLOCK_SIZE;
+    for (vcl_size_t p = num_panels; p-- > 0;)
+    {
+      vcl_size_t k = p * SYMEIG_BLOCK_SIZE;
+      vcl_size_t panel = std::min<vcl_size_t>(SYMEIG_BLOCK_SIZE, n - 1 - k);
+      vcl_size_t rows = n - k - 1;
+
+      // explicit (unit lower trapezoidal) Householder vectors acting on rows k+1:n:
+      for (vcl_size_t i = 0; i < panel; ++i)
+      {
+        NumericT * v_i = v + i * ldv;
+        NumericT const * a_i = a + (k + i) * lda + k + 1;
+        for (vcl_size_t r = 0; r < i; ++r)
+          v_i[r] = 0;
+        v_i[i] = 1;
+        for (vcl_size_t r = i + 1; r < rows; ++r)
+          v_i[r] = a_i[r];
+      }
+
+      symeig_apply_block_reflector<NumericT>(V, rows, panel, &(tau[k]), X, Z, k + 1);
+    }
+  }
+
+  /** @brief Implicit QL method for the symmetric tridiagonal matrix with diagonal d and off-diagonal e (e[i] couples i and i+1).
+  *
+  * If z is not NULL, the rotations are applied to the n columns of the column-major array z (leading dimension ldz, n rows).
+  * The eigenvalues are returned in d in no particular order. Derived from the Algol procedure tql2 by Bowdler, Martin, Reinsch, and Wilkinson.
+  */
+  template<typename NumericT>
+  void symeig_tridiagonal_ql(vcl_size_t n, NumericT * d, NumericT const * e_in, NumericT * z, vcl_size_t ldz)
+  {
+    if (n == 0)
+      return;
+
+    std::vector<NumericT> e(e_in, e_in + n);
+    e[n-1] = 0;
+
+    NumericT f = 0;
+    NumericT tst1 = 0;
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+    for (vcl_size_t l = 0; l < n; ++l)
+    {
+      tst1 = std::max<NumericT>(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+      vcl_size_t m = l;
+      while (m < n-1)
+      {
+        if (std::fabs(e[m]) <= eps * tst1)
+          break;
+        ++m;
+      }
+
+      if (m > l)
+      {
+        vcl_size_t iter = 0;
+        do
+        {
+          ++iter;
+          NumericT g = d[l];
+          NumericT p = (d[l+1] - g) / (2 * e[l]);
+          NumericT r = std::sqrt(p * p + 1);
+          if (p < 0)
+            r = -r;
+          d[l]   = e[l] / (p + r);
+          d[l+1] = e[l] * (p + r);
+          NumericT dl1 = d[l+1];
+          NumericT h = g - d[l];
+          for (vcl_size_t i = l+2; i < n; ++i)
+            d[i] -= h;
+          f += h;
+
+          p = d[m];
+          NumericT c = 1, c2 = 1, c3 = 1;
+          NumericT el1 = e[l+1];
+          NumericT s = 0, s2 = 0;
+          for (vcl_size_t i = m; i-- > l;)
+          {
+            c3 = c2;
+            c2 = c;
+            s2 = s;
+            g = c * e[i];
+            h = c * p;
+            r = std::sqrt(p * p + e[i] * e[i]);
+            e[i+1] = s * r;
+            s = e[i] / r;
+            c = p / r;
+            p = c * d[i] - s * g;
+            d[i+1] = h + s * (c * g + s * d[i]);
+
+            if (z)
+            {
+              NumericT * z_i  = z + i * ldz;
+              NumericT * z_i1 = z + (i+1) * ldz;
+              for (vcl_size_t k = 0; k < n; ++k)
+              {
+                h = z_i1[k];
+                z_i1[k] = s * z_i[k] + c * h;
+                z_i[k]  = c * z_i[k] - s * h;
+              }
+            }
+          }
+          p = -s * s2 * c3 * el1 * e[l] / dl1;
+          e[l] = s * p;
+          d[l] = c * p;
+        } while (std::fabs(e[l]) > eps * tst1 && iter < 30 * n);
+      }
+      d[l] += f;
+      e[l] = 0;
+    }
+  }
+
+  /** @brief Workspace and data shared by the recursion levels of the divide-and-conquer method */
+  template<typename NumericT>
+  struct symeig_dc_data
+  {
+    typedef typename symeig_workspace<NumericT>::type   MatrixType;
+
+    symeig_dc_data(vcl_size_t n, NumericT * d_in, NumericT * e_in, MatrixType & Z_in)
+      : d(d_in), e(e_in), Z(Z_in),
+        G(n, n, viennacl::context(viennacl::MAIN_MEMORY)),
+        U(n, n, viennacl::context(viennacl::MAIN_MEMORY)) {}
+
+    NumericT * d;
+    NumericT * e;
+    MatrixType & Z;   // eigenvectors
+    MatrixType G;     // gathered eigenvectors of the two subproblems
+    MatrixType U;     // eigenvectors of the rank-one modification
+  };
+
+  /** @brief Differences d_j - d_l of the poles of the secular equation, here the eigenvalues d of the two subproblems */
+  template<typename NumericT>
+  struct symeig_pole_difference
+  {
+    symeig_pole_difference(NumericT const * d) : d_(d) {}
+
+    NumericT operator()(vcl_size_t j, vcl_size_t l) const { return d_[j] - d_[l]; }
+
+    NumericT const * d_;
+  };
+
+  /** @brief Solves the secular equation 1 + rho * sum_j z_j^2 / (d_j - lambda) = 0 for its i-th root, which lies in (d_i, d_{i+1}), or in (d_{k-1}, d_{k-1} + rho * z^T z) for i = k-1.
+  *
+  * The poles d_j are only accessed through their differences diff(j, l) = d_j - d_l, which the caller may compute more accurately than by subtraction.
+  * The root is returned as lambda = d[origin] + tau with origin being the closer pole, so that the differences d_j - lambda are available to full relative accuracy.
+  * A two-pole rational model of the secular function (Bunch, Nielsen, and Sorensen) is safeguarded by bisection.
+  */
+  template<typename NumericT, typename PoleDifferenceT>
+  void symeig_secular_root(vcl_size_t i, vcl_size_t k, PoleDifferenceT const & diff, NumericT const * zk, NumericT rho, NumericT znorm2,
+                           vcl_size_t & origin, NumericT & tau)
+  {
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+    NumericT lower, upper;
+
+    if (i + 1 < k)
+    {
+      NumericT mid = diff(i+1, i) / 2;
+      NumericT f = 1;
+      for (vcl_size_t j = 0; j < k; ++j)
+        f += rho * zk[j] * zk[j] / (diff(j, i) - mid);
+      if (f >= 0) // root in the left half
+      {
+        origin = i;
+        lower = 0;
+        upper = mid;
+      }
+      else
+      {
+        origin = i + 1;
+        lower = -mid;
+        upper = 0;
+      }
+    }
+    else
+    {
+      origin = i;
+      lower = 0;
+      upper = rho * znorm2;
+    }
+
+    std::vector<NumericT> delta(k);   // poles relative to the origin
+    for (vcl_size_t j = 0; j < k; ++j)
+      delta[j] = diff(j, origin);
+    NumericT a = delta[i];                                    // left pole
+    NumericT b = (i + 1 < k) ? delta[i+1] : NumericT(0);      // right pole, unused for the last root
+
+    tau = (lower + upper) / 2;
+    for (vcl_size_t iter = 0; iter < 200; ++iter)
+    {
+      NumericT psi = 0, dpsi = 0, phi = 0, dphi = 0;
+      for (vcl_size_t j = 0; j <= i; ++j)
+      {
+        NumericT t = zk[j] / (delta[j] - tau);
+        psi  += zk[j] * t;
+        dpsi += t * t;
+      }
+      for (vcl_size_t j = i + 1; j < k; ++j)
+      {
+        NumericT t = zk[j] / (delta[j] - tau);
+        phi  += zk[j] * t;
+        dphi += t * t;
+      }
+      psi *= rho; dpsi *= rho; phi *= rho; dphi *= rho;
+      NumericT f = 1 + psi + phi;
+
+      if (f < 0)
+        lower = tau;
+      else
+        upper = tau;
+
+      if (std::fabs(f) <= eps * NumericT(k) * (1 + std::fabs(psi) + std::fabs(phi))
+          || upper - lower <= 2 * eps * std::max(std::fabs(lower), std::fabs(upper)))
+        break;
+
+      // rational model psi ~ A1 + B1 / (a - t), phi ~ A2 + B2 / (b - t), matching values and derivatives at tau:
+      NumericT candidate;
+      NumericT B1 = dpsi * (a - tau) * (a - tau);
+      NumericT A1 = psi - B1 / (a - tau);
+      if (i + 1 < k)
+      {
+        NumericT B2 = dphi * (b - tau) * (b - tau);
+        NumericT A2 = phi - B2 / (b - tau);
+        NumericT c = 1 + A1 + A2;
+        // c (a - t)(b - t) + B1 (b - t) + B2 (a - t) = 0
+        NumericT beta  = c * (a + b) + B1 + B2;
+        NumericT gamma = c * a * b + B1 * b + B2 * a;
+        NumericT disc  = std::sqrt(std::max<NumericT>(beta * beta - 4 * c * gamma, 0));
+        if (beta >= 0)
+          candidate = (c > 0 || c < 0) ? ((beta + disc) / (2 * c)) : gamma / beta;
+        else
+          candidate = (c > 0 || c < 0) ? ((beta - disc) / (2 * c)) : gamma / beta;
+        if (!(candidate > lower && candidate < upper))
+          candidate = (beta >= 0) ? 2 * gamma / (beta + disc) : 2 * gamma / (beta - disc);
+      }
+      else
+        candidate = a + B1 / (1 + A1 + phi);
+
+      if (candidate > lower && candidate < upper)
+        tau = candidate;
+      else
+        tau = (lower + upper) / 2;
+    }
+  }
+
+  /** @brief Merges the eigendecompositions of the two halves [first, first + split) and [first + split, first + size) coupled by rho = e[first + split - 1] */
+  template<typename NumericT>
+  void symeig_dc_merge(symeig_dc_data<NumericT> & data, vcl_size_t first, vcl_size_t size, vcl_size_t split, NumericT rho)
+  {
+    NumericT * d = data.d + first;
+    vcl_size_t ldz = data.Z.internal_size1();
+    vcl_size_t ldg = data.G.internal_size1();
+    vcl_size_t ldu = data.U.internal_size1();
+    NumericT * z_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.Z) + first + first * ldz;
+    NumericT * g_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.G);
+    NumericT * u_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.U);
+
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+
+    // T = diag(Q1, Q2) (diag(D) + rho' z z^T) diag(Q1, Q2)^T with z of unit norm and rho' = 2 |rho|:
+    std::vector<NumericT> z(size);
+    NumericT sign = (rho < 0) ? NumericT(-1) : NumericT(1);
+    NumericT scale = NumericT(1) / std::sqrt(NumericT(2));
+    for (vcl_size_t j = 0; j < split; ++j)
+      z[j] = z_mat[split - 1 + j * ldz] * scale;
+    for (vcl_size_t j = split; j < size; ++j)
+      z[j] = sign * z_mat[split + j * ldz] * scale;
+    rho = 2 * std::fabs(rho);
+
+    // sort the eigenvalues of both halves:
+    std::vector<std::pair<NumericT, vcl_size_t> > order(size);
+    for (vcl_size_t j = 0; j < size; ++j)
+      order[j] = std::make_pair(d[j], j);
+    std::sort(order.begin(), order.end());
+
+    NumericT d_max = 0, z_max = 0;
+    for (vcl_size_t j = 0; j < size; ++j)
+    {
+      d_max = std::max<NumericT>(d_max, std::fabs(d[j]));
+      z_max = std::max<NumericT>(z_max, std::fabs(z[j]));
+    }
+    NumericT tol = 8 * eps * std::max<NumericT>(d_max, rho * z_max);
+
+    // deflation: columns are of type 1 (nonzero in the upper half only), 2 (dense), or 3 (lower half only)
+    std::vector<int> type(size);
+    for (vcl_size_t j = 0; j < size; ++j)
+      type[j] = (j < split) ? 1 : 3;
+
+    std::vector<vcl_size_t> kept, deflated;
+    kept.reserve(size);
+    deflated.reserve(size);
+    bool has_pending = false;
+    vcl_size_t pending = 0;
+    for (vcl_size_t jj = 0; jj < size; ++jj)
+    {
+      vcl_size_t j = order[jj].second;
+      if (rho * std::fabs(z[j]) <= tol)
+      {
+        deflated.push_back(j);
+        continue;
+      }
+      if (!has_pending)
+      {
+        pending = j;
+        has_pending = true;
+        continue;
+      }
+
+      NumericT c = z[j];
+      NumericT s = z[pending];
+      NumericT r = std::sqrt(c * c + s * s);
+      c /= r;
+      s = -s / r;
+      if (std::fabs((d[j] - d[pending]) * c * s) <= tol)
+      {
+        // rotate the two (numerically) equal eigenvalues such that z[pending] vanishes:
+        z[j] = r;
+        z[pending] = 0;
+        NumericT * col_p = z_mat + pending * ldz;
+        NumericT * col_j = z_mat + j * ldz;
+        for (vcl_size_t row = 0; row < size; ++row)
+        {
+          NumericT x = col_p[row];
+          NumericT y = col_j[row];
+          col_p[row] = c * x + s * y;
+          col_j[row] = c * y - s * x;
+        }
+        NumericT t = d[pending] * c * c + d[j] * s * s;
+        d[j] = d[pending] * s * s + d[j] * c * c;
+        d[pending] = t;
+        if (type[pending] != type[j])
+          type[pending] = type[j] = 2;
+        deflated.push_back(pending);
+      }
+      else
+        kept.push_back(pending);
+      pending = j;
+    }
+    if (has_pending)
+      kept.push_back(pending);
+
+    vcl_size_t k = kept.size();
+
+    // gather the eigenvectors: non-deflated ones grouped by type, deflated ones at the end
+    std::vector<vcl_size_t> position(k);
+    vcl_size_t count[4] = {0, 0, 0, 0};
+    for (vcl_size_t j = 0; j < k; ++j)
+      ++count[type[kept[j]]];
+    vcl_size_t offset[4] = {0, 0, count[1], count[1] + count[2]};
+    for (vcl_size_t j = 0; j < k; ++j)
+      position[j] = offset[type[kept[j]]]++;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (size * size > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+    for (long j2 = 0; j2 < static_cast<long>(size); ++j2)
+    {
+      vcl_size_t j = static_cast<vcl_size_t>(j2);
+      vcl_size_t src = (j < k) ? kept[j] : deflated[j - k];
+      vcl_size_t dst = (j < k) ? position[j] : j;
+      std::copy(z_mat + src * ldz, z_mat + src * ldz + size, g_mat + dst * ldg);
+    }
+
+    // solve the secular equation for the non-deflated eigenvalues:
+    std::vector<NumericT> dk(k), zk(k), tau(k);
+    std::vector<vcl_size_t> origin(k);
+    NumericT znorm2 = 0;
+    for (vcl_size_t j = 0; j < k; ++j)
+    {
+      dk[j] = d[kept[j]];
+      zk[j] = z[kept[j]];
+      znorm2 += zk[j] * zk[j];
+    }
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(dynamic, 8) if (k > 64)
+#endif
+    for (long i2 = 0; i2 < static_cast<long>(k); ++i2)
+      symeig_secular_root(static_cast<vcl_size_t>(i2), k, symeig_pole_difference<NumericT>(&(dk[0])), &(zk[0]), rho, znorm2, origin[static_cast<vcl_size_t>(i2)], tau[static_cast<vcl_size_t>(i2)]);
+
+    // z recomputed from the computed eigenvalues (Gu and Eisenstat), so that the eigenvectors are numerically orthogonal:
+    std::vector<NumericT> zhat(k);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (k > 64)
+#endif
+    for (long j2 = 0; j2 < static_cast<long>(k); ++j2)
+    {
+      vcl_size_t j = static_cast<vcl_size_t>(j2);
+      NumericT prod = -((dk[j] - dk[origin[k-1]]) - tau[k-1]) / rho;
+      for (vcl_size_t i = 0; i + 1 < k; ++i)
+      {
+        NumericT diff = -((dk[j] - dk[origin[i]]) - tau[i]);   // lambda_i - d_j
+        prod *= diff / (((i < j) ? dk[i] : dk[i+1]) - dk[j]);
+      }
+      zhat[j] = (zk[j] < 0) ? -std::sqrt(std::fabs(prod)) : std::sqrt(std::fabs(prod));
+    }
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (k > 64)
+#endif
+    for (long i2 = 0; i2 < static_cast<long>(k); ++i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      NumericT * u_i = u_mat + i * ldu;
+      NumericT norm = 0;
+      for (vcl_size_t j = 0; j < k; ++j)
+      {
+        NumericT u = zhat[j] / ((dk[j] - dk[origin[i]]) - tau[i]);
+        u_i[position[j]] = u;
+        norm += u * u;
+      }
+      norm = NumericT(1) / std::sqrt(norm);
+      for (vcl_size_t j = 0; j < k; ++j)
+        u_i[j] *= norm;
+    }
+
+    // eigenvectors of the merged problem: upper rows from the type 1 and 2 columns, lower rows from the type 2 and 3 columns
+    vcl_size_t upper_cols = count[1] + count[2];
+    vcl_size_t lower_cols = count[2] + count[3];
+    symeig_gemm<NumericT>(NumericT(1), data.G, 0, 0, false, data.U, 0, 0, false,
+                          NumericT(0), data.Z, first, first, split, k, upper_cols);
+    symeig_gemm<NumericT>(NumericT(1), data.G, split, count[1], false, data.U, count[1], 0, false,
+                          NumericT(0), data.Z, first + split, first, size - split, k, lower_cols);
+
+    for (vcl_size_t j = k; j < size; ++j)
+      std::copy(g_mat + j * ldg, g_mat + j * ldg + size, z_mat + j * ldz);
+
+    std::vector<NumericT> d_deflated(size - k);
+    for (vcl_size_t j = 0; j < size - k; ++j)
+      d_deflated[j] = d[deflated[j]];
+    for (vcl_size_t i = 0; i < k; ++i)
+      d[i] = dk[origin[i]] + tau[i];
+    std::copy(d_deflated.begin(), d_deflated.end(), d + k);
+  }
+
+  /** @brief Computes the eigendecomposition of the tridiagonal block [first, first + size) by divide-and-conquer. The eigenvalues are returned in no particular order. */
+  template<typename NumericT>
+  void symeig_dc_recursive(symeig_dc_data<NumericT> & data, vcl_size_t first, vcl_size_t size)
+  {
+    vcl_size_t ldz = data.Z.internal_size1();
+    NumericT * z_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.Z) + first + first * ldz;
+
+    if (size <= SYMEIG_LEAF_SIZE)
+    {
+      for (vcl_size_t j = 0; j < size; ++j)
+      {
+        std::fill(z_mat + j * ldz, z_mat + j * ldz + size, NumericT(0));
+        z_mat[j + j * ldz] = 1;
+      }
+      symeig_tridiagonal_ql(size, data.d + first, data.e + first, z_mat, ldz);
+      return;
+    }
+
+    vcl_size_t split = size / 2;
+    NumericT rho = data.e[first + split - 1];
+    data.d[first + split - 1] -= std::fabs(rho);
+    data.d[first + split]     -= std::fabs(rho);
+
+    symeig_dc_recursive(data, first, split);
+    symeig_dc_recursive(data, first + split, size - split);
+
+    // the off-diagonal blocks are zero before merging:
+    for (vcl_size_t j = 0; j < split; ++j)
+      std::fill(z_mat + j * ldz + split, z_mat + j * ldz + size, NumericT(0));
+    for (vcl_size_t j = split; j < size; ++j)
+      std::fill(z_mat + j * ldz, z_mat + j * ldz + split, NumericT(0));
+
+    symeig_dc_merge(data, first, size, split, rho);
+  }
+
+  /** @brief Computes all eigenvalues (ascending) and, if Z is not NULL, the eigenvectors of the symmetric tridiagonal matrix with diagonal d and off-diagonal e by divide-and-conquer */
+  template<typename NumericT>
+  void symeig_tridiagonal(std::vector<NumericT> & d, std::vector<NumericT> & e, typename symeig_workspace<NumericT>::type * Z)
+  {
+    vcl_size_t n = d.size();
+    if (n == 0)
+      return;
+
+    // scale to unit max-norm to avoid over- and underflow in the secular equation:
+    NumericT scale = 0;
+    for (vcl_size_t i = 0; i < n; ++i)
+      scale = std::max<NumericT>(scale, std::max<NumericT>(std::fabs(d[i]), std::fabs(e[i])));
+    if (scale <= 0)
+      scale = 1;
+    for (vcl_size_t i = 0; i < n; ++i)
+    {
+      d[i] /= scale;
+      e[i] /= scale;
+    }
+
+    if (Z)
+    {
+      symeig_dc_data<NumericT> data(n, &(d[0]), &(e[0]), *Z);
+      symeig_dc_recursive(data, 0, n);
+
+      // sort eigenvalues and eigenvectors in ascending order:
+      std::vector<std::pair<NumericT, vcl_size_t> > order(n);
+      for (vcl_size_t i = 0; i < n; ++i)
+        order[i] = std::make_pair(d[i], i);
+      std::sort(order.begin(), order.end());
+
+      vcl_size_t ldz = Z->internal_size1();
+      vcl_size_t ldg = data.G.internal_size1();
+      NumericT * z_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(*Z);
+      NumericT * g_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(data.G);
+      for (vcl_size_t i = 0; i < n; ++i)
+      {
+        d[i] = order[i].first;
+        std::copy(z_mat + order[i].second * ldz, z_mat + order[i].second * ldz + n, g_mat + i * ldg);
+      }
+      for (vcl_size_t i = 0; i < n; ++i)
+        std::copy(g_mat + i * ldg, g_mat + i * ldg + n, z_mat + i * ldz);
+    }
+    else
+    {
+      symeig_tridiagonal_ql(n, &(d[0]), &(e[0]), static_cast<NumericT *>(NULL), 0);
+      std::sort(d.begin(), d.end());
+    }
+
+    for (vcl_size_t i = 0; i < n; ++i)
+      d[i] *= scale;
+  }
+
+  /** @brief Copies the matrix src to dst, where both reside in main memory but may differ in layout */
+  template<typename NumericT>
+  void symeig_copy_host(viennacl::matrix_base<NumericT> const & src, viennacl::matrix_base<NumericT> & dst)
+  {
+    NumericT const * data_src = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(src);
+    NumericT       * data_dst = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(dst);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (src.size1() * src.size2() > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+#endif
+    for (long i2 = 0; i2 < static_cast<long>(src.size1()); ++i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      for (vcl_size_t j = 0; j < src.size2(); ++j)
+      {
+        vcl_size_t src_row = src.start1() + i * src.stride1(), src_col = src.start2() + j * src.stride2();
+        vcl_size_t dst_row = dst.start1() + i * dst.stride1(), dst_col = dst.start2() + j * dst.stride2();
+        data_dst[dst.row_major() ? dst_row * dst.internal_size2() + dst_col : dst_row + dst_col * dst.internal_size1()]
+          = data_src[src.row_major() ? src_row * src.internal_size2() + src_col : src_row + src_col * src.internal_size1()];
+      }
+    }
+  }
+
+  /** @brief Computes the eigenvalues (ascending) and optionally the eigenvectors of the symmetric matrix A on the host */
+  template<typename NumericT>
+  void symmetric_eig(viennacl::matrix_base<NumericT> const & A, std::vector<NumericT> & D, viennacl::matrix_base<NumericT> * Q)
+  {
+    assert(A.size1() == A.size2() && bool("Matrix must be square for the symmetric eigensolver!"));
+
+    typedef typename symeig_workspace<NumericT>::type   MatrixType;
+
+    vcl_size_t n = A.size1();
+    viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+
+    MatrixType work(n, n, host_ctx);   // lower triangle is overwritten by the Householder vectors
+    if (A.memory_domain() == viennacl::MAIN_MEMORY)
+      symeig_copy_host(A, work);
+    else
+    {
+      viennacl::matrix_base<NumericT> staging(n, n, A.row_major(), viennacl::traits::context(A));
+      staging = A;
+      staging.switch_memory_context(host_ctx);
+      symeig_copy_host(staging, work);
+    }
+
+    std::vector<NumericT> e, tau;
+    symeig_tridiagonalize<NumericT>(work, D, e, tau);
+
+    if (!Q)
+    {
+      symeig_tridiagonal<NumericT>(D, e, static_cast<MatrixType *>(NULL));
+      return;
+    }
+
+    MatrixType Z(n, n, host_ctx);
+    symeig_tridiagonal<NumericT>(D, e, &Z);
+    symeig_apply_q<NumericT>(work, tau, Z);
+
+    if (Q->memory_domain() == viennacl::MAIN_MEMORY)
+      symeig_copy_host(Z, *Q);
+    else
+    {
+      viennacl::matrix_base<NumericT> staging(n, n, Q->row_major(), host_ctx);
+      symeig_copy_host(Z, staging);
+      staging.switch_memory_context(viennacl::traits::context(*Q));
+      *Q = staging;
+    }
+  }
+} //namespace detail
+
+
+/** @brief Computes all eigenvalues and eigenvectors of a dense symmetric matrix.
+*
+* Only the lower triangle of A is referenced. The computation is carried out in main memory (with OpenMP, if enabled),
+* matrices in other memory domains are transferred.
+*
+* @param A    The symmetric input matrix
+* @param D    Vector receiving the eigenvalues in ascending order
+* @param Q    Matrix receiving the orthonormal eigenvectors, column j belonging to D[j]
+*/
+template<typename NumericT>
+void symmetric_eig(viennacl::matrix_base<NumericT> const & A, std::vector<NumericT> & D, viennacl::matrix_base<NumericT> & Q)
+{
+  detail::symmetric_eig(A, D, &Q);
+}
+
+/** @brief Computes all eigenvalues and eigenvectors of a dense symmetric matrix. Eigenvalues are written to a ViennaCL vector, see above for details. */
+template<typename NumericT>
+void symmetric_eig(viennacl::matrix_base<NumericT> const & A, viennacl::vector_base<NumericT> & D, viennacl::matrix_base<NumericT> & Q)
+{
+  std::vector<NumericT> std_D;
+  detail::symmetric_eig(A, std_D, &Q);
+  viennacl::copy(std_D, D);
+}
+
+/** @brief Computes all eigenvalues (ascending) of a dense symmetric matrix. Only the lower triangle of A is referenced. */
+template<typename NumericT>
+void symmetric_eig(viennacl::matrix_base<NumericT> const & A, std::vector<NumericT> & D)
+{
+  detail::symmetric_eig(A, D, static_cast<viennacl::matrix_base<NumericT> *>(NULL));
+}
+
+/** @brief Computes all eigenvalues (ascending) of a dense symmetric matrix and writes them to a ViennaCL vector. */
+template<typename NumericT>
+void symmetric_eig(viennacl::matrix_base<NumericT> const & A, viennacl::vector_base<NumericT> & D)
+{
+  std::vector<NumericT> std_D;
+  detail::symmetric_eig(A, std_D, static_cast<viennacl::matrix_base<NumericT> *>(NULL));
+  viennacl::copy(std_D, D);
+}
+
+} //namespace linalg
+} //namespace viennacl
+
+#endif
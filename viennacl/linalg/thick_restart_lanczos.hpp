@@ -0,0 +1,576 @@
+#ifndef VIENNACL_LINALG_THICK_RESTART_LANCZOS_HPP_
+#define VIENNACL_LINALG_THICK_RESTART_LANCZOS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/thick_restart_lanczos.hpp
+*   @brief Thick-restart Lanczos method with locking and optional Chebyshev polynomial filtering for extremal eigenpairs of large symmetric matrices.
+*
+*   The implementation follows the TRLan algorithm by Wu and Simon: The Krylov basis is kept at a fixed size,
+*   and after each cycle the wanted Ritz vectors are retained as the first basis vectors of the next cycle.
+*/
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/symmetric_eig.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/tools/random.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the thick-restart Lanczos method.
+*
+* In contrast to lanczos_tag, the memory requirements are bounded by the size of the Krylov basis (krylov_size vectors),
+* while the number of restarts determines the accuracy.
+*/
+class thick_restart_lanczos_tag
+{
+public:
+
+  enum
+  {
+    largest = 0,
+    smallest
+  };
+
+  /** @brief The constructor
+  *
+  * @param numeig         Number of eigenpairs to be computed
+  * @param krylov         Size of the Krylov basis. A value of zero selects max(2*numeig, numeig + 20).
+  * @param tol            Relative tolerance for the residual norm of a Ritz pair, at which the Ritz pair is considered converged and locked
+  * @param max_restarts   Maximum number of restarts
+  * @param which          Whether the largest or the smallest eigenvalues are computed
+  */
+  thick_restart_lanczos_tag(vcl_size_t numeig = 10,
+                            vcl_size_t krylov = 0,
+                            double tol = 1e-8,
+                            vcl_size_t max_restarts = 500,
+                            int which = largest)
+    : num_eigenvalues_(numeig), krylov_size_(krylov), tol_(tol), max_restarts_(max_restarts), which_(which), chebyshev_degree_(0),
+      restarts_(0), matrix_vector_products_(0), num_converged_(0) {}
+
+  /** @brief Sets the number of eigenpairs to be computed */
+  void num_eigenvalues(vcl_size_t numeig) { num_eigenvalues_ = numeig; }
+  /** @brief Returns the number of eigenpairs to be computed */
+  vcl_size_t num_eigenvalues() const { return num_eigenvalues_; }
+
+  /** @brief Sets the size of the Krylov basis. Must be larger than the number of eigenpairs. Zero selects max(2*numeig, numeig + 20). */
+  void krylov_size(vcl_size_t krylov) { krylov_size_ = krylov; }
+  /** @brief Returns the size of the Krylov basis */
+  vcl_size_t krylov_size() const { return (krylov_size_ > 0) ? krylov_size_ : std::max<vcl_size_t>(2 * num_eigenvalues_, num_eigenvalues_ + 20); }
+
+  /** @brief Sets the relative tolerance for the residual norms of the Ritz pairs */
+  void tolerance(double tol) { tol_ = tol; }
+  /** @brief Returns the relative tolerance for the residual norms of the Ritz pairs */
+  double tolerance() const { return tol_; }
+
+  /** @brief Sets the maximum number of restarts */
+  void max_restarts(vcl_size_t num) { max_restarts_ = num; }
+  /** @brief Returns the maximum number of restarts */
+  vcl_size_t max_restarts() const { return max_restarts_; }
+
+  /** @brief Sets whether the largest (thick_restart_lanczos_tag::largest) or the smallest (thick_restart_lanczos_tag::smallest) eigenvalues are computed */
+  void which(int w) { which_ = w; }
+  /** @brief Returns whether the largest or the smallest eigenvalues are computed */
+  int which() const { return which_; }
+
+  /** @brief Sets the degree of the Chebyshev polynomial filter. A degree of zero (default) disables filtering.
+  *
+  * With filtering enabled, the Lanczos iteration is applied to p(A), where p is a Chebyshev polynomial damping the unwanted part of the spectrum.
+  * Each application of p(A) requires 'degree' sparse matrix-vector products, but the number of restarts is reduced considerably for clustered spectra.
+  */
+  void chebyshev_degree(vcl_size_t degree) { chebyshev_degree_ = degree; }
+  /** @brief Returns the degree of the Chebyshev polynomial filter */
+  vcl_size_t chebyshev_degree() const { return chebyshev_degree_; }
+
+  /** @brief Returns the number of restarts of the last run */
+  vcl_size_t restarts() const { return restarts_; }
+  /** @brief Returns the number of matrix-vector products with the system matrix of the last run */
+  vcl_size_t matrix_vector_products() const { return matrix_vector_products_; }
+  /** @brief Returns the number of eigenpairs which met the tolerance in the last run */
+  vcl_size_t num_converged() const { return num_converged_; }
+
+  /** @brief Sets the statistics of the last run. Called by the eigensolver. */
+  void statistics(vcl_size_t restarts, vcl_size_t mvps, vcl_size_t converged) const
+  {
+    restarts_ = restarts;
+    matrix_vector_products_ = mvps;
+    num_converged_ = converged;
+  }
+
+private:
+  vcl_size_t num_eigenvalues_;
+  vcl_size_t krylov_size_;
+  double     tol_;
+  vcl_size_t max_restarts_;
+  int        which_;
+  vcl_size_t chebyshev_degree_;
+
+  mutable vcl_size_t restarts_;
+  mutable vcl_size_t matrix_vector_products_;
+  mutable vcl_size_t num_converged_;
+};
+
+
+namespace detail
+{
+  /** @brief Computes all eigenpairs of a small dense symmetric matrix on the host with symmetric_eig().
+  *
+  * @param Z   Column-major n-by-n symmetric matrix on input, orthonormal eigenvectors (one per column) on output
+  * @param d   Eigenvalues in ascending order on output
+  * @param n   Dimension of the matrix
+  */
+  template<typename NumericT>
+  void trlan_symmetric_eig(std::vector<NumericT> & Z, std::vector<NumericT> & d, vcl_size_t n)
+  {
+    d.resize(n);
+    if (n == 0)
+      return;
+
+    typedef typename symeig_workspace<NumericT>::type   MatrixType;
+
+    viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+    MatrixType A(n, n, host_ctx);
+    MatrixType Q(n, n, host_ctx);
+    NumericT * a_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A);
+    for (vcl_size_t j = 0; j < n; ++j)
+      std::copy(Z.begin() + long(j * n), Z.begin() + long((j+1) * n), a_mat + j * A.internal_size1());
+
+    viennacl::linalg::detail::symmetric_eig(A, d, &Q);
+
+    NumericT const * q_mat = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(Q);
+    for (vcl_size_t j = 0; j < n; ++j)
+      std::copy(q_mat + j * Q.internal_size1(), q_mat + j * Q.internal_size1() + n, Z.begin() + long(j * n));
+  }
+
+  /** @brief Chebyshev polynomial filter p(x) = T_d((x - center) / half_width) of degree d. Damps the interval [center - |half_width|, center + |half_width|]. */
+  template<typename NumericT>
+  struct trlan_filter
+  {
+    trlan_filter() : degree(0), center(0), half_width(1) {}
+
+    vcl_size_t degree;      // zero if no filter is applied
+    NumericT   center;
+    NumericT   half_width;  // negative if the wanted eigenvalues are to the left of the damped interval
+  };
+
+  /** @brief Computes y = p(A) x using the three-term recurrence of the Chebyshev polynomials, or y = A x if no filter is active. Returns the number of matrix-vector products. */
+  template<typename MatrixT, typename NumericT>
+  vcl_size_t trlan_apply(MatrixT const & A, viennacl::vector_base<NumericT> const & x, viennacl::vector<NumericT> & y, trlan_filter<NumericT> const & filter,
+                         viennacl::vector<NumericT> & work0, viennacl::vector<NumericT> & work1)
+  {
+    y = viennacl::linalg::prod(A, x);
+    if (filter.degree == 0)
+      return 1;
+
+    NumericT c = filter.center;
+    NumericT e = filter.half_width;
+
+    // T_1: (A - c) x / e
+    y -= c * x;
+    y *= NumericT(1) / e;
+    if (filter.degree == 1)
+      return 1;
+
+    // T_{k+1} = 2 (A - c) T_k / e - T_{k-1}
+    viennacl::vector<NumericT> * t_prev = &work0;
+    viennacl::vector<NumericT> * t_curr = &work1;
+    viennacl::vector<NumericT> * t_next = &y;
+    *t_prev = x;
+    *t_curr = y;
+    for (vcl_size_t k = 2; k <= filter.degree; ++k)
+    {
+      *t_next = viennacl::linalg::prod(A, *t_curr);
+      *t_next -= c * (*t_curr);
+      *t_next *= NumericT(2) / e;
+      *t_next -= *t_prev;
+
+      viennacl::vector<NumericT> * tmp = t_prev;
+      t_prev = t_curr;
+      t_curr = t_next;
+      t_next = tmp;
+    }
+    if (t_curr != &y)
+      y = *t_curr;
+    return filter.degree;
+  }
+
+  /** @brief Orthogonalizes w against the first 'num' columns of V by classical Gram-Schmidt with one reorthogonalization step. Returns the accumulated projection coefficients. */
+  template<typename NumericT>
+  std::vector<NumericT> trlan_orthogonalize(viennacl::matrix<NumericT, viennacl::column_major> & V, vcl_size_t num, viennacl::vector<NumericT> & w)
+  {
+    std::vector<NumericT> coeffs(num);
+    if (num == 0)
+      return coeffs;
+
+    viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::column_major> > V_range(V, viennacl::range(0, V.size1()), viennacl::range(0, num));
+    std::vector<NumericT> h_host(num);
+    for (vcl_size_t pass = 0; pass < 2; ++pass)
+    {
+      viennacl::vector<NumericT> h = viennacl::linalg::prod(trans(V_range), w);
+      w -= viennacl::linalg::prod(V_range, h);
+
+      viennacl::copy(h, h_host);
+      for (vcl_size_t i = 0; i < num; ++i)
+        coeffs[i] += h_host[i];
+    }
+    return coeffs;
+  }
+
+  /** @brief Replaces the columns [first, first + Y_cols) of V by V(:, first:first+Y_rows) * Y, where Y is a column-major host matrix */
+  template<typename NumericT>
+  void trlan_rotate(viennacl::matrix<NumericT, viennacl::column_major> & V, vcl_size_t first,
+                    std::vector<NumericT> const & Y, vcl_size_t Y_rows, vcl_size_t Y_cols)
+  {
+    if (Y_cols == 0)
+      return;
+
+    std::vector<std::vector<NumericT> > Y_host(Y_rows, std::vector<NumericT>(Y_cols));
+    for (vcl_size_t j = 0; j < Y_cols; ++j)
+      for (vcl_size_t i = 0; i < Y_rows; ++i)
+        Y_host[i][j] = Y[i + j * Y_rows];
+    viennacl::matrix<NumericT, viennacl::column_major> Y_dev(Y_rows, Y_cols, viennacl::traits::context(V));
+    viennacl::copy(Y_host, Y_dev);
+
+    viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::column_major> > V_in(V, viennacl::range(0, V.size1()), viennacl::range(first, first + Y_rows));
+    viennacl::matrix<NumericT, viennacl::column_major> W = viennacl::linalg::prod(V_in, Y_dev);
+
+    viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::column_major> > V_out(V, viennacl::range(0, V.size1()), viennacl::range(first, first + Y_cols));
+    V_out = W;
+  }
+
+  /** @brief Fills column j of V with a random vector orthonormal to the first j columns */
+  template<typename NumericT>
+  void trlan_random_column(viennacl::matrix<NumericT, viennacl::column_major> & V, vcl_size_t j, viennacl::tools::uniform_random_numbers<NumericT> & random_gen)
+  {
+    std::vector<NumericT> s(V.size1());
+    for (vcl_size_t i = 0; i < s.size(); ++i)
+      s[i] = NumericT(0.5) + random_gen();
+    viennacl::vector<NumericT> w(V.size1(), viennacl::traits::context(V));
+    viennacl::copy(s, w);
+
+    trlan_orthogonalize(V, j, w);
+    NumericT norm_w = viennacl::linalg::norm_2(w);
+    if (norm_w > 0)
+      w /= norm_w;
+
+    viennacl::vector_base<NumericT> v_j(V.handle(), V.size1(), j * V.internal_size1(), 1);
+    v_j = w;
+  }
+
+  /** @brief Returns the indices of the Ritz values sorted such that the wanted ones come first */
+  template<typename NumericT>
+  std::vector<vcl_size_t> trlan_wanted_order(std::vector<NumericT> const & theta, bool wants_largest)
+  {
+    std::vector<vcl_size_t> idx(theta.size());
+    for (vcl_size_t i = 0; i < idx.size(); ++i)
+      idx[i] = wants_largest ? idx.size() - i - 1 : i;   // theta is sorted in ascending order
+    return idx;
+  }
+
+  /** @brief Implementation of the thick-restart Lanczos method.
+  *
+  * @param A                      The symmetric system matrix
+  * @param eigenvectors_A         Dense matrix holding the eigenvectors (one per column) on return, if compute_eigenvectors is true
+  * @param tag                    The tag with the parameters of the method
+  * @param compute_eigenvectors   Whether eigenvectors are to be written to eigenvectors_A
+  * @return                       The wanted eigenvalues, the most extremal first
+  */
+  template<typename MatrixT, typename DenseMatrixT, typename NumericT>
+  std::vector<NumericT> thick_restart_lanczos(MatrixT const & A, DenseMatrixT & eigenvectors_A, thick_restart_lanczos_tag const & tag, bool compute_eigenvectors, NumericT)
+  {
+    vcl_size_t n   = A.size1();
+    vcl_size_t nev = std::min<vcl_size_t>(tag.num_eigenvalues(), n);
+    vcl_size_t m   = std::min<vcl_size_t>(std::max<vcl_size_t>(tag.krylov_size(), nev + 1), n);
+    bool wants_largest = (tag.which() == thick_restart_lanczos_tag::largest);
+
+    vcl_size_t restarts = 0;
+    vcl_size_t mvps = 0;
+    if (nev == 0)
+    {
+      tag.statistics(0, 0, 0);
+      return std::vector<NumericT>();
+    }
+
+    viennacl::context ctx = viennacl::traits::context(A);
+    viennacl::matrix<NumericT, viennacl::column_major> V(n, m + 1, ctx);   // Krylov basis, last column is the residual vector
+    viennacl::vector<NumericT> w(n, ctx), work0(n, ctx), work1(n, ctx);
+    std::vector<NumericT> T(m * m);          // projected matrix (column-major), only the active block [l, m) is used
+    std::vector<NumericT> column_theta(m);   // Ritz values associated with the locked and retained columns
+
+    viennacl::tools::uniform_random_numbers<NumericT> random_gen;
+    trlan_random_column(V, 0, random_gen);
+
+    trlan_filter<NumericT> filter;
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+    NumericT anorm = 0;
+
+    vcl_size_t l = 0;   // number of locked columns
+    vcl_size_t k = 0;   // number of retained Ritz vectors (columns l, ..., l+k-1), followed by the residual vector in column l+k
+    for (;;)
+    {
+      //
+      // Step 1: Extend the Lanczos basis to m vectors
+      //
+      NumericT beta = 0;
+      for (vcl_size_t j = l + k; j < m; ++j)
+      {
+        viennacl::vector_base<NumericT> v_j(V.handle(), V.size1(), j * V.internal_size1(), 1);
+        mvps += trlan_apply(A, v_j, w, filter, work0, work1);
+
+        std::vector<NumericT> coeffs = trlan_orthogonalize(V, j + 1, w);
+        T[j + j * m] = coeffs[j];
+        anorm = std::max<NumericT>(anorm, std::fabs(coeffs[j]));
+
+        beta = viennacl::linalg::norm_2(w);
+        if (j + 1 < n && beta > eps * anorm * NumericT(n))
+        {
+          viennacl::vector_base<NumericT> v_jplus1(V.handle(), V.size1(), (j+1) * V.internal_size1(), 1);
+          v_jplus1 = w / beta;
+        }
+        else // invariant subspace found
+        {
+          beta = 0;
+          if (j + 1 < n)
+            trlan_random_column(V, j + 1, random_gen);
+        }
+        if (j + 1 < m)
+        {
+          T[j + (j+1) * m] = beta;
+          T[(j+1) + j * m] = beta;
+        }
+      }
+
+      //
+      // Step 2: Compute the Ritz pairs of the active block
+      //
+      vcl_size_t p = m - l;
+      std::vector<NumericT> Y(p * p);
+      for (vcl_size_t j = 0; j < p; ++j)
+        for (vcl_size_t i = 0; i < p; ++i)
+          Y[i + j * p] = T[(l + i) + (l + j) * m];
+      std::vector<NumericT> theta;
+      trlan_symmetric_eig(Y, theta, p);
+      anorm = std::max<NumericT>(anorm, std::max(std::fabs(theta[0]), std::fabs(theta[p-1])));
+
+      std::vector<vcl_size_t> idx = trlan_wanted_order(theta, wants_largest || filter.degree > 0);
+      vcl_size_t need = nev - l;
+
+      // number of leading wanted Ritz pairs with residual norm |beta * y_{p-1}| below the tolerance:
+      vcl_size_t converged = 0;
+      while (converged < need && std::fabs(beta * Y[(p-1) + idx[converged] * p]) <= NumericT(tag.tolerance()) * anorm)
+        ++converged;
+
+      bool done = (converged == need) || (restarts >= tag.max_restarts());
+      vcl_size_t num_retained = done ? need : std::min<vcl_size_t>(need + (p - need) / 2, p - 1);
+
+      // switch to the polynomial filter after the first cycle, when estimates of the spectrum are available:
+      bool enable_filter = !done && filter.degree == 0 && tag.chebyshev_degree() > 0;
+      if (enable_filter)
+      {
+        NumericT lower = theta[0]   - std::fabs(beta * Y[(p-1)]);
+        NumericT upper = theta[p-1] + std::fabs(beta * Y[(p-1) + (p-1) * p]);
+        NumericT cut = theta[idx[num_retained]];
+        NumericT a = wants_largest ? lower : cut;
+        NumericT b = wants_largest ? cut   : upper;
+        if (b > a)
+        {
+          filter.degree     = tag.chebyshev_degree();
+          filter.center     = (a + b) / NumericT(2);
+          filter.half_width = wants_largest ? (b - a) / NumericT(2) : (a - b) / NumericT(2);
+        }
+        else
+          enable_filter = false;
+      }
+
+      //
+      // Step 3: Thick restart: Lock the converged Ritz vectors and retain the wanted ones
+      //
+      std::vector<NumericT> Y_retained(p * num_retained);
+      for (vcl_size_t j = 0; j < num_retained; ++j)
+      {
+        std::copy(Y.begin() + long(idx[j] * p), Y.begin() + long((idx[j] + 1) * p), Y_retained.begin() + long(j * p));
+        column_theta[l + j] = theta[idx[j]];
+      }
+      trlan_rotate(V, l, Y_retained, p, num_retained);
+
+      if (done)
+      {
+        l += converged;
+        break;
+      }
+
+      l += converged;
+      k = num_retained - converged;
+
+      for (vcl_size_t j = 0; j < p; ++j)
+        for (vcl_size_t i = 0; i < p; ++i)
+          T[(m - p + i) + (m - p + j) * m] = 0;
+
+      viennacl::vector_base<NumericT> v_m(V.handle(), V.size1(), m * V.internal_size1(), 1);
+      viennacl::vector_base<NumericT> v_lk(V.handle(), V.size1(), (l + k) * V.internal_size1(), 1);
+
+      if (enable_filter)
+      {
+        // the retained vectors do not satisfy a Lanczos relation for p(A), hence restart from their sum:
+        w.clear();
+        for (vcl_size_t j = 0; j < k; ++j)
+        {
+          viennacl::vector_base<NumericT> v_j(V.handle(), V.size1(), (l + j) * V.internal_size1(), 1);
+          w += v_j;
+        }
+        trlan_orthogonalize(V, l, w);
+        NumericT norm_w = viennacl::linalg::norm_2(w);
+        viennacl::vector_base<NumericT> v_l(V.handle(), V.size1(), l * V.internal_size1(), 1);
+        if (norm_w > 0)
+          v_l = w / norm_w;
+        else
+          trlan_random_column(V, l, random_gen);
+        k = 0;
+        anorm = 0;
+      }
+      else
+      {
+        // arrowhead structure: diagonal Ritz values and couplings beta * y_{p-1} to the residual vector
+        for (vcl_size_t j = 0; j < k; ++j)
+        {
+          NumericT s = beta * Y[(p-1) + idx[converged + j] * p];
+          T[(l + j) + (l + j) * m] = theta[idx[converged + j]];
+          T[(l + j) + (l + k) * m] = s;
+          T[(l + k) + (l + j) * m] = s;
+        }
+        v_lk = v_m;
+      }
+
+      ++restarts;
+    }
+
+    //
+    // Step 4: If a filter was used, the Ritz values refer to p(A). Recover the eigenvalues of A by a Rayleigh-Ritz step.
+    //
+    viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::column_major> > X(V, viennacl::range(0, n), viennacl::range(0, nev));
+    if (filter.degree > 0)
+    {
+      viennacl::matrix<NumericT, viennacl::column_major> AX(n, nev, ctx);
+      for (vcl_size_t j = 0; j < nev; ++j)
+      {
+        viennacl::vector_base<NumericT> x_j(V.handle(), V.size1(), j * V.internal_size1(), 1);
+        viennacl::vector_base<NumericT> ax_j(AX.handle(), AX.size1(), j * AX.internal_size1(), 1);
+        ax_j = viennacl::linalg::prod(A, x_j);
+      }
+      mvps += nev;
+
+      viennacl::matrix<NumericT, viennacl::column_major> H_dev = viennacl::linalg::prod(trans(X), AX);
+      std::vector<std::vector<NumericT> > H_host(nev, std::vector<NumericT>(nev));
+      viennacl::copy(H_dev, H_host);
+      std::vector<NumericT> H(nev * nev);
+      for (vcl_size_t j = 0; j < nev; ++j)
+        for (vcl_size_t i = 0; i < nev; ++i)
+          H[i + j * nev] = (H_host[i][j] + H_host[j][i]) / NumericT(2);
+      std::vector<NumericT> theta;
+      trlan_symmetric_eig(H, theta, nev);
+
+      std::vector<vcl_size_t> idx = trlan_wanted_order(theta, wants_largest);
+      std::vector<NumericT> H_sorted(nev * nev);
+      for (vcl_size_t j = 0; j < nev; ++j)
+      {
+        std::copy(H.begin() + long(idx[j] * nev), H.begin() + long((idx[j] + 1) * nev), H_sorted.begin() + long(j * nev));
+        column_theta[j] = theta[idx[j]];
+      }
+      trlan_rotate(V, 0, H_sorted, nev, nev);
+    }
+
+    //
+    // Step 5: Sort by wanted order (locked vectors may have been found out of order) and write the results
+    //
+    std::vector<std::pair<NumericT, vcl_size_t> > order(nev);
+    for (vcl_size_t j = 0; j < nev; ++j)
+      order[j] = std::make_pair(wants_largest ? -column_theta[j] : column_theta[j], j);
+    std::sort(order.begin(), order.end());
+
+    std::vector<NumericT> eigenvalues(nev);
+    for (vcl_size_t j = 0; j < nev; ++j)
+    {
+      eigenvalues[j] = column_theta[order[j].second];
+      if (compute_eigenvectors)
+      {
+        viennacl::vector_base<NumericT> x_j(V.handle(), V.size1(), order[j].second * V.internal_size1(), 1);
+        viennacl::vector_base<NumericT> eigenvector_A(eigenvectors_A.handle(),
+                                                      eigenvectors_A.size1(),
+                                                      eigenvectors_A.row_major() ? j : j * eigenvectors_A.internal_size1(),
+                                                      eigenvectors_A.row_major() ? eigenvectors_A.internal_size2() : 1);
+        eigenvector_A = x_j;
+      }
+    }
+
+    tag.statistics(restarts, mvps, l);
+    return eigenvalues;
+  }
+
+} // end namespace detail
+
+
+/** @brief Computes extremal eigenpairs of a symmetric matrix using the thick-restart Lanczos method.
+*
+* @param matrix                 The symmetric system matrix
+* @param eigenvectors_A         A dense matrix with at least tag.num_eigenvalues() columns, in which the eigenvectors of A will be stored. Both row- and column-major matrices are supported.
+* @param tag                    Tag with the options of the thick-restart Lanczos method
+* @param compute_eigenvectors   Boolean flag. If true, eigenvectors are computed. Otherwise only eigenvalues are returned.
+* @return                       The largest (or smallest, depending on the tag) eigenvalues, the most extremal first
+*/
+template<typename MatrixT, typename DenseMatrixT>
+std::vector< typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type >
+eig(MatrixT const & matrix, DenseMatrixT & eigenvectors_A, thick_restart_lanczos_tag const & tag, bool compute_eigenvectors = true)
+{
+  typedef typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type   CPU_NumericType;
+
+  return detail::thick_restart_lanczos(matrix, eigenvectors_A, tag, compute_eigenvectors, CPU_NumericType());
+}
+
+/** @brief Computes extremal eigenvalues of a symmetric matrix using the thick-restart Lanczos method.
+*
+* @param matrix        The symmetric system matrix
+* @param tag           Tag with the options of the thick-restart Lanczos method
+* @return              The largest (or smallest, depending on the tag) eigenvalues, the most extremal first
+*/
+template<typename MatrixT>
+std::vector< typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type >
+eig(MatrixT const & matrix, thick_restart_lanczos_tag const & tag)
+{
+  typedef typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type  NumericType;
+
+  viennacl::matrix<NumericType> eigenvectors(matrix.size1(), 1);
+  return eig(matrix, eigenvectors, tag, false);
+}
+
+} // end namespace linalg
+} // end namespace viennacl
+#endif
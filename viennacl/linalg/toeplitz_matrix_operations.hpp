@@ -23,12 +23,17 @@
 */
 
 #include "viennacl/forwards.h"
+#ifdef VIENNACL_WITH_OPENCL
 #include "viennacl/ocl/backend.hpp"
+#endif
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/fft.hpp"
 
+#include <stdexcept>
+#include <vector>
+
 namespace viennacl
 {
   namespace linalg
@@ -40,6 +45,7 @@ namespace viennacl
     /** @brief Carries out matrix-vector multiplication with a toeplitz_matrix
     *
     * Implementation of the convenience expression result = prod(mat, vec);
+    * The spectrum of the circulant embedding of mat is cached within mat, so only one forward and one inverse FFT of vec are computed.
     *
     * @param mat    The matrix
     * @param vec    The vector
@@ -53,19 +59,103 @@ namespace viennacl
       assert(mat.size1() == result.size());
       assert(mat.size2() == vec.size());
 
-      viennacl::vector<SCALARTYPE> tmp(vec.size() * 4); tmp.clear();
-      viennacl::vector<SCALARTYPE> tmp2(vec.size() * 4);
+      mat.spectrum().apply(vec, result);
+    }
 
-      viennacl::vector<SCALARTYPE> tep(mat.elements().size() * 2);
-      viennacl::linalg::real_to_complex(mat.elements(), tep, mat.elements().size());
+    /** @brief Multiplies a toeplitz_matrix with all columns of a dense matrix: result = mat * vecs
+    *
+    * The columns are processed in parallel, each with one forward and one inverse FFT.
+    *
+    * @param mat    The matrix
+    * @param vecs   The dense matrix holding the vectors as columns
+    * @param result The dense result matrix
+    */
+    template<class SCALARTYPE, unsigned int ALIGNMENT>
+    void prod_impl(const viennacl::toeplitz_matrix<SCALARTYPE, ALIGNMENT> & mat,
+                   const viennacl::matrix_base<SCALARTYPE> & vecs,
+                         viennacl::matrix_base<SCALARTYPE> & result)
+    {
+      assert(mat.size1() == result.size1());
+      assert(mat.size2() == vecs.size1());
+      assert(vecs.size2() == result.size2());
 
+      mat.spectrum().apply(vecs, result);
+    }
 
 
-      viennacl::copy(vec.begin(), vec.end(), tmp.begin());
-      viennacl::linalg::real_to_complex(tmp, tmp2, vec.size() * 2);
-      viennacl::linalg::convolve(tep, tmp2, tmp);
-      viennacl::linalg::complex_to_real(tmp, tmp2, vec.size() * 2);
-      viennacl::copy(tmp2.begin(), tmp2.begin() + static_cast<vcl_ptrdiff_t>(vec.size()), result.begin());
+    /** @brief A tag for the solution of linear systems with a Toeplitz matrix by the Levinson recursion
+    *
+    * The Levinson recursion requires O(n^2) operations and O(n) memory. All leading principal submatrices must be nonsingular.
+    */
+    class levinson_tag {};
+
+    /** @brief Solves a linear system with a toeplitz_matrix using the Levinson recursion
+    *
+    * The recursion is carried out on the host, the result resides in the memory domain of rhs.
+    *
+    * @param mat    The Toeplitz matrix
+    * @param rhs    The right hand side
+    * @return The solution vector
+    */
+    template<class SCALARTYPE, unsigned int ALIGNMENT>
+    viennacl::vector<SCALARTYPE> solve(const viennacl::toeplitz_matrix<SCALARTYPE, ALIGNMENT> & mat,
+                                       const viennacl::vector_base<SCALARTYPE> & rhs,
+                                       levinson_tag)
+    {
+      assert(mat.size1() == rhs.size());
+
+      vcl_size_t n = mat.size1();
+      viennacl::vector<SCALARTYPE> result(n, viennacl::traits::context(rhs));
+      if (n == 0)
+        return result;
+
+      // t[k] = A(i, j) for k = i - j >= 0, t[2n + k] = A(i, j) for k < 0
+      std::vector<SCALARTYPE> t(2 * n);
+      std::vector<SCALARTYPE> y(n);
+      viennacl::copy(mat.elements(), t);
+      viennacl::copy(rhs, y);
+
+      std::vector<SCALARTYPE> f(n), b(n), x(n);  // forward, backward and solution vectors
+      std::vector<SCALARTYPE> f_new(n), b_new(n);
+
+      if (t[0] <= 0 && t[0] >= 0)
+        throw std::runtime_error("Levinson recursion: singular leading principal submatrix");
+      f[0] = b[0] = SCALARTYPE(1) / t[0];
+      x[0] = y[0] / t[0];
+
+      for (vcl_size_t m = 1; m < n; ++m)
+      {
+        // errors of the extended vectors: e_f = A(m, 0:m) * f, e_b = A(0, 1:m+1) * b, e_x = A(m, 0:m) * x
+        SCALARTYPE e_f = 0, e_b = 0, e_x = 0;
+        for (vcl_size_t i = 0; i < m; ++i)
+        {
+          e_f += t[m - i] * f[i];
+          e_x += t[m - i] * x[i];
+          e_b += t[2 * n - i - 1] * b[i];
+        }
+
+        SCALARTYPE denominator = SCALARTYPE(1) - e_f * e_b;
+        if (denominator <= 0 && denominator >= 0)
+          throw std::runtime_error("Levinson recursion: singular leading principal submatrix");
+
+        // f <- ([f; 0] - e_f [0; b]) / d,  b <- ([0; b] - e_b [f; 0]) / d
+        for (vcl_size_t i = 0; i <= m; ++i)
+        {
+          SCALARTYPE f_i = (i < m) ? f[i]     : SCALARTYPE(0);
+          SCALARTYPE b_i = (i > 0) ? b[i - 1] : SCALARTYPE(0);
+          f_new[i] = (f_i - e_f * b_i) / denominator;
+          b_new[i] = (b_i - e_b * f_i) / denominator;
+        }
+        f.swap(f_new);
+        b.swap(b_new);
+
+        // x <- [x; 0] + (y_m - e_x) b
+        for (vcl_size_t i = 0; i <= m; ++i)
+          x[i] = ((i < m) ? x[i] : SCALARTYPE(0)) + (y[m] - e_x) * b[i];
+      }
+
+      viennacl::copy(x, result);
+      return result;
     }
 
   } //namespace linalg
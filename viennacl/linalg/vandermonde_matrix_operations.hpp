@@ -27,7 +27,11 @@
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/fft.hpp"
-#include "viennacl/linalg/opencl/vandermonde_matrix_operations.hpp"
+#include "viennacl/linalg/host_based/vandermonde_matrix_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/vandermonde_matrix_operations.hpp"
+#endif
 
 namespace viennacl
 {
@@ -54,14 +58,48 @@ namespace viennacl
 
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(mat, vec, result);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
         case viennacl::OPENCL_MEMORY:
           viennacl::linalg::opencl::prod_impl(mat, vec, result);
           break;
+#endif
         default:
           throw std::runtime_error("not implemented");
       }
     }
 
+    /** @brief Multiplies a vandermonde_matrix with all columns of a dense matrix: result = mat * vecs
+    *
+    * @param mat    The matrix
+    * @param vecs   The dense matrix holding the vectors as columns
+    * @param result The dense result matrix
+    */
+    template<class SCALARTYPE, unsigned int ALIGNMENT>
+    void prod_impl(const viennacl::vandermonde_matrix<SCALARTYPE, ALIGNMENT> & mat,
+                   const viennacl::matrix_base<SCALARTYPE> & vecs,
+                         viennacl::matrix_base<SCALARTYPE> & result)
+    {
+      assert(mat.size1() == result.size1());
+      assert(mat.size2() == vecs.size1());
+      assert(vecs.size2() == result.size2());
+
+      vcl_size_t x_inc   = vecs.row_major() ? vecs.stride1() * vecs.internal_size2() : vecs.stride1();
+      vcl_size_t x_col   = vecs.row_major() ? vecs.stride2() : vecs.stride2() * vecs.internal_size1();
+      vcl_size_t x_start = vecs.row_major() ? vecs.start1() * vecs.internal_size2() + vecs.start2() : vecs.start1() + vecs.start2() * vecs.internal_size1();
+      vcl_size_t y_inc   = result.row_major() ? result.stride1() * result.internal_size2() : result.stride1();
+      vcl_size_t y_col   = result.row_major() ? result.stride2() : result.stride2() * result.internal_size1();
+      vcl_size_t y_start = result.row_major() ? result.start1() * result.internal_size2() + result.start2() : result.start1() + result.start2() * result.internal_size1();
+      for (vcl_size_t j = 0; j < vecs.size2(); ++j)
+      {
+        viennacl::vector_base<SCALARTYPE> x_j(const_cast<viennacl::backend::mem_handle &>(vecs.handle()), vecs.size1(), x_start + j * x_col, x_inc);
+        viennacl::vector_base<SCALARTYPE> y_j(result.handle(), result.size1(), y_start + j * y_col, y_inc);
+        prod_impl(mat, x_j, y_j);
+      }
+    }
+
   } //namespace linalg
 
 
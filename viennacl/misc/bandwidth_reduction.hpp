@@ -25,6 +25,7 @@
 
 #include "viennacl/misc/cuthill_mckee.hpp"
 #include "viennacl/misc/gibbs_poole_stockmeyer.hpp"
+#include "viennacl/misc/parallel_cuthill_mckee.hpp"
 
 
 namespace viennacl
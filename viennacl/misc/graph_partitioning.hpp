@@ -0,0 +1,544 @@
+#ifndef VIENNACL_MISC_GRAPH_PARTITIONING_HPP
+#define VIENNACL_MISC_GRAPH_PARTITIONING_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/misc/graph_partitioning.hpp
+*    @brief Implementation of a multilevel k-way graph partitioner for the sparsity pattern of a matrix.  Experimental.
+*/
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+namespace viennacl
+{
+
+/** @brief Tag for the multilevel k-way graph partitioner
+*
+* The graph of the symmetrized sparsity pattern is coarsened by heavy-edge matching until it is small, partitioned by recursive graph-growing bisection,
+* and then projected back to the original graph level by level, where each level is improved by a greedy k-way boundary refinement (cf. Karypis and Kumar, METIS).
+*/
+class multilevel_kway_tag
+{
+public:
+  /** @brief The constructor.
+  *
+  * @param num_parts           Number of parts
+  * @param imbalance           Allowed relative excess of the size of a part over the average part size. Enforced by moving boundary vertices greedily, hence a tolerance of zero is in general not met exactly.
+  * @param refinement_passes   Maximum number of refinement passes on each level
+  */
+  multilevel_kway_tag(vcl_size_t num_parts = 8, double imbalance = 0.03, unsigned int refinement_passes = 8)
+    : num_parts_(num_parts), imbalance_(imbalance), refinement_passes_(refinement_passes), edge_cut_(0), num_levels_(0), max_part_size_(0) {}
+
+  vcl_size_t num_parts() const { return num_parts_; }
+  void num_parts(vcl_size_t num) { if (num > 0) num_parts_ = num; }
+
+  double imbalance() const { return imbalance_; }
+  void imbalance(double tol) { if (tol >= 0) imbalance_ = tol; }
+
+  unsigned int refinement_passes() const { return refinement_passes_; }
+  void refinement_passes(unsigned int passes) { refinement_passes_ = passes; }
+
+  /** @brief Returns the number of edges of the symmetrized graph between different parts in the last partitioning */
+  vcl_size_t edge_cut() const { return edge_cut_; }
+  /** @brief Returns the number of levels of the multilevel hierarchy in the last partitioning, including the original graph */
+  vcl_size_t num_levels() const { return num_levels_; }
+  /** @brief Returns the number of vertices in the largest part of the last partitioning */
+  vcl_size_t max_part_size() const { return max_part_size_; }
+
+  /** @brief Sets the partitioning statistics. Called by the partitioner. */
+  void statistics(vcl_size_t edge_cut, vcl_size_t num_levels, vcl_size_t max_part_size) const
+  {
+    edge_cut_ = edge_cut;
+    num_levels_ = num_levels;
+    max_part_size_ = max_part_size;
+  }
+
+private:
+  vcl_size_t   num_parts_;
+  double       imbalance_;
+  unsigned int refinement_passes_;
+
+  //return values from partitioning
+  mutable vcl_size_t edge_cut_;
+  mutable vcl_size_t num_levels_;
+  mutable vcl_size_t max_part_size_;
+};
+
+
+namespace detail
+{
+  /** @brief Weighted undirected graph in CSR format used by the multilevel partitioner */
+  struct partitioning_graph
+  {
+    vcl_size_t size() const { return vertex_weights.size(); }
+
+    std::vector<unsigned int> row_buffer;
+    std::vector<unsigned int> col_buffer;
+    std::vector<unsigned int> edge_weights;
+    std::vector<unsigned int> vertex_weights;
+  };
+
+  /** @brief Sets up the graph of the symmetrized sparsity pattern of a CSR matrix without self-loops. All weights are one. */
+  inline void partitioning_graph_from_csr(unsigned int const * row_buffer, unsigned int const * col_buffer, vcl_size_t n, partitioning_graph & g)
+  {
+    std::vector<unsigned int> degrees(n + 1, 0);
+    for (vcl_size_t i = 0; i < n; ++i)
+      for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+        if (col_buffer[j] != i)
+        {
+          ++degrees[i];
+          ++degrees[col_buffer[j]];
+        }
+
+    // fill A + A^T, then remove duplicates:
+    std::vector<unsigned int> offsets(n + 1, 0);
+    for (vcl_size_t i = 0; i < n; ++i)
+      offsets[i+1] = offsets[i] + degrees[i];
+    std::vector<unsigned int> neighbors(offsets[n]);
+    std::vector<unsigned int> fill_pos(offsets.begin(), offsets.end() - 1);
+    for (vcl_size_t i = 0; i < n; ++i)
+      for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+        if (col_buffer[j] != i)
+        {
+          neighbors[fill_pos[i]++] = col_buffer[j];
+          neighbors[fill_pos[col_buffer[j]]++] = static_cast<unsigned int>(i);
+        }
+
+    std::vector<vcl_size_t> marker(n, n);
+    g.row_buffer.assign(1, 0);
+    g.col_buffer.clear();
+    for (vcl_size_t i = 0; i < n; ++i)
+    {
+      for (unsigned int j = offsets[i]; j < offsets[i+1]; ++j)
+        if (marker[neighbors[j]] != i)
+        {
+          marker[neighbors[j]] = i;
+          g.col_buffer.push_back(neighbors[j]);
+        }
+      g.row_buffer.push_back(static_cast<unsigned int>(g.col_buffer.size()));
+    }
+    g.edge_weights.assign(g.col_buffer.size(), 1);
+    g.vertex_weights.assign(n, 1);
+  }
+
+  /** @brief Computes a heavy-edge matching and the resulting coarse graph.
+    *
+    * Vertices are visited in a fixed pseudo-random order and matched with the unmatched neighbor connected by the heaviest edge.
+    *
+    * @param fine              The graph to be coarsened
+    * @param coarse            Output: The coarse graph
+    * @param coarse_map        Output: The coarse vertex of each fine vertex
+    * @param max_vertex_weight Vertices are not matched if their combined weight would exceed this limit
+    */
+  inline void partitioning_coarsen(partitioning_graph const & fine, partitioning_graph & coarse, std::vector<unsigned int> & coarse_map, unsigned int max_vertex_weight)
+  {
+    vcl_size_t n = fine.size();
+    unsigned int const unmatched = static_cast<unsigned int>(n);
+
+    // pseudo-random visiting order (linear congruential generator, deterministic for reproducible partitions):
+    std::vector<unsigned int> order(n);
+    for (vcl_size_t i = 0; i < n; ++i)
+      order[i] = static_cast<unsigned int>(i);
+    unsigned long state = 12345;
+    for (vcl_size_t i = n; i > 1; --i)
+    {
+      state = (state * 1103515245ul + 12345ul) & 0x7fffffff;
+      std::swap(order[i-1], order[state % i]);
+    }
+
+    std::vector<unsigned int> match(n, unmatched);
+    std::vector<unsigned int> coarse_vertices; // pairs of fine vertices forming a coarse vertex
+    coarse_map.resize(n);
+    for (vcl_size_t i = 0; i < n; ++i)
+    {
+      unsigned int v = order[i];
+      if (match[v] != unmatched)
+        continue;
+
+      unsigned int best = v;
+      unsigned int best_weight = 0;
+      for (unsigned int j = fine.row_buffer[v]; j < fine.row_buffer[v+1]; ++j)
+      {
+        unsigned int u = fine.col_buffer[j];
+        if (match[u] == unmatched && u != v && fine.edge_weights[j] > best_weight
+            && fine.vertex_weights[v] + fine.vertex_weights[u] <= max_vertex_weight)
+        {
+          best = u;
+          best_weight = fine.edge_weights[j];
+        }
+      }
+
+      match[v] = best;
+      match[best] = v;
+      coarse_map[v] = coarse_map[best] = static_cast<unsigned int>(coarse_vertices.size() / 2);
+      coarse_vertices.push_back(v);
+      coarse_vertices.push_back(best);
+    }
+
+    // contract matched edges, summing up the weights of parallel edges:
+    vcl_size_t coarse_n = coarse_vertices.size() / 2;
+    std::vector<long> position(coarse_n, -1);
+    coarse.row_buffer.assign(1, 0);
+    coarse.col_buffer.clear();
+    coarse.edge_weights.clear();
+    coarse.vertex_weights.resize(coarse_n);
+    for (vcl_size_t c = 0; c < coarse_n; ++c)
+    {
+      unsigned int v1 = coarse_vertices[2*c];
+      unsigned int v2 = coarse_vertices[2*c+1];
+      coarse.vertex_weights[c] = fine.vertex_weights[v1] + ((v2 != v1) ? fine.vertex_weights[v2] : 0);
+
+      vcl_size_t row_start = coarse.col_buffer.size();
+      for (unsigned int k = 0; k < ((v2 != v1) ? 2u : 1u); ++k)
+      {
+        unsigned int v = (k == 0) ? v1 : v2;
+        for (unsigned int j = fine.row_buffer[v]; j < fine.row_buffer[v+1]; ++j)
+        {
+          unsigned int cu = coarse_map[fine.col_buffer[j]];
+          if (cu == c)
+            continue;
+          if (position[cu] < static_cast<long>(row_start))
+          {
+            position[cu] = static_cast<long>(coarse.col_buffer.size());
+            coarse.col_buffer.push_back(cu);
+            coarse.edge_weights.push_back(fine.edge_weights[j]);
+          }
+          else
+            coarse.edge_weights[static_cast<vcl_size_t>(position[cu])] += fine.edge_weights[j];
+        }
+      }
+      coarse.row_buffer.push_back(static_cast<unsigned int>(coarse.col_buffer.size()));
+    }
+  }
+
+  /** @brief Breadth-first search within the vertex set marked by the given stamp. Returns the visited vertices in order. */
+  inline void partitioning_bfs(partitioning_graph const & g, unsigned int start, std::vector<unsigned int> const & in_set, unsigned int stamp,
+                               std::vector<unsigned int> & visited, unsigned int visit_stamp, std::vector<unsigned int> & queue)
+  {
+    queue.clear();
+    queue.push_back(start);
+    visited[start] = visit_stamp;
+    for (vcl_size_t q = 0; q < queue.size(); ++q)
+    {
+      unsigned int v = queue[q];
+      for (unsigned int j = g.row_buffer[v]; j < g.row_buffer[v+1]; ++j)
+      {
+        unsigned int u = g.col_buffer[j];
+        if (in_set[u] == stamp && visited[u] != visit_stamp)
+        {
+          visited[u] = visit_stamp;
+          queue.push_back(u);
+        }
+      }
+    }
+  }
+
+  /** @brief Initial partitioning by recursive bisection, where each bisection grows a region from a pseudo-peripheral vertex until half of the weight is reached.
+    *
+    * @param g            The (coarsest) graph
+    * @param vertices     The vertices to be partitioned
+    * @param num_parts    Number of parts for the given vertices
+    * @param first_part   Index of the first part
+    * @param part         Output: Part of each vertex
+    * @param in_set       Work array of graph size, entries are overwritten
+    * @param visited      Work array of graph size, entries are overwritten
+    * @param stamp        Counter for generating unique stamps in the work arrays
+    */
+  inline void partitioning_recursive_bisection(partitioning_graph const & g, std::vector<unsigned int> const & vertices,
+                                               vcl_size_t num_parts, unsigned int first_part, std::vector<unsigned int> & part,
+                                               std::vector<unsigned int> & in_set, std::vector<unsigned int> & visited, unsigned int & stamp)
+  {
+    if (num_parts <= 1 || vertices.size() <= 1)
+    {
+      for (vcl_size_t i = 0; i < vertices.size(); ++i)
+        part[vertices[i]] = first_part;
+      return;
+    }
+
+    vcl_size_t left_parts = num_parts / 2;
+    unsigned long total_weight = 0;
+    unsigned int set_stamp = ++stamp;
+    for (vcl_size_t i = 0; i < vertices.size(); ++i)
+    {
+      in_set[vertices[i]] = set_stamp;
+      total_weight += g.vertex_weights[vertices[i]];
+    }
+    unsigned long target_weight = (total_weight * left_parts) / num_parts;
+
+    // find a pseudo-peripheral vertex by repeated breadth-first searches:
+    std::vector<unsigned int> queue;
+    unsigned int start = vertices[0];
+    for (unsigned int sweep = 0; sweep < 2; ++sweep)
+    {
+      partitioning_bfs(g, start, in_set, set_stamp, visited, ++stamp, queue);
+      start = queue.back();
+    }
+
+    // grow the left region, continuing in further components if the current one is exhausted:
+    std::vector<unsigned int> left, right;
+    unsigned int left_stamp  = ++stamp;
+    unsigned int queue_stamp = ++stamp;
+    unsigned long left_weight = 0;
+    vcl_size_t next_candidate = 0;
+    while (left_weight < target_weight)
+    {
+      queue.clear();
+      queue.push_back(start);
+      visited[start] = queue_stamp;
+      for (vcl_size_t q = 0; q < queue.size() && left_weight < target_weight; ++q)
+      {
+        unsigned int v = queue[q];
+        in_set[v] = left_stamp;
+        left.push_back(v);
+        left_weight += g.vertex_weights[v];
+        for (unsigned int j = g.row_buffer[v]; j < g.row_buffer[v+1]; ++j)
+        {
+          unsigned int u = g.col_buffer[j];
+          if (in_set[u] == set_stamp && visited[u] != queue_stamp)
+          {
+            visited[u] = queue_stamp;
+            queue.push_back(u);
+          }
+        }
+      }
+
+      while (next_candidate < vertices.size() && in_set[vertices[next_candidate]] != set_stamp)
+        ++next_candidate;
+      if (next_candidate == vertices.size())
+        break;
+      start = vertices[next_candidate];
+    }
+
+    for (vcl_size_t i = 0; i < vertices.size(); ++i)
+      if (in_set[vertices[i]] == set_stamp)
+        right.push_back(vertices[i]);
+
+    partitioning_recursive_bisection(g, left,  left_parts,             first_part,                                         part, in_set, visited, stamp);
+    partitioning_recursive_bisection(g, right, num_parts - left_parts, first_part + static_cast<unsigned int>(left_parts), part, in_set, visited, stamp);
+  }
+
+  /** @brief Greedy k-way refinement: Boundary vertices are moved to the neighboring part with the largest reduction of the edge cut, subject to the balance constraint.
+    *
+    * Vertices in overweight parts are moved even if the edge cut increases, so that the balance constraint is restored.
+    */
+  inline void partitioning_refine(partitioning_graph const & g, std::vector<unsigned int> & part, vcl_size_t num_parts,
+                                  unsigned long max_part_weight, unsigned int passes)
+  {
+    std::vector<unsigned long> part_weights(num_parts, 0);
+    for (vcl_size_t v = 0; v < g.size(); ++v)
+      part_weights[part[v]] += g.vertex_weights[v];
+
+    std::vector<long>         connectivity(num_parts, 0);
+    std::vector<unsigned int> touched;
+    for (unsigned int pass = 0; pass < passes; ++pass)
+    {
+      vcl_size_t moves = 0;
+      for (vcl_size_t v = 0; v < g.size(); ++v)
+      {
+        unsigned int p = part[v];
+        unsigned int vw = g.vertex_weights[v];
+
+        touched.clear();
+        for (unsigned int j = g.row_buffer[v]; j < g.row_buffer[v+1]; ++j)
+        {
+          unsigned int q = part[g.col_buffer[j]];
+          if (connectivity[q] == 0)
+            touched.push_back(q);
+          connectivity[q] += g.edge_weights[j];
+        }
+
+        bool overweight = part_weights[p] > max_part_weight;
+        unsigned int best = p;
+        long best_gain = 0;
+        for (vcl_size_t i = 0; i < touched.size(); ++i)
+        {
+          unsigned int q = touched[i];
+          if (q == p || part_weights[q] + vw > max_part_weight)
+            continue;
+          long gain = connectivity[q] - connectivity[p];
+          bool better;
+          if (best == p)
+            better = overweight || gain > 0 || (gain == 0 && part_weights[q] + vw < part_weights[p]);
+          else
+            better = gain > best_gain || (gain == best_gain && part_weights[q] < part_weights[best]);
+          if (better)
+          {
+            best = q;
+            best_gain = gain;
+          }
+        }
+
+        for (vcl_size_t i = 0; i < touched.size(); ++i)
+          connectivity[touched[i]] = 0;
+        connectivity[p] = 0;
+
+        if (best != p)
+        {
+          part[v] = best;
+          part_weights[p] -= vw;
+          part_weights[best] += vw;
+          ++moves;
+        }
+      }
+      if (moves == 0)
+        break;
+    }
+  }
+
+  /** @brief Multilevel k-way partitioning of a CSR sparsity pattern. See multilevel_kway_tag for details. */
+  inline void partition_csr(unsigned int const * row_buffer, unsigned int const * col_buffer, vcl_size_t n,
+                            multilevel_kway_tag const & tag, std::vector<unsigned int> & part)
+  {
+    vcl_size_t num_parts = tag.num_parts();
+    part.assign(n, 0);
+    if (n == 0)
+    {
+      tag.statistics(0, 0, 0);
+      return;
+    }
+
+    // Step 1: Coarsening
+    std::vector<partitioning_graph>          graphs(1);
+    std::vector< std::vector<unsigned int> > coarse_maps;
+    partitioning_graph_from_csr(row_buffer, col_buffer, n, graphs[0]);
+
+    vcl_size_t coarsest_size = std::max<vcl_size_t>(20 * num_parts, 100);
+    unsigned int max_vertex_weight = static_cast<unsigned int>(std::max<vcl_size_t>((3 * n) / (2 * coarsest_size), 1));
+    while (graphs.back().size() > coarsest_size)
+    {
+      partitioning_graph coarse;
+      coarse_maps.push_back(std::vector<unsigned int>());
+      partitioning_coarsen(graphs.back(), coarse, coarse_maps.back(), max_vertex_weight);
+      if (10 * coarse.size() > 9 * graphs.back().size()) // too little progress, e.g. for star-shaped graphs
+      {
+        coarse_maps.pop_back();
+        break;
+      }
+      graphs.push_back(coarse);
+    }
+
+    // Step 2: Initial partitioning of the coarsest graph
+    unsigned long max_part_weight = static_cast<unsigned long>((1.0 + tag.imbalance()) * static_cast<double>((n + num_parts - 1) / num_parts));
+    std::vector<unsigned int> coarse_part(graphs.back().size());
+    {
+      std::vector<unsigned int> vertices(graphs.back().size());
+      for (vcl_size_t i = 0; i < vertices.size(); ++i)
+        vertices[i] = static_cast<unsigned int>(i);
+      std::vector<unsigned int> in_set(vertices.size(), 0);
+      std::vector<unsigned int> visited(vertices.size(), 0);
+      unsigned int stamp = 0;
+      partitioning_recursive_bisection(graphs.back(), vertices, num_parts, 0, coarse_part, in_set, visited, stamp);
+    }
+    partitioning_refine(graphs.back(), coarse_part, num_parts, max_part_weight, tag.refinement_passes());
+
+    // Step 3: Uncoarsening with refinement on each level
+    for (vcl_size_t level = coarse_maps.size(); level > 0; --level)
+    {
+      std::vector<unsigned int> const & coarse_map = coarse_maps[level - 1];
+      std::vector<unsigned int> fine_part(coarse_map.size());
+      for (vcl_size_t v = 0; v < coarse_map.size(); ++v)
+        fine_part[v] = coarse_part[coarse_map[v]];
+      partitioning_refine(graphs[level - 1], fine_part, num_parts, max_part_weight, tag.refinement_passes());
+      coarse_part.swap(fine_part);
+    }
+    part.swap(coarse_part);
+
+    // statistics:
+    partitioning_graph const & g = graphs[0];
+    vcl_size_t edge_cut = 0;
+    for (vcl_size_t v = 0; v < n; ++v)
+      for (unsigned int j = g.row_buffer[v]; j < g.row_buffer[v+1]; ++j)
+        if (part[v] != part[g.col_buffer[j]])
+          ++edge_cut;
+    std::vector<vcl_size_t> part_sizes(num_parts, 0);
+    for (vcl_size_t v = 0; v < n; ++v)
+      ++part_sizes[part[v]];
+    tag.statistics(edge_cut / 2, graphs.size(), *std::max_element(part_sizes.begin(), part_sizes.end()));
+  }
+
+} //namespace detail
+
+
+/** @brief Partitions the graph of the (symmetrized) sparsity pattern of a matrix into tag.num_parts() parts of (almost) equal size with a small number of edges between the parts.
+ *
+ * @param A     The matrix. Only the sparsity pattern is used. Matrices not residing in main memory are transferred to main memory temporarily.
+ * @param tag   The partitioner configuration. The edge cut and the largest part size are written to the tag.
+ * @return The part of each row of A
+ */
+template<typename NumericT, unsigned int AlignmentV>
+std::vector<unsigned int> partition(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, multilevel_kway_tag const & tag)
+{
+  std::vector<unsigned int> part;
+  if (A.handle1().get_active_handle_id() == viennacl::MAIN_MEMORY)
+  {
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+    detail::partition_csr(row_buffer, col_buffer, A.size1(), tag, part);
+  }
+  else
+  {
+    viennacl::compressed_matrix<NumericT> host_A(viennacl::context(viennacl::MAIN_MEMORY));
+    host_A = A;
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(host_A.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(host_A.handle2());
+    detail::partition_csr(row_buffer, col_buffer, host_A.size1(), tag, part);
+  }
+  return part;
+}
+
+
+/** @brief Computes a renumbering of the unknowns such that the unknowns of each part are numbered consecutively.
+ *
+ * The relative order of the unknowns within each part is preserved. The resulting index ranges can be passed to block_ilu_precond after reordering the system matrix.
+ *
+ * @param part               Part of each unknown as returned by partition()
+ * @param num_parts          Number of parts
+ * @param block_boundaries   Output: Index range [first, second) of each part in the new numbering
+ * @return permutation vector r. r[i] = l means that the new label of node i will be l (same convention as reorder()).
+ */
+template<typename IndexT>
+std::vector<IndexT> partition_permutation(std::vector<unsigned int> const & part, vcl_size_t num_parts,
+                                          std::vector< std::pair<vcl_size_t, vcl_size_t> > & block_boundaries)
+{
+  std::vector<vcl_size_t> offsets(num_parts + 1, 0);
+  for (vcl_size_t i = 0; i < part.size(); ++i)
+    ++offsets[part[i] + 1];
+  for (vcl_size_t p = 0; p < num_parts; ++p)
+    offsets[p+1] += offsets[p];
+
+  block_boundaries.resize(num_parts);
+  for (vcl_size_t p = 0; p < num_parts; ++p)
+    block_boundaries[p] = std::make_pair(offsets[p], offsets[p+1]);
+
+  std::vector<IndexT> permutation(part.size());
+  for (vcl_size_t i = 0; i < part.size(); ++i)
+    permutation[i] = static_cast<IndexT>(offsets[part[i]]++);
+  return permutation;
+}
+
+} //namespace viennacl
+
+
+#endif
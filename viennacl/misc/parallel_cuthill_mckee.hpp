@@ -0,0 +1,292 @@
+#ifndef VIENNACL_MISC_PARALLEL_CUTHILL_MCKEE_HPP
+#define VIENNACL_MISC_PARALLEL_CUTHILL_MCKEE_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/misc/parallel_cuthill_mckee.hpp
+*    @brief Implementation of the (reverse) Cuthill-McKee algorithm operating directly on the CSR arrays of a compressed_matrix, parallelized with OpenMP.  Experimental.
+*/
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/misc/cuthill_mckee.hpp"
+#include "viennacl/misc/graph_partitioning.hpp"
+
+namespace viennacl
+{
+
+/** @brief A tag for the reverse Cuthill-McKee algorithm, i.e. the Cuthill-McKee numbering in reverse order. Usually results in less fill-in for factorizations than the plain Cuthill-McKee numbering. */
+struct reverse_cuthill_mckee_tag {};
+
+
+namespace detail
+{
+  /** @brief Numbers the connected component containing the start vertex by a level-synchronous Cuthill-McKee breadth-first search.
+    *
+    * Each vertex of the next level is assigned to the neighbor with the smallest number in the current level.
+    * The children of each vertex are numbered by increasing degree, which yields exactly the sequential Cuthill-McKee numbering.
+    * Each level is processed in parallel in two passes: The first pass counts the children of each vertex, the second pass sorts and stores them after an exclusive scan of the counts.
+    *
+    * @param g              The graph of the symmetrized sparsity pattern
+    * @param start          The start vertex
+    * @param order          Vertices in Cuthill-McKee order. The component is appended.
+    * @param label          Position of each vertex in order, or -1 if not numbered yet
+    * @param level_starts   Output: Start positions of the levels of the component within order, followed by the end position of the component
+    */
+  inline void cuthill_mckee_component(partitioning_graph const & g, unsigned int start,
+                                      std::vector<unsigned int> & order, std::vector<long> & label,
+                                      std::vector<vcl_size_t> & level_starts)
+  {
+    unsigned int const * row_buffer = &(g.row_buffer[0]);
+    unsigned int const * col_buffer = g.col_buffer.size() > 0 ? &(g.col_buffer[0]) : NULL;
+
+    level_starts.assign(1, order.size());
+    label[start] = static_cast<long>(order.size());
+    order.push_back(start);
+
+    std::vector<unsigned int> child_offsets;
+    while (true)
+    {
+      vcl_size_t level_begin = level_starts.back();
+      vcl_size_t level_end   = order.size();
+      level_starts.push_back(level_end);
+      long level_size = static_cast<long>(level_end - level_begin);
+
+      // Pass 1: count the children of each vertex in the current level.
+      // An unnumbered neighbor u is a child of v if v is its neighbor with the smallest number in the current level.
+      child_offsets.resize(static_cast<vcl_size_t>(level_size) + 1);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (level_size > 256)
+#endif
+      for (long i2 = 0; i2 < level_size; ++i2)
+      {
+        unsigned int v = order[level_begin + static_cast<vcl_size_t>(i2)];
+        long v_label = label[v];
+        unsigned int num_children = 0;
+        for (unsigned int j = row_buffer[v]; j < row_buffer[v+1]; ++j)
+        {
+          unsigned int u = col_buffer[j];
+          if (label[u] >= 0)
+            continue;
+          bool is_parent = true;
+          for (unsigned int k = row_buffer[u]; k < row_buffer[u+1]; ++k)
+          {
+            long w_label = label[col_buffer[k]];
+            if (w_label >= static_cast<long>(level_begin) && w_label < v_label)
+            {
+              is_parent = false;
+              break;
+            }
+          }
+          if (is_parent)
+            ++num_children;
+        }
+        child_offsets[static_cast<vcl_size_t>(i2) + 1] = num_children;
+      }
+
+      child_offsets[0] = 0;
+      for (vcl_size_t i = 0; i < static_cast<vcl_size_t>(level_size); ++i)
+        child_offsets[i+1] += child_offsets[i];
+      if (child_offsets[static_cast<vcl_size_t>(level_size)] == 0)
+        break;
+
+      // Pass 2: store the children of each vertex sorted by degree:
+      order.resize(level_end + child_offsets[static_cast<vcl_size_t>(level_size)]);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel if (level_size > 256)
+#endif
+      {
+        std::vector< std::pair<unsigned int, unsigned int> > children;
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp for
+#endif
+        for (long i2 = 0; i2 < level_size; ++i2)
+        {
+          unsigned int v = order[level_begin + static_cast<vcl_size_t>(i2)];
+          long v_label = label[v];
+          children.clear();
+          for (unsigned int j = row_buffer[v]; j < row_buffer[v+1]; ++j)
+          {
+            unsigned int u = col_buffer[j];
+            if (label[u] >= 0)
+              continue;
+            bool is_parent = true;
+            for (unsigned int k = row_buffer[u]; k < row_buffer[u+1]; ++k)
+            {
+              long w_label = label[col_buffer[k]];
+              if (w_label >= static_cast<long>(level_begin) && w_label < v_label)
+              {
+                is_parent = false;
+                break;
+              }
+            }
+            if (is_parent)
+              children.push_back(std::make_pair(row_buffer[u+1] - row_buffer[u], u));
+          }
+          std::sort(children.begin(), children.end());
+
+          vcl_size_t offset = level_end + child_offsets[static_cast<vcl_size_t>(i2)];
+          for (vcl_size_t i = 0; i < children.size(); ++i)
+            order[offset + i] = children[i].second;
+        }
+      }
+
+      // Number the next level. Done after pass 2, since the passes rely on the next level not being numbered yet:
+      long next_size = static_cast<long>(order.size() - level_end);
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (next_size > 4096)
+#endif
+      for (long i2 = 0; i2 < next_size; ++i2)
+      {
+        vcl_size_t i = level_end + static_cast<vcl_size_t>(i2);
+        label[order[i]] = static_cast<long>(i);
+      }
+    }
+  }
+
+  /** @brief Computes the Cuthill-McKee numbering of the graph of a CSR sparsity pattern.
+    *
+    * The start vertex of each connected component is determined by the pseudo-peripheral node finder of George and Liu:
+    * Starting with a vertex of minimum degree, the vertex of minimum degree in the last level of the level structure is taken as new start vertex as long as this increases the number of levels.
+    *
+    * @return The vertices in Cuthill-McKee order, i.e. the inverse of the permutation
+    */
+  inline std::vector<unsigned int> cuthill_mckee_csr(unsigned int const * row_buffer, unsigned int const * col_buffer, vcl_size_t n)
+  {
+    partitioning_graph g;
+    partitioning_graph_from_csr(row_buffer, col_buffer, n, g);
+
+    // vertices sorted by degree (counting sort), used for selecting the initial vertex of each component:
+    std::vector<unsigned int> degree_offsets(n + 1, 0);
+    for (vcl_size_t i = 0; i < n; ++i)
+      ++degree_offsets[g.row_buffer[i+1] - g.row_buffer[i] + 1];
+    for (vcl_size_t d = 0; d < n; ++d)
+      degree_offsets[d+1] += degree_offsets[d];
+    std::vector<unsigned int> by_degree(n);
+    for (vcl_size_t i = 0; i < n; ++i)
+      by_degree[degree_offsets[g.row_buffer[i+1] - g.row_buffer[i]]++] = static_cast<unsigned int>(i);
+
+    std::vector<unsigned int> order;
+    order.reserve(n);
+    std::vector<long> label(n, -1);
+    std::vector<vcl_size_t> level_starts;
+    for (vcl_size_t candidate = 0; order.size() < n; ++candidate)
+    {
+      unsigned int start = by_degree[candidate];
+      if (label[start] >= 0)
+        continue;
+
+      // George-Liu pseudo-peripheral node finder:
+      vcl_size_t component_begin = order.size();
+      cuthill_mckee_component(g, start, order, label, level_starts);
+      while (true)
+      {
+        vcl_size_t num_levels = level_starts.size();
+        unsigned int candidate_start = order[level_starts[num_levels - 2]];
+        for (vcl_size_t i = level_starts[num_levels - 2]; i < level_starts[num_levels - 1]; ++i)
+          if (g.row_buffer[order[i]+1] - g.row_buffer[order[i]] < g.row_buffer[candidate_start+1] - g.row_buffer[candidate_start])
+            candidate_start = order[i];
+
+        std::vector<vcl_size_t> candidate_level_starts;
+        for (vcl_size_t i = component_begin; i < order.size(); ++i)
+          label[order[i]] = -1;
+        std::vector<unsigned int> previous_order(order.begin() + static_cast<long>(component_begin), order.end());
+        order.resize(component_begin);
+        cuthill_mckee_component(g, candidate_start, order, label, candidate_level_starts);
+
+        if (candidate_level_starts.size() <= num_levels)
+        {
+          // no improvement: restore the numbering from the previous start vertex
+          for (vcl_size_t i = component_begin; i < order.size(); ++i)
+            label[order[i]] = -1;
+          order.resize(component_begin);
+          for (vcl_size_t i = 0; i < previous_order.size(); ++i)
+          {
+            label[previous_order[i]] = static_cast<long>(order.size());
+            order.push_back(previous_order[i]);
+          }
+          break;
+        }
+        level_starts.swap(candidate_level_starts);
+      }
+    }
+
+    return order;
+  }
+
+  /** @brief Extracts the CSR arrays of a compressed_matrix, transferring the matrix to main memory if necessary, and computes the Cuthill-McKee order */
+  template<typename NumericT, unsigned int AlignmentV>
+  std::vector<unsigned int> cuthill_mckee_csr(viennacl::compressed_matrix<NumericT, AlignmentV> const & A)
+  {
+    if (A.handle1().get_active_handle_id() == viennacl::MAIN_MEMORY)
+      return cuthill_mckee_csr(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1()),
+                               viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2()),
+                               A.size1());
+
+    viennacl::compressed_matrix<NumericT> host_A(viennacl::context(viennacl::MAIN_MEMORY));
+    host_A = A;
+    return cuthill_mckee_csr(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(host_A.handle1()),
+                             viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(host_A.handle2()),
+                             host_A.size1());
+  }
+}
+
+
+/** @brief Computes the Cuthill-McKee permutation of a compressed_matrix without conversion to STL containers. Parallelized with OpenMP.
+ *
+ * The sparsity pattern is symmetrized, the start vertex of each connected component is determined by the pseudo-peripheral node finder of George and Liu.
+ *
+ * @param A   The matrix. Only the sparsity pattern is used. Matrices not residing in main memory are transferred to main memory temporarily.
+ * @return permutation vector r. r[i] = l means that the new label of node i will be l.
+ */
+template<typename NumericT, unsigned int AlignmentV>
+std::vector<unsigned int> reorder(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, cuthill_mckee_tag)
+{
+  std::vector<unsigned int> order = detail::cuthill_mckee_csr(A);
+  std::vector<unsigned int> permutation(order.size());
+  for (vcl_size_t i = 0; i < order.size(); ++i)
+    permutation[order[i]] = static_cast<unsigned int>(i);
+  return permutation;
+}
+
+/** @brief Computes the reverse Cuthill-McKee permutation of a compressed_matrix without conversion to STL containers. Parallelized with OpenMP.
+ *
+ * @param A   The matrix. Only the sparsity pattern is used. Matrices not residing in main memory are transferred to main memory temporarily.
+ * @return permutation vector r. r[i] = l means that the new label of node i will be l.
+ */
+template<typename NumericT, unsigned int AlignmentV>
+std::vector<unsigned int> reorder(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, reverse_cuthill_mckee_tag)
+{
+  std::vector<unsigned int> order = detail::cuthill_mckee_csr(A);
+  std::vector<unsigned int> permutation(order.size());
+  for (vcl_size_t i = 0; i < order.size(); ++i)
+    permutation[order[i]] = static_cast<unsigned int>(order.size() - i - 1);
+  return permutation;
+}
+
+} //namespace viennacl
+
+
+#endif
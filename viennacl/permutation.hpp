@@ -0,0 +1,356 @@
+#ifndef VIENNACL_PERMUTATION_HPP_
+#define VIENNACL_PERMUTATION_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/permutation.hpp
+    @brief Permutations of the unknowns and their application to compressed_matrix and vectors, e.g. for applying the orderings computed by the bandwidth reduction algorithms.  Experimental.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+namespace viennacl
+{
+
+/** @brief A permutation of the unknowns, mapping each index i to its new index.
+*
+* Uses the convention of the bandwidth reduction algorithms (see viennacl/misc/bandwidth_reduction.hpp): If r is the permutation array returned by reorder(), then r[i] is the new index of unknown i.
+* With the permutation matrix P defined by (P x)[r[i]] = x[i], a matrix A is permuted to P A P^T.
+*/
+class permutation
+{
+public:
+  /** @brief Creates an empty permutation */
+  permutation() {}
+
+  /** @brief Creates the identity permutation of size n */
+  explicit permutation(vcl_size_t n) : new_indices_(n), old_indices_(n)
+  {
+    for (vcl_size_t i = 0; i < n; ++i)
+      new_indices_[i] = old_indices_[i] = static_cast<unsigned int>(i);
+  }
+
+  /** @brief Creates a permutation from a permutation array r, where r[i] is the new index of unknown i */
+  template<typename IndexT>
+  explicit permutation(std::vector<IndexT> const & r) : new_indices_(r.size()), old_indices_(r.size(), static_cast<unsigned int>(r.size()))
+  {
+    for (vcl_size_t i = 0; i < r.size(); ++i)
+    {
+      assert(static_cast<vcl_size_t>(r[i]) < r.size() && bool("Permutation index out of range"));
+      assert(old_indices_[static_cast<vcl_size_t>(r[i])] == r.size() && bool("Permutation array is not a permutation"));
+      new_indices_[i] = static_cast<unsigned int>(r[i]);
+      old_indices_[static_cast<vcl_size_t>(r[i])] = static_cast<unsigned int>(i);
+    }
+  }
+
+  vcl_size_t size() const { return new_indices_.size(); }
+
+  /** @brief Returns the new index of unknown i */
+  unsigned int operator[](vcl_size_t i) const { return new_indices_[i]; }
+
+  /** @brief Returns the old index of the unknown with new index i */
+  unsigned int old_index(vcl_size_t i) const { return old_indices_[i]; }
+
+  /** @brief Returns the array of new indices */
+  std::vector<unsigned int> const & new_indices() const { return new_indices_; }
+
+  /** @brief Returns the array of old indices, i.e. the inverse permutation array */
+  std::vector<unsigned int> const & old_indices() const { return old_indices_; }
+
+  /** @brief Returns the inverse permutation */
+  permutation inverse() const
+  {
+    permutation result;
+    result.new_indices_ = old_indices_;
+    result.old_indices_ = new_indices_;
+    return result;
+  }
+
+private:
+  std::vector<unsigned int> new_indices_;
+  std::vector<unsigned int> old_indices_;
+};
+
+
+namespace detail
+{
+  /** @brief Computes the CSR arrays of P A P^T on the host. Rows of the result are processed in parallel, column indices within each row are sorted.
+    *
+    * The output arrays must not alias the input arrays.
+    */
+  template<typename NumericT>
+  void permute_csr(unsigned int const * A_row_buffer, unsigned int const * A_col_buffer, NumericT const * A_elements,
+                   permutation const & P,
+                   unsigned int * B_row_buffer, unsigned int * B_col_buffer, NumericT * B_elements)
+  {
+    long n = static_cast<long>(P.size());
+
+    B_row_buffer[0] = 0;
+    for (long i = 0; i < n; ++i)
+    {
+      unsigned int old_row = P.old_index(static_cast<vcl_size_t>(i));
+      B_row_buffer[i+1] = B_row_buffer[i] + (A_row_buffer[old_row+1] - A_row_buffer[old_row]);
+    }
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      std::vector< std::pair<unsigned int, NumericT> > row_entries;
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long i = 0; i < n; ++i)
+      {
+        unsigned int old_row = P.old_index(static_cast<vcl_size_t>(i));
+        row_entries.clear();
+        for (unsigned int j = A_row_buffer[old_row]; j < A_row_buffer[old_row+1]; ++j)
+          row_entries.push_back(std::make_pair(P[A_col_buffer[j]], A_elements[j]));
+        std::sort(row_entries.begin(), row_entries.end());
+
+        unsigned int offset = B_row_buffer[i];
+        for (vcl_size_t j = 0; j < row_entries.size(); ++j)
+        {
+          B_col_buffer[offset + j] = row_entries[j].first;
+          B_elements[offset + j]   = row_entries[j].second;
+        }
+      }
+    }
+  }
+
+  /** @brief Computes y[P[i]] = x[i] (scatter) if inverse is false, or y[i] = x[P[i]] (gather) otherwise, for host arrays */
+  template<typename NumericT>
+  void permute_vector(NumericT const * x, NumericT * y, permutation const & P, bool inverse)
+  {
+    long n = static_cast<long>(P.size());
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (n > 10000)
+#endif
+    for (long i = 0; i < n; ++i)
+    {
+      if (inverse)
+        y[i] = x[P[static_cast<vcl_size_t>(i)]];
+      else
+        y[P[static_cast<vcl_size_t>(i)]] = x[i];
+    }
+  }
+
+  /** @brief Permutes a vector in place, transferring it to main memory and back if it does not reside in main memory */
+  template<typename NumericT>
+  void permute_vector(viennacl::vector_base<NumericT> & x, permutation const & P, bool inverse)
+  {
+    assert(x.size() == P.size() && bool("Size mismatch of vector and permutation"));
+    if (x.size() == 0)
+      return;
+
+    std::vector<NumericT> x_copy(x.size());
+    if (viennacl::traits::active_handle_id(x) == viennacl::MAIN_MEMORY)
+    {
+      NumericT * x_buf = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(x) + viennacl::traits::start(x);
+      vcl_size_t stride = viennacl::traits::stride(x);
+      if (stride == 1)
+      {
+        std::copy(x_buf, x_buf + x.size(), x_copy.begin());
+        permute_vector(&(x_copy[0]), x_buf, P, inverse);
+      }
+      else
+      {
+        std::vector<NumericT> y(x.size());
+        for (vcl_size_t i = 0; i < x.size(); ++i)
+          x_copy[i] = x_buf[i * stride];
+        permute_vector(&(x_copy[0]), &(y[0]), P, inverse);
+        for (vcl_size_t i = 0; i < x.size(); ++i)
+          x_buf[i * stride] = y[i];
+      }
+    }
+    else
+    {
+      std::vector<NumericT> y(x.size());
+      viennacl::copy(x, x_copy);
+      permute_vector(&(x_copy[0]), &(y[0]), P, inverse);
+      viennacl::copy(y, x);
+    }
+  }
+}
+
+
+/** @brief Computes the symmetric permutation B = P A P^T, i.e. B(P[i], P[j]) = A(i, j). The result resides in the same memory domain as A.
+ *
+ * @param A   The matrix to be permuted
+ * @param P   The permutation
+ * @param B   The result. Must not be the same object as A, see the in-place overload for this case. Matrices without nonzeros are not supported.
+ */
+template<typename NumericT, unsigned int AlignmentV>
+void permute(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, permutation const & P, viennacl::compressed_matrix<NumericT, AlignmentV> & B)
+{
+  assert(A.size1() == P.size() && A.size2() == P.size() && bool("Size mismatch of matrix and permutation"));
+  assert(&A != &B && bool("Use the in-place overload for permuting a matrix in place"));
+
+  viennacl::compressed_matrix<NumericT, AlignmentV> host_A(viennacl::context(viennacl::MAIN_MEMORY));
+  bool A_on_host = (A.handle1().get_active_handle_id() == viennacl::MAIN_MEMORY);
+  if (!A_on_host)
+    host_A = A;
+  viennacl::compressed_matrix<NumericT, AlignmentV> const & src = A_on_host ? A : host_A;
+
+  unsigned int const * src_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(src.handle1());
+  vcl_size_t nnz = src_row_buffer[src.size1()];
+  std::vector<unsigned int> rows(src.size1() + 1);
+  std::vector<unsigned int> cols(std::max<vcl_size_t>(nnz, 1));
+  std::vector<NumericT>     elements(std::max<vcl_size_t>(nnz, 1));
+  detail::permute_csr(src_row_buffer,
+                      viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(src.handle2()),
+                      viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(src.handle()),
+                      P, &(rows[0]), &(cols[0]), &(elements[0]));
+
+  viennacl::switch_memory_context(B, viennacl::traits::context(A));
+  B.set(&(rows[0]), &(cols[0]), &(elements[0]), A.size1(), A.size2(), std::max<vcl_size_t>(nnz, 1));
+}
+
+/** @brief Permutes a matrix, A <- P A P^T.
+ *
+ * For matrices in main memory, the permuted matrix is written to newly allocated buffers of the same sizes, which then replace the buffers of A without further copies.
+ * Other matrices are permuted on the host and transferred back, see the out-of-place overload.
+ */
+template<typename NumericT, unsigned int AlignmentV>
+void permute(viennacl::compressed_matrix<NumericT, AlignmentV> & A, permutation const & P)
+{
+  assert(A.size1() == P.size() && A.size2() == P.size() && bool("Size mismatch of matrix and permutation"));
+
+  if (A.nnz() == 0)
+    return;
+
+  if (A.handle1().get_active_handle_id() != viennacl::MAIN_MEMORY)
+  {
+    viennacl::compressed_matrix<NumericT, AlignmentV> B;
+    permute(A, P, B);
+    A = B;
+    return;
+  }
+
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  viennacl::backend::mem_handle row_handle, col_handle, elements_handle;
+  viennacl::backend::memory_create(row_handle,      A.handle1().raw_size(), host_ctx);
+  viennacl::backend::memory_create(col_handle,      A.handle2().raw_size(), host_ctx);
+  viennacl::backend::memory_create(elements_handle, A.handle().raw_size(),  host_ctx);
+
+  detail::permute_csr(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1()),
+                      viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2()),
+                      viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle()),
+                      P,
+                      viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(row_handle),
+                      viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(col_handle),
+                      viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(elements_handle));
+
+  // the old buffers are released with the local handles:
+  A.handle1().swap(row_handle);
+  A.handle2().swap(col_handle);
+  A.handle().swap(elements_handle);
+  A.generate_row_block_information();
+}
+
+/** @brief Permutes a vector in place, x <- P x, i.e. the entry x[i] is moved to position P[i] (scatter). */
+template<typename NumericT>
+void permute(viennacl::vector_base<NumericT> & x, permutation const & P)
+{
+  detail::permute_vector(x, P, false);
+}
+
+/** @brief Applies the inverse permutation to a vector in place, x <- P^T x, i.e. x[i] is replaced by the entry at position P[i] (gather). */
+template<typename NumericT>
+void permute_inverse(viennacl::vector_base<NumericT> & x, permutation const & P)
+{
+  detail::permute_vector(x, P, true);
+}
+
+
+namespace linalg
+{
+  namespace detail
+  {
+    /** @brief Calls the solver for the tag through argument-dependent lookup, such that the solver headers may be included after this file */
+    template<typename MatrixT, typename VectorT, typename SolverTagT>
+    VectorT permuted_system_solve(MatrixT const & A, VectorT const & rhs, SolverTagT const & tag)
+    {
+      return solve(A, rhs, tag);
+    }
+
+    template<typename MatrixT, typename VectorT, typename SolverTagT, typename PreconditionerT>
+    VectorT permuted_system_solve(MatrixT const & A, VectorT const & rhs, SolverTagT const & tag, PreconditionerT const & precond)
+    {
+      return solve(A, rhs, tag, precond);
+    }
+  }
+
+  /** @brief A linear system with reordered unknowns. The system matrix is permuted once, right-hand sides and solutions are permuted on entry and exit of the solver.
+  *
+  * Preconditioners need to be set up for the permuted matrix returned by matrix().
+  */
+  template<typename NumericT>
+  class permuted_system
+  {
+  public:
+    /** @brief Permutes the system matrix. The permuted matrix resides in the same memory domain as A. */
+    permuted_system(viennacl::compressed_matrix<NumericT> const & A, viennacl::permutation const & P) : P_(P)
+    {
+      viennacl::permute(A, P, A_);
+    }
+
+    /** @brief Returns the permuted system matrix P A P^T, e.g. for setting up preconditioners */
+    viennacl::compressed_matrix<NumericT> const & matrix() const { return A_; }
+
+    /** @brief Returns the permutation */
+    viennacl::permutation const & reordering() const { return P_; }
+
+    /** @brief Solves the system for the given right-hand side in the original numbering */
+    template<typename SolverTagT>
+    viennacl::vector<NumericT> solve(viennacl::vector_base<NumericT> const & rhs, SolverTagT const & tag) const
+    {
+      viennacl::vector<NumericT> b(rhs);
+      viennacl::permute(b, P_);
+      viennacl::vector<NumericT> x = detail::permuted_system_solve(A_, b, tag);
+      viennacl::permute_inverse(x, P_);
+      return x;
+    }
+
+    /** @brief Solves the system for the given right-hand side in the original numbering using a preconditioner set up for matrix() */
+    template<typename SolverTagT, typename PreconditionerT>
+    viennacl::vector<NumericT> solve(viennacl::vector_base<NumericT> const & rhs, SolverTagT const & tag, PreconditionerT const & precond) const
+    {
+      viennacl::vector<NumericT> b(rhs);
+      viennacl::permute(b, P_);
+      viennacl::vector<NumericT> x = detail::permuted_system_solve(A_, b, tag, precond);
+      viennacl::permute_inverse(x, P_);
+      return x;
+    }
+
+  private:
+    viennacl::permutation P_;
+    viennacl::compressed_matrix<NumericT> A_;
+  };
+}
+
+} //namespace viennacl
+
+#endif
@@ -24,7 +24,9 @@
 
 #include "viennacl/forwards.h"
 #include "viennacl/vector.hpp"
+#ifdef VIENNACL_WITH_OPENCL
 #include "viennacl/ocl/backend.hpp"
+#endif
 
 #include "viennacl/fft.hpp"
 
@@ -73,6 +75,7 @@ public:
   void resize(vcl_size_t sz, bool preserve = true)
   {
     elements_.resize(sz * 2, preserve);
+    spectrum_.invalidate();
   }
 
   /** @brief Returns the OpenCL handle
@@ -85,9 +88,21 @@ public:
        * @brief Returns an internal viennacl::vector, which represents a Toeplitz matrix elements
        *
        */
-  viennacl::vector<NumericT, AlignmentV> & elements() { return elements_; }
+  viennacl::vector<NumericT, AlignmentV> & elements() { spectrum_.invalidate(); return elements_; }
   viennacl::vector<NumericT, AlignmentV> const & elements() const { return elements_; }
 
+  /**
+       * @brief Returns the spectrum of the circulant embedding of size 2 * size1(), which is computed on first use and reused by all products until the entries are modified
+       *
+       * Modifications of the entries are detected through the non-const member functions, so references obtained from elements() must not be kept across products.
+       */
+  viennacl::detail::fft::circulant_spectrum<NumericT> const & spectrum() const
+  {
+    if (!spectrum_.valid())
+      spectrum_.setup(elements_);
+    return spectrum_;
+  }
+
 
   /**
        * @brief Returns the number of rows of the matrix
@@ -124,6 +139,7 @@ public:
       index = -index;
     else if
         (index > 0) index = 2 * static_cast<long>(size1()) - index;
+    spectrum_.invalidate();
     return elements_[vcl_size_t(index)];
   }
 
@@ -137,6 +153,7 @@ public:
   toeplitz_matrix<NumericT, AlignmentV>& operator +=(toeplitz_matrix<NumericT, AlignmentV>& that)
   {
     elements_ += that.elements();
+    spectrum_.invalidate();
     return *this;
   }
 
@@ -146,6 +163,7 @@ private:
 
 
   viennacl::vector<NumericT, AlignmentV> elements_;
+  mutable viennacl::detail::fft::circulant_spectrum<NumericT> spectrum_;
 };
 
 /** @brief Copies a Toeplitz matrix from the std::vector to the OpenCL device (either GPU or multi-core CPU)